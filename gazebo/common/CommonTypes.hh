@@ -77,6 +77,7 @@ namespace gazebo
     class DiagnosticTimer;
     class Image;
     class Mesh;
+    class MeshBVH;
     class SubMesh;
     class MouseEvent;
     class NumericAnimation;
@@ -17,12 +17,14 @@
 #ifndef GAZEBO_COMMON_EVENT_HH_
 #define GAZEBO_COMMON_EVENT_HH_
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
@@ -63,7 +65,7 @@ namespace gazebo
       public: void SetSignaled(const bool _sig);
 
       /// \brief True if the event has been signaled.
-      private: bool signaled;
+      private: std::atomic_bool signaled;
     };
 
     /// \brief A class that encapsulates a connection.
@@ -272,15 +274,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            conn.callback();
             IGN_PROFILE_END();
           }
         }
@@ -293,15 +295,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            conn.callback(_p);
             IGN_PROFILE_END();
           }
         }
@@ -315,15 +317,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            conn.callback(_p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +340,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            conn.callback(_p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +365,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            conn.callback(_p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +392,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            conn.callback(_p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +420,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            conn.callback(_p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +449,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            conn.callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +480,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            conn.callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,15 +513,15 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
+            conn.callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
@@ -544,60 +546,129 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8, const P9 &_p9, const P10 &_p10)
       {
-        this->Cleanup();
+        SignalScope scope(this);
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        for (const auto &conn : *scope.connections)
         {
           IGN_PROFILE("Event::Signal");
 
-          if (iter.second->on)
+          if (scope.Connected(conn))
           {
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
+            conn.callback(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
         }
       }
 
-      /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
-
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
         /// \brief Constructor
-        public: EventConnection(const bool _on, const std::function<T> &_cb)
-                : callback(_cb)
+        public: EventConnection(const int _id, const std::function<T> &_cb)
+                : id(_id), callback(_cb)
         {
-          // Windows Visual Studio 2012 does not have atomic_bool constructor,
-          // so we have to set "on" using operator=
-          this->on = _on;
         }
 
-        /// \brief On/off value for the event callback
-        public: std::atomic_bool on;
+        /// \brief Connection id
+        public: int id;
 
         /// \brief Callback function
         public: std::function<T> callback;
       };
 
-      /// \def EvtConnectionMap
-      /// \brief Event Connection map typedef.
-      typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
+      /// \def EvtConnectionList
+      /// \brief Event connection list typedef, sorted by id.
+      typedef std::vector<EventConnection> EvtConnectionList;
+
+      /// \internal
+      /// \brief Counts a signal in progress and holds the list of
+      /// connections it iterates, for the lifetime of the object.
+      private: class SignalScope
+      {
+        /// \brief Constructor.
+        /// \param[in] _event Event being signaled.
+        public: explicit SignalScope(EventT<T> *_event)
+                : event(_event)
+        {
+          // Count the signal before loading the list, so that a list
+          // replaced after this point isn't deleted under us.
+          ++this->event->signalCount;
+          this->disconnections = this->event->disconnections;
+          this->connections = this->event->connections.load();
+        }
+
+        /// \brief Destructor.
+        public: ~SignalScope()
+        {
+          if (--this->event->signalCount == 0 && this->event->hasRetired)
+            this->event->Reclaim();
+        }
+
+        /// \brief Get whether a connection of the list being iterated is
+        /// still connected.
+        /// \param[in] _conn Connection.
+        /// \return False if it was disconnected since the signal started.
+        public: bool Connected(const EventConnection &_conn) const
+        {
+          if (this->event->disconnections == this->disconnections)
+            return true;
+
+          // Slow path, look it up in the latest list
+          const EvtConnectionList *list = this->event->connections.load();
+          auto it = std::lower_bound(list->begin(), list->end(), _conn.id,
+              [](const EventConnection &_c, const int _id)
+              {
+                return _c.id < _id;
+              });
+          return it != list->end() && it->id == _conn.id;
+        }
+
+        /// \brief Event being signaled.
+        public: EventT<T> *event;
+
+        /// \brief Connections to call.
+        public: const EvtConnectionList *connections;
+
+        /// \brief Number of disconnections when the signal started.
+        public: unsigned int disconnections;
+      };
+
+      /// \internal
+      /// \brief Replace the list of connections. The mutex must be locked.
+      /// \param[in] _connections New list, owned by the event.
+      private: void Publish(const EvtConnectionList *_connections);
+
+      /// \internal
+      /// \brief Delete the replaced lists of connections if no signal is in
+      /// progress. Doesn't wait if the mutex is locked.
+      private: void Reclaim();
+
+      /// \brief Connections in connection order. The list is immutable, it is
+      /// replaced as a whole on connect and disconnect so that signals
+      /// iterate it without locking.
+      private: std::atomic<const EvtConnectionList *> connections;
+
+      /// \brief Number of signals in progress.
+      private: std::atomic<unsigned int> signalCount;
+
+      /// \brief Number of disconnections, lets signals in progress skip
+      /// the connections removed after they started.
+      private: std::atomic<unsigned int> disconnections;
+
+      /// \brief Replaced lists that signals in progress may still iterate.
+      private: std::vector<const EvtConnectionList *> retired;
 
-      /// \brief Array of connection callbacks.
-      private: EvtConnectionMap connections;
+      /// \brief True if there are replaced lists to delete.
+      private: std::atomic_bool hasRetired;
 
-      /// \brief A thread lock.
-      private: std::mutex mutex;
+      /// \brief Id of the next connection.
+      private: int nextId = 0;
 
-      /// \brief List of connections to remove
-      private: std::list<typename EvtConnectionMap::const_iterator>
-              connectionsToRemove;
+      /// \brief A thread lock, serializes changes to the connections.
+      private: mutable std::mutex mutex;
     };
 
     /// \brief Constructor.
@@ -605,13 +676,19 @@ namespace gazebo
     EventT<T>::EventT()
     : Event()
     {
+      this->connections = new EvtConnectionList();
+      this->signalCount = 0;
+      this->disconnections = 0;
+      this->hasRetired = false;
     }
 
     /// \brief Destructor. Deletes all the associated connections.
     template<typename T>
     EventT<T>::~EventT()
     {
-      this->connections.clear();
+      for (auto list : this->retired)
+        delete list;
+      delete this->connections.load();
     }
 
     /// \brief Adds a connection.
@@ -619,14 +696,15 @@ namespace gazebo
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
     {
-      int index = 0;
-      if (!this->connections.empty())
-      {
-        auto const &iter = this->connections.rbegin();
-        index = iter->first + 1;
-      }
-      this->connections[index].reset(new EventConnection(true, _subscriber));
-      return ConnectionPtr(new Connection(this, index));
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      const int id = this->nextId++;
+      EvtConnectionList *list =
+          new EvtConnectionList(*this->connections.load());
+      list->emplace_back(id, _subscriber);
+      this->Publish(list);
+
+      return ConnectionPtr(new Connection(this, id));
     }
 
     /// \brief Get the number of connections.
@@ -634,7 +712,8 @@ namespace gazebo
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      return this->connections.size();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->connections.load()->size();
     }
 
     /// \brief Removes a connection.
@@ -642,25 +721,56 @@ namespace gazebo
     template<typename T>
     void EventT<T>::Disconnect(int _id)
     {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
       // Find the connection
-      auto const &it = this->connections.find(_id);
+      const EvtConnectionList *current = this->connections.load();
+      auto it = std::lower_bound(current->begin(), current->end(), _id,
+          [](const EventConnection &_conn, const int _connId)
+          {
+            return _conn.id < _connId;
+          });
+      if (it == current->end() || it->id != _id)
+        return;
+
+      EvtConnectionList *list = new EvtConnectionList();
+      list->reserve(current->size() - 1);
+      list->insert(list->end(), current->begin(), it);
+      list->insert(list->end(), it + 1, current->end());
+      this->Publish(list);
+
+      // Signals in progress stop calling it from now on
+      ++this->disconnections;
+    }
 
-      if (it != this->connections.end())
+    /////////////////////////////////////////////
+    template<typename T>
+    void EventT<T>::Publish(const EvtConnectionList *_connections)
+    {
+      this->retired.push_back(this->connections.exchange(_connections));
+
+      // Signals that start from now on only see the new list
+      if (this->signalCount == 0)
       {
-        it->second->on = false;
-        this->connectionsToRemove.push_back(it);
+        for (auto list : this->retired)
+          delete list;
+        this->retired.clear();
       }
+      this->hasRetired = !this->retired.empty();
     }
 
     /////////////////////////////////////////////
     template<typename T>
-    void EventT<T>::Cleanup()
+    void EventT<T>::Reclaim()
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      std::unique_lock<std::mutex> lock(this->mutex, std::try_to_lock);
+      if (!lock.owns_lock() || this->signalCount != 0)
+        return;
+
+      for (auto list : this->retired)
+        delete list;
+      this->retired.clear();
+      this->hasRetired = false;
     }
     /// \}
   }
@@ -15,7 +15,10 @@
  *
 */
 
+#include <atomic>
 #include <functional>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -220,6 +223,80 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, ConnectionCount)
+{
+  event::EventT<void ()> evt;
+  EXPECT_EQ(0u, evt.ConnectionCount());
+
+  event::ConnectionPtr conn = evt.Connect(std::bind(&callback));
+  event::ConnectionPtr conn1 = evt.Connect(std::bind(&callback1));
+  EXPECT_EQ(2u, evt.ConnectionCount());
+  EXPECT_NE(conn->Id(), conn1->Id());
+
+  // Disconnections are applied right away
+  conn.reset();
+  EXPECT_EQ(1u, evt.ConnectionCount());
+  conn1.reset();
+  EXPECT_EQ(0u, evt.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, ChangesDuringSignal)
+{
+  event::EventT<void (int)> evt;
+  std::vector<int> calls;
+  event::ConnectionPtr conn, conn1, conn2;
+
+  // The first callback disconnects the second one and connects a third
+  conn = evt.Connect([&](int _i)
+      {
+        calls.push_back(0);
+        if (_i == 0)
+        {
+          conn1.reset();
+          conn2 = evt.Connect([&](int) {calls.push_back(2);});
+        }
+      });
+  conn1 = evt.Connect([&](int) {calls.push_back(1);});
+
+  // The disconnected callback isn't called anymore, the new one is only
+  // called by the next signals
+  evt(0);
+  EXPECT_EQ(std::vector<int>({0}), calls);
+
+  calls.clear();
+  evt(1);
+  EXPECT_EQ(std::vector<int>({0, 2}), calls);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, ConcurrentChanges)
+{
+  event::EventT<void (int)> evt;
+  std::atomic<int> total(0);
+  event::ConnectionPtr conn = evt.Connect([&](int _i) {total += _i;});
+
+  // Connect and disconnect from another thread while signaling
+  std::atomic_bool done(false);
+  std::thread changes([&]()
+      {
+        while (!done)
+        {
+          event::ConnectionPtr other = evt.Connect([](int) {});
+          other.reset();
+        }
+      });
+
+  for (int i = 0; i < 100000; ++i)
+    evt(1);
+  done = true;
+  changes.join();
+
+  EXPECT_EQ(100000, total);
+  EXPECT_EQ(1u, evt.ConnectionCount());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -29,6 +29,7 @@ EventT<void (std::string)> Events::entityCreated;
 EventT<void (std::string, std::string)> Events::setSelectedEntity;
 EventT<void (std::string)> Events::addEntity;
 EventT<void (std::string)> Events::deleteEntity;
+EventT<void (std::string)> Events::windModeChanged;
 
 EventT<void (const common::UpdateInfo &)> Events::worldUpdateBegin;
 EventT<void (const common::UpdateInfo &)> Events::beforePhysicsUpdate;
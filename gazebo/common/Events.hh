@@ -92,6 +92,14 @@ namespace gazebo
               static ConnectionPtr ConnectDeleteEntity(T _subscriber)
               { return deleteEntity.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a callback to the wind mode changed signal
+      /// \param[in] _subscriber the subscriber to this event
+      /// \return a connection
+      public: template<typename T>
+              static ConnectionPtr ConnectWindModeChanged(T _subscriber)
+              { return windModeChanged.Connect(_subscriber); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the add entity signal
       /// \param[in] _subscriber the subscriber to this event
@@ -243,6 +251,9 @@ namespace gazebo
       /// \brief An entity has been deleted
       public: static EventT<void (std::string)> deleteEntity;
 
+      /// \brief The wind mode of a link has changed
+      public: static EventT<void (std::string)> windModeChanged;
+
       /// \brief World update has started
       public: static EventT<void (const common::UpdateInfo &)> worldUpdateBegin;
 
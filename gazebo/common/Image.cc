@@ -21,12 +21,14 @@
 
 #include <FreeImage.h>
 #include <boost/filesystem.hpp>
+#include <cstring>
 #include <string>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/PixelFormatConversion.hh"
 
 using namespace gazebo;
 using namespace common;
@@ -112,6 +114,25 @@ void Image::SavePNG(const std::string &_filename)
 void Image::SetFromData(const unsigned char *_data, unsigned int _width,
     unsigned int _height, PixelFormat _format)
 {
+  // Reuse the current bitmap when it already has the requested layout, so
+  // that repeatedly setting frames of the same size does not allocate.
+  if (this->bitmap && _format != UNKNOWN_PIXEL_FORMAT &&
+      FreeImage_GetImageType(this->bitmap) == FIT_BITMAP &&
+      FreeImage_GetWidth(this->bitmap) == _width &&
+      FreeImage_GetHeight(this->bitmap) == _height &&
+      this->GetPixelFormat() == _format)
+  {
+    const unsigned int rowBytes =
+      _width * (FreeImage_GetBPP(this->bitmap) / 8);
+    for (unsigned int y = 0; y < _height; ++y)
+    {
+      // FreeImage stores rows bottom up
+      std::memcpy(FreeImage_GetScanLine(this->bitmap, _height - 1 - y),
+          _data + y * rowBytes, rowBytes);
+    }
+    return;
+  }
+
   if (this->bitmap)
     FreeImage_Unload(this->bitmap);
   this->bitmap = nullptr;
@@ -176,6 +197,36 @@ int Image::GetPitch() const
 //////////////////////////////////////////////////
 void Image::GetRGBData(unsigned char **_data, unsigned int &_count) const
 {
+  const unsigned int bpp = this->GetBPP();
+  if (this->Valid() && FreeImage_GetImageType(this->bitmap) == FIT_BITMAP &&
+      (bpp == 24 || bpp == 32))
+  {
+    // Copy or convert the rows directly instead of going through a
+    // temporary 24 bit bitmap. The output layout matches that of
+    // FreeImage_ConvertTo24Bits: top down rows padded to 4 bytes.
+    const unsigned int width = this->GetWidth();
+    const unsigned int height = this->GetHeight();
+    const unsigned int pitch = ((width * 24 + 31) / 32) * 4;
+
+    if (*_data)
+      delete [] *_data;
+
+    _count = pitch * height;
+    *_data = new unsigned char[_count]();
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      const unsigned char *src = FreeImage_GetScanLine(this->bitmap,
+          height - 1 - y);
+      unsigned char *dst = *_data + y * pitch;
+      if (bpp == 24)
+        std::memcpy(dst, src, width * 3);
+      else
+        ConvertRGBAToRGB(src, dst, width);
+    }
+    return;
+  }
+
   FIBITMAP *tmp = FreeImage_ConvertTo24Bits(this->bitmap);
   this->GetDataImpl(_data, _count, tmp);
   FreeImage_Unload(tmp);
@@ -27,7 +27,7 @@ using namespace gazebo;
 using namespace common;
 
 
-unsigned int Material::counter = 0;
+std::atomic<unsigned int> Material::counter{0};
 
 std::string Material::ShadeModeStr[SHADE_COUNT] = {"FLAT", "GOURAUD",
   "PHONG", "BLINN"};
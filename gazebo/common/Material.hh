@@ -17,6 +17,7 @@
 #ifndef GAZEBO_COMMON_MATERIAL_HH_
 #define GAZEBO_COMMON_MATERIAL_HH_
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <ignition/math/Color.hh>
@@ -224,7 +225,7 @@ namespace gazebo
       protected: ShadeMode shadeMode;
 
       /// \brief the total number of instanciated Material instances
-      private: static unsigned int counter;
+      private: static std::atomic<unsigned int> counter;
 
       /// \brief flag to perform depth buffer write
       private: bool depthWrite = true;
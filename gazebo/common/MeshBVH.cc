@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \brief Node of a mesh bounding volume hierarchy.
+    class MeshBVHNode
+    {
+      /// \brief Minimum corner of the node bounds.
+      public: ignition::math::Vector3d min;
+
+      /// \brief Maximum corner of the node bounds.
+      public: ignition::math::Vector3d max;
+
+      /// \brief Index of the first of the two children of an inner node,
+      /// or of the first triangle of a leaf.
+      public: unsigned int first = 0;
+
+      /// \brief Number of triangles of a leaf, zero for inner nodes.
+      public: unsigned int count = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for MeshBVH.
+    class MeshBVHPrivate
+    {
+      /// \brief Nodes, the root first. Children are stored next to each
+      /// other.
+      public: std::vector<MeshBVHNode> nodes;
+
+      /// \brief Triangle vertices, three per triangle, ordered so that the
+      /// triangles of each leaf are contiguous.
+      public: std::vector<ignition::math::Vector3d> vertices;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Maximum number of triangles in a leaf.
+static const unsigned int kLeafSize = 4;
+
+/////////////////////////////////////////////////
+/// \brief Intersect a ray with an axis aligned box.
+/// \param[in] _node Node with the box.
+/// \param[in] _origin Ray origin.
+/// \param[in] _invDir Inverse of the ray direction, per axis.
+/// \param[in] _maxDistance Ignore hits further than this.
+/// \param[out] _distance Distance at which the ray enters the box.
+/// \return True if the ray hits the box.
+static bool IntersectBox(const MeshBVHNode &_node,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_invDir, const double _maxDistance,
+    double &_distance)
+{
+  double tmin = 0;
+  double tmax = _maxDistance;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (std::isinf(_invDir[i]))
+    {
+      // Ray parallel to the slab
+      if (_origin[i] < _node.min[i] || _origin[i] > _node.max[i])
+        return false;
+      continue;
+    }
+
+    double t1 = (_node.min[i] - _origin[i]) * _invDir[i];
+    double t2 = (_node.max[i] - _origin[i]) * _invDir[i];
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tmin = std::max(tmin, t1);
+    tmax = std::min(tmax, t2);
+    if (tmin > tmax)
+      return false;
+  }
+  _distance = tmin;
+  return true;
+}
+
+/////////////////////////////////////////////////
+MeshBVH::MeshBVH(const Mesh &_mesh)
+  : dataPtr(new MeshBVHPrivate)
+{
+  // Gather the triangles, along with their centroids
+  std::vector<ignition::math::Vector3d> vertices;
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+      continue;
+
+    const unsigned int vertexCount = subMesh->GetVertexCount();
+    const unsigned int indexCount = subMesh->GetIndexCount();
+    for (unsigned int j = 0; j + 2 < indexCount; j += 3)
+    {
+      const unsigned int a = subMesh->GetIndex(j);
+      const unsigned int b = subMesh->GetIndex(j + 1);
+      const unsigned int c = subMesh->GetIndex(j + 2);
+      if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+        continue;
+      vertices.push_back(subMesh->Vertex(a));
+      vertices.push_back(subMesh->Vertex(b));
+      vertices.push_back(subMesh->Vertex(c));
+    }
+  }
+
+  const unsigned int triangleCount =
+      static_cast<unsigned int>(vertices.size() / 3);
+  if (triangleCount == 0)
+    return;
+
+  std::vector<ignition::math::Vector3d> centroids(triangleCount);
+  std::vector<unsigned int> order(triangleCount);
+  for (unsigned int i = 0; i < triangleCount; ++i)
+  {
+    centroids[i] = (vertices[3 * i] + vertices[3 * i + 1] +
+        vertices[3 * i + 2]) / 3.0;
+    order[i] = i;
+  }
+
+  // Build top-down, splitting each node at the median centroid along the
+  // longest axis of the centroid bounds. Each entry of the work list is a
+  // node with its range of triangles in order.
+  struct Range
+  {
+    unsigned int node;
+    unsigned int begin;
+    unsigned int end;
+  };
+  std::vector<Range> work;
+  this->dataPtr->nodes.reserve(2 * triangleCount / kLeafSize + 1);
+  this->dataPtr->nodes.emplace_back();
+  work.push_back({0, 0, triangleCount});
+  while (!work.empty())
+  {
+    const Range range = work.back();
+    work.pop_back();
+
+    const double inf = std::numeric_limits<double>::infinity();
+    ignition::math::Vector3d min(inf, inf, inf), max(-inf, -inf, -inf);
+    ignition::math::Vector3d cmin(inf, inf, inf), cmax(-inf, -inf, -inf);
+    for (unsigned int i = range.begin; i < range.end; ++i)
+    {
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        min.Min(vertices[3 * order[i] + k]);
+        max.Max(vertices[3 * order[i] + k]);
+      }
+      cmin.Min(centroids[order[i]]);
+      cmax.Max(centroids[order[i]]);
+    }
+    this->dataPtr->nodes[range.node].min = min;
+    this->dataPtr->nodes[range.node].max = max;
+
+    const ignition::math::Vector3d extent = cmax - cmin;
+    unsigned int axis = 0;
+    if (extent.Y() > extent[axis])
+      axis = 1;
+    if (extent.Z() > extent[axis])
+      axis = 2;
+
+    const unsigned int count = range.end - range.begin;
+    if (count <= kLeafSize || extent[axis] <= 0)
+    {
+      this->dataPtr->nodes[range.node].first = range.begin;
+      this->dataPtr->nodes[range.node].count = count;
+      continue;
+    }
+
+    const unsigned int mid = range.begin + count / 2;
+    std::nth_element(order.begin() + range.begin, order.begin() + mid,
+        order.begin() + range.end,
+        [&](const unsigned int _a, const unsigned int _b)
+        {
+          return centroids[_a][axis] < centroids[_b][axis];
+        });
+
+    const unsigned int first =
+        static_cast<unsigned int>(this->dataPtr->nodes.size());
+    this->dataPtr->nodes[range.node].first = first;
+    this->dataPtr->nodes.resize(first + 2);
+    work.push_back({first, range.begin, mid});
+    work.push_back({first + 1, mid, range.end});
+  }
+
+  this->dataPtr->vertices.reserve(vertices.size());
+  for (const auto i : order)
+  {
+    this->dataPtr->vertices.push_back(vertices[3 * i]);
+    this->dataPtr->vertices.push_back(vertices[3 * i + 1]);
+    this->dataPtr->vertices.push_back(vertices[3 * i + 2]);
+  }
+}
+
+/////////////////////////////////////////////////
+MeshBVH::~MeshBVH()
+{
+}
+
+/////////////////////////////////////////////////
+unsigned int MeshBVH::TriangleCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->vertices.size() / 3);
+}
+
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox MeshBVH::BoundingBox() const
+{
+  if (this->dataPtr->nodes.empty())
+    return ignition::math::AxisAlignedBox();
+  return ignition::math::AxisAlignedBox(this->dataPtr->nodes[0].min,
+      this->dataPtr->nodes[0].max);
+}
+
+/////////////////////////////////////////////////
+bool MeshBVH::Intersect(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, double &_distance,
+    ignition::math::Triangle3d &_triangle, const bool _backFaces) const
+{
+  if (this->dataPtr->nodes.empty() || _dir == ignition::math::Vector3d::Zero)
+    return false;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const ignition::math::Vector3d invDir(
+      _dir.X() != 0 ? 1.0 / _dir.X() : inf,
+      _dir.Y() != 0 ? 1.0 / _dir.Y() : inf,
+      _dir.Z() != 0 ? 1.0 / _dir.Z() : inf);
+
+  const auto &nodes = this->dataPtr->nodes;
+  const auto &vertices = this->dataPtr->vertices;
+
+  double closest = inf;
+  unsigned int closestTriangle = 0;
+
+  double entry;
+  if (!IntersectBox(nodes[0], _origin, invDir, closest, entry))
+    return false;
+
+  // Depth first, visiting the nearest child first so that far nodes are
+  // culled by the closest hit found so far
+  std::vector<std::pair<unsigned int, double>> stack;
+  stack.reserve(64);
+  stack.emplace_back(0, entry);
+  while (!stack.empty())
+  {
+    const auto top = stack.back();
+    stack.pop_back();
+    if (top.second > closest)
+      continue;
+
+    const MeshBVHNode &node = nodes[top.first];
+    if (node.count == 0)
+    {
+      double near0, near1;
+      const bool hit0 =
+          IntersectBox(nodes[node.first], _origin, invDir, closest, near0);
+      const bool hit1 =
+          IntersectBox(nodes[node.first + 1], _origin, invDir, closest, near1);
+      if (hit0 && hit1)
+      {
+        if (near0 <= near1)
+        {
+          stack.emplace_back(node.first + 1, near1);
+          stack.emplace_back(node.first, near0);
+        }
+        else
+        {
+          stack.emplace_back(node.first, near0);
+          stack.emplace_back(node.first + 1, near1);
+        }
+      }
+      else if (hit0)
+        stack.emplace_back(node.first, near0);
+      else if (hit1)
+        stack.emplace_back(node.first + 1, near1);
+      continue;
+    }
+
+    // Moller-Trumbore ray-triangle test
+    for (unsigned int i = node.first; i < node.first + node.count; ++i)
+    {
+      const ignition::math::Vector3d &a = vertices[3 * i];
+      const ignition::math::Vector3d edge1 = vertices[3 * i + 1] - a;
+      const ignition::math::Vector3d edge2 = vertices[3 * i + 2] - a;
+      const ignition::math::Vector3d p = _dir.Cross(edge2);
+      const double det = edge1.Dot(p);
+
+      // A positive determinant means the ray hits the front face
+      if (det == 0 || (!_backFaces && det < 0))
+        continue;
+
+      const double invDet = 1.0 / det;
+      const ignition::math::Vector3d s = _origin - a;
+      const double u = s.Dot(p) * invDet;
+      if (u < 0 || u > 1)
+        continue;
+
+      const ignition::math::Vector3d q = s.Cross(edge1);
+      const double v = _dir.Dot(q) * invDet;
+      if (v < 0 || u + v > 1)
+        continue;
+
+      const double t = edge2.Dot(q) * invDet;
+      if (t >= 0 && t < closest)
+      {
+        closest = t;
+        closestTriangle = i;
+      }
+    }
+  }
+
+  if (std::isinf(closest))
+    return false;
+
+  _distance = closest;
+  _triangle.Set(vertices[3 * closestTriangle],
+      vertices[3 * closestTriangle + 1], vertices[3 * closestTriangle + 2]);
+  return true;
+}
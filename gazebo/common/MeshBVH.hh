@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHBVH_HH_
+#define GAZEBO_COMMON_MESHBVH_HH_
+
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Triangle3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declarations.
+    class Mesh;
+    class MeshBVHPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshBVH MeshBVH.hh common/common.hh
+    /// \brief Bounding volume hierarchy over the triangles of a mesh, for
+    /// ray queries that are logarithmic in the number of triangles.
+    ///
+    /// The hierarchy is built once from the triangle submeshes of a mesh, in
+    /// the mesh frame, and doesn't follow later changes to the mesh.
+    class GZ_COMMON_VISIBLE MeshBVH
+    {
+      /// \brief Constructor, builds the hierarchy.
+      /// \param[in] _mesh Mesh to index.
+      public: explicit MeshBVH(const Mesh &_mesh);
+
+      /// \brief Destructor.
+      public: ~MeshBVH();
+
+      /// \brief Get the number of indexed triangles.
+      /// \return Number of triangles.
+      public: unsigned int TriangleCount() const;
+
+      /// \brief Get the bounding box of the indexed triangles.
+      /// \return Bounding box, empty if there are no triangles.
+      public: ignition::math::AxisAlignedBox BoundingBox() const;
+
+      /// \brief Find the closest triangle hit by a ray.
+      /// \param[in] _origin Ray origin, in the mesh frame.
+      /// \param[in] _dir Ray direction, in the mesh frame. It doesn't need
+      /// to be normalized, distances are measured in multiples of it.
+      /// \param[out] _distance Distance from the origin to the hit.
+      /// \param[out] _triangle Triangle that was hit.
+      /// \param[in] _backFaces True to also hit triangles from behind, when
+      /// the ray direction points the same way as the triangle normal.
+      /// \return True if a triangle was hit.
+      public: bool Intersect(const ignition::math::Vector3d &_origin,
+          const ignition::math::Vector3d &_dir, double &_distance,
+          ignition::math::Triangle3d &_triangle,
+          const bool _backFaces = true) const;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<MeshBVHPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
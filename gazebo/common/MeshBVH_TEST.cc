@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshBVHTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create a UV sphere mesh.
+/// \param[in] _rings Number of rings.
+/// \param[in] _segments Number of segments.
+/// \return The mesh.
+common::Mesh *Sphere(const unsigned int _rings, const unsigned int _segments)
+{
+  common::SubMesh *subMesh = new common::SubMesh();
+  for (unsigned int r = 0; r <= _rings; ++r)
+  {
+    const double theta = M_PI * r / _rings;
+    for (unsigned int s = 0; s < _segments; ++s)
+    {
+      const double phi = 2.0 * M_PI * s / _segments;
+      subMesh->AddVertex(std::sin(theta) * std::cos(phi),
+          std::sin(theta) * std::sin(phi), std::cos(theta));
+    }
+  }
+  for (unsigned int r = 0; r < _rings; ++r)
+  {
+    for (unsigned int s = 0; s < _segments; ++s)
+    {
+      const unsigned int a = r * _segments + s;
+      const unsigned int b = r * _segments + (s + 1) % _segments;
+      subMesh->AddIndex(a);
+      subMesh->AddIndex(a + _segments);
+      subMesh->AddIndex(b);
+      subMesh->AddIndex(b);
+      subMesh->AddIndex(a + _segments);
+      subMesh->AddIndex(b + _segments);
+    }
+  }
+
+  common::Mesh *mesh = new common::Mesh();
+  mesh->AddSubMesh(subMesh);
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+/// \brief Closest hit of a ray on a mesh, testing every triangle.
+/// \return Distance to the hit, infinity if there is none.
+double BruteForce(const common::Mesh &_mesh,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir)
+{
+  double closest = std::numeric_limits<double>::infinity();
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = _mesh.GetSubMesh(i);
+    for (unsigned int j = 0; j + 2 < subMesh->GetIndexCount(); j += 3)
+    {
+      const ignition::math::Vector3d a =
+          subMesh->Vertex(subMesh->GetIndex(j));
+      const ignition::math::Vector3d b =
+          subMesh->Vertex(subMesh->GetIndex(j + 1));
+      const ignition::math::Vector3d c =
+          subMesh->Vertex(subMesh->GetIndex(j + 2));
+
+      // Intersect with the plane, then check the barycentric coordinates
+      const ignition::math::Vector3d normal = (b - a).Cross(c - a);
+      const double denom = normal.Dot(_dir);
+      if (std::fabs(denom) < 1e-12)
+        continue;
+      const double t = normal.Dot(a - _origin) / denom;
+      if (t < 0 || t >= closest)
+        continue;
+      const ignition::math::Vector3d p = _origin + _dir * t;
+      if (normal.Dot((b - a).Cross(p - a)) < 0 ||
+          normal.Dot((c - b).Cross(p - b)) < 0 ||
+          normal.Dot((a - c).Cross(p - c)) < 0)
+      {
+        continue;
+      }
+      closest = t;
+    }
+  }
+  return closest;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBVHTest, Empty)
+{
+  common::Mesh mesh;
+  common::MeshBVH bvh(mesh);
+  EXPECT_EQ(0u, bvh.TriangleCount());
+
+  double distance;
+  ignition::math::Triangle3d triangle;
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitZ, distance, triangle));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBVHTest, Sphere)
+{
+  std::unique_ptr<common::Mesh> mesh(Sphere(32, 64));
+  common::MeshBVH bvh(*mesh);
+  EXPECT_EQ(32u * 64u * 2u, bvh.TriangleCount());
+  EXPECT_TRUE(bvh.BoundingBox().Min().Equal(
+      ignition::math::Vector3d(-1, -1, -1), 1e-6));
+  EXPECT_TRUE(bvh.BoundingBox().Max().Equal(
+      ignition::math::Vector3d(1, 1, 1), 1e-6));
+
+  // Straight down onto the pole
+  double distance;
+  ignition::math::Triangle3d triangle;
+  ASSERT_TRUE(bvh.Intersect(ignition::math::Vector3d(0.01, 0.01, 5),
+      -ignition::math::Vector3d::UnitZ, distance, triangle));
+  EXPECT_NEAR(4.0, distance, 1e-3);
+  EXPECT_GT(triangle[0].Z(), 0.9);
+
+  // The distance is measured in multiples of the direction
+  ASSERT_TRUE(bvh.Intersect(ignition::math::Vector3d(0.01, 0.01, 5),
+      ignition::math::Vector3d(0, 0, -2), distance, triangle));
+  EXPECT_NEAR(2.0, distance, 1e-3);
+
+  // Pointing away and passing by
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d(0, 0, 5),
+      ignition::math::Vector3d::UnitZ, distance, triangle));
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d(0, 2, 5),
+      -ignition::math::Vector3d::UnitZ, distance, triangle));
+
+  // From the inside, only back faces are hit
+  ASSERT_TRUE(bvh.Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitX, distance, triangle));
+  EXPECT_NEAR(1.0, distance, 1e-2);
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitX, distance, triangle, false));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBVHTest, MatchesBruteForce)
+{
+  std::unique_ptr<common::Mesh> mesh(Sphere(16, 24));
+  common::MeshBVH bvh(*mesh);
+
+  // Random rays from around the sphere towards random points near it
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-1.5, 1.5);
+  unsigned int hits = 0;
+  for (unsigned int i = 0; i < 500; ++i)
+  {
+    const ignition::math::Vector3d origin(
+        3 * dist(gen), 3 * dist(gen), 3 * dist(gen));
+    const ignition::math::Vector3d target(dist(gen), dist(gen), dist(gen));
+    const ignition::math::Vector3d dir = target - origin;
+
+    const double expected = BruteForce(*mesh, origin, dir);
+    double distance;
+    ignition::math::Triangle3d triangle;
+    const bool hit = bvh.Intersect(origin, dir, distance, triangle);
+    EXPECT_EQ(!std::isinf(expected), hit) << origin << " " << dir;
+    if (hit && !std::isinf(expected))
+    {
+      EXPECT_NEAR(expected, distance, 1e-9);
+      ++hits;
+    }
+  }
+  EXPECT_GT(hits, 100u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
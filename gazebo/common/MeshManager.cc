@@ -16,12 +16,24 @@
  */
 
 #include <sys/stat.h>
-#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <future>
 #include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
@@ -62,14 +74,431 @@ class MeshManagerPrivate
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
+  /// \brief Meshes that are currently being loaded, indexed by name.
+  /// Threads that request a mesh in this list wait on its future instead
+  /// of parsing the file again.
+  public: std::map<std::string, std::shared_future<Mesh *>> loading;
+
+  /// \brief Directory of the binary mesh cache, empty if disabled.
+  public: std::string cachePath;
+
+  /// \brief Mutex to protect the mesh dictionaries. It is not held while
+  /// a file is parsed, so distinct meshes load in parallel.
   public: boost::mutex mutex;
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+/// \brief Identifies binary mesh cache files.
+static const char kMeshCacheMagic[4] = {'G', 'Z', 'M', 'C'};
+
+/// \brief Version of the binary mesh cache layout. Increment it when the
+/// layout changes so that stale files are parsed again.
+static const uint32_t kMeshCacheVersion = 1;
+
+//////////////////////////////////////////////////
+/// \brief 64 bit FNV-1a hash of a buffer.
+/// \param[in] _data Buffer to hash.
+/// \param[in] _size Size of the buffer in bytes.
+/// \param[in] _hash Hash to continue from.
+/// \return Updated hash.
+static uint64_t HashBytes(const char *_data, const size_t _size,
+    uint64_t _hash = 14695981039346656037ull)
+{
+  for (size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= static_cast<unsigned char>(_data[i]);
+    _hash *= 1099511628211ull;
+  }
+  return _hash;
+}
+
+//////////////////////////////////////////////////
+/// \brief Hash the content of a file.
+/// \param[in] _filename Path to the file.
+/// \param[out] _hash Hash of the file content.
+/// \param[out] _size Size of the file in bytes.
+/// \return False if the file could not be read.
+static bool HashFile(const std::string &_filename, uint64_t &_hash,
+    uint64_t &_size)
+{
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in)
+    return false;
+
+  _hash = HashBytes(nullptr, 0);
+  _size = 0;
+  std::vector<char> buffer(1 << 16);
+  while (in)
+  {
+    in.read(buffer.data(), buffer.size());
+    const size_t count = static_cast<size_t>(in.gcount());
+    _hash = HashBytes(buffer.data(), count, _hash);
+    _size += count;
+  }
+  return in.eof();
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a plain value to a binary stream.
+template<typename T>
+static void WriteValue(std::ostream &_out, const T &_value)
+{
+  _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a plain value from a binary stream.
+template<typename T>
+static bool ReadValue(std::istream &_in, T &_value)
+{
+  return static_cast<bool>(
+      _in.read(reinterpret_cast<char *>(&_value), sizeof(T)));
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a length prefixed string to a binary stream.
+static void WriteString(std::ostream &_out, const std::string &_str)
+{
+  WriteValue(_out, static_cast<uint32_t>(_str.size()));
+  _out.write(_str.data(), _str.size());
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a length prefixed string from a binary stream.
+static bool ReadString(std::istream &_in, std::string &_str)
+{
+  uint32_t size = 0;
+  if (!ReadValue(_in, size) || size > (1u << 20))
+    return false;
+  _str.resize(size);
+  return size == 0 || static_cast<bool>(_in.read(&_str[0], size));
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a color to a binary stream.
+static void WriteColor(std::ostream &_out, const ignition::math::Color &_clr)
+{
+  WriteValue(_out, _clr.R());
+  WriteValue(_out, _clr.G());
+  WriteValue(_out, _clr.B());
+  WriteValue(_out, _clr.A());
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a color from a binary stream.
+static bool ReadColor(std::istream &_in, ignition::math::Color &_clr)
+{
+  float r, g, b, a;
+  if (!ReadValue(_in, r) || !ReadValue(_in, g) || !ReadValue(_in, b) ||
+      !ReadValue(_in, a))
+  {
+    return false;
+  }
+  _clr.Set(r, g, b, a);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the cache file of a mesh file.
+/// \param[in] _cachePath Cache directory.
+/// \param[in] _fullname Full path of the mesh file.
+/// \return Path of the cache file.
+static std::string MeshCacheFile(const std::string &_cachePath,
+    const std::string &_fullname)
+{
+  std::ostringstream stream;
+  stream << std::hex << HashBytes(_fullname.data(), _fullname.size())
+         << ".gzmesh";
+  return (boost::filesystem::path(_cachePath) / stream.str()).string();
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a mesh from the binary cache.
+/// \param[in] _cacheFile Cache file.
+/// \param[in] _fullname Full path of the original mesh file.
+/// \param[in] _hash Hash of the original mesh file content.
+/// \param[in] _size Size of the original mesh file.
+/// \return The mesh, or null if the cache file is missing, stale or
+/// corrupt.
+static Mesh *ReadMeshCache(const std::string &_cacheFile,
+    const std::string &_fullname, const uint64_t _hash, const uint64_t _size)
+{
+  std::ifstream in(_cacheFile, std::ios::binary | std::ios::ate);
+  if (!in)
+    return nullptr;
+
+  // Size of the cache file, to check array sizes before allocating them
+  const std::streamoff fileSize = in.tellg();
+  if (fileSize < 0 || !in.seekg(0))
+    return nullptr;
+
+  char magic[4];
+  uint32_t version = 0;
+  uint64_t hash = 0;
+  uint64_t size = 0;
+  std::string fullname;
+  if (!in.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + 4, kMeshCacheMagic) ||
+      !ReadValue(in, version) || version != kMeshCacheVersion ||
+      !ReadValue(in, hash) || hash != _hash ||
+      !ReadValue(in, size) || size != _size ||
+      !ReadString(in, fullname) || fullname != _fullname)
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  std::string path;
+  if (!ReadString(in, path))
+    return nullptr;
+  mesh->SetPath(path);
+
+  uint32_t materialCount = 0;
+  if (!ReadValue(in, materialCount))
+    return nullptr;
+  for (uint32_t i = 0; i < materialCount; ++i)
+  {
+    std::unique_ptr<Material> mat(new Material());
+    std::string texture;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, srcFactor, dstFactor, pointSize;
+    int32_t blendMode, shadeMode;
+    uint8_t depthWrite, lighting;
+    if (!ReadString(in, texture) ||
+        !ReadColor(in, ambient) || !ReadColor(in, diffuse) ||
+        !ReadColor(in, specular) || !ReadColor(in, emissive) ||
+        !ReadValue(in, transparency) || !ReadValue(in, shininess) ||
+        !ReadValue(in, srcFactor) || !ReadValue(in, dstFactor) ||
+        !ReadValue(in, pointSize) || !ReadValue(in, blendMode) ||
+        !ReadValue(in, shadeMode) || !ReadValue(in, depthWrite) ||
+        !ReadValue(in, lighting) ||
+        blendMode < 0 || blendMode >= Material::BLEND_COUNT ||
+        shadeMode < 0 || shadeMode >= Material::SHADE_COUNT)
+    {
+      return nullptr;
+    }
+    mat->SetTextureImage(texture);
+    mat->SetAmbient(ambient);
+    mat->SetDiffuse(diffuse);
+    mat->SetSpecular(specular);
+    mat->SetEmissive(emissive);
+    mat->SetTransparency(transparency);
+    mat->SetShininess(shininess);
+    mat->SetBlendFactors(srcFactor, dstFactor);
+    mat->SetPointSize(pointSize);
+    mat->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    mat->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    mat->SetDepthWrite(depthWrite != 0);
+    mat->SetLighting(lighting != 0);
+    mesh->AddMaterial(mat.release());
+  }
+
+  uint32_t subMeshCount = 0;
+  if (!ReadValue(in, subMeshCount))
+    return nullptr;
+  for (uint32_t i = 0; i < subMeshCount; ++i)
+  {
+    std::unique_ptr<SubMesh> subMesh(new SubMesh());
+    std::string name;
+    int32_t primitive;
+    uint32_t materialIndex;
+    uint32_t vertexCount, normalCount, texCoordCount, indexCount;
+    if (!ReadString(in, name) || !ReadValue(in, primitive) ||
+        !ReadValue(in, materialIndex) || !ReadValue(in, vertexCount) ||
+        !ReadValue(in, normalCount) || !ReadValue(in, texCoordCount) ||
+        !ReadValue(in, indexCount))
+    {
+      return nullptr;
+    }
+
+    // A sub-mesh without material is stored with the index -1
+    if (primitive < SubMesh::POINTS || primitive > SubMesh::TRISTRIPS ||
+        (materialIndex >= materialCount &&
+         materialIndex != std::numeric_limits<uint32_t>::max()))
+    {
+      return nullptr;
+    }
+
+    // A corrupt count must not cause a huge allocation
+    const std::streamoff position = in.tellg();
+    const uint64_t arrayBytes =
+        sizeof(double) * (3 * (uint64_t(vertexCount) + normalCount) +
+                          2 * uint64_t(texCoordCount)) +
+        sizeof(uint32_t) * uint64_t(indexCount);
+    if (position < 0 || arrayBytes > uint64_t(fileSize - position))
+      return nullptr;
+
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(static_cast<SubMesh::PrimitiveType>(primitive));
+    subMesh->SetMaterialIndex(materialIndex);
+
+    // Vectors are stored as doubles, read them in one block per array
+    std::vector<double> values(3 * std::max(vertexCount, normalCount) +
+        2 * texCoordCount);
+    if (!in.read(reinterpret_cast<char *>(values.data()),
+          sizeof(double) * 3 * vertexCount))
+    {
+      return nullptr;
+    }
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+      subMesh->SetVertex(v, ignition::math::Vector3d(
+          values[3 * v], values[3 * v + 1], values[3 * v + 2]));
+    }
+
+    if (!in.read(reinterpret_cast<char *>(values.data()),
+          sizeof(double) * 3 * normalCount))
+    {
+      return nullptr;
+    }
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t n = 0; n < normalCount; ++n)
+    {
+      subMesh->SetNormal(n, ignition::math::Vector3d(
+          values[3 * n], values[3 * n + 1], values[3 * n + 2]));
+    }
+
+    if (!in.read(reinterpret_cast<char *>(values.data()),
+          sizeof(double) * 2 * texCoordCount))
+    {
+      return nullptr;
+    }
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t t = 0; t < texCoordCount; ++t)
+    {
+      subMesh->SetTexCoord(t,
+          ignition::math::Vector2d(values[2 * t], values[2 * t + 1]));
+    }
+
+    std::vector<uint32_t> indices(indexCount);
+    if (!in.read(reinterpret_cast<char *>(indices.data()),
+          sizeof(uint32_t) * indexCount))
+    {
+      return nullptr;
+    }
+    for (const auto index : indices)
+    {
+      if (index >= vertexCount)
+        return nullptr;
+      subMesh->AddIndex(index);
+    }
+
+    mesh->AddSubMesh(subMesh.release());
+  }
+
+  return mesh.release();
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a mesh to the binary cache. The file is written next to
+/// its final location and renamed, so that readers in other processes never
+/// see a partial file.
+/// \param[in] _cacheFile Cache file.
+/// \param[in] _fullname Full path of the original mesh file.
+/// \param[in] _hash Hash of the original mesh file content.
+/// \param[in] _size Size of the original mesh file.
+/// \param[in] _mesh Mesh to store.
+static void WriteMeshCache(const std::string &_cacheFile,
+    const std::string &_fullname, const uint64_t _hash, const uint64_t _size,
+    const Mesh *_mesh)
+{
+  boost::system::error_code ec;
+  const boost::filesystem::path target(_cacheFile);
+  boost::filesystem::create_directories(target.parent_path(), ec);
+  const boost::filesystem::path tmp = target.parent_path() /
+      boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp", ec);
+  if (ec)
+    return;
+
+  {
+    std::ofstream out(tmp.string(), std::ios::binary);
+    if (!out)
+    {
+      gzwarn << "Unable to write mesh cache file[" << tmp.string() << "]\n";
+      return;
+    }
+
+    out.write(kMeshCacheMagic, sizeof(kMeshCacheMagic));
+    WriteValue(out, kMeshCacheVersion);
+    WriteValue(out, _hash);
+    WriteValue(out, _size);
+    WriteString(out, _fullname);
+    WriteString(out, _mesh->GetPath());
+
+    WriteValue(out, static_cast<uint32_t>(_mesh->GetMaterialCount()));
+    for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+    {
+      const Material *mat = _mesh->GetMaterial(i);
+      double srcFactor, dstFactor;
+      mat->GetBlendFactors(srcFactor, dstFactor);
+      WriteString(out, mat->GetTextureImage());
+      WriteColor(out, mat->Ambient());
+      WriteColor(out, mat->Diffuse());
+      WriteColor(out, mat->Specular());
+      WriteColor(out, mat->Emissive());
+      WriteValue(out, mat->GetTransparency());
+      WriteValue(out, mat->GetShininess());
+      WriteValue(out, srcFactor);
+      WriteValue(out, dstFactor);
+      WriteValue(out, mat->GetPointSize());
+      WriteValue(out, static_cast<int32_t>(mat->GetBlendMode()));
+      WriteValue(out, static_cast<int32_t>(mat->GetShadeMode()));
+      WriteValue(out, static_cast<uint8_t>(mat->GetDepthWrite()));
+      WriteValue(out, static_cast<uint8_t>(mat->GetLighting()));
+    }
+
+    WriteValue(out, static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+    std::vector<double> values;
+    std::vector<uint32_t> indices;
+    for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+    {
+      const SubMesh *subMesh = _mesh->GetSubMesh(i);
+      WriteString(out, subMesh->GetName());
+      WriteValue(out, static_cast<int32_t>(subMesh->GetPrimitiveType()));
+      WriteValue(out, static_cast<uint32_t>(subMesh->GetMaterialIndex()));
+      WriteValue(out, static_cast<uint32_t>(subMesh->GetVertexCount()));
+      WriteValue(out, static_cast<uint32_t>(subMesh->GetNormalCount()));
+      WriteValue(out, static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+      WriteValue(out, static_cast<uint32_t>(subMesh->GetIndexCount()));
+
+      values.clear();
+      for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+      {
+        const auto vertex = subMesh->Vertex(v);
+        values.insert(values.end(), {vertex.X(), vertex.Y(), vertex.Z()});
+      }
+      for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+      {
+        const auto normal = subMesh->Normal(n);
+        values.insert(values.end(), {normal.X(), normal.Y(), normal.Z()});
+      }
+      for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+      {
+        const auto texCoord = subMesh->TexCoord(t);
+        values.insert(values.end(), {texCoord.X(), texCoord.Y()});
+      }
+      out.write(reinterpret_cast<const char *>(values.data()),
+          sizeof(double) * values.size());
+
+      indices.resize(subMesh->GetIndexCount());
+      for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+        indices[n] = subMesh->GetIndex(n);
+      out.write(reinterpret_cast<const char *>(indices.data()),
+          sizeof(uint32_t) * indices.size());
+    }
+
+    if (!out)
+    {
+      out.close();
+      boost::filesystem::remove(tmp, ec);
+      return;
+    }
+  }
+
+  boost::filesystem::rename(tmp, target, ec);
+  if (ec)
+    boost::filesystem::remove(tmp, ec);
+}
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
@@ -111,6 +540,10 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stlb");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  const char *cachePath = std::getenv("GAZEBO_MESH_CACHE_PATH");
+  if (cachePath)
+    this->dataPtr->cachePath = cachePath;
 }
 
 //////////////////////////////////////////////////
@@ -138,81 +571,127 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
-
-  std::string extension;
-
-  if (this->HasMesh(_filename))
+  // Either return the loaded mesh, wait for a load of the same file in
+  // another thread, or register this thread as the one loading the file.
+  // The lock is only held for the lookups, so distinct files are parsed in
+  // parallel.
+  std::promise<Mesh *> promise;
+  std::shared_future<Mesh *> pending;
+  std::string cachePath;
   {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(_filename);
+    if (iter != this->dataPtr->meshes.end())
+      return iter->second;
+
+    auto loadIter = this->dataPtr->loading.find(_filename);
+    if (loadIter != this->dataPtr->loading.end())
+      pending = loadIter->second;
+    else
+      this->dataPtr->loading[_filename] = promise.get_future().share();
+    cachePath = this->dataPtr->cachePath;
   }
 
+  // get() rethrows the exception of a failed load.
+  if (pending.valid())
+    return pending.get();
+
+  Mesh *mesh = nullptr;
   std::string fullname = common::find_file(_filename);
 
   if (!fullname.empty())
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
+    std::string extension =
+      fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
 
+    // Loaders keep parsing state, each load uses its own instance.
+    std::unique_ptr<MeshLoader> loader;
     if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
+      loader.reset(new STLLoader());
     else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
+      loader.reset(new ColladaLoader());
     else if (extension == "obj")
-      loader = &objLoader;
+      loader.reset(new OBJLoader());
     else
-    {
       gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
-    }
 
     try
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
+      uint64_t hash = 0;
+      uint64_t size = 0;
+      std::string cacheFile;
+      if (loader && !cachePath.empty() && HashFile(fullname, hash, size))
+      {
+        cacheFile = MeshCacheFile(cachePath, fullname);
+        mesh = ReadMeshCache(cacheFile, fullname, hash, size);
+      }
+
+      if (loader && !mesh)
       {
         if ((mesh = loader->Load(fullname)) != nullptr)
         {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+          if (!cacheFile.empty() && !mesh->HasSkeleton())
+            WriteMeshCache(cacheFile, fullname, hash, size, mesh);
         }
         else
           gzerr << "Unable to load mesh[" << fullname << "]\n";
       }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
     }
     catch(gazebo::common::Exception &e)
     {
+      {
+        boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+        this->dataPtr->loading.erase(_filename);
+      }
+      promise.set_exception(std::current_exception());
+
       gzerr << "Error loading mesh[" << fullname << "]\n";
       gzerr << e << "\n";
       gzthrow(e);
     }
+    catch(...)
+    {
+      {
+        boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+        this->dataPtr->loading.erase(_filename);
+      }
+      promise.set_exception(std::current_exception());
+      throw;
+    }
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
 
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    if (mesh)
+    {
+      mesh->SetName(_filename);
+      this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+    }
+    this->dataPtr->loading.erase(_filename);
+  }
+  promise.set_value(mesh);
+
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->cachePath = _path;
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->cachePath;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -249,28 +728,33 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->meshes.insert(std::make_pair(_mesh->GetName(), _mesh));
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -287,6 +771,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -310,7 +795,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -378,7 +863,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -458,7 +943,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -759,7 +1244,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
   return;
 }
 
@@ -775,7 +1260,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -876,7 +1361,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -993,7 +1478,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->AddMesh(mesh);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1110,7 +1595,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1331,7 +1816,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->AddMesh(mesh);
 }
 #endif
 
@@ -57,11 +57,30 @@ namespace gazebo
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file.
+      ///
+      /// Distinct files can be loaded concurrently from several threads.
+      /// A thread requesting a file that is already being loaded waits for
+      /// that load to finish and gets the same mesh. If a cache path is
+      /// set, see SetCachePath, the parsed mesh is read from or written to
+      /// the binary mesh cache.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Set the directory of the binary mesh cache. Parsed meshes
+      /// are stored there, keyed by their full path and a hash of the file
+      /// content, so that loading an unchanged file skips parsing. Meshes
+      /// with a skeleton are not cached. The initial value is taken from the
+      /// GAZEBO_MESH_CACHE_PATH environment variable.
+      /// \param[in] _path Cache directory, it is created if needed. An
+      /// empty path disables the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the binary mesh cache.
+      /// \return Cache directory, empty if the cache is disabled.
+      public: std::string CachePath() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -16,6 +16,12 @@
 */
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
@@ -266,6 +272,122 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ParallelLoad)
+{
+  const std::string dataPath = std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/";
+  const std::vector<std::string> files =
+  {
+    dataPath + "box.dae", dataPath + "box_offset.dae",
+    dataPath + "box_with_multiple_geoms.dae", dataPath + "box.obj",
+    dataPath + "twoFaces.stl"
+  };
+
+  // Several threads per file, so that both distinct files and the same file
+  // are requested concurrently
+  const unsigned int threadsPerFile = 4;
+  std::vector<const common::Mesh *> results(files.size() * threadsPerFile);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < results.size(); ++i)
+  {
+    threads.emplace_back([&files, &results, i]()
+    {
+      results[i] = common::MeshManager::Instance()->Load(
+          files[i % files.size()]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Every request of a file gets the same mesh
+  for (unsigned int i = 0; i < results.size(); ++i)
+  {
+    const std::string &file = files[i % files.size()];
+    ASSERT_NE(nullptr, results[i]) << file;
+    EXPECT_EQ(common::MeshManager::Instance()->GetMesh(file), results[i]);
+    EXPECT_EQ(file, results[i]->GetName());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, BinaryCache)
+{
+  auto meshManager = common::MeshManager::Instance();
+
+  const boost::filesystem::path tmpDir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  const boost::filesystem::path cacheDir = tmpDir / "cache";
+  const std::string meshFile = (tmpDir / "two_faces.stl").string();
+  ASSERT_TRUE(boost::filesystem::create_directories(tmpDir));
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/twoFaces.stl", meshFile);
+
+  const std::string previousPath = meshManager->CachePath();
+  meshManager->SetCachePath(cacheDir.string());
+  EXPECT_EQ(cacheDir.string(), meshManager->CachePath());
+
+  // A cold load parses the file and writes the cache
+  const common::Mesh *cold = meshManager->Load(meshFile);
+  ASSERT_NE(nullptr, cold);
+  ASSERT_TRUE(boost::filesystem::exists(cacheDir));
+  unsigned int cacheFiles = 0;
+  for (boost::filesystem::directory_iterator iter(cacheDir);
+       iter != boost::filesystem::directory_iterator(); ++iter)
+  {
+    EXPECT_EQ(".gzmesh", iter->path().extension().string());
+    ++cacheFiles;
+  }
+  EXPECT_EQ(1u, cacheFiles);
+
+  // The same file under another name resolves to the same full path, so
+  // it is read back from the cache
+  const common::Mesh *warm = meshManager->Load("file://" + meshFile);
+  ASSERT_NE(nullptr, warm);
+  EXPECT_NE(cold, warm);
+  ASSERT_EQ(cold->GetSubMeshCount(), warm->GetSubMeshCount());
+  EXPECT_EQ(cold->GetMaterialCount(), warm->GetMaterialCount());
+  for (unsigned int i = 0; i < cold->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *a = cold->GetSubMesh(i);
+    const common::SubMesh *b = warm->GetSubMesh(i);
+    EXPECT_EQ(a->GetPrimitiveType(), b->GetPrimitiveType());
+    ASSERT_EQ(a->GetVertexCount(), b->GetVertexCount());
+    ASSERT_EQ(a->GetNormalCount(), b->GetNormalCount());
+    ASSERT_EQ(a->GetIndexCount(), b->GetIndexCount());
+    for (unsigned int v = 0; v < a->GetVertexCount(); ++v)
+      EXPECT_EQ(a->Vertex(v), b->Vertex(v));
+    for (unsigned int n = 0; n < a->GetNormalCount(); ++n)
+      EXPECT_EQ(a->Normal(n), b->Normal(n));
+    for (unsigned int n = 0; n < a->GetIndexCount(); ++n)
+      EXPECT_EQ(a->GetIndex(n), b->GetIndex(n));
+  }
+
+  // Changing the file content invalidates its cache entry
+  const std::string otherFile = (tmpDir / "other.stl").string();
+  boost::filesystem::copy_file(meshFile, otherFile);
+  ASSERT_NE(nullptr, meshManager->Load(otherFile));
+  {
+    std::ofstream out(otherFile);
+    out << "solid one\n"
+        << "facet normal 0 0 1\n"
+        << "outer loop\n"
+        << "vertex 0 0 0\n"
+        << "vertex 1 0 0\n"
+        << "vertex 0 1 0\n"
+        << "endloop\n"
+        << "endfacet\n"
+        << "endsolid one\n";
+  }
+  const common::Mesh *changed = meshManager->Load("file://" + otherFile);
+  ASSERT_NE(nullptr, changed);
+  EXPECT_EQ(3u, changed->GetVertexCount());
+
+  meshManager->SetCachePath(previousPath);
+  boost::filesystem::remove_all(tmpDir);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// The SIMD paths below are selected at compile time from the instruction
+// sets enabled by cmake/HostCFlags.cmake. Every function has a scalar
+// implementation that handles the remaining pixels and non-x86 builds.
+#ifdef __SSE2__
+  #include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+  #include <tmmintrin.h>
+#endif
+
+#include "gazebo/common/PixelFormatConversion.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+#ifdef __SSSE3__
+  /// \brief Byte shuffle masks that gather one 16 byte output register from
+  /// N consecutive 16 byte input registers.
+  template<int N>
+  struct GatherMasks
+  {
+    /// \brief One pshufb mask per input register.
+    __m128i mask[N];
+  };
+
+  /// \brief Build gather masks.
+  /// \param[in] _srcIndex For each of the 16 output bytes, the index of the
+  /// source byte in the N * 16 input bytes, or -1 to output zero.
+  /// \return Masks to be used with Gather().
+  template<int N>
+  GatherMasks<N> MakeGatherMasks(const int _srcIndex[16])
+  {
+    GatherMasks<N> result;
+    for (int r = 0; r < N; ++r)
+    {
+      alignas(16) int8_t m[16];
+      for (int k = 0; k < 16; ++k)
+      {
+        // A mask byte with the high bit set makes pshufb output zero
+        if (_srcIndex[k] >= 0 && _srcIndex[k] / 16 == r)
+          m[k] = static_cast<int8_t>(_srcIndex[k] % 16);
+        else
+          m[k] = -128;
+      }
+      result.mask[r] = _mm_load_si128(reinterpret_cast<const __m128i *>(m));
+    }
+    return result;
+  }
+
+  /// \brief Gather 16 bytes from N input registers.
+  /// \param[in] _in Input registers.
+  /// \param[in] _masks Masks created by MakeGatherMasks().
+  /// \return The gathered bytes.
+  template<int N>
+  inline __m128i Gather(const __m128i *_in, const GatherMasks<N> &_masks)
+  {
+    __m128i out = _mm_shuffle_epi8(_in[0], _masks.mask[0]);
+    for (int r = 1; r < N; ++r)
+      out = _mm_or_si128(out, _mm_shuffle_epi8(_in[r], _masks.mask[r]));
+    return out;
+  }
+
+  /// \brief Masks that produce the three output registers of a 16 pixel
+  /// RGB <-> BGR swap.
+  struct SwapMasks
+  {
+    /// \brief Constructor
+    SwapMasks()
+    {
+      for (int r = 0; r < 3; ++r)
+      {
+        int srcIndex[16];
+        for (int k = 0; k < 16; ++k)
+        {
+          int b = r * 16 + k;
+          srcIndex[k] = 3 * (b / 3) + 2 - b % 3;
+        }
+        this->out[r] = MakeGatherMasks<3>(srcIndex);
+      }
+    }
+
+    /// \brief Masks for each output register.
+    GatherMasks<3> out[3];
+  };
+
+  /// \brief Masks that produce the three output registers of a 16 pixel
+  /// RGBA -> RGB conversion.
+  struct DropAlphaMasks
+  {
+    /// \brief Constructor
+    DropAlphaMasks()
+    {
+      for (int r = 0; r < 3; ++r)
+      {
+        int srcIndex[16];
+        for (int k = 0; k < 16; ++k)
+        {
+          int b = r * 16 + k;
+          srcIndex[k] = 4 * (b / 3) + b % 3;
+        }
+        this->out[r] = MakeGatherMasks<4>(srcIndex);
+      }
+    }
+
+    /// \brief Masks for each output register.
+    GatherMasks<4> out[3];
+  };
+
+  /// \brief Masks that split 16 RGB pixels into one register per channel.
+  struct PlanarMasks
+  {
+    /// \brief Constructor
+    PlanarMasks()
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        int srcIndex[16];
+        for (int k = 0; k < 16; ++k)
+          srcIndex[k] = 3 * k + c;
+        this->channel[c] = MakeGatherMasks<3>(srcIndex);
+      }
+    }
+
+    /// \brief Masks for the R, G and B registers.
+    GatherMasks<3> channel[3];
+  };
+
+  /// \brief Load 16 packed RGB pixels.
+  /// \param[in] _src Pointer to the first pixel.
+  /// \param[out] _in Three registers holding the 48 bytes.
+  inline void Load48(const unsigned char *_src, __m128i *_in)
+  {
+    _in[0] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src));
+    _in[1] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + 16));
+    _in[2] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + 32));
+  }
+#endif
+
+  /// \brief Source channel for each Bayer cell, indexed by row parity and
+  /// then column parity. Rows and columns start at zero.
+  typedef int BayerTable[2][2];
+
+  /// \brief Get the channel layout of a Bayer format.
+  /// \param[in] _format Bayer pixel format.
+  /// \return Channel table, nullptr if _format is not a Bayer format.
+  const BayerTable *BayerLayout(const Image::PixelFormat _format)
+  {
+    // RG
+    // GB
+    static const BayerTable rggb = {{0, 1}, {1, 2}};
+    // BG
+    // GR
+    static const BayerTable bggr = {{2, 1}, {1, 0}};
+    // GB
+    // RG
+    static const BayerTable gbrg = {{1, 2}, {0, 1}};
+    // GR
+    // BG
+    static const BayerTable grbg = {{1, 0}, {2, 1}};
+
+    switch (_format)
+    {
+      case Image::BAYER_RGGB8:
+        return &rggb;
+      case Image::BAYER_BGGR8:
+        return &bggr;
+      case Image::BAYER_GBRG8:
+        return &gbrg;
+      case Image::BAYER_GRBG8:
+        return &grbg;
+      default:
+        return nullptr;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void common::ConvertRGBToBGR(const unsigned char *_src, unsigned char *_dst,
+    const unsigned int _pixelCount)
+{
+  unsigned int i = 0;
+
+#ifdef __SSSE3__
+  static const SwapMasks masks;
+  for (; i + 16 <= _pixelCount; i += 16)
+  {
+    __m128i in[3];
+    Load48(_src + i * 3, in);
+
+    // All input is loaded before storing, so in place conversion is safe
+    __m128i out0 = Gather(in, masks.out[0]);
+    __m128i out1 = Gather(in, masks.out[1]);
+    __m128i out2 = Gather(in, masks.out[2]);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 3), out0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 3 + 16), out1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 3 + 32), out2);
+  }
+#endif
+
+  for (; i < _pixelCount; ++i)
+  {
+    const unsigned char r = _src[i * 3];
+    const unsigned char g = _src[i * 3 + 1];
+    const unsigned char b = _src[i * 3 + 2];
+    _dst[i * 3] = b;
+    _dst[i * 3 + 1] = g;
+    _dst[i * 3 + 2] = r;
+  }
+}
+
+//////////////////////////////////////////////////
+void common::ConvertRGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+    const unsigned int _pixelCount)
+{
+  unsigned int i = 0;
+
+#ifdef __SSSE3__
+  static const DropAlphaMasks masks;
+  for (; i + 16 <= _pixelCount; i += 16)
+  {
+    const unsigned char *src = _src + i * 4;
+    __m128i in[4];
+    in[0] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    in[1] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+    in[2] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+    in[3] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 48));
+
+    unsigned char *dst = _dst + i * 3;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+        Gather(in, masks.out[0]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16),
+        Gather(in, masks.out[1]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 32),
+        Gather(in, masks.out[2]));
+  }
+#endif
+
+  for (; i < _pixelCount; ++i)
+  {
+    _dst[i * 3] = _src[i * 4];
+    _dst[i * 3 + 1] = _src[i * 4 + 1];
+    _dst[i * 3 + 2] = _src[i * 4 + 2];
+  }
+}
+
+//////////////////////////////////////////////////
+void common::ConvertRGBToMono(const unsigned char *_src, unsigned char *_dst,
+    const unsigned int _pixelCount)
+{
+  unsigned int i = 0;
+
+#ifdef __SSSE3__
+  static const PlanarMasks masks;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i wr = _mm_set1_epi16(77);
+  const __m128i wg = _mm_set1_epi16(150);
+  const __m128i wb = _mm_set1_epi16(29);
+  for (; i + 16 <= _pixelCount; i += 16)
+  {
+    __m128i in[3];
+    Load48(_src + i * 3, in);
+    __m128i r = Gather(in, masks.channel[0]);
+    __m128i g = Gather(in, masks.channel[1]);
+    __m128i b = Gather(in, masks.channel[2]);
+
+    // The weights sum to 256, so the 16 bit sums can not overflow
+    __m128i lo = _mm_add_epi16(_mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(r, zero), wr),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(g, zero), wg)),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), wb));
+    __m128i hi = _mm_add_epi16(_mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(r, zero), wr),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(g, zero), wg)),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), wb));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+  }
+#endif
+
+  for (; i < _pixelCount; ++i)
+  {
+    const unsigned int sum = 77u * _src[i * 3] + 150u * _src[i * 3 + 1] +
+        29u * _src[i * 3 + 2];
+    _dst[i] = static_cast<unsigned char>(sum >> 8);
+  }
+}
+
+//////////////////////////////////////////////////
+bool common::ConvertRGBToBayer(const unsigned char *_src, unsigned char *_dst,
+    const unsigned int _width, const unsigned int _height,
+    const Image::PixelFormat _format)
+{
+  const BayerTable *layout = BayerLayout(_format);
+  if (!layout)
+    return false;
+
+#ifdef __SSSE3__
+  // One set of masks for even rows and one for odd rows
+  GatherMasks<3> rowMasks[2];
+  for (int p = 0; p < 2; ++p)
+  {
+    int srcIndex[16];
+    for (int k = 0; k < 16; ++k)
+      srcIndex[k] = 3 * k + (*layout)[p][k % 2];
+    rowMasks[p] = MakeGatherMasks<3>(srcIndex);
+  }
+#endif
+
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const unsigned char *src = _src + y * _width * 3;
+    unsigned char *dst = _dst + y * _width;
+    const int *channel = (*layout)[y % 2];
+    unsigned int x = 0;
+
+#ifdef __SSSE3__
+    const GatherMasks<3> &m = rowMasks[y % 2];
+    for (; x + 16 <= _width; x += 16)
+    {
+      __m128i in[3];
+      Load48(src + x * 3, in);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), Gather(in, m));
+    }
+#endif
+
+    for (; x < _width; ++x)
+      dst[x] = src[x * 3 + channel[x % 2]];
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void common::ConvertDepthToUInt16(const float *_src, uint16_t *_dst,
+    const unsigned int _count, const float _scale)
+{
+  unsigned int i = 0;
+
+#ifdef __SSE2__
+  const __m128 scale = _mm_set1_ps(_scale);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 maxValue = _mm_set1_ps(65535.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128i bias = _mm_set1_epi32(32768);
+  const __m128i signBit = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  for (; i + 8 <= _count; i += 8)
+  {
+    // maxps returns its second operand when the first is NaN, which maps
+    // NaN to zero
+    __m128 a = _mm_mul_ps(_mm_loadu_ps(_src + i), scale);
+    __m128 b = _mm_mul_ps(_mm_loadu_ps(_src + i + 4), scale);
+    a = _mm_add_ps(_mm_min_ps(_mm_max_ps(a, zero), maxValue), half);
+    b = _mm_add_ps(_mm_min_ps(_mm_max_ps(b, zero), maxValue), half);
+
+    // SSE2 only has a signed saturating pack, so shift the values into the
+    // signed range and flip the sign bit back afterwards
+    __m128i ia = _mm_sub_epi32(_mm_cvttps_epi32(a), bias);
+    __m128i ib = _mm_sub_epi32(_mm_cvttps_epi32(b), bias);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_xor_si128(_mm_packs_epi32(ia, ib), signBit));
+  }
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const float v = _src[i] * _scale;
+    if (!(v > 0.0f))
+      _dst[i] = 0;
+    else if (v >= 65535.0f)
+      _dst[i] = 65535;
+    else
+      _dst[i] = static_cast<uint16_t>(v + 0.5f);
+  }
+}
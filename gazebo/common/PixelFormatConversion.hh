@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PIXELFORMATCONVERSION_HH_
+#define GAZEBO_COMMON_PIXELFORMATCONVERSION_HH_
+
+#include <cstdint>
+
+#include "gazebo/common/Image.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \brief Swap the red and blue channels of packed 8-bit RGB pixels.
+    /// The same function converts BGR to RGB. The conversion can be done
+    /// in place by passing the same buffer as _src and _dst.
+    /// \param[in] _src Source pixels, 3 bytes per pixel.
+    /// \param[out] _dst Destination pixels, 3 bytes per pixel.
+    /// \param[in] _pixelCount Number of pixels to convert.
+    GZ_COMMON_VISIBLE
+    void ConvertRGBToBGR(const unsigned char *_src, unsigned char *_dst,
+        const unsigned int _pixelCount);
+
+    /// \brief Drop the alpha channel of packed 8-bit four channel pixels.
+    /// Channel order is preserved, so RGBA becomes RGB and BGRA becomes BGR.
+    /// \param[in] _src Source pixels, 4 bytes per pixel.
+    /// \param[out] _dst Destination pixels, 3 bytes per pixel. Must not
+    /// overlap _src.
+    /// \param[in] _pixelCount Number of pixels to convert.
+    GZ_COMMON_VISIBLE
+    void ConvertRGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+        const unsigned int _pixelCount);
+
+    /// \brief Convert packed 8-bit RGB pixels to 8-bit luminance, using the
+    /// integer approximation (77 R + 150 G + 29 B) / 256 of the ITU-R
+    /// BT.601 weights.
+    /// \param[in] _src Source pixels, 3 bytes per pixel.
+    /// \param[out] _dst Destination pixels, 1 byte per pixel. Must not
+    /// overlap _src.
+    /// \param[in] _pixelCount Number of pixels to convert.
+    GZ_COMMON_VISIBLE
+    void ConvertRGBToMono(const unsigned char *_src, unsigned char *_dst,
+        const unsigned int _pixelCount);
+
+    /// \brief Convert a packed 8-bit RGB image to a Bayer pattern image.
+    /// \param[in] _src Source image, 3 bytes per pixel, rows are contiguous.
+    /// \param[out] _dst Destination image, 1 byte per pixel. Must not
+    /// overlap _src.
+    /// \param[in] _width Image width in pixels.
+    /// \param[in] _height Image height in pixels.
+    /// \param[in] _format One of Image::BAYER_RGGB8, Image::BAYER_BGGR8,
+    /// Image::BAYER_GBRG8 or Image::BAYER_GRBG8.
+    /// \return False if _format is not a Bayer format.
+    GZ_COMMON_VISIBLE
+    bool ConvertRGBToBayer(const unsigned char *_src, unsigned char *_dst,
+        const unsigned int _width, const unsigned int _height,
+        const Image::PixelFormat _format);
+
+    /// \brief Convert floating point depth values to 16-bit unsigned
+    /// integers, e.g. meters to millimeters with a scale of 1000.
+    /// Scaled values are rounded to the nearest integer. NaN and negative
+    /// values become 0, values beyond the 16-bit range saturate to 65535.
+    /// \param[in] _src Source depth values.
+    /// \param[out] _dst Destination values.
+    /// \param[in] _count Number of values to convert.
+    /// \param[in] _scale Factor applied to each value before conversion.
+    GZ_COMMON_VISIBLE
+    void ConvertDepthToUInt16(const float *_src, uint16_t *_dst,
+        const unsigned int _count, const float _scale = 1000.0f);
+
+    /// \}
+  }
+}
+#endif
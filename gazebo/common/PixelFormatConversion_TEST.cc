@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gazebo/common/PixelFormatConversion.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PixelFormatConversionTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Fill a buffer with a deterministic byte pattern.
+std::vector<unsigned char> Pattern(const unsigned int _size)
+{
+  std::vector<unsigned char> data(_size);
+  for (unsigned int i = 0; i < _size; ++i)
+    data[i] = static_cast<unsigned char>((i * 37 + i / 7) & 0xff);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelFormatConversionTest, RGBToBGR)
+{
+  // Sizes that are not a multiple of the SIMD block size exercise the
+  // scalar tail as well
+  for (unsigned int count : {0u, 1u, 15u, 16u, 17u, 100u, 641u})
+  {
+    std::vector<unsigned char> src = Pattern(count * 3);
+    std::vector<unsigned char> dst(count * 3);
+    common::ConvertRGBToBGR(src.data(), dst.data(), count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(src[i * 3], dst[i * 3 + 2]);
+      EXPECT_EQ(src[i * 3 + 1], dst[i * 3 + 1]);
+      EXPECT_EQ(src[i * 3 + 2], dst[i * 3]);
+    }
+
+    // In place conversion back to the original
+    common::ConvertRGBToBGR(dst.data(), dst.data(), count);
+    EXPECT_EQ(src, dst);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelFormatConversionTest, RGBAToRGB)
+{
+  for (unsigned int count : {1u, 16u, 33u, 640u})
+  {
+    std::vector<unsigned char> src = Pattern(count * 4);
+    std::vector<unsigned char> dst(count * 3);
+    common::ConvertRGBAToRGB(src.data(), dst.data(), count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(src[i * 4], dst[i * 3]);
+      EXPECT_EQ(src[i * 4 + 1], dst[i * 3 + 1]);
+      EXPECT_EQ(src[i * 4 + 2], dst[i * 3 + 2]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelFormatConversionTest, RGBToMono)
+{
+  for (unsigned int count : {1u, 16u, 47u, 640u})
+  {
+    std::vector<unsigned char> src = Pattern(count * 3);
+    std::vector<unsigned char> dst(count);
+    common::ConvertRGBToMono(src.data(), dst.data(), count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      unsigned int expected = (77u * src[i * 3] + 150u * src[i * 3 + 1] +
+          29u * src[i * 3 + 2]) >> 8;
+      EXPECT_EQ(expected, dst[i]);
+    }
+  }
+
+  // White stays white and black stays black
+  unsigned char white[3] = {255, 255, 255};
+  unsigned char black[3] = {0, 0, 0};
+  unsigned char mono = 0;
+  common::ConvertRGBToMono(white, &mono, 1);
+  EXPECT_EQ(255u, mono);
+  common::ConvertRGBToMono(black, &mono, 1);
+  EXPECT_EQ(0u, mono);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelFormatConversionTest, RGBToBayer)
+{
+  // Channel sampled at (row parity, column parity) for each format
+  struct Layout
+  {
+    common::Image::PixelFormat format;
+    int channel[2][2];
+  };
+  const Layout layouts[] =
+  {
+    {common::Image::BAYER_RGGB8, {{0, 1}, {1, 2}}},
+    {common::Image::BAYER_BGGR8, {{2, 1}, {1, 0}}},
+    {common::Image::BAYER_GBRG8, {{1, 2}, {0, 1}}},
+    {common::Image::BAYER_GRBG8, {{1, 0}, {2, 1}}}
+  };
+
+  const unsigned int width = 37;
+  const unsigned int height = 5;
+  std::vector<unsigned char> src = Pattern(width * height * 3);
+
+  for (const auto &layout : layouts)
+  {
+    std::vector<unsigned char> dst(width * height);
+    EXPECT_TRUE(common::ConvertRGBToBayer(src.data(), dst.data(), width,
+          height, layout.format));
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        EXPECT_EQ(src[(y * width + x) * 3 + layout.channel[y % 2][x % 2]],
+            dst[y * width + x]);
+      }
+    }
+  }
+
+  std::vector<unsigned char> dst(width * height);
+  EXPECT_FALSE(common::ConvertRGBToBayer(src.data(), dst.data(), width,
+        height, common::Image::RGB_INT8));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelFormatConversionTest, DepthToUInt16)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  std::vector<float> src =
+      {0.0f, 0.001f, 1.2344f, 1.2346f, 65.535f, 70.0f, -1.0f, nan,
+       inf, -inf, 0.0004f, 0.0006f, 10.0f, 20.5f, 30.25f, 0.5f, 42.0f};
+  std::vector<uint16_t> expected =
+      {0, 1, 1234, 1235, 65535, 65535, 0, 0,
+       65535, 0, 0, 1, 10000, 20500, 30250, 500, 42000};
+
+  std::vector<uint16_t> dst(src.size());
+  common::ConvertDepthToUInt16(src.data(), dst.data(), src.size(), 1000.0f);
+  EXPECT_EQ(expected, dst);
+
+  // Unit scale
+  float meters = 3.6f;
+  uint16_t value = 0;
+  common::ConvertDepthToUInt16(&meters, &value, 1, 1.0f);
+  EXPECT_EQ(4u, value);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,9 @@
  *
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "gazebo/common/SkeletonAnimation.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Assert.hh"
@@ -22,8 +25,19 @@
 using namespace gazebo;
 using namespace common;
 
+/// \brief Private data for NodeAnimation
+class gazebo::common::NodeAnimationPrivate
+{
+  /// \brief Times of the key frames, sorted, searched by FrameAt
+  public: std::vector<double> keyTimes;
+
+  /// \brief Key frames, in the order of keyTimes
+  public: std::vector<ignition::math::Matrix4d> keyFrames;
+};
+
 //////////////////////////////////////////////////
 NodeAnimation::NodeAnimation(const std::string& _name)
+  : dataPtr(new NodeAnimationPrivate)
 {
   this->name = _name;
   this->length = 0.0;
@@ -55,6 +69,22 @@ void NodeAnimation::AddKeyFrame(const double _time,
     this->length = _time;
 
   this->keyFrames[_time] = _trans;
+
+  // Sorted copy searched by FrameAt. Key frames are usually added in order,
+  // which appends them.
+  auto &times = this->dataPtr->keyTimes;
+  auto &frames = this->dataPtr->keyFrames;
+  auto it = std::lower_bound(times.begin(), times.end(), _time);
+  const auto index = it - times.begin();
+  if (it != times.end() && *it == _time)
+  {
+    frames[index] = _trans;
+  }
+  else
+  {
+    times.insert(it, _time);
+    frames.insert(frames.begin() + index, _trans);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -82,6 +112,11 @@ void NodeAnimation::GetKeyFrame(const unsigned int _i, double &_time,
     gzerr << "Invalid key frame index " << _i << "\n";
     _time = -1.0;
   }
+  else if (this->dataPtr->keyTimes.size() == this->keyFrames.size())
+  {
+    _time = this->dataPtr->keyTimes[_i];
+    _trans = this->dataPtr->keyFrames[_i];
+  }
   else
   {
     std::map<double, ignition::math::Matrix4d>::const_iterator iter =
@@ -127,21 +162,56 @@ ignition::math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
   if (ignition::math::equal(time, this->length))
     return this->keyFrames.rbegin()->second;
 
-  std::map<double, ignition::math::Matrix4d>::const_iterator it1 =
-    this->keyFrames.upper_bound(time);
+  double nextKey, prevKey;
+  const ignition::math::Matrix4d *nextTrans;
+  const ignition::math::Matrix4d *prevTrans;
 
-  if (it1 == this->keyFrames.begin() || ignition::math::equal(it1->first, time))
-    return it1->second;
+  const auto &times = this->dataPtr->keyTimes;
+  const auto &frames = this->dataPtr->keyFrames;
+  if (times.size() == this->keyFrames.size())
+  {
+    // Binary search of the next key frame in the sorted copy
+    const size_t next = std::upper_bound(times.begin(), times.end(), time) -
+        times.begin();
 
-  std::map<double, ignition::math::Matrix4d>::const_iterator it2 = it1--;
+    if (next == times.size())
+      return frames.back();
+
+    if (next == 0 || ignition::math::equal(times[next], time))
+      return frames[next];
 
-  if (ignition::math::equal(it2->first, time))
-    return it2->second;
+    const size_t prev = next - 1;
 
-  double nextKey = it2->first;
-  ignition::math::Matrix4d nextTrans = it2->second;
-  double prevKey = it1->first;
-  ignition::math::Matrix4d prevTrans = it1->second;
+    if (ignition::math::equal(times[prev], time))
+      return frames[prev];
+
+    nextKey = times[next];
+    nextTrans = &frames[next];
+    prevKey = times[prev];
+    prevTrans = &frames[prev];
+  }
+  else
+  {
+    // Key frames were added or removed directly by a derived class
+    std::map<double, ignition::math::Matrix4d>::const_iterator it1 =
+      this->keyFrames.upper_bound(time);
+
+    if (it1 == this->keyFrames.begin() ||
+        ignition::math::equal(it1->first, time))
+    {
+      return it1->second;
+    }
+
+    std::map<double, ignition::math::Matrix4d>::const_iterator it2 = it1--;
+
+    if (ignition::math::equal(it2->first, time))
+      return it2->second;
+
+    nextKey = it2->first;
+    nextTrans = &it2->second;
+    prevKey = it1->first;
+    prevTrans = &it1->second;
+  }
 
   double t = (time - prevKey) / (nextKey - prevKey);
   if (t < 0.0 || t > 1.0)
@@ -151,15 +221,15 @@ ignition::math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
     return ignition::math::Matrix4d();
   }
 
-  ignition::math::Vector3d nextPos = nextTrans.Translation();
-  ignition::math::Vector3d prevPos = prevTrans.Translation();
+  ignition::math::Vector3d nextPos = nextTrans->Translation();
+  ignition::math::Vector3d prevPos = prevTrans->Translation();
   ignition::math::Vector3d pos = ignition::math::Vector3d(
       prevPos.X() + ((nextPos.X() - prevPos.X()) * t),
       prevPos.Y() + ((nextPos.Y() - prevPos.Y()) * t),
       prevPos.Z() + ((nextPos.Z() - prevPos.Z()) * t));
 
-  ignition::math::Quaterniond nextRot = nextTrans.Rotation();
-  ignition::math::Quaterniond prevRot = prevTrans.Rotation();
+  ignition::math::Quaterniond nextRot = nextTrans->Rotation();
+  ignition::math::Quaterniond prevRot = prevTrans->Rotation();
   ignition::math::Quaterniond rot = ignition::math::Quaterniond::Slerp(t,
       prevRot, nextRot, true);
 
@@ -178,6 +248,9 @@ void NodeAnimation::Scale(const double _scale)
     ignition::math::Vector3d pos = mat->Translation();
     mat->SetTranslation(pos * _scale);
   }
+
+  for (auto &frame : this->dataPtr->keyFrames)
+    frame.SetTranslation(frame.Translation() * _scale);
 }
 
 //////////////////////////////////////////////////
@@ -298,9 +371,21 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAt(
 //////////////////////////////////////////////////
 std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
     const double _x, const std::string &_node, const bool _loop) const
+{
+  return this->PoseAt(this->TimeAtX(_x, _node, _loop), _loop);
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimation::TimeAtX(const double _x, const std::string &_node,
+    const bool _loop) const
 {
   std::map<std::string, NodeAnimation*>::const_iterator nodeAnim =
       this->animations.find(_node);
+  if (nodeAnim == this->animations.end() ||
+      nodeAnim->second->GetFrameCount() == 0)
+  {
+    return 0.0;
+  }
 
   ignition::math::Matrix4d lastPos = nodeAnim->second->KeyFrame(
       nodeAnim->second->GetFrameCount() - 1).second;
@@ -317,9 +402,17 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
   while (x > lastX)
     x -= lastX;
 
-  double time = nodeAnim->second->GetTimeAtX(x);
+  return nodeAnim->second->GetTimeAtX(x);
+}
 
-  return this->PoseAt(time, _loop);
+//////////////////////////////////////////////////
+NodeAnimation *SkeletonAnimation::NodeAnimationByName(
+    const std::string &_node) const
+{
+  auto iter = this->animations.find(_node);
+  if (iter == this->animations.end())
+    return nullptr;
+  return iter->second;
 }
 
 //////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #define _GAZEBO_SKELETONANIMATION_HH_
 
 #include <map>
+#include <memory>
 #include <utility>
 #include <string>
 
@@ -31,6 +32,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class
+    class NodeAnimationPrivate;
+
     /// \addtogroup gazebo_common Common Animation
     /// \{
 
@@ -120,6 +124,10 @@ namespace gazebo
 
       /// \brief the duration of the animations (time of last key frame)
       protected: double length;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<NodeAnimationPrivate> dataPtr;
     };
 
     /// \brief Skeleton animation
@@ -200,6 +208,24 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Returns the time where a named node transformation's
+      /// translational value along the X axis is equal to _x, as used by
+      /// PoseAtX.
+      /// \param[in] _x the value along x.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, _x wraps around the distance covered by
+      /// the node
+      /// \return the time, 0 if the node isn't animated
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
+      /// \brief Get the animation of a node, to evaluate it directly
+      /// without looking it up by name on every frame.
+      /// \param[in] _node the name of the animation node
+      /// \return the node animation, null if the node isn't animated. It
+      /// is owned by this skeleton animation.
+      public: NodeAnimation *NodeAnimationByName(
+                  const std::string &_node) const;
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
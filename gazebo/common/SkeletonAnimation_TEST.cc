@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/SkeletonAnimation.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SkeletonAnimationTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, NodeKeyFrames)
+{
+  common::NodeAnimation anim("node");
+  EXPECT_EQ("node", anim.GetName());
+
+  // Out of order, and a time added twice
+  anim.AddKeyFrame(2.0, ignition::math::Pose3d(2, 0, 0, 0, 0, 0));
+  anim.AddKeyFrame(0.0, ignition::math::Pose3d(0, 0, 0, 0, 0, 0));
+  anim.AddKeyFrame(1.0, ignition::math::Pose3d(5, 0, 0, 0, 0, 0));
+  anim.AddKeyFrame(1.0, ignition::math::Pose3d(1, 0, 0, 0, 0, 0));
+  EXPECT_EQ(3u, anim.GetFrameCount());
+  EXPECT_DOUBLE_EQ(2.0, anim.GetLength());
+
+  for (unsigned int i = 0; i < anim.GetFrameCount(); ++i)
+  {
+    auto frame = anim.KeyFrame(i);
+    EXPECT_DOUBLE_EQ(i, frame.first);
+    EXPECT_DOUBLE_EQ(i, frame.second.Translation().X());
+  }
+
+  // Key frames and interpolation between them
+  EXPECT_DOUBLE_EQ(0.0, anim.FrameAt(0.0).Translation().X());
+  EXPECT_DOUBLE_EQ(1.0, anim.FrameAt(1.0).Translation().X());
+  EXPECT_DOUBLE_EQ(2.0, anim.FrameAt(2.0).Translation().X());
+  EXPECT_NEAR(0.25, anim.FrameAt(0.25).Translation().X(), 1e-9);
+  EXPECT_NEAR(1.5, anim.FrameAt(1.5).Translation().X(), 1e-9);
+
+  // Looping
+  EXPECT_NEAR(0.5, anim.FrameAt(2.5).Translation().X(), 1e-9);
+  EXPECT_DOUBLE_EQ(2.0, anim.FrameAt(2.5, false).Translation().X());
+
+  EXPECT_NEAR(1.25, anim.GetTimeAtX(1.25), 1e-9);
+
+  anim.Scale(2.0);
+  EXPECT_DOUBLE_EQ(4.0, anim.KeyFrame(2).second.Translation().X());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationTest, NodeLookup)
+{
+  common::SkeletonAnimation anim("walk");
+  for (int i = 0; i <= 10; ++i)
+  {
+    anim.AddKeyFrame("root", i * 0.1,
+        ignition::math::Pose3d(i * 0.2, 0, 0, 0, 0, 0));
+    anim.AddKeyFrame("arm", i * 0.1,
+        ignition::math::Pose3d(0, 0, 0, 0, 0, i * 0.1));
+  }
+  EXPECT_EQ(2u, anim.GetNodeCount());
+
+  common::NodeAnimation *root = anim.NodeAnimationByName("root");
+  common::NodeAnimation *arm = anim.NodeAnimationByName("arm");
+  ASSERT_NE(nullptr, root);
+  ASSERT_NE(nullptr, arm);
+  EXPECT_EQ(nullptr, anim.NodeAnimationByName("leg"));
+
+  // Evaluating the nodes directly matches the pose by name
+  for (double time = 0; time < 2.0; time += 0.037)
+  {
+    auto pose = anim.PoseAt(time);
+    EXPECT_EQ(pose["root"], root->FrameAt(time));
+    EXPECT_EQ(pose["arm"], arm->FrameAt(time));
+  }
+
+  // Same along X
+  for (double x = 0; x < 4.0; x += 0.13)
+  {
+    const double time = anim.TimeAtX(x, "root");
+    auto pose = anim.PoseAtX(x, "root");
+    EXPECT_EQ(pose["root"], root->FrameAt(time));
+    EXPECT_EQ(pose["arm"], arm->FrameAt(time));
+  }
+  EXPECT_NEAR(0.25, anim.TimeAtX(0.5, "root"), 1e-9);
+  EXPECT_NEAR(0.25, anim.TimeAtX(2.5, "root"), 1e-9);
+  EXPECT_DOUBLE_EQ(0.0, anim.TimeAtX(0.5, "leg"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,7 +14,12 @@
  * limitations under the License.
  *
 */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
+#include <vector>
 #include <stdio.h>
 #include <gazebo/gazebo_config.h>
 
@@ -78,19 +83,13 @@ class gazebo::common::VideoEncoderPrivate
   /// \brief libav output video frame
   public: AVFrame *avOutFrame = nullptr;
 
-  /// \brief libav input image data
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-  public: AVPicture *avInFrame = nullptr;
-#else
-  public: AVFrame *avInFrame = nullptr;
-#endif
-
   /// \brief Software scaling context
   public: SwsContext *swsCtx = nullptr;
 #endif
 
-  /// \brief True if the encoder is running
-  public: bool encoding = false;
+  /// \brief True if the encoder is running. Atomic, since frames are
+  /// accepted from other threads than the ones starting and stopping.
+  public: std::atomic<bool> encoding{false};
 
   /// \brief Video encoding bit rate
   public: unsigned int bitRate = VIDEO_ENCODER_BITRATE_DEFAULT;
@@ -113,10 +112,258 @@ class gazebo::common::VideoEncoderPrivate
   /// \brief Number of frames in the video
   public: uint64_t frameCount = 0;
 
-  /// \brief Mutex for thread safety.
+  /// \brief Mutex for thread safety. Guards the libav state.
   public: std::mutex mutex;
+
+  /// \brief An RGB frame waiting to be encoded.
+  public: struct QueuedFrame
+  {
+    /// \brief Pixel data, 3 bytes per pixel.
+    std::vector<unsigned char> data;
+
+    /// \brief Frame width in pixels.
+    unsigned int width = 0;
+
+    /// \brief Frame height in pixels.
+    unsigned int height = 0;
+  };
+
+  /// \brief Check whether a new frame should be encoded and, if so,
+  /// record its timestamp.
+  /// \param[in] _timestamp Timestamp of the frame.
+  /// \return True if the frame should be encoded.
+  public: bool AcceptFrame(
+              const std::chrono::steady_clock::time_point &_timestamp);
+
+  /// \brief Add a frame to the queue of the encoder thread.
+  /// \param[in] _frame Image buffer to be encoded.
+  /// \param[in] _width Input frame width.
+  /// \param[in] _height Input frame height.
+  /// \param[in] _timestamp Timestamp of the frame.
+  /// \return True if the frame was queued.
+  public: bool QueueFrame(const unsigned char *_frame,
+              const unsigned int _width, const unsigned int _height,
+              const std::chrono::steady_clock::time_point &_timestamp);
+
+#ifdef HAVE_FFMPEG
+  /// \brief Convert and encode a frame. The caller must hold mutex.
+  /// \param[in] _frame Image buffer to be encoded.
+  /// \param[in] _width Input frame width.
+  /// \param[in] _height Input frame height.
+  /// \return True on success.
+  public: bool EncodeFrame(const unsigned char *_frame,
+              const unsigned int _width, const unsigned int _height);
+#endif
+
+  /// \brief Main loop of the encoder thread.
+  public: void EncodeThread();
+
+  /// \brief Encode all queued frames and stop the encoder thread.
+  public: void StopEncodeThread();
+
+  /// \brief True if frames are encoded on encodeThread.
+  public: bool async = false;
+
+  /// \brief Maximum number of queued frames in asynchronous mode.
+  public: unsigned int queueSize = VIDEO_ENCODER_QUEUE_SIZE_DEFAULT;
+
+  /// \brief What to do when the queue is full.
+  public: VideoEncoder::FrameDropPolicy dropPolicy =
+          VideoEncoder::FrameDropPolicy::DROP_OLDEST;
+
+  /// \brief Number of threads used by the codec.
+  public: unsigned int threadCount = VIDEO_ENCODER_THREAD_COUNT_DEFAULT;
+
+  /// \brief Frames waiting to be encoded, oldest first.
+  public: std::deque<std::unique_ptr<QueuedFrame>> queue;
+
+  /// \brief Frame buffers available for reuse.
+  public: std::vector<std::unique_ptr<QueuedFrame>> framePool;
+
+  /// \brief Mutex that guards the queue, the frame pool and stopThread.
+  public: mutable std::mutex queueMutex;
+
+  /// \brief Notified when a frame is queued or the thread should stop.
+  public: std::condition_variable frameQueued;
+
+  /// \brief Notified when a frame is removed from the queue.
+  public: std::condition_variable frameDequeued;
+
+  /// \brief Thread that encodes the queued frames.
+  public: std::unique_ptr<std::thread> encodeThread;
+
+  /// \brief True when the encoder thread should exit once the queue
+  /// is empty.
+  public: bool stopThread = false;
+
+  /// \brief Number of frames dropped since Start.
+  public: std::atomic<uint64_t> droppedFrames{0};
 };
 
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::AcceptFrame(
+    const std::chrono::steady_clock::time_point &_timestamp)
+{
+  if (!this->encoding)
+  {
+    gzerr << "Start encoding before adding a frame\n";
+    return false;
+  }
+
+  auto dt = _timestamp - this->timePrev;
+
+  // Skip frames that arrive faster than the video's fps
+  if (dt < std::chrono::duration<double>(1.0/this->fps))
+    return false;
+
+  this->timePrev = _timestamp;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::QueueFrame(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height,
+    const std::chrono::steady_clock::time_point &_timestamp)
+{
+  std::unique_ptr<QueuedFrame> frame;
+  {
+    std::unique_lock<std::mutex> lock(this->queueMutex);
+    if (this->stopThread || !this->AcceptFrame(_timestamp))
+      return false;
+
+    if (this->queue.size() >= this->queueSize)
+    {
+      if (this->dropPolicy == VideoEncoder::FrameDropPolicy::DROP_NEWEST)
+      {
+        this->droppedFrames++;
+        return false;
+      }
+      else if (this->dropPolicy == VideoEncoder::FrameDropPolicy::BLOCK)
+      {
+        this->frameDequeued.wait(lock, [this]
+            {
+              return this->queue.size() < this->queueSize || this->stopThread;
+            });
+        if (this->stopThread)
+          return false;
+      }
+    }
+
+    if (this->framePool.empty())
+    {
+      frame.reset(new QueuedFrame);
+    }
+    else
+    {
+      frame = std::move(this->framePool.back());
+      this->framePool.pop_back();
+    }
+  }
+
+  // Copy outside of the lock so the encoder thread is not held up. The
+  // pooled buffer keeps its capacity, so this does not allocate once the
+  // frame size is stable.
+  frame->data.assign(_frame, _frame + _width * _height * 3);
+  frame->width = _width;
+  frame->height = _height;
+
+  {
+    std::unique_lock<std::mutex> lock(this->queueMutex);
+
+    // The encoder may have been stopped while copying
+    if (this->stopThread)
+    {
+      this->framePool.push_back(std::move(frame));
+      return false;
+    }
+
+    // Another producer may have filled the queue in the meantime
+    if (this->queue.size() >= this->queueSize)
+    {
+      if (this->dropPolicy == VideoEncoder::FrameDropPolicy::DROP_NEWEST)
+      {
+        this->framePool.push_back(std::move(frame));
+        this->droppedFrames++;
+        return false;
+      }
+      else if (this->dropPolicy == VideoEncoder::FrameDropPolicy::BLOCK)
+      {
+        this->frameDequeued.wait(lock, [this]
+            {
+              return this->queue.size() < this->queueSize || this->stopThread;
+            });
+        if (this->stopThread)
+        {
+          this->framePool.push_back(std::move(frame));
+          return false;
+        }
+      }
+      else
+      {
+        this->framePool.push_back(std::move(this->queue.front()));
+        this->queue.pop_front();
+        this->droppedFrames++;
+      }
+    }
+
+    this->queue.push_back(std::move(frame));
+  }
+  this->frameQueued.notify_one();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::EncodeThread()
+{
+  while (true)
+  {
+    std::unique_ptr<QueuedFrame> frame;
+    {
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->frameQueued.wait(lock, [this]
+          {
+            return !this->queue.empty() || this->stopThread;
+          });
+
+      // Only exit once every queued frame has been encoded
+      if (this->queue.empty())
+        break;
+
+      frame = std::move(this->queue.front());
+      this->queue.pop_front();
+    }
+    this->frameDequeued.notify_all();
+
+#ifdef HAVE_FFMPEG
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->EncodeFrame(frame->data.data(), frame->width, frame->height);
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->framePool.push_back(std::move(frame));
+  }
+}
+
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::StopEncodeThread()
+{
+  if (!this->encodeThread)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stopThread = true;
+  }
+  this->frameQueued.notify_all();
+  this->frameDequeued.notify_all();
+
+  this->encodeThread->join();
+  this->encodeThread.reset();
+}
+
 /////////////////////////////////////////////////
 VideoEncoder::VideoEncoder()
 : dataPtr(new VideoEncoderPrivate)
@@ -159,7 +406,7 @@ bool VideoEncoder::Start(const std::string &_format,
 
   // This will be true if Stop has been called, but not reset. We will reset
   // automatically to prevent any errors.
-  if (this->dataPtr->formatCtx || this->dataPtr->avInFrame ||
+  if (this->dataPtr->formatCtx ||
       this->dataPtr->avOutFrame || this->dataPtr->swsCtx)
   {
     this->Reset();
@@ -370,7 +617,7 @@ bool VideoEncoder::Start(const std::string &_format,
   this->dataPtr->codecCtx->gop_size = 10;
   this->dataPtr->codecCtx->max_b_frames = 1;
   this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
-  this->dataPtr->codecCtx->thread_count = 5;
+  this->dataPtr->codecCtx->thread_count = this->dataPtr->threadCount;
 
   // Set the codec id
   this->dataPtr->codecCtx->codec_id =
@@ -497,6 +744,18 @@ bool VideoEncoder::Start(const std::string &_format,
   }
 
   this->dataPtr->encoding = true;
+  this->dataPtr->droppedFrames = 0;
+
+  if (this->dataPtr->async)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+      this->dataPtr->stopThread = false;
+    }
+    this->dataPtr->encodeThread.reset(new std::thread(
+          &VideoEncoderPrivate::EncodeThread, this->dataPtr.get()));
+  }
+
   return true;
 }
 // #else for HAVE_FFMPEG version check
@@ -538,88 +797,64 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
     const unsigned int _height,
     const std::chrono::steady_clock::time_point &_timestamp)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  if (!this->dataPtr->encoding)
+  if (this->dataPtr->async)
   {
-    gzerr << "Start encoding before adding a frame\n";
-    return false;
+    return this->dataPtr->QueueFrame(_frame, _width, _height, _timestamp);
   }
 
-  auto dt = _timestamp - this->dataPtr->timePrev;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // Skip frames that arrive faster than the video's fps
-  if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
+  if (!this->dataPtr->AcceptFrame(_timestamp))
     return false;
 
-  this->dataPtr->timePrev = _timestamp;
+  return this->dataPtr->EncodeFrame(_frame, _width, _height);
+}
 
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::EncodeFrame(const unsigned char *_frame,
+    const unsigned int _width, const unsigned int _height)
+{
   // Cause the sws to be recreated on image resize
-  if (this->dataPtr->swsCtx &&
-      (this->dataPtr->inWidth != _width || this->dataPtr->inHeight != _height))
+  if (this->swsCtx &&
+      (this->inWidth != _width || this->inHeight != _height))
   {
-    sws_freeContext(this->dataPtr->swsCtx);
-    this->dataPtr->swsCtx = nullptr;
-
-    if (this->dataPtr->avInFrame)
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      av_free(this->dataPtr->avInFrame);
-#else
-      av_frame_free(&this->dataPtr->avInFrame);
-#endif
-    this->dataPtr->avInFrame = nullptr;
+    sws_freeContext(this->swsCtx);
+    this->swsCtx = nullptr;
   }
 
-  if (!this->dataPtr->swsCtx)
+  if (!this->swsCtx)
   {
-    this->dataPtr->inWidth = _width;
-    this->dataPtr->inHeight = _height;
-
-    if (!this->dataPtr->avInFrame)
-    {
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      this->dataPtr->avInFrame = new AVPicture;
-      avpicture_alloc(this->dataPtr->avInFrame,
-          AV_PIX_FMT_RGB24, this->dataPtr->inWidth,
-          this->dataPtr->inHeight);
-#else
-      this->dataPtr->avInFrame = av_frame_alloc();
-
-      av_image_alloc(this->dataPtr->avInFrame->data,
-          this->dataPtr->avInFrame->linesize,
-          this->dataPtr->inWidth, this->dataPtr->inHeight,
-          AV_PIX_FMT_RGB24, 1);
-#endif
-    }
+    this->inWidth = _width;
+    this->inHeight = _height;
 
-    this->dataPtr->swsCtx = sws_getContext(
-        this->dataPtr->inWidth,
-        this->dataPtr->inHeight,
+    this->swsCtx = sws_getContext(
+        this->inWidth,
+        this->inHeight,
         AV_PIX_FMT_RGB24,
-        this->dataPtr->codecCtx->width,
-        this->dataPtr->codecCtx->height,
-        this->dataPtr->codecCtx->pix_fmt,
+        this->codecCtx->width,
+        this->codecCtx->height,
+        this->codecCtx->pix_fmt,
         SWS_BICUBIC, nullptr, nullptr, nullptr);
 
-    if (this->dataPtr->swsCtx == nullptr)
+    if (this->swsCtx == nullptr)
     {
       gzerr << "Error while calling sws_getContext\n";
       return false;
     }
   }
 
-  // encode
-  memcpy(this->dataPtr->avInFrame->data[0], _frame,
-         this->dataPtr->inWidth * this->dataPtr->inHeight * 3);
+  // encode, reading the caller's buffer directly instead of copying it
+  const uint8_t *const srcSlice[1] = {_frame};
+  const int srcStride[1] = {static_cast<int>(this->inWidth * 3)};
 
-  sws_scale(this->dataPtr->swsCtx,
-      this->dataPtr->avInFrame->data,
-      this->dataPtr->avInFrame->linesize,
-      0, this->dataPtr->inHeight,
-      this->dataPtr->avOutFrame->data,
-      this->dataPtr->avOutFrame->linesize);
+  sws_scale(this->swsCtx,
+      srcSlice,
+      srcStride,
+      0, this->inHeight,
+      this->avOutFrame->data,
+      this->avOutFrame->linesize);
 
-  this->dataPtr->avOutFrame->pts = this->dataPtr->frameCount++;
+  this->avOutFrame->pts = this->frameCount++;
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
   int gotOutput = 0;
@@ -628,31 +863,31 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket.data = nullptr;
   avPacket.size = 0;
 
-  int ret = avcodec_encode_video2(this->dataPtr->codecCtx, &avPacket,
-      this->dataPtr->avOutFrame, &gotOutput);
+  int ret = avcodec_encode_video2(this->codecCtx, &avPacket,
+      this->avOutFrame, &gotOutput);
 
   if (ret >= 0 && gotOutput == 1)
   {
-    avPacket.stream_index = this->dataPtr->videoStream->index;
+    avPacket.stream_index = this->videoStream->index;
 
     // Scale timestamp appropriately.
     if (avPacket.pts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.pts = av_rescale_q(avPacket.pts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     if (avPacket.dts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.dts = av_rescale_q(
           avPacket.dts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     // Write frame to disk
-    ret = av_interleaved_write_frame(this->dataPtr->formatCtx, &avPacket);
+    ret = av_interleaved_write_frame(this->formatCtx, &avPacket);
 
     if (ret < 0)
     {
@@ -672,38 +907,38 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket->data = nullptr;
   avPacket->size = 0;
 
-  int ret = avcodec_send_frame(this->dataPtr->codecCtx,
-                               this->dataPtr->avOutFrame);
+  int ret = avcodec_send_frame(this->codecCtx,
+                               this->avOutFrame);
 
   // This loop will retrieve and write available packets
   while (ret >= 0)
   {
-    ret = avcodec_receive_packet(this->dataPtr->codecCtx, avPacket);
+    ret = avcodec_receive_packet(this->codecCtx, avPacket);
 
     // Potential performance improvement: Queue the packets and write in
     // a separate thread.
     if (ret >= 0)
     {
-      avPacket->stream_index = this->dataPtr->videoStream->index;
+      avPacket->stream_index = this->videoStream->index;
 
       // Scale timestamp appropriately.
       if (avPacket->pts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->pts = av_rescale_q(avPacket->pts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       if (avPacket->dts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->dts = av_rescale_q(
             avPacket->dts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       // Write frame to disk
-      if (av_interleaved_write_frame(this->dataPtr->formatCtx, avPacket) < 0)
+      if (av_interleaved_write_frame(this->formatCtx, avPacket) < 0)
         gzerr << "Error writing frame" << std::endl;
     }
   }
@@ -729,6 +964,9 @@ bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
 /////////////////////////////////////////////////
 bool VideoEncoder::Stop()
 {
+  // Flush the queue while the codec is still open
+  this->dataPtr->StopEncodeThread();
+
 #ifdef HAVE_FFMPEG
   if (this->dataPtr->encoding && this->dataPtr->formatCtx)
     av_write_trailer(this->dataPtr->formatCtx);
@@ -739,14 +977,6 @@ bool VideoEncoder::Stop()
 #endif
   this->dataPtr->codecCtx = nullptr;
 
-  if (this->dataPtr->avInFrame)
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    av_free(this->dataPtr->avInFrame);
-#else
-    av_frame_free(&this->dataPtr->avInFrame);
-#endif
-  this->dataPtr->avInFrame = nullptr;
-
   if (this->dataPtr->avOutFrame)
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
     av_free(this->dataPtr->avOutFrame);
@@ -822,3 +1052,51 @@ void VideoEncoder::Reset()
   this->dataPtr->fps = VIDEO_ENCODER_FPS_DEFAULT;
   this->dataPtr->format = VIDEO_ENCODER_FORMAT_DEFAULT;
 }
+
+/////////////////////////////////////////////////
+bool VideoEncoder::SetAsync(const bool _async, const unsigned int _queueSize,
+    const FrameDropPolicy _policy)
+{
+  if (this->dataPtr->encoding)
+  {
+    gzerr << "Unable to change the encoding mode while encoding\n";
+    return false;
+  }
+
+  if (_queueSize == 0)
+  {
+    gzerr << "Frame queue size must be greater than zero\n";
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  this->dataPtr->async = _async;
+  this->dataPtr->queueSize = _queueSize;
+  this->dataPtr->dropPolicy = _policy;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoder::Async() const
+{
+  return this->dataPtr->async;
+}
+
+/////////////////////////////////////////////////
+void VideoEncoder::SetEncoderThreadCount(const unsigned int _count)
+{
+  this->dataPtr->threadCount = _count;
+}
+
+/////////////////////////////////////////////////
+unsigned int VideoEncoder::QueueDepth() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->queue.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t VideoEncoder::DroppedFrames() const
+{
+  return this->dataPtr->droppedFrames;
+}
@@ -18,6 +18,7 @@
 #define GAZEBO_COMMON_VIDEOENCODER_HH_
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <gazebo/util/system.hh>
@@ -29,6 +30,8 @@
 #define VIDEO_ENCODER_HEIGHT_DEFAULT 720
 #define VIDEO_ENCODER_FPS_DEFAULT 25
 #define VIDEO_ENCODER_FORMAT_DEFAULT "mp4"
+#define VIDEO_ENCODER_QUEUE_SIZE_DEFAULT 8
+#define VIDEO_ENCODER_THREAD_COUNT_DEFAULT 5
 
 namespace gazebo
 {
@@ -45,6 +48,22 @@ namespace gazebo
     /// to a video format, and then writing the video to disk.
     class GZ_COMMON_VISIBLE VideoEncoder
     {
+      /// \brief What to do with a frame added in asynchronous mode while
+      /// the frame queue is full.
+      /// \sa SetAsync
+      public: enum class FrameDropPolicy
+              {
+                /// \brief Drop the oldest queued frame to make room.
+                DROP_OLDEST,
+
+                /// \brief Drop the frame being added.
+                DROP_NEWEST,
+
+                /// \brief Block the caller until the encoder thread has
+                /// made room in the queue. No frames are dropped.
+                BLOCK
+              };
+
       /// \brief Constructor
       public: VideoEncoder();
 
@@ -122,6 +141,43 @@ namespace gazebo
       /// memory. This will also delete any temporary files.
       public: void Reset();
 
+      /// \brief Enable or disable asynchronous encoding. In asynchronous
+      /// mode AddFrame only copies the image into a pooled buffer and
+      /// queues it; color conversion and encoding happen on a dedicated
+      /// thread. Stop waits for all queued frames to be encoded. This
+      /// setting survives Reset and must be changed while not encoding.
+      /// \param[in] _async True to encode on a separate thread.
+      /// \param[in] _queueSize Maximum number of frames waiting to be
+      /// encoded. Must be greater than zero.
+      /// \param[in] _policy What to do when the queue is full.
+      /// \return False if the encoder is running or _queueSize is zero.
+      public: bool SetAsync(const bool _async,
+                  const unsigned int _queueSize =
+                  VIDEO_ENCODER_QUEUE_SIZE_DEFAULT,
+                  const FrameDropPolicy _policy =
+                  FrameDropPolicy::DROP_OLDEST);
+
+      /// \brief Get whether asynchronous encoding is enabled.
+      /// \return True if frames are encoded on a separate thread.
+      /// \sa SetAsync
+      public: bool Async() const;
+
+      /// \brief Set the number of threads the codec may use internally.
+      /// Takes effect on the next call to Start. This setting survives
+      /// Reset.
+      /// \param[in] _count Number of threads, 0 lets the codec decide.
+      public: void SetEncoderThreadCount(const unsigned int _count);
+
+      /// \brief Get the number of frames currently waiting to be encoded.
+      /// Always zero in synchronous mode.
+      /// \return Number of queued frames.
+      public: unsigned int QueueDepth() const;
+
+      /// \brief Get the number of frames dropped because the queue was
+      /// full since the last call to Start.
+      /// \return Number of dropped frames.
+      public: uint64_t DroppedFrames() const;
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<VideoEncoderPrivate> dataPtr;
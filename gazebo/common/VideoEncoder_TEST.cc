@@ -14,6 +14,8 @@
  *
 */
 #include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/VideoEncoder.hh"
@@ -75,3 +77,66 @@ TEST_F(VideoEncoderTest, Exists)
   EXPECT_FALSE(common::exists(common::cwd() + "/TMP_RECORDING.mp4"));
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, Async)
+{
+  VideoEncoder video;
+  EXPECT_FALSE(video.Async());
+  EXPECT_EQ(0u, video.QueueDepth());
+  EXPECT_EQ(0u, video.DroppedFrames());
+
+  EXPECT_FALSE(video.SetAsync(true, 0));
+  EXPECT_FALSE(video.Async());
+  EXPECT_TRUE(video.SetAsync(true, 2,
+        VideoEncoder::FrameDropPolicy::DROP_NEWEST));
+  EXPECT_TRUE(video.Async());
+
+  // Asynchronous mode survives a reset
+  video.Reset();
+  EXPECT_TRUE(video.Async());
+
+#ifdef HAVE_FFMPEG
+  const unsigned int width = 320;
+  const unsigned int height = 240;
+  std::vector<unsigned char> frame(width * height * 3, 128);
+
+  EXPECT_TRUE(video.SetAsync(true, 4, VideoEncoder::FrameDropPolicy::BLOCK));
+  EXPECT_TRUE(video.Start("mp4", "", width, height));
+  EXPECT_TRUE(video.IsEncoding());
+
+  // The mode can not change while encoding
+  EXPECT_FALSE(video.SetAsync(false));
+  EXPECT_TRUE(video.Async());
+
+  // Space the timestamps one frame period apart so none are skipped
+  auto time = std::chrono::steady_clock::now();
+  for (int i = 0; i < 50; ++i)
+  {
+    time += std::chrono::milliseconds(1000 / VIDEO_ENCODER_FPS_DEFAULT + 1);
+    EXPECT_TRUE(video.AddFrame(frame.data(), width, height, time));
+    EXPECT_LE(video.QueueDepth(), 4u);
+  }
+
+  // Stop encodes every queued frame
+  EXPECT_TRUE(video.Stop());
+  EXPECT_EQ(0u, video.QueueDepth());
+  EXPECT_EQ(0u, video.DroppedFrames());
+  EXPECT_FALSE(video.IsEncoding());
+
+  // Every frame of a burst is either queued or counted as dropped
+  EXPECT_TRUE(video.SetAsync(true, 1,
+        VideoEncoder::FrameDropPolicy::DROP_NEWEST));
+  EXPECT_TRUE(video.Start("mp4", "", width, height));
+  unsigned int added = 0;
+  for (int i = 0; i < 50; ++i)
+  {
+    time += std::chrono::milliseconds(1000 / VIDEO_ENCODER_FPS_DEFAULT + 1);
+    if (video.AddFrame(frame.data(), width, height, time))
+      added++;
+  }
+  EXPECT_EQ(50u, added + video.DroppedFrames());
+  video.Reset();
+  EXPECT_FALSE(common::exists(common::cwd() + "/TMP_RECORDING.mp4"));
+#endif
+}
@@ -26,6 +26,7 @@
 #include "gazebo/common/common.hh"
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/ProfileManager.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/gazebo_shared.hh"
 #include "gazebo/gazebo.hh"
@@ -130,6 +131,7 @@ bool gazebo::shutdown()
   boost::mutex::scoped_lock lock(fini_mutex);
   util::LogRecord::Instance()->Fini();
   util::DiagnosticManager::Instance()->Fini();
+  util::ProfileManager::Instance()->Fini();
   g_plugins.clear();
   gazebo::transport::fini();
 
@@ -363,8 +363,11 @@ void IncrementalPlot::Update()
     ignition::math::Vector2d minPt = curve.second->Min();
     ignition::math::Vector2d maxPt = curve.second->Max();
 
+    // the curve only exposes the plotted range to Qwt, possibly decimated
+    const int drawCount =
+        static_cast<int>(curve.second->Curve()->dataSize());
     this->dataPtr->directPainter->drawSeries(curve.second->Curve(),
-      pointCount - 1, pointCount - 1);
+      drawCount - 1, drawCount - 1);
   }
 
   // get x axis lower and upper bounds
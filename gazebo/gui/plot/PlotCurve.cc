@@ -14,7 +14,13 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <utility>
+#include <vector>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Assert.hh"
@@ -45,18 +51,143 @@ namespace gazebo
           Colors[ColorGroupCount][ColorCount];
     };
 
-    /// \brief A class that manages curve data
-    class CurveData: public QwtArraySeriesData<QPointF>
+    /// \brief Fixed capacity ring of curve points. Once full, each new
+    /// point overwrites the oldest one. Points are expected to be added in
+    /// increasing x, as with time series, so that they can be searched.
+    class CurvePointRing
     {
-      public: CurveData()
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of points.
+      public: explicit CurvePointRing(const size_t _capacity)
+              : capacity(_capacity)
               {}
 
-      /// \brief Add a point to the sample.
+      /// \brief Append a point, dropping the oldest one if the ring is full.
+      /// \param[in] _point Point to append.
+      public: void Push(const QPointF &_point)
+              {
+                if (this->points.size() < this->capacity)
+                {
+                  this->points.push_back(_point);
+                  return;
+                }
+
+                this->points[this->head] = _point;
+                this->head = (this->head + 1) % this->capacity;
+                this->dropped = true;
+              }
+
+      /// \brief Get the number of points.
+      /// \return Number of points.
+      public: size_t Size() const
+              {
+                return this->points.size();
+              }
+
+      /// \brief Get whether points were dropped since the last clear.
+      /// \return True if the ring wrapped around.
+      public: bool Dropped() const
+              {
+                return this->dropped;
+              }
+
+      /// \brief Get a point, the oldest first.
+      /// \param[in] _index Index of the point, less than Size().
+      /// \return The point.
+      public: const QPointF &operator[](const size_t _index) const
+              {
+                return this->points[(this->head + _index) %
+                    this->points.size()];
+              }
+
+      /// \brief Get the index of the first point whose x is not less than
+      /// (or, if _after is true, greater than) a value.
+      /// \param[in] _x Value to search.
+      /// \param[in] _after True to skip points at _x.
+      /// \return Index of the point, Size() if there is none.
+      public: size_t Find(const double _x, const bool _after) const
+              {
+                size_t low = 0;
+                size_t high = this->points.size();
+                while (low < high)
+                {
+                  const size_t mid = low + (high - low) / 2;
+                  const double x = (*this)[mid].x();
+                  if (x < _x || (_after && x <= _x))
+                    low = mid + 1;
+                  else
+                    high = mid;
+                }
+                return low;
+              }
+
+      /// \brief Remove all points and release their memory.
+      public: void Clear()
+              {
+                this->points.clear();
+                this->points.shrink_to_fit();
+                this->head = 0;
+                this->dropped = false;
+              }
+
+      /// \brief Points, grown up to the capacity.
+      private: std::vector<QPointF> points;
+
+      /// \brief Maximum number of points.
+      private: size_t capacity;
+
+      /// \brief Index of the oldest point once the ring is full.
+      private: size_t head = 0;
+
+      /// \brief True if points were overwritten.
+      private: bool dropped = false;
+    };
+
+    /// \brief A class that manages curve data.
+    ///
+    /// The raw samples are kept in a ring holding the most recent ones.
+    /// Coarser levels keep the minimum and maximum sample of consecutive
+    /// buckets of the level below, so that older history stays available
+    /// at a lower resolution. Qwt only sees a view of the x range being
+    /// plotted, taken from the finest level that covers the range within
+    /// a point budget, so that the drawing cost doesn't grow with the
+    /// number of samples.
+    class CurveData: public QwtSeriesData<QPointF>
+    {
+      /// \brief Constructor.
+      public: CurveData()
+              {
+                this->levels.push_back(CurvePointRing(RawCapacity));
+                for (unsigned int i = 1; i < LevelCount; ++i)
+                  this->levels.push_back(CurvePointRing(LevelCapacity));
+                this->buckets.resize(LevelCount);
+                this->d_boundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
+              }
+
+      /// \brief Get the number of points in the view.
+      /// \return Number of points.
+      public: virtual size_t size() const
+              {
+                this->UpdateView();
+                return this->view.size();
+              }
+
+      /// \brief Get a point of the view.
+      /// \param[in] _index Index of the point.
+      /// \return The point.
+      public: virtual QPointF sample(size_t _index) const
+              {
+                this->UpdateView();
+                return this->view[_index];
+              }
+
+      /// \brief Get the bounding box of all the samples added since the
+      /// last clear.
       /// \return Bounding box of the sample.
       public: virtual QRectF boundingRect() const
               {
                 if (this->d_boundingRect.width() < 0.0)
-                  this->d_boundingRect = qwtBoundingRect(*this);
+                  return this->d_boundingRect;
 
                 // set a minimum bounding box height
                 // this prevents plot's auto scale to zoom in on near-zero
@@ -75,20 +206,31 @@ namespace gazebo
                 return this->d_boundingRect;
               }
 
+      /// \brief Set the area being plotted. Called by Qwt when the plot
+      /// scales change.
+      /// \param[in] _rect Plotted area.
+      public: virtual void setRectOfInterest(const QRectF &_rect)
+              {
+                const double minX = std::min(_rect.left(), _rect.right());
+                const double maxX = std::max(_rect.left(), _rect.right());
+                if (minX == this->viewMinX && maxX == this->viewMaxX)
+                  return;
+
+                this->viewMinX = minX;
+                this->viewMaxX = maxX;
+                this->viewDirty = true;
+              }
+
       /// \brief Add a point to the sample.
       /// \param[in] _point Point to add.
       public: inline void Add(const QPointF &_point)
               {
-                this->d_samples += _point;
-
-                if (this->d_samples.size() > maxSampleSize)
-                {
-                  // remove sample window
-                  // update bounding rect?
-                  this->d_samples.remove(0, windowSize);
-                }
+                this->levels[0].Push(_point);
+                this->Accumulate(1, _point);
+                this->Close(1);
+                this->viewDirty = true;
 
-                if (this->d_samples.size() == 1)
+                if (this->d_boundingRect.width() < 0.0)
                 {
                   // init bounding rect
                   this->d_boundingRect.setTopLeft(_point);
@@ -110,25 +252,170 @@ namespace gazebo
       /// \brief Clear the sample data.
       public: void Clear()
               {
-                this->d_samples.clear();
-                this->d_samples.squeeze();
+                for (auto &level : this->levels)
+                  level.Clear();
+                for (auto &bucket : this->buckets)
+                  bucket = Bucket();
+                this->view.clear();
+                this->view.squeeze();
+                this->viewDirty = false;
                 this->d_boundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
               }
 
-      /// \brief Get the sample data.
-      /// \return A vector of same points.
-      public: QVector<QPointF> Samples() const
+      /// \brief Get the most recent samples at full resolution.
+      /// \return Ring of raw samples.
+      public: const CurvePointRing &Raw() const
               {
-                return this->d_samples;
+                return this->levels[0];
               }
 
-      /// \brief maxium sample size of this curve.
-      private: int maxSampleSize = 11000;
+      /// \brief Extend the open bucket of a level with a point.
+      /// \param[in] _level Level of the bucket, at least 1.
+      /// \param[in] _point Point from the level below.
+      private: void Accumulate(const unsigned int _level,
+                   const QPointF &_point)
+              {
+                Bucket &bucket = this->buckets[_level];
+                if (bucket.empty)
+                {
+                  bucket.min = _point;
+                  bucket.max = _point;
+                  bucket.empty = false;
+                }
+                else if (_point.y() < bucket.min.y())
+                  bucket.min = _point;
+                else if (_point.y() > bucket.max.y())
+                  bucket.max = _point;
+              }
 
-      /// \brief Size of samples to remove when maxSampleSize is reached.
-      private: int windowSize = 1000;
-    };
+      /// \brief Count one more unit of the level below in the open bucket of
+      /// a level, and move the bucket to the level once it is full.
+      /// \param[in] _level Level of the bucket, at least 1.
+      private: void Close(const unsigned int _level)
+              {
+                Bucket &bucket = this->buckets[_level];
+                if (++bucket.count < BucketSize)
+                  return;
+
+                // Keep both extremes in x order so the line stays monotonic
+                QPointF first = bucket.min;
+                QPointF second = bucket.max;
+                if (second.x() < first.x())
+                  std::swap(first, second);
+                bucket = Bucket();
+
+                this->levels[_level].Push(first);
+                this->levels[_level].Push(second);
+                if (_level + 1 < LevelCount)
+                {
+                  this->Accumulate(_level + 1, first);
+                  this->Accumulate(_level + 1, second);
+                  this->Close(_level + 1);
+                }
+              }
 
+      /// \brief Rebuild the view of the plotted x range if needed.
+      private: void UpdateView() const
+              {
+                if (!this->viewDirty)
+                  return;
+                this->viewDirty = false;
+                this->view.clear();
+
+                // Finest level that reaches back to the start of the range
+                // and fits it within the budget
+                unsigned int top = LevelCount - 1;
+                for (unsigned int i = 0; i < LevelCount; ++i)
+                {
+                  const CurvePointRing &level = this->levels[i];
+                  if (level.Dropped() && level[0].x() > this->viewMinX)
+                    continue;
+                  const size_t count = level.Find(this->viewMaxX, true) -
+                      level.Find(this->viewMinX, false);
+                  if (count <= MaxViewSize)
+                  {
+                    top = i;
+                    break;
+                  }
+                }
+
+                // The most recent samples are still in open buckets, take
+                // them from the finer levels. Each level also contributes
+                // one point on either side of the range so that the line
+                // reaches the plot edges.
+                double after = -std::numeric_limits<double>::infinity();
+                for (int i = static_cast<int>(top); i >= 0; --i)
+                {
+                  const CurvePointRing &level = this->levels[i];
+                  if (level.Size() == 0)
+                    continue;
+
+                  size_t begin = level.Find(this->viewMinX, false);
+                  if (begin > 0)
+                    --begin;
+                  begin = std::max(begin, level.Find(after, true));
+                  size_t end = level.Find(this->viewMaxX, true);
+                  if (end < level.Size())
+                    ++end;
+
+                  for (size_t j = begin; j < end; ++j)
+                    this->view.append(level[j]);
+                  after = std::max(after, level[level.Size() - 1].x());
+                }
+              }
+
+      /// \brief Open bucket of a level.
+      private: class Bucket
+               {
+                 /// \brief Point with the smallest y.
+                 public: QPointF min;
+
+                 /// \brief Point with the largest y.
+                 public: QPointF max;
+
+                 /// \brief Number of units of the level below.
+                 public: unsigned int count = 0;
+
+                 /// \brief True if no point was accumulated.
+                 public: bool empty = true;
+               };
+
+      /// \brief Number of raw samples kept at full resolution.
+      private: static const size_t RawCapacity = 32768;
+
+      /// \brief Number of points kept in each coarser level.
+      private: static const size_t LevelCapacity = 16384;
+
+      /// \brief Number of levels, the raw samples included. Each coarser
+      /// level spans BucketSize times more time than the one below, which
+      /// keeps days of history for a 1 kHz signal.
+      private: static const unsigned int LevelCount = 5;
+
+      /// \brief Number of units of a level merged in a bucket of the next.
+      private: static const unsigned int BucketSize = 16;
+
+      /// \brief Maximum number of points of a level in the view, about two
+      /// points per pixel on a wide plot.
+      private: static const size_t MaxViewSize = 4096;
+
+      /// \brief Raw samples followed by the min/max levels.
+      private: std::vector<CurvePointRing> levels;
+
+      /// \brief Open bucket of each level, unused for the raw level.
+      private: std::vector<Bucket> buckets;
+
+      /// \brief Points passed to Qwt.
+      private: mutable QVector<QPointF> view;
+
+      /// \brief True if the view needs to be rebuilt.
+      private: mutable bool viewDirty = false;
+
+      /// \brief Smallest plotted x.
+      private: double viewMinX = -std::numeric_limits<double>::infinity();
+
+      /// \brief Largest plotted x.
+      private: double viewMaxX = std::numeric_limits<double>::infinity();
+    };
 
     /// \internal
     /// \brief PlotCurve private data
@@ -149,7 +436,7 @@ namespace gazebo
       /// \brief Qwt Curve object.
       public: QwtPlotCurve *curve = nullptr;
 
-      /// \brief Curve data in the form of QwtArraySeriesData
+      /// \brief Curve data, owned by the Qwt curve.
       public: CurveData *curveData;
 
       /// \brief Global id incremented on every new curve
@@ -342,7 +629,7 @@ void PlotCurve::SetAge(const unsigned int _age)
 /////////////////////////////////////////////////
 unsigned int PlotCurve::Size() const
 {
-  return static_cast<unsigned int>(this->dataPtr->curveData->samples().size());
+  return static_cast<unsigned int>(this->dataPtr->curveData->Raw().Size());
 }
 
 /////////////////////////////////////////////////
@@ -362,17 +649,28 @@ ignition::math::Vector2d PlotCurve::Max()
 /////////////////////////////////////////////////
 ignition::math::Vector2d PlotCurve::Point(const unsigned int _index) const
 {
-  if (_index >= static_cast<unsigned int>(
-      this->dataPtr->curveData->samples().size()))
+  const CurvePointRing &raw = this->dataPtr->curveData->Raw();
+  if (_index >= raw.Size())
   {
     return ignition::math::Vector2d(ignition::math::NAN_D,
         ignition::math::NAN_D);
   }
 
-  const QPointF &pt = this->dataPtr->curveData->samples()[_index];
+  const QPointF &pt = raw[_index];
   return ignition::math::Vector2d(pt.x(), pt.y());
 }
 
+/////////////////////////////////////////////////
+std::vector<ignition::math::Vector2d> PlotCurve::Points() const
+{
+  const CurvePointRing &raw = this->dataPtr->curveData->Raw();
+  std::vector<ignition::math::Vector2d> points;
+  points.reserve(raw.Size());
+  for (size_t i = 0; i < raw.Size(); ++i)
+    points.emplace_back(raw[i].x(), raw[i].y());
+  return points;
+}
+
 /////////////////////////////////////////////////
 QwtPlotCurve *PlotCurve::Curve()
 {
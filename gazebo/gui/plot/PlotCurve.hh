@@ -99,7 +99,9 @@ namespace gazebo
       /// \return Curve age
       public: unsigned int Age() const;
 
-      /// \brief Get the number of data points in the curve
+      /// \brief Get the number of data points in the curve kept at full
+      /// resolution. Older points are only kept at a lower resolution for
+      /// plotting.
       /// \return Number of data points.
       public: unsigned int Size() const;
 
@@ -117,7 +119,8 @@ namespace gazebo
       /// returned if the index is out of bounds.
       public: ignition::math::Vector2d Point(const unsigned int _index) const;
 
-      /// \brief Return all the sample points in the curve.
+      /// \brief Return all the sample points in the curve kept at full
+      /// resolution.
       /// \return Curve sample points
       public: std::vector<ignition::math::Vector2d> Points() const;
 
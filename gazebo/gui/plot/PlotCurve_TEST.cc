@@ -15,6 +15,10 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+
+#include "gazebo/gui/plot/qwt_gazebo.h"
 #include "gazebo/gui/plot/PlottingTypes.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
 #include "gazebo/gui/plot/PlotCurve_TEST.hh"
@@ -133,5 +137,68 @@ void PlotCurve_TEST::AddPoint()
   delete plotCurve;
 }
 
+/////////////////////////////////////////////////
+void PlotCurve_TEST::History()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::PlotCurve *plotCurve = new gazebo::gui::PlotCurve("curve01");
+  QVERIFY(plotCurve != nullptr);
+
+  // 10 minutes of a 1 kHz signal, with a single spike early on
+  const unsigned int count = 600000;
+  const unsigned int spike = 12345;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    plotCurve->AddPoint(ignition::math::Vector2d(i * 1e-3,
+        i == spike ? 100.0 : std::sin(i * 1e-3)));
+  }
+
+  // only the most recent points are kept at full resolution
+  const unsigned int size = plotCurve->Size();
+  QVERIFY(size > 0u);
+  QVERIFY(size < count);
+  const double lastX = (count - 1) * 1e-3;
+  QCOMPARE(plotCurve->Point(size - 1),
+      ignition::math::Vector2d(lastX, std::sin(lastX)));
+  QCOMPARE(plotCurve->Points().size(), static_cast<size_t>(size));
+  QVERIFY(ignition::math::isnan(plotCurve->Point(size).X()));
+
+  // the bounds cover the whole run
+  QCOMPARE(plotCurve->Min().X(), 0.0);
+  QCOMPARE(plotCurve->Max().Y(), 100.0);
+
+  // the plotted view of the whole run starts at the beginning, is bounded
+  // and keeps the spike
+  QwtSeriesData<QPointF> *data = plotCurve->Curve()->data();
+  data->setRectOfInterest(QRectF(0.0, -1.0, count * 1e-3, 2.0));
+  QVERIFY(data->size() > 0u);
+  QVERIFY(data->size() < 10000u);
+  QVERIFY(data->sample(0).x() < 60.0);
+  QVERIFY(ignition::math::equal(data->sample(data->size() - 1).x(), lastX));
+  double maxY = 0;
+  for (size_t i = 0; i < data->size(); ++i)
+  {
+    maxY = std::max(maxY, data->sample(i).y());
+    if (i > 0)
+      QVERIFY(data->sample(i).x() >= data->sample(i - 1).x());
+  }
+  QCOMPARE(maxY, 100.0);
+
+  // a short recent range is plotted at full resolution
+  data->setRectOfInterest(QRectF((count - 1000) * 1e-3, -1.0, 1.0, 2.0));
+  QVERIFY(data->size() >= 1000u);
+  QVERIFY(data->size() <= 1002u);
+
+  plotCurve->Clear();
+  QCOMPARE(plotCurve->Size(), 0u);
+  QCOMPARE(data->size(), static_cast<size_t>(0u));
+
+  delete plotCurve;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(PlotCurve_TEST)
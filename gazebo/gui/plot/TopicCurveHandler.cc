@@ -15,8 +15,17 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <google/protobuf/descriptor.h>
 #include <google/protobuf/message.h>
 
 #include "gazebo/msgs/msgs.hh"
@@ -68,14 +77,110 @@ namespace gazebo
       private: common::Time lastSimTime;
     };
 
-    /// \brief Helper class to update curves associated with a single topic
-    class TopicCurve
+    /// \brief Field path of a curve query resolved against a message
+    /// descriptor, so that values are read from each message without
+    /// looking up fields by name.
+    class TopicFieldAccessor
+    {
+      /// \brief Compile a query, e.g. ?p=/pose[1]/position/x. Repeated
+      /// fields need an index.
+      /// \param[in] _descriptor Descriptor of the topic messages.
+      /// \param[in] _query URI query string.
+      /// \return True if the query names a plottable field.
+      public: bool Compile(const google::protobuf::Descriptor *_descriptor,
+                  const std::string &_query);
+
+      /// \brief Read the value of the field from a message.
+      /// \param[in] _msg Message of the compiled type.
+      /// \param[out] _value Field value.
+      /// \return False if the query isn't compiled or a repeated index is
+      /// out of range in this message.
+      public: bool Value(const google::protobuf::Message &_msg,
+                  double &_value) const;
+
+      /// \brief How the value is taken from the last field of the path.
+      private: enum Leaf
+               {
+                 /// \brief Numeric or boolean field
+                 SCALAR,
+
+                 /// \brief Time message, in seconds
+                 TIME,
+
+                 /// \brief Component of a Vector3d message
+                 VECTOR3_X,
+                 VECTOR3_Y,
+                 VECTOR3_Z,
+
+                 /// \brief Euler angle of a Quaternion message
+                 ROLL,
+                 PITCH,
+                 YAW
+               };
+
+      /// \brief Fields from the top level message to the leaf, along with
+      /// their index if they are repeated, -1 otherwise.
+      private: std::vector<std::pair<const google::protobuf::FieldDescriptor *,
+                   int> > path;
+
+      /// \brief Kind of leaf.
+      private: Leaf leaf = SCALAR;
+    };
+
+    /// \brief Reduces the points of a curve to the minimum and maximum
+    /// value over each short x interval before they are plotted.
+    class TopicCurveDecimator
+    {
+      /// \brief Add a point.
+      /// \param[in] _point Point to add.
+      /// \param[out] _points Points of the intervals that were closed.
+      public: void Add(const ignition::math::Vector2d &_point,
+                  std::vector<ignition::math::Vector2d> &_points);
+
+      /// \brief Close the current interval.
+      /// \param[out] _points Points of the interval.
+      public: void Flush(std::vector<ignition::math::Vector2d> &_points);
+
+      /// \brief Length of an interval, in x units.
+      public: static constexpr double Period = 1e-3;
+
+      /// \brief X value at the start of the interval.
+      private: double start = 0;
+
+      /// \brief Point with the smallest y in the interval.
+      private: ignition::math::Vector2d min;
+
+      /// \brief Point with the largest y in the interval.
+      private: ignition::math::Vector2d max;
+
+      /// \brief True if the min point came after the max point.
+      private: bool minLast = false;
+
+      /// \brief Number of points in the interval.
+      private: unsigned int count = 0;
+    };
+
+    /// \brief Curves plotting the same field of a topic.
+    class TopicCurveField
     {
-      /// \def CurveVariableMapIt
-      /// \brief Curve variable map iterator
-      public: using CurveVariableMapIt =
-          std::map<std::string, CurveVariableSet>::iterator;
+      /// \brief Plot curves.
+      public: CurveVariableSet curves;
 
+      /// \brief Compiled field path.
+      public: TopicFieldAccessor accessor;
+
+      /// \brief Point decimation.
+      public: TopicCurveDecimator decimator;
+
+      /// \brief Points waiting to be added to the curves.
+      public: std::vector<ignition::math::Vector2d> points;
+    };
+
+    /// \brief Helper class to update curves associated with a single topic.
+    /// Messages are queued by the subscriber callback and processed in
+    /// batches by a worker thread.
+    class TopicCurve
+    {
       /// \brief Constructor.
       public: explicit TopicCurve(const std::string &_topic);
 
@@ -105,15 +210,14 @@ namespace gazebo
       /// \param[in] _msg Message data
       public: void OnTopicData(const std::string &_msg);
 
-      /// \brief Update the plot curve based on message
-      /// \param[in] _msg Message containing data to be added to the curve
-      /// \param[in] _index Index of token in the param path string
-      /// \param[in] _x X value. Only used if the topic data is not timestamped
-      /// \param[in] _curvesUpdates A list of curves and values to update
-      public: void UpdateCurve(google::protobuf::Message *_msg,
-                  const int _index, const double _x,
-                  std::vector<std::pair<TopicCurve::CurveVariableMapIt,
-                      ignition::math::Vector2d> > &_curvesUpdates);
+      /// \brief Worker thread, processes the queued messages.
+      private: void Run();
+
+      /// \brief Add the fields of a batch of messages to the curves.
+      /// \param[in] _batch Serialized messages, each with the sim time at
+      /// which it was received.
+      private: void ProcessBatch(
+                   const std::vector<std::pair<std::string, double> > &_batch);
 
       /// \brief Topic name
       private: std::string topic;
@@ -130,8 +234,34 @@ namespace gazebo
       /// \brief Topic message type.
       private: std::string msgType;
 
+      /// \brief Message reused to parse the topic data.
+      private: boost::shared_ptr<google::protobuf::Message> msg;
+
+      /// \brief Top level time field used as x value, null if the
+      /// messages are not timestamped.
+      private: const google::protobuf::FieldDescriptor *stampField = nullptr;
+
       /// \brief A map of param names to plot curves.
-      private: std::map<std::string, CurveVariableSet> curves;
+      private: std::map<std::string, TopicCurveField> curves;
+
+      /// \brief Mutex to protect the message queue.
+      private: std::mutex queueMutex;
+
+      /// \brief Signals the worker thread.
+      private: std::condition_variable queueCondition;
+
+      /// \brief Messages waiting to be processed, with their sim time.
+      private: std::vector<std::pair<std::string, double> > queue;
+
+      /// \brief True to stop the worker thread.
+      private: bool stop = false;
+
+      /// \brief Worker thread.
+      private: std::thread thread;
+
+      /// \brief Maximum number of queued messages. Newer ones are dropped
+      /// when the worker can't keep up.
+      private: static const size_t MaxQueueSize = 10000;
     };
 
     /// \brief Private data for the TopicCurveHandler class.
@@ -175,6 +305,274 @@ common::Time TopicTime::LastSimTime()
   return this->lastSimTime;
 }
 
+/////////////////////////////////////////////////
+bool TopicFieldAccessor::Compile(
+    const google::protobuf::Descriptor *_descriptor, const std::string &_query)
+{
+  this->path.clear();
+
+  // tokenize query, e.g. ?p=/pose[1]/position/x -> [?p, pose[1], position, x]
+  std::vector<std::string> tokens = common::split(_query, "=/");
+  if (tokens.size() < 2u)
+    return false;
+
+  auto descriptor = _descriptor;
+  for (size_t i = 1; i < tokens.size(); ++i)
+  {
+    if (!descriptor)
+      return false;
+
+    // split the repeated field index, e.g. pose[1] -> pose, 1
+    std::string name = tokens[i];
+    int index = -1;
+    size_t bracket = name.find('[');
+    if (bracket != std::string::npos)
+    {
+      if (name.back() != ']')
+        return false;
+      try
+      {
+        index = std::stoi(name.substr(bracket + 1,
+            name.size() - bracket - 2));
+      }
+      catch(...)
+      {
+        return false;
+      }
+      if (index < 0)
+        return false;
+      name = name.substr(0, bracket);
+    }
+
+    auto field = descriptor->FindFieldByName(name);
+    if (!field || field->is_repeated() != (index >= 0))
+      return false;
+    this->path.push_back(std::make_pair(field, index));
+
+    const bool last = i + 1 == tokens.size();
+    switch (field->type())
+    {
+      case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+      case google::protobuf::FieldDescriptor::TYPE_FLOAT:
+      case google::protobuf::FieldDescriptor::TYPE_INT64:
+      case google::protobuf::FieldDescriptor::TYPE_UINT64:
+      case google::protobuf::FieldDescriptor::TYPE_INT32:
+      case google::protobuf::FieldDescriptor::TYPE_UINT32:
+      case google::protobuf::FieldDescriptor::TYPE_BOOL:
+      {
+        this->leaf = SCALAR;
+        return last;
+      }
+      case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
+      {
+        const std::string &type = field->message_type()->name();
+        if (type == "Time")
+        {
+          this->leaf = TIME;
+          return last;
+        }
+
+        // the next token is the component and must be the last one
+        if (type == "Vector3d" || type == "Quaternion")
+        {
+          if (i + 2 != tokens.size())
+            return false;
+
+          const std::string &elem = tokens[i + 1];
+          if (type == "Vector3d" && elem == "x")
+            this->leaf = VECTOR3_X;
+          else if (type == "Vector3d" && elem == "y")
+            this->leaf = VECTOR3_Y;
+          else if (type == "Vector3d" && elem == "z")
+            this->leaf = VECTOR3_Z;
+          else if (type == "Quaternion" && elem == "roll")
+            this->leaf = ROLL;
+          else if (type == "Quaternion" && elem == "pitch")
+            this->leaf = PITCH;
+          else if (type == "Quaternion" && elem == "yaw")
+            this->leaf = YAW;
+          else
+            return false;
+          return true;
+        }
+
+        descriptor = field->message_type();
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  // the query ends on a message
+  this->path.clear();
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool TopicFieldAccessor::Value(const google::protobuf::Message &_msg,
+    double &_value) const
+{
+  if (this->path.empty())
+    return false;
+
+  // walk down to the message holding the leaf field
+  const google::protobuf::Message *msg = &_msg;
+  for (size_t i = 0; i + 1 < this->path.size(); ++i)
+  {
+    auto ref = msg->GetReflection();
+    auto field = this->path[i].first;
+    const int index = this->path[i].second;
+    if (index < 0)
+    {
+      msg = &ref->GetMessage(*msg, field);
+    }
+    else
+    {
+      if (index >= ref->FieldSize(*msg, field))
+        return false;
+      msg = &ref->GetRepeatedMessage(*msg, field, index);
+    }
+  }
+
+  auto ref = msg->GetReflection();
+  auto field = this->path.back().first;
+  const int index = this->path.back().second;
+  if (index >= 0 && index >= ref->FieldSize(*msg, field))
+    return false;
+
+  switch (field->type())
+  {
+    case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+      _value = index < 0 ? ref->GetDouble(*msg, field) :
+          ref->GetRepeatedDouble(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_FLOAT:
+      _value = index < 0 ? ref->GetFloat(*msg, field) :
+          ref->GetRepeatedFloat(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_INT64:
+      _value = index < 0 ? ref->GetInt64(*msg, field) :
+          ref->GetRepeatedInt64(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_UINT64:
+      _value = index < 0 ? ref->GetUInt64(*msg, field) :
+          ref->GetRepeatedUInt64(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_INT32:
+      _value = index < 0 ? ref->GetInt32(*msg, field) :
+          ref->GetRepeatedInt32(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_UINT32:
+      _value = index < 0 ? ref->GetUInt32(*msg, field) :
+          ref->GetRepeatedUInt32(*msg, field, index);
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_BOOL:
+      _value = static_cast<int>(index < 0 ? ref->GetBool(*msg, field) :
+          ref->GetRepeatedBool(*msg, field, index));
+      return true;
+    case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
+      break;
+    default:
+      return false;
+  }
+
+  const google::protobuf::Message &valueMsg = index < 0 ?
+      ref->GetMessage(*msg, field) :
+      ref->GetRepeatedMessage(*msg, field, index);
+
+  switch (this->leaf)
+  {
+    case TIME:
+    {
+      auto timeMsg = dynamic_cast<const msgs::Time *>(&valueMsg);
+      if (!timeMsg)
+        return false;
+      _value = msgs::Convert(*timeMsg).Double();
+      return true;
+    }
+    case VECTOR3_X:
+    case VECTOR3_Y:
+    case VECTOR3_Z:
+    {
+      auto vecMsg = dynamic_cast<const msgs::Vector3d *>(&valueMsg);
+      if (!vecMsg)
+        return false;
+      _value = this->leaf == VECTOR3_X ? vecMsg->x() :
+          this->leaf == VECTOR3_Y ? vecMsg->y() : vecMsg->z();
+      return true;
+    }
+    case ROLL:
+    case PITCH:
+    case YAW:
+    {
+      auto quatMsg = dynamic_cast<const msgs::Quaternion *>(&valueMsg);
+      if (!quatMsg)
+        return false;
+      ignition::math::Vector3d rpy = msgs::ConvertIgn(*quatMsg).Euler();
+      _value = this->leaf == ROLL ? rpy.X() :
+          this->leaf == PITCH ? rpy.Y() : rpy.Z();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicCurveDecimator::Add(const ignition::math::Vector2d &_point,
+    std::vector<ignition::math::Vector2d> &_points)
+{
+  // close the interval once x leaves it, or goes back after a reset
+  if (this->count > 0 &&
+      (_point.X() >= this->start + Period || _point.X() < this->start))
+  {
+    this->Flush(_points);
+  }
+
+  if (this->count == 0)
+  {
+    this->start = _point.X();
+    this->min = _point;
+    this->max = _point;
+    this->minLast = false;
+  }
+  else if (_point.Y() < this->min.Y())
+  {
+    this->min = _point;
+    this->minLast = true;
+  }
+  else if (_point.Y() > this->max.Y())
+  {
+    this->max = _point;
+    this->minLast = false;
+  }
+  ++this->count;
+}
+
+/////////////////////////////////////////////////
+void TopicCurveDecimator::Flush(std::vector<ignition::math::Vector2d> &_points)
+{
+  if (this->count == 0)
+    return;
+
+  if (this->count == 1 || this->min == this->max)
+  {
+    _points.push_back(this->min);
+  }
+  else if (this->minLast)
+  {
+    _points.push_back(this->max);
+    _points.push_back(this->min);
+  }
+  else
+  {
+    _points.push_back(this->min);
+    _points.push_back(this->max);
+  }
+  this->count = 0;
+}
+
 /////////////////////////////////////////////////
 TopicCurve::TopicCurve(const std::string &_topic)
 {
@@ -191,6 +589,33 @@ TopicCurve::TopicCurve(const std::string &_topic)
     return;
   }
 
+  this->msg = msgs::MsgFactory::NewMsg(this->msgType);
+  if (!this->msg)
+  {
+    gzwarn << "Couldn't create message of type [" << this->msgType << "]"
+        << std::endl;
+    return;
+  }
+
+  // Check if message has timestamp and use it if it exists and is
+  // a top level msg field.
+  // TODO x axis is hardcoded to be the sim time for now. Once it is
+  // configurable, remove this logic for setting the x value
+  auto descriptor = this->msg->GetDescriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i)
+  {
+    auto field = descriptor->field(i);
+    if ((field->name() == "stamp" || field->name() == "time") &&
+        field->type() == google::protobuf::FieldDescriptor::TYPE_MESSAGE &&
+        !field->is_repeated() && field->message_type()->name() == "Time")
+    {
+      this->stampField = field;
+      break;
+    }
+  }
+
+  this->thread = std::thread(&TopicCurve::Run, this);
+
   this->subscriber = this->node->Subscribe(
       this->topic, &TopicCurve::OnTopicData, this);
 }
@@ -200,6 +625,14 @@ TopicCurve::~TopicCurve()
 {
   this->subscriber.reset();
   this->node.reset();
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stop = true;
+  }
+  this->queueCondition.notify_all();
+  if (this->thread.joinable())
+    this->thread.join();
 }
 
 /////////////////////////////////////////////////
@@ -225,17 +658,22 @@ bool TopicCurve::AddCurve(const std::string &_name, PlotCurveWeakPtr _curve)
   auto it = this->curves.find(topicQueryStr);
   if (it == this->curves.end())
   {
-    // create entry in map
-    CurveVariableSet curveSet;
-    curveSet.insert(_curve);
-    this->curves[topicQueryStr] = curveSet;
+    // create entry in map and resolve the field path once
+    TopicCurveField &field = this->curves[topicQueryStr];
+    field.curves.insert(_curve);
+    if (this->msg && !field.accessor.Compile(this->msg->GetDescriptor(),
+        topicQueryStr))
+    {
+      gzwarn << "Field '" << topicQueryStr << "' can't be plotted from "
+          << "topic [" << this->topic << "]" << std::endl;
+    }
   }
   else
   {
-    auto cIt = it->second.find(_curve);
-    if (cIt == it->second.end())
+    auto cIt = it->second.curves.find(_curve);
+    if (cIt == it->second.curves.end())
     {
-      it->second.insert(_curve);
+      it->second.curves.insert(_curve);
     }
   }
   return true;
@@ -252,11 +690,11 @@ bool TopicCurve::RemoveCurve(PlotCurveWeakPtr _curve)
 
   for (auto it = this->curves.begin(); it != this->curves.end(); ++it)
   {
-    auto cIt = it->second.find(_curve);
-    if (cIt != it->second.end())
+    auto cIt = it->second.curves.find(_curve);
+    if (cIt != it->second.curves.end())
     {
-      it->second.erase(cIt);
-      if (it->second.empty())
+      it->second.curves.erase(cIt);
+      if (it->second.curves.empty())
       {
         this->curves.erase(it);
       }
@@ -273,7 +711,7 @@ bool TopicCurve::HasCurve(PlotCurveWeakPtr _curve) const
   std::lock_guard<std::mutex> lock(this->mutex);
   for (const auto &it : this->curves)
   {
-    if (it.second.find(_curve) != it.second.end())
+    if (it.second.curves.find(_curve) != it.second.curves.end())
       return true;
   }
 
@@ -286,239 +724,102 @@ unsigned int TopicCurve::CurveCount() const
   std::lock_guard<std::mutex> lock(this->mutex);
   unsigned int count = 0;
   for (const auto &it : this->curves)
-    count += it.second.size();
+    count += it.second.curves.size();
   return count;
 }
 
 /////////////////////////////////////////////////
 void TopicCurve::OnTopicData(const std::string &_msg)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-
-  if (this->curves.empty())
-    return;
-
-  auto msg = msgs::MsgFactory::NewMsg(this->msgType);
-  msg->ParseFromString(_msg);
-
-  // stores a list of curve iterators and their new values
-  std::vector<std::pair<TopicCurve::CurveVariableMapIt,
-      ignition::math::Vector2d> > curvesUpdates;
-
   // nearest sim time - use this x value if the message is not timestamped
   double x = TopicTime::Instance()->LastSimTime().Double();
 
-  // collect updates
-  this->UpdateCurve(msg.get(), 0, x, curvesUpdates);
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  if (this->queue.size() >= MaxQueueSize)
+    return;
 
-  // update curves!
-  for (auto &curveUpdate : curvesUpdates)
+  this->queue.push_back(std::make_pair(_msg, x));
+  this->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void TopicCurve::Run()
+{
+  std::vector<std::pair<std::string, double> > batch;
+  while (true)
   {
-    for (auto &cIt : curveUpdate.first->second)
     {
-      auto curve = cIt.lock();
-      if (!curve)
-        continue;
-
-      curve->AddPoint(curveUpdate.second);
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->queueCondition.wait(lock,
+          [this]{return this->stop || !this->queue.empty();});
+      if (this->stop)
+        return;
+      batch.swap(this->queue);
     }
+
+    this->ProcessBatch(batch);
+    batch.clear();
+
+    // let messages accumulate, curves are redrawn at a much lower rate
+    // than high rate topics are published
+    std::unique_lock<std::mutex> lock(this->queueMutex);
+    this->queueCondition.wait_for(lock, std::chrono::milliseconds(20),
+        [this]{return this->stop;});
   }
 }
 
 /////////////////////////////////////////////////
-void TopicCurve::UpdateCurve(google::protobuf::Message *_msg,
-    const int _index, const double x,
-    std::vector<std::pair<TopicCurve::CurveVariableMapIt,
-    ignition::math::Vector2d> > &_curvesUpdates)
+void TopicCurve::ProcessBatch(
+    const std::vector<std::pair<std::string, double> > &_batch)
 {
-  if (!_msg)
-  {
-    GZ_ASSERT(_msg,
-        "_msg pointer in TopicCurve::UpdateCurve should not be null");
-  }
-
-  auto ref = _msg->GetReflection();
-  if (!ref)
-    return;
+  std::lock_guard<std::mutex> lock(this->mutex);
 
-  auto descriptor = _msg->GetDescriptor();
-  if (!descriptor)
+  if (this->curves.empty())
     return;
 
-  // x axis data
-  double xData = x;
-
-  for (int i = 0; i < descriptor->field_count(); ++i)
+  for (const auto &data : _batch)
   {
-    auto field = descriptor->field(i);
-    if (!field)
+    if (!this->msg->ParsePartialFromString(data.first))
       continue;
 
-    std::string fieldName = field->name();
+    // x axis data
+    double x = data.second;
+    if (this->stampField)
+    {
+      auto stamp = dynamic_cast<const msgs::Time *>(
+          &this->msg->GetReflection()->GetMessage(*this->msg,
+          this->stampField));
+      if (stamp)
+        x = msgs::Convert(*stamp).Double();
+    }
 
-    // Check if message has timestamp and use it if it exists and is
-    // a top level msg field.
-    // TODO x axis is hardcoded to be the sim time for now. Once it is
-    // configurable, remove this logic for setting the x value
-    if (_index == 0 && (fieldName == "stamp" || fieldName == "time") &&
-        field->type() == google::protobuf::FieldDescriptor::TYPE_MESSAGE &&
-        !field->is_repeated())
+    for (auto &field : this->curves)
     {
-      auto valueMsg = ref->MutableMessage(_msg, field);
-      if (field->message_type()->name() == "Time")
+      double value;
+      if (field.second.accessor.Value(*this->msg, value))
       {
-        msgs::Time *msg = dynamic_cast<msgs::Time *>(valueMsg);
-        if (msg)
-        {
-          common::Time time = msgs::Convert(*msg);
-          xData = time.Double();
-        }
+        field.second.decimator.Add(ignition::math::Vector2d(x, value),
+            field.second.points);
       }
     }
+  }
 
-    // loop through all the topic param name + curve pairs
-    for (auto cIt = this->curves.begin(); cIt != this->curves.end(); ++cIt)
-    {
-      // parse param to get field at current index
-      std::string topicField;
-
-      std::string query = cIt->first;
-
-      // tokenize query, e.g. ?p=sim_time -> [?p, sim_time]
-      std::vector<std::string> queryTokens = common::split(query, "=/");
-
-      // skip ?p
-      unsigned int queryIndex = _index + 1;
-
-      if (queryTokens.size() < 2 || queryTokens.size() <= queryIndex)
-        continue;
-
-      topicField = queryTokens[queryIndex];
+  // update curves!
+  for (auto &field : this->curves)
+  {
+    field.second.decimator.Flush(field.second.points);
+    if (field.second.points.empty())
+      continue;
 
-      double data = 0;
-      bool addData = true;
-      if (topicField != fieldName)
+    for (auto &cIt : field.second.curves)
+    {
+      auto curve = cIt.lock();
+      if (!curve)
         continue;
 
-      switch (field->type())
-      {
-        case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
-        {
-          data = ref->GetDouble(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_FLOAT:
-        {
-          data = ref->GetFloat(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_INT64:
-        {
-          data = ref->GetInt64(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_UINT64:
-        {
-          data = ref->GetUInt64(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_INT32:
-        {
-          data = ref->GetInt32(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_UINT32:
-        {
-          data = ref->GetUInt32(*_msg, field);
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_BOOL:
-        {
-          data = static_cast<int>(ref->GetBool(*_msg, field));
-          break;
-        }
-        case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
-        {
-          auto valueMsg = ref->MutableMessage(_msg, field);
-
-          if (field->message_type()->name() == "Time")
-          {
-            msgs::Time *msg = dynamic_cast<msgs::Time *>(valueMsg);
-
-            if (!msg)
-              continue;
-
-             common::Time time = msgs::Convert(*msg);
-             data = time.Double();
-          }
-          else if (field->message_type()->name() == "Vector3d")
-          {
-            msgs::Vector3d *msg = dynamic_cast<msgs::Vector3d *>(valueMsg);
-
-            if (!msg)
-              continue;
-
-            ignition::math::Vector3d vec = msgs::ConvertIgn(*msg);
-
-            // parse param to get x, y, or z at leaf of query
-            std::string elem = query.substr(query.size()-1);
-            if (elem == "x")
-            {
-              data = vec.X();
-            }
-            else if (elem == "y")
-            {
-              data = vec.Y();
-            }
-            else if (elem == "z")
-            {
-              data = vec.Z();
-            }
-            else
-              continue;
-          }
-          else if (field->message_type()->name() == "Quaternion")
-          {
-            msgs::Quaternion *msg =
-                dynamic_cast<msgs::Quaternion *>(valueMsg);
-
-            if (!msg)
-              continue;
-
-            ignition::math::Quaterniond quat = msgs::ConvertIgn(*msg);
-
-            // parse query to get roll, pitch, or yaw at leaf of uri
-            ignition::math::Vector3d rpy = quat.Euler();
-            if (query.find("roll") != std::string::npos)
-              data = rpy.X();
-            else if (query.find("pitch") != std::string::npos)
-              data = rpy.Y();
-            else if (query.find("yaw") != std::string::npos)
-              data = rpy.Z();
-            else
-              continue;
-          }
-          else
-          {
-            this->UpdateCurve(valueMsg, _index + 1, xData, _curvesUpdates);
-            addData = false;
-          }
-          break;
-        }
-        default:
-        {
-          continue;
-        }
-      // end switch
-      }
-
-      // push to tmp list and update later
-      if (addData)
-      {
-        _curvesUpdates.push_back(
-            std::make_pair(cIt, ignition::math::Vector2d(xData, data)));
-      }
+      curve->AddPoints(field.second.points);
     }
+    field.second.points.clear();
   }
 }
 
@@ -63,5 +63,65 @@ void TopicCurveHandler_TEST::AddRemoveCurve()
   QCOMPARE(handler.CurveCount(), 0u);
 }
 
+/////////////////////////////////////////////////
+void TopicCurveHandler_TEST::UpdateCurve()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  // advertise a timestamped topic with a repeated field
+  gazebo::transport::NodePtr node(new gazebo::transport::Node());
+  node->Init();
+  gazebo::transport::PublisherPtr pub =
+      node->Advertise<gazebo::msgs::PosesStamped>("~/plot_test");
+
+  gazebo::gui::TopicCurveHandler handler;
+  gazebo::gui::PlotCurvePtr positionCurve(
+      new gazebo::gui::PlotCurve("position"));
+  handler.AddCurve("/gazebo/default/plot_test?p=/pose[1]/position/y",
+      positionCurve);
+  gazebo::gui::PlotCurvePtr yawCurve(new gazebo::gui::PlotCurve("yaw"));
+  handler.AddCurve("/gazebo/default/plot_test?p=/pose[0]/orientation/yaw",
+      yawCurve);
+  gazebo::gui::PlotCurvePtr missingCurve(
+      new gazebo::gui::PlotCurve("missing"));
+  handler.AddCurve("/gazebo/default/plot_test?p=/pose[5]/position/y",
+      missingCurve);
+  QCOMPARE(handler.CurveCount(), 3u);
+  QVERIFY(pub->WaitForConnection(gazebo::common::Time(5, 0)));
+
+  // publish messages 10 ms apart
+  const unsigned int count = 50;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    gazebo::msgs::PosesStamped msg;
+    gazebo::msgs::Set(msg.mutable_time(), gazebo::common::Time(i * 0.01));
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+      gazebo::msgs::Set(msg.add_pose(), ignition::math::Pose3d(
+          0, i + j, 0, 0, 0, 0.01 * i));
+    }
+    pub->Publish(msg);
+  }
+
+  for (unsigned int i = 0; i < 50 && positionCurve->Size() < count; ++i)
+    gazebo::common::Time::MSleep(100);
+
+  // the message stamps are used as x values
+  QCOMPARE(positionCurve->Size(), count);
+  QCOMPARE(yawCurve->Size(), count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    QVERIFY(ignition::math::equal(positionCurve->Point(i).X(), i * 0.01));
+    QVERIFY(ignition::math::equal(positionCurve->Point(i).Y(), i + 1.0));
+    QVERIFY(ignition::math::equal(yawCurve->Point(i).Y(), 0.01 * i, 1e-6));
+  }
+
+  // repeated indices out of range don't produce points
+  QCOMPARE(missingCurve->Size(), 0u);
+}
+
 // Generate a main function for the test
 QTEST_MAIN(TopicCurveHandler_TEST)
@@ -27,5 +27,8 @@ class TopicCurveHandler_TEST : public QTestFixture
 
   /// \brief Test adding and removing curves
   private slots: void AddRemoveCurve();
+
+  /// \brief Test plotting fields of published messages
+  private slots: void UpdateCurve();
 };
 #endif
@@ -17,6 +17,9 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
@@ -35,9 +38,63 @@
 
 #include "gazebo/transport/Node.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Skeleton animation resolved for each bone of the skin,
+    /// indexed by bone handle, so that playing it doesn't look bones up by
+    /// name.
+    class ActorAnimationBones
+    {
+      /// \brief Animation the bones were resolved for.
+      public: common::SkeletonAnimation *animation = nullptr;
+
+      /// \brief Animation of each bone, null if the bone isn't animated.
+      public: std::vector<common::NodeAnimation *> nodes;
+
+      /// \brief Translation aligning each BVH bone to the skin.
+      public: std::vector<ignition::math::Matrix4d> translationAligners;
+
+      /// \brief Rotation aligning each BVH bone to the skin.
+      public: std::vector<ignition::math::Matrix4d> rotationAligners;
+
+      /// \brief Handle of the root bone.
+      public: unsigned int root = 0;
+
+      /// \brief Name of the animation node of the root bone.
+      public: std::string rootNode;
+    };
+  }
+}
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
+  /// \brief Pose update evaluated by Actor::UpdateAnimation, which
+  /// Actor::Update applies.
+  public: enum PendingUpdate
+          {
+            /// \brief Nothing to apply.
+            NO_UPDATE,
+
+            /// \brief Only the model pose changes.
+            MODEL_UPDATE,
+
+            /// \brief The model and bone poses change.
+            SKELETON_UPDATE
+          };
+
+  /// \brief Resolve the bones of a skeleton animation.
+  /// \param[in] _skeleton Skeleton of the skin.
+  /// \param[in] _animation Skeleton animation.
+  /// \param[in] _skelMap Animation node names, indexed by skin node name.
+  /// \param[out] _bones Resolved bones.
+  public: void ResolveBones(common::Skeleton *_skeleton,
+              common::SkeletonAnimation *_animation,
+              const std::map<std::string, std::string> &_skelMap,
+              ActorAnimationBones &_bones) const;
+
   /// \brief True if the animation is loaded from BVH file
   public: bool bvhFile = false;
 
@@ -48,12 +105,99 @@ class gazebo::physics::ActorPrivate
   /// \brief Rotations to align BVH skeleton to DAE skin
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
+
+  /// \brief Resolved bones of each skeleton animation, indexed by
+  /// animation name.
+  public: std::map<std::string, ActorAnimationBones> animationBones;
+
+  /// \brief Skin bones, indexed by handle.
+  public: std::vector<common::SkeletonNode *> bones;
+
+  /// \brief Link of each bone.
+  public: std::vector<LinkPtr> boneLinks;
+
+  /// \brief Link of the parent of each bone, null for the root.
+  public: std::vector<LinkPtr> parentLinks;
+
+  /// \brief Transform of each bone relative to its parent, as evaluated
+  /// last. The root transform is in the world frame.
+  public: std::vector<ignition::math::Matrix4d> boneFrame;
+
+  /// \brief Model pose evaluated last.
+  public: ignition::math::Pose3d modelPose;
+
+  /// \brief Sim time of the frame evaluated last, in seconds.
+  public: double frameTime = 0.0;
+
+  /// \brief True if UpdateAnimation ran since the last Update.
+  public: bool evaluated = false;
+
+  /// \brief Update to apply.
+  public: PendingUpdate pending = NO_UPDATE;
+
+  /// \brief Publisher of the packed skeleton poses.
+  public: transport::PublisherPtr packedPosePub;
+
+  /// \brief Packed skeleton pose message, reused.
+  public: msgs::PackedSkeletonPose packedPoseMsg;
 };
 
 using namespace gazebo;
 using namespace physics;
 using namespace common;
 
+//////////////////////////////////////////////////
+/// \brief Append a pose to a packed field, as seven floats.
+/// \param[in] _pose Pose to append.
+/// \param[out] _field Packed field.
+static void AddPackedPose(const ignition::math::Pose3d &_pose,
+    google::protobuf::RepeatedField<float> *_field)
+{
+  _field->Add(static_cast<float>(_pose.Pos().X()));
+  _field->Add(static_cast<float>(_pose.Pos().Y()));
+  _field->Add(static_cast<float>(_pose.Pos().Z()));
+  _field->Add(static_cast<float>(_pose.Rot().W()));
+  _field->Add(static_cast<float>(_pose.Rot().X()));
+  _field->Add(static_cast<float>(_pose.Rot().Y()));
+  _field->Add(static_cast<float>(_pose.Rot().Z()));
+}
+
+//////////////////////////////////////////////////
+void ActorPrivate::ResolveBones(Skeleton *_skeleton,
+    SkeletonAnimation *_animation,
+    const std::map<std::string, std::string> &_skelMap,
+    ActorAnimationBones &_bones) const
+{
+  const unsigned int count = _skeleton->GetNumNodes();
+  _bones.animation = _animation;
+  _bones.nodes.assign(count, nullptr);
+  _bones.translationAligners.assign(count,
+      ignition::math::Matrix4d::Identity);
+  _bones.rotationAligners.assign(count, ignition::math::Matrix4d::Identity);
+  _bones.root = _skeleton->GetRootNode()->GetHandle();
+  _bones.rootNode.clear();
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    auto name = _skelMap.find(_skeleton->GetNodeByHandle(i)->GetName());
+    if (name == _skelMap.end())
+      continue;
+
+    if (i == _bones.root)
+      _bones.rootNode = name->second;
+
+    _bones.nodes[i] = _animation->NodeAnimationByName(name->second);
+
+    auto aligner = this->translationAligner.find(name->second);
+    if (aligner != this->translationAligner.end())
+      _bones.translationAligners[i] = aligner->second;
+
+    aligner = this->rotationAligner.find(name->second);
+    if (aligner != this->rotationAligner.end())
+      _bones.rotationAligners[i] = aligner->second;
+  }
+}
+
 //////////////////////////////////////////////////
 Actor::Actor(BasePtr _parent)
   : Model(_parent), dataPtr(new ActorPrivate)
@@ -68,6 +212,7 @@ Actor::Actor(BasePtr _parent)
 Actor::~Actor()
 {
   this->bonePosePub.reset();
+  this->dataPtr->packedPosePub.reset();
   this->customTrajectoryInfo.reset();
 
   this->skelAnimation.clear();
@@ -157,6 +302,9 @@ void Actor::Load(sdf::ElementPtr _sdf)
   // Advertise skeleton pose info
   this->bonePosePub = this->node->Advertise<msgs::PoseAnimation>(
                                        "~/skeleton_pose/info", 10);
+  this->dataPtr->packedPosePub =
+      this->node->Advertise<msgs::PackedSkeletonPose>(
+      "~/skeleton_pose/packed/info", 10);
 }
 
 //////////////////////////////////////////////////
@@ -667,6 +815,25 @@ bool Actor::IsActive() const
 ///////////////////////////////////////////////////
 void Actor::Update()
 {
+  if (!this->dataPtr->evaluated)
+    this->UpdateAnimation();
+  this->dataPtr->evaluated = false;
+
+  const ActorPrivate::PendingUpdate pending = this->dataPtr->pending;
+  this->dataPtr->pending = ActorPrivate::NO_UPDATE;
+
+  if (pending == ActorPrivate::MODEL_UPDATE)
+    this->SetWorldPose(this->dataPtr->modelPose);
+  else if (pending == ActorPrivate::SKELETON_UPDATE)
+    this->SetPose(this->dataPtr->frameTime);
+}
+
+///////////////////////////////////////////////////
+void Actor::UpdateAnimation()
+{
+  this->dataPtr->evaluated = true;
+  this->dataPtr->pending = ActorPrivate::NO_UPDATE;
+
   if (!this->active)
     return;
 
@@ -733,13 +900,13 @@ void Actor::Update()
 
   // Update global trajectory (not skeleton animation)
   ignition::math::Pose3d modelPose;
-  if (!this->customTrajectoryInfo &&
-      this->trajectories.find(tinfo->id) != this->trajectories.end())
+  auto trajectory = this->trajectories.find(tinfo->id);
+  if (!this->customTrajectoryInfo && trajectory != this->trajectories.end())
   {
     // Get the pose keyframe calculated for this script time
     common::PoseKeyFrame posFrame(0.0);
-    this->trajectories[tinfo->id]->SetTime(this->scriptTime);
-    this->trajectories[tinfo->id]->GetInterpolatedKeyFrame(posFrame);
+    trajectory->second->SetTime(this->scriptTime);
+    trajectory->second->GetInterpolatedKeyFrame(posFrame);
 
     modelPose.Pos() = posFrame.Translation();
     modelPose.Rot() = posFrame.Rotation();
@@ -754,51 +921,63 @@ void Actor::Update()
     else
     {
       auto frame0 = dynamic_cast<common::PoseKeyFrame *>
-        (this->trajectories[tinfo->id]->GetKeyFrame(0));
+        (trajectory->second->GetKeyFrame(0));
       ignition::math::Vector3d vector3Ign = frame0->Translation();
       this->pathLength = modelPose.Pos().Distance(vector3Ign);
     }
     this->lastPos = modelPose.Pos();
   }
 
-  SkeletonAnimation *skelAnim = this->skelAnimation[tinfo->type];
+  auto animIter = this->skelAnimation.find(tinfo->type);
+  SkeletonAnimation *skelAnim = animIter != this->skelAnimation.end() ?
+      animIter->second : nullptr;
 
   // If there's no skeleton animation, we just update the global pose
   if (!skelAnim)
   {
-    this->SetWorldPose(modelPose);
+    this->dataPtr->modelPose = modelPose;
+    this->dataPtr->pending = ActorPrivate::MODEL_UPDATE;
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
+  // Resolve the bones the first time the animation plays
+  ActorAnimationBones &bones = this->dataPtr->animationBones[tinfo->type];
+  if (bones.animation != skelAnim)
+  {
+    this->dataPtr->ResolveBones(this->skeleton, skelAnim,
+        this->skelNodesMap[tinfo->type], bones);
+  }
 
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
+  const unsigned int boneCount = bones.nodes.size();
+  if (this->dataPtr->bones.size() != boneCount)
   {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
+    this->dataPtr->bones.resize(boneCount);
+    this->dataPtr->boneLinks.resize(boneCount);
+    this->dataPtr->parentLinks.resize(boneCount);
+    for (unsigned int i = 0; i < boneCount; ++i)
     {
-      frame = skelAnim->PoseAt(this->scriptTime);
+      SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+      this->dataPtr->bones[i] = bone;
+      this->dataPtr->boneLinks[i] = this->GetChildLink(bone->GetName());
+      this->dataPtr->parentLinks[i] = bone->GetParent() ?
+          this->GetChildLink(bone->GetParent()->GetName()) : LinkPtr();
     }
   }
-  else
+
+  double time = this->scriptTime;
+  auto interpolateXIter = this->interpolateX.find(tinfo->type);
+  if (!this->customTrajectoryInfo &&
+      interpolateXIter != this->interpolateX.end() &&
+      interpolateXIter->second && trajectory != this->trajectories.end())
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    time = skelAnim->TimeAtX(this->pathLength, bones.rootNode);
   }
 
   this->lastTraj = tinfo->id;
 
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  if (bones.nodes[bones.root])
+    rootTrans = bones.nodes[bones.root]->FrameAt(time);
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -839,20 +1018,67 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  // Transform of each bone relative to its parent
+  std::vector<ignition::math::Matrix4d> &frame = this->dataPtr->boneFrame;
+  frame.resize(boneCount);
+  for (unsigned int i = 0; i < boneCount; ++i)
+  {
+    SkeletonNode *bone = this->dataPtr->bones[i];
+    if (i != bones.root && !bones.nodes[i])
+    {
+      frame[i] = bone->Transform();
+      continue;
+    }
+
+    ignition::math::Matrix4d transform =
+        i == bones.root ? rootM : bones.nodes[i]->FrameAt(time);
+
+    if (this->dataPtr->bvhFile)
+    {
+      if (i != bones.root)
+      {
+        ignition::math::Vector3d bvhOffset = transform.Translation();
+        ignition::math::Vector3d daeOffset = bone->Transform().Translation();
+        // scale bvh offset to dae link length
+        transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
+      }
+
+      transform = bones.translationAligners[i] * transform *
+          bones.rotationAligners[i];
+    }
+    frame[i] = transform;
+  }
 
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->dataPtr->frameTime = currentTime.Double();
+  this->dataPtr->pending = ActorPrivate::SKELETON_UPDATE;
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::SetPose(const double _time)
 {
+  // Only build the messages for subscribers
+  const bool publish = this->bonePosePub &&
+      this->bonePosePub->HasConnections();
+  const bool publishPacked = this->dataPtr->packedPosePub &&
+      this->dataPtr->packedPosePub->HasConnections();
+
   msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  if (publish)
+  {
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
+
+  msgs::PackedSkeletonPose &packedMsg = this->dataPtr->packedPoseMsg;
+  if (publishPacked)
+  {
+    packedMsg.set_visual_id(this->visualId);
+    msgs::Set(packedMsg.mutable_time(), common::Time(_time));
+    packedMsg.clear_bone_pose();
+    packedMsg.clear_id();
+    packedMsg.clear_pose();
+  }
 
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
 
   if (this->customTrajectoryInfo)
@@ -861,41 +1087,12 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     mainLinkPose.Rot() = this->worldPose.Rot();
   }
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  for (unsigned int i = 0; i < this->dataPtr->boneFrame.size(); ++i)
   {
-    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
-    ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
-
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
-    {
-      if (this->dataPtr->bvhFile)
-      {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
-
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
-        {
-          ignition::math::Vector3d bvhOffset = transform.Translation();
-          ignition::math::Vector3d daeOffset = bone->Transform().Translation();
-          // scale bvh offset to dae link length
-          transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
-        }
-
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
-      }
-    }
-    else
-    {
-      transform = bone->Transform();
-    }
+    SkeletonNode *bone = this->dataPtr->bones[i];
+    ignition::math::Matrix4d transform = this->dataPtr->boneFrame[i];
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
+    const LinkPtr &currentLink = this->dataPtr->boneLinks[i];
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
@@ -904,59 +1101,89 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
-
-    if (!parentBone)
+    if (!bone->GetParent())
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
+      if (publish)
+      {
+        msgs::Pose *bone_pose = msg.add_pose();
+        bone_pose->set_name(bone->GetName());
+        bone_pose->mutable_position()->CopyFrom(
+            msgs::Convert(ignition::math::Vector3d()));
+        bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
+            ignition::math::Quaterniond()));
+      }
+      if (publishPacked)
+      {
+        AddPackedPose(ignition::math::Pose3d::Zero,
+            packedMsg.mutable_bone_pose());
+      }
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
+      if (publish)
+      {
+        msgs::Pose *bone_pose = msg.add_pose();
+        bone_pose->set_name(bone->GetName());
+        bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
+        bone_pose->mutable_orientation()->CopyFrom(
+            msgs::Convert(bonePose.Rot()));
+      }
+      if (publishPacked)
+        AddPackedPose(bonePose, packedMsg.mutable_bone_pose());
+      ignition::math::Matrix4d parentTrans(
+          this->dataPtr->parentLinks[i]->WorldPose());
       transform = parentTrans * transform;
     }
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
+    if (publish || publishPacked)
+    {
+      ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
+      if (publish)
+      {
+        msgs::Pose *link_pose = msg.add_pose();
+        link_pose->set_name(currentLink->GetScopedName());
+        link_pose->set_id(currentLink->GetId());
+        link_pose->mutable_position()->CopyFrom(
+            msgs::Convert(linkPose.Pos()));
+        link_pose->mutable_orientation()->CopyFrom(
+            msgs::Convert(linkPose.Rot()));
+      }
+      if (publishPacked)
+      {
+        packedMsg.add_id(currentLink->GetId());
+        AddPackedPose(linkPose, packedMsg.mutable_pose());
+      }
+    }
     currentLink->SetWorldPose(transform.Pose(), true, false);
   }
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
+  const ignition::math::Pose3d &modelPose =
+      this->customTrajectoryInfo ? this->worldPose : mainLinkPose;
 
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
+  if (publish)
   {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    model_pose->mutable_position()->CopyFrom(msgs::Convert(modelPose.Pos()));
     model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
+        msgs::Convert(modelPose.Rot()));
+
+    this->bonePosePub->Publish(msg);
   }
-  else
+
+  if (publishPacked)
   {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
+    packedMsg.add_id(this->GetId());
+    AddPackedPose(modelPose, packedMsg.mutable_pose());
+    this->dataPtr->packedPosePub->Publish(packedMsg);
   }
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
-    this->bonePosePub->Publish(msg);
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
@@ -111,9 +111,17 @@ namespace gazebo
       /// \return True if animation is being played.
       public: virtual bool IsActive() const;
 
-      /// \brief Update the actor
+      /// \brief Update the actor. This applies the frame evaluated by
+      /// UpdateAnimation, evaluating it first if needed.
       public: void Update();
 
+      /// \brief Evaluate the trajectory and skeleton animation at the
+      /// current time, without moving the actor. This only touches the
+      /// state of this actor, so the world evaluates its actors in parallel
+      /// before updating them in order.
+      /// \sa Update
+      public: void UpdateAnimation();
+
       /// \brief Finalize the actor
       public: virtual void Fini();
 
@@ -277,15 +285,11 @@ namespace gazebo
       /// \param[in] _sdf SDF element containing the trajectory script.
       private: void LoadScript(sdf::ElementPtr _sdf);
 
-      /// \brief Set the actor's pose. This sets the pose for each bone in the
-      /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
+      /// \brief Set the actor's pose from the bone transforms evaluated by
+      /// UpdateAnimation. This sets the pose for each bone in the skeleton
+      /// and also the actor's pose in the world.
       /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      private: void SetPose(const double _time);
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
@@ -15,6 +15,14 @@
  *
 */
 
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/Skeleton.hh"
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Actor.hh"
 
@@ -22,7 +30,26 @@
 
 using namespace gazebo;
 
-class ActorTest : public ServerFixture { };
+class ActorTest : public ServerFixture
+{
+  /// \brief Packed skeleton pose callback.
+  /// \param[in] _msg Skeleton pose.
+  public: void OnPackedPose(ConstPackedSkeletonPosePtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->packedPose = *_msg;
+    ++this->packedCount;
+  }
+
+  /// \brief Protects the received message.
+  protected: std::mutex mutex;
+
+  /// \brief Last packed skeleton pose received.
+  protected: msgs::PackedSkeletonPose packedPose;
+
+  /// \brief Number of packed skeleton poses received.
+  protected: unsigned int packedCount = 0;
+};
 
 //////////////////////////////////////////////////
 TEST_F(ActorTest, Load)
@@ -102,6 +129,104 @@ TEST_F(ActorTest, TrajectoryFromSDF)
   EXPECT_LT(fabs(actor->ScriptTime() - world->SimTime().Double()), 1.0 / 30);
 }
 
+//////////////////////////////////////////////////
+TEST_F(ActorTest, ParallelUpdate)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Two identical actors, which the world animates in parallel
+  std::vector<physics::ActorPtr> actors;
+  for (const std::string name : {"actor_1", "actor_2"})
+  {
+    std::ostringstream actorStr;
+    actorStr << "<sdf version='" << SDF_VERSION << "'>"
+      << "<actor name ='" << name << "'>"
+      << "  <skin><filename>walk.dae</filename></skin>"
+      << "  <animation name='walking'>"
+      << "    <filename>walk.dae</filename>"
+      << "    <interpolate_x>true</interpolate_x>"
+      << "  </animation>"
+      << "  <script>"
+      << "    <trajectory id='0' type='walking'>"
+      << "      <waypoint><time>0</time><pose>0 0 0 0 0 0</pose></waypoint>"
+      << "      <waypoint><time>5</time><pose>5 0 0 0 0 0</pose></waypoint>"
+      << "    </trajectory>"
+      << "  </script>"
+      << "</actor>"
+      << "</sdf>";
+    this->SpawnSDF(actorStr.str());
+
+    auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+        world->ModelByName(name));
+    ASSERT_TRUE(actor != nullptr);
+    actors.push_back(actor);
+  }
+
+  world->Step(1500);
+  EXPECT_GT(actors[0]->ScriptTime(), 1.0);
+  EXPECT_DOUBLE_EQ(actors[0]->ScriptTime(), actors[1]->ScriptTime());
+
+  // The bones match
+  auto links = actors[0]->GetLinks();
+  ASSERT_FALSE(links.empty());
+  EXPECT_EQ(links.size(), actors[1]->GetLinks().size());
+  for (const auto &link : links)
+  {
+    auto other = actors[1]->GetLink(link->GetName());
+    ASSERT_TRUE(other != nullptr);
+    EXPECT_EQ(link->WorldPose(), other->WorldPose());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(ActorTest, PackedSkeletonPose)
+{
+  this->Load("worlds/actor.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+      world->ModelByName("actor"));
+  ASSERT_TRUE(actor != nullptr);
+  ASSERT_TRUE(actor->Mesh() != nullptr);
+  const unsigned int boneCount =
+      actor->Mesh()->GetSkeleton()->GetNumNodes();
+
+  auto sub = this->node->Subscribe("~/skeleton_pose/packed/info",
+      &ActorTest::OnPackedPose, this);
+
+  world->Step(1000);
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->packedCount > 0)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ASSERT_GT(this->packedCount, 0u);
+
+  // Seven floats for each bone, and for each link plus the actor
+  EXPECT_EQ(static_cast<int>(7 * boneCount),
+      this->packedPose.bone_pose_size());
+  EXPECT_EQ(static_cast<int>(boneCount + 1), this->packedPose.id_size());
+  EXPECT_EQ(7 * this->packedPose.id_size(), this->packedPose.pose_size());
+
+  // Bones are moved by links of the actor, and the actor comes last
+  std::set<uint32_t> linkIds;
+  for (const auto &link : actor->GetLinks())
+    linkIds.insert(link->GetId());
+  const int last = this->packedPose.id_size() - 1;
+  for (int i = 0; i < last; ++i)
+    EXPECT_EQ(1u, linkIds.count(this->packedPose.id(i)));
+  EXPECT_EQ(actor->GetId(), this->packedPose.id(last));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
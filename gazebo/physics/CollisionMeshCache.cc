@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/physics/CollisionMeshCache.hh"
+#include "gazebo/physics/ConvexDecomposition.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the CollisionMeshData class
+    class CollisionMeshDataPrivate
+    {
+      /// \brief Vertex coordinates, three per vertex.
+      public: std::vector<float> vertices;
+
+      /// \brief Vertex indices, three per triangle.
+      public: std::vector<int> indices;
+
+      /// \brief Vertex and index count of each convex hull.
+      public: std::vector<unsigned int> hullSizes;
+
+      /// \brief Data built by physics engines, indexed by engine name.
+      public: std::map<std::string, std::shared_ptr<void>> engineData;
+
+      /// \brief Protects engineData.
+      public: std::mutex mutex;
+    };
+
+    /// \internal
+    /// \brief Private data for the CollisionMeshCache class
+    class CollisionMeshCachePrivate
+    {
+      /// \brief Cached data, indexed by key. Entries expire with the last
+      /// collision that uses them.
+      public: std::map<std::string, std::weak_ptr<CollisionMeshData>> entries;
+
+      /// \brief Number of cache hits.
+      public: uint64_t hits = 0;
+
+      /// \brief Number of cache misses.
+      public: uint64_t misses = 0;
+
+      /// \brief Protects the members above.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+CollisionMeshData::CollisionMeshData(std::vector<float> &&_vertices,
+    std::vector<int> &&_indices)
+  : dataPtr(new CollisionMeshDataPrivate)
+{
+  this->dataPtr->vertices = std::move(_vertices);
+  this->dataPtr->indices = std::move(_indices);
+}
+
+//////////////////////////////////////////////////
+CollisionMeshData::CollisionMeshData(std::vector<float> &&_vertices,
+    std::vector<int> &&_indices, std::vector<unsigned int> &&_hullSizes)
+  : CollisionMeshData(std::move(_vertices), std::move(_indices))
+{
+  this->dataPtr->hullSizes = std::move(_hullSizes);
+}
+
+//////////////////////////////////////////////////
+CollisionMeshData::~CollisionMeshData()
+{
+  // Release the engine data first, it may point into the triangles.
+  this->dataPtr->engineData.clear();
+}
+
+//////////////////////////////////////////////////
+const float *CollisionMeshData::Vertices() const
+{
+  return this->dataPtr->vertices.data();
+}
+
+//////////////////////////////////////////////////
+unsigned int CollisionMeshData::VertexCount() const
+{
+  return this->dataPtr->vertices.size() / 3;
+}
+
+//////////////////////////////////////////////////
+const int *CollisionMeshData::Indices() const
+{
+  return this->dataPtr->indices.data();
+}
+
+//////////////////////////////////////////////////
+unsigned int CollisionMeshData::IndexCount() const
+{
+  return this->dataPtr->indices.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int CollisionMeshData::HullCount() const
+{
+  return this->dataPtr->hullSizes.size() / 2;
+}
+
+//////////////////////////////////////////////////
+const unsigned int *CollisionMeshData::HullSizes() const
+{
+  return this->dataPtr->hullSizes.data();
+}
+
+//////////////////////////////////////////////////
+size_t CollisionMeshData::MemorySize() const
+{
+  return this->dataPtr->vertices.size() * sizeof(float) +
+      this->dataPtr->indices.size() * sizeof(int) +
+      this->dataPtr->hullSizes.size() * sizeof(unsigned int);
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<void> CollisionMeshData::EngineData(const std::string &_engine,
+    const std::function<std::shared_ptr<void>()> &_create)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->engineData.find(_engine);
+  if (iter != this->dataPtr->engineData.end())
+    return iter->second;
+
+  std::shared_ptr<void> data = _create();
+  this->dataPtr->engineData[_engine] = data;
+  return data;
+}
+
+//////////////////////////////////////////////////
+CollisionMeshCache::CollisionMeshCache()
+  : dataPtr(new CollisionMeshCachePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+CollisionMeshCache::~CollisionMeshCache()
+{
+}
+
+//////////////////////////////////////////////////
+CollisionMeshDataPtr CollisionMeshCache::Data(const common::Mesh *_mesh,
+    const common::SubMesh *_subMesh, const ignition::math::Vector3d &_scale,
+    const bool _centered, const unsigned int _maxConvexHulls,
+    const unsigned int _maxHullVertices)
+{
+  if (!_mesh)
+    return CollisionMeshDataPtr();
+
+  // The element counts guard against a different mesh loaded under a
+  // name that is still in use.
+  std::ostringstream stream;
+  stream.precision(17);
+  stream << _mesh->GetName() << '\n';
+  if (_subMesh)
+  {
+    stream << _subMesh->GetName() << ' ' << _centered << ' '
+           << _subMesh->GetVertexCount() << ' ' << _subMesh->GetIndexCount();
+  }
+  else
+  {
+    stream << _mesh->GetVertexCount() << ' ' << _mesh->GetIndexCount();
+  }
+  stream << '\n' << _scale.X() << ' ' << _scale.Y() << ' ' << _scale.Z();
+  if (_maxConvexHulls > 0)
+    stream << '\n' << _maxConvexHulls << ' ' << _maxHullVertices;
+  const std::string key = stream.str();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->entries.find(key);
+  if (iter != this->dataPtr->entries.end())
+  {
+    CollisionMeshDataPtr data = iter->second.lock();
+    if (data)
+    {
+      ++this->dataPtr->hits;
+      return data;
+    }
+  }
+
+  // Drop expired entries while the lock is held anyway
+  for (auto it = this->dataPtr->entries.begin();
+       it != this->dataPtr->entries.end();)
+  {
+    if (it->second.expired())
+      it = this->dataPtr->entries.erase(it);
+    else
+      ++it;
+  }
+
+  ++this->dataPtr->misses;
+  CollisionMeshDataPtr data = Build(_mesh, _subMesh, _scale,
+      _maxConvexHulls, _maxHullVertices);
+  this->dataPtr->entries[key] = data;
+  return data;
+}
+
+//////////////////////////////////////////////////
+CollisionMeshDataPtr CollisionMeshCache::Build(const common::Mesh *_mesh,
+    const common::SubMesh *_subMesh, const ignition::math::Vector3d &_scale,
+    const unsigned int _maxConvexHulls, const unsigned int _maxHullVertices)
+{
+  float *vertArr = nullptr;
+  int *indArr = nullptr;
+  unsigned int vertexCount = 0;
+  unsigned int indexCount = 0;
+
+  if (_subMesh)
+  {
+    vertexCount = _subMesh->GetVertexCount();
+    indexCount = _subMesh->GetIndexCount();
+    _subMesh->FillArrays(&vertArr, &indArr);
+  }
+  else if (_mesh)
+  {
+    // Mesh::FillArrays skips submeshes that can't hold a triangle
+    for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+    {
+      const common::SubMesh *subMesh = _mesh->GetSubMesh(i);
+      if (subMesh->GetVertexCount() <= 2)
+        continue;
+      vertexCount += subMesh->GetVertexCount();
+      indexCount += subMesh->GetIndexCount();
+    }
+    _mesh->FillArrays(&vertArr, &indArr);
+  }
+  else
+  {
+    return CollisionMeshDataPtr();
+  }
+
+  std::vector<float> vertices(vertArr, vertArr + vertexCount * 3);
+  std::vector<int> indices(indArr, indArr + indexCount);
+  delete [] vertArr;
+  delete [] indArr;
+
+  // Scale the vertex data
+  for (unsigned int j = 0; j < vertexCount; ++j)
+  {
+    vertices[j*3+0] *= _scale.X();
+    vertices[j*3+1] *= _scale.Y();
+    vertices[j*3+2] *= _scale.Z();
+  }
+
+  // Replace the triangles by convex hulls. The scale is applied first so
+  // that the hulls follow the scaled shape.
+  if (_maxConvexHulls > 0)
+  {
+    std::vector<float> hullVertices;
+    std::vector<int> hullIndices;
+    std::vector<unsigned int> hullSizes;
+    if (ConvexDecomposition(vertices, indices, _maxConvexHulls,
+          _maxHullVertices, hullVertices, hullIndices, hullSizes) > 0)
+    {
+      return CollisionMeshDataPtr(new CollisionMeshData(
+          std::move(hullVertices), std::move(hullIndices),
+          std::move(hullSizes)));
+    }
+  }
+
+  return CollisionMeshDataPtr(
+      new CollisionMeshData(std::move(vertices), std::move(indices)));
+}
+
+//////////////////////////////////////////////////
+unsigned int CollisionMeshCache::EntryCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  unsigned int count = 0;
+  for (auto const &entry : this->dataPtr->entries)
+  {
+    if (!entry.second.expired())
+      ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+size_t CollisionMeshCache::MemorySize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  size_t size = 0;
+  for (auto const &entry : this->dataPtr->entries)
+  {
+    if (CollisionMeshDataPtr data = entry.second.lock())
+      size += data->MemorySize();
+  }
+  return size;
+}
+
+//////////////////////////////////////////////////
+uint64_t CollisionMeshCache::HitCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->hits;
+}
+
+//////////////////////////////////////////////////
+uint64_t CollisionMeshCache::MissCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->misses;
+}
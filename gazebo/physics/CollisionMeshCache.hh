@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_COLLISIONMESHCACHE_HH_
+#define GAZEBO_PHYSICS_COLLISIONMESHCACHE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_PHYSICS_VISIBLE, gazebo, physics, CollisionMeshCache)
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class SubMesh;
+  }
+
+  namespace physics
+  {
+    // Forward declare private data classes.
+    class CollisionMeshDataPrivate;
+    class CollisionMeshCachePrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class CollisionMeshData CollisionMeshCache.hh physics/physics.hh
+    /// \brief Scaled triangle data of a mesh collision, shared by every
+    /// collision that uses the same mesh, submesh and scale. Physics
+    /// engines attach their acceleration structures to it with EngineData,
+    /// so that they are built once as well.
+    class GZ_PHYSICS_VISIBLE CollisionMeshData
+    {
+      /// \brief Constructor.
+      /// \param[in] _vertices Vertex coordinates, three per vertex.
+      /// \param[in] _indices Vertex indices, three per triangle.
+      public: CollisionMeshData(std::vector<float> &&_vertices,
+                  std::vector<int> &&_indices);
+
+      /// \brief Constructor for a set of convex hulls.
+      /// \param[in] _vertices Vertex coordinates, three per vertex.
+      /// \param[in] _indices Vertex indices, three per triangle.
+      /// \param[in] _hullSizes Number of vertices and number of indices of
+      /// each hull, two values per hull. See ConvexDecomposition.
+      public: CollisionMeshData(std::vector<float> &&_vertices,
+                  std::vector<int> &&_indices,
+                  std::vector<unsigned int> &&_hullSizes);
+
+      /// \brief Destructor.
+      public: ~CollisionMeshData();
+
+      /// \brief Get the vertex coordinates, three per vertex.
+      /// \return Pointer to VertexCount() * 3 floats.
+      public: const float *Vertices() const;
+
+      /// \brief Get the number of vertices.
+      /// \return Number of vertices.
+      public: unsigned int VertexCount() const;
+
+      /// \brief Get the vertex indices, three per triangle.
+      /// \return Pointer to IndexCount() indices.
+      public: const int *Indices() const;
+
+      /// \brief Get the number of indices.
+      /// \return Number of indices.
+      public: unsigned int IndexCount() const;
+
+      /// \brief Get the number of convex hulls the triangles form.
+      /// \return Number of hulls, zero if the triangles are a plain mesh.
+      public: unsigned int HullCount() const;
+
+      /// \brief Get the number of vertices and number of indices of each
+      /// convex hull, two values per hull. The vertices and triangles of a
+      /// hull follow those of the previous hull.
+      /// \return Pointer to HullCount() * 2 values.
+      public: const unsigned int *HullSizes() const;
+
+      /// \brief Get the memory used by the vertices and indices.
+      /// \return Size in bytes.
+      public: size_t MemorySize() const;
+
+      /// \brief Get data built by a physics engine from the triangles,
+      /// creating it on first use.
+      /// \param[in] _engine Name of the physics engine.
+      /// \param[in] _create Function creating the data. Called at most once
+      /// per engine while this object is alive.
+      /// \return The engine data.
+      public: std::shared_ptr<void> EngineData(const std::string &_engine,
+                  const std::function<std::shared_ptr<void>()> &_create);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<CollisionMeshDataPrivate> dataPtr;
+    };
+
+    /// \class CollisionMeshCache CollisionMeshCache.hh physics/physics.hh
+    /// \brief Process wide cache of collision mesh data. Entries are held
+    /// by the collisions that use them and released with the last one.
+    class GZ_PHYSICS_VISIBLE CollisionMeshCache
+      : public SingletonT<CollisionMeshCache>
+    {
+      /// \brief Constructor.
+      private: CollisionMeshCache();
+
+      /// \brief Destructor.
+      private: virtual ~CollisionMeshCache();
+
+      /// \brief Get the collision data of a mesh or submesh, building it
+      /// if no collision currently uses the same data.
+      /// \param[in] _mesh Mesh. Its name identifies the data.
+      /// \param[in] _subMesh Submesh of _mesh to use instead of the whole
+      /// mesh, or null.
+      /// \param[in] _scale Scale applied to the vertices.
+      /// \param[in] _centered True if _subMesh was centered at the origin.
+      /// \param[in] _maxConvexHulls If not zero, the triangles are replaced
+      /// by at most this many convex hulls. See ConvexDecomposition.
+      /// \param[in] _maxHullVertices Maximum number of vertices per hull.
+      /// \return The collision data, null if _mesh is null.
+      public: CollisionMeshDataPtr Data(const common::Mesh *_mesh,
+                  const common::SubMesh *_subMesh,
+                  const ignition::math::Vector3d &_scale,
+                  const bool _centered = false,
+                  const unsigned int _maxConvexHulls = 0,
+                  const unsigned int _maxHullVertices = 64);
+
+      /// \brief Build collision data that is not shared.
+      /// \param[in] _mesh Mesh, used if _subMesh is null.
+      /// \param[in] _subMesh Submesh, or null.
+      /// \param[in] _scale Scale applied to the vertices.
+      /// \param[in] _maxConvexHulls If not zero, the triangles are replaced
+      /// by at most this many convex hulls.
+      /// \param[in] _maxHullVertices Maximum number of vertices per hull.
+      /// \return The collision data, null if both meshes are null.
+      public: static CollisionMeshDataPtr Build(const common::Mesh *_mesh,
+                  const common::SubMesh *_subMesh,
+                  const ignition::math::Vector3d &_scale,
+                  const unsigned int _maxConvexHulls = 0,
+                  const unsigned int _maxHullVertices = 64);
+
+      /// \brief Get the number of cached entries in use.
+      /// \return Number of entries.
+      public: unsigned int EntryCount() const;
+
+      /// \brief Get the memory used by the triangles of the cached entries.
+      /// \return Size in bytes.
+      public: size_t MemorySize() const;
+
+      /// \brief Get the number of requests served from the cache.
+      /// \return Number of cache hits.
+      public: uint64_t HitCount() const;
+
+      /// \brief Get the number of requests that built new data.
+      /// \return Number of cache misses.
+      public: uint64_t MissCount() const;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<CollisionMeshCache>;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<CollisionMeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
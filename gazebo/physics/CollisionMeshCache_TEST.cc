@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/physics/CollisionMeshCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CollisionMeshCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create a mesh with a single triangle submesh.
+/// \param[in] _name Mesh name.
+/// \return The new mesh.
+std::unique_ptr<common::Mesh> TriangleMesh(const std::string &_name)
+{
+  std::unique_ptr<common::Mesh> mesh(new common::Mesh());
+  mesh->SetName(_name);
+
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetName("triangle");
+  subMesh->AddVertex(0, 0, 0);
+  subMesh->AddVertex(1, 0, 0);
+  subMesh->AddVertex(0, 2, 0);
+  subMesh->AddIndex(0);
+  subMesh->AddIndex(1);
+  subMesh->AddIndex(2);
+  mesh->AddSubMesh(subMesh);
+
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(CollisionMeshCacheTest, Share)
+{
+  physics::CollisionMeshCache *cache = physics::CollisionMeshCache::Instance();
+  std::unique_ptr<common::Mesh> mesh = TriangleMesh("cache_test_mesh");
+  const ignition::math::Vector3d scale(2, 3, 4);
+
+  EXPECT_EQ(nullptr, cache->Data(nullptr, nullptr, scale));
+
+  const unsigned int entries = cache->EntryCount();
+  const uint64_t hits = cache->HitCount();
+  const uint64_t misses = cache->MissCount();
+
+  physics::CollisionMeshDataPtr data = cache->Data(mesh.get(), nullptr, scale);
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(misses + 1, cache->MissCount());
+  EXPECT_EQ(entries + 1, cache->EntryCount());
+
+  // Vertices are scaled
+  ASSERT_EQ(3u, data->VertexCount());
+  ASSERT_EQ(3u, data->IndexCount());
+  EXPECT_FLOAT_EQ(2.0f, data->Vertices()[3]);
+  EXPECT_FLOAT_EQ(6.0f, data->Vertices()[7]);
+  EXPECT_EQ(2, data->Indices()[2]);
+  EXPECT_EQ(9 * sizeof(float) + 3 * sizeof(int), data->MemorySize());
+  EXPECT_EQ(0u, data->HullCount());
+
+  // Same mesh and scale share the data
+  physics::CollisionMeshDataPtr other =
+      cache->Data(mesh.get(), nullptr, scale);
+  EXPECT_EQ(data, other);
+  EXPECT_EQ(hits + 1, cache->HitCount());
+  EXPECT_EQ(entries + 1, cache->EntryCount());
+
+  // A different scale or a submesh is different data
+  physics::CollisionMeshDataPtr scaled =
+      cache->Data(mesh.get(), nullptr, ignition::math::Vector3d::One);
+  EXPECT_NE(data, scaled);
+  physics::CollisionMeshDataPtr sub =
+      cache->Data(mesh.get(), mesh->GetSubMesh(0), scale);
+  EXPECT_NE(data, sub);
+  EXPECT_NE(data, cache->Data(mesh.get(), mesh->GetSubMesh(0), scale, true));
+  EXPECT_EQ(entries + 3, cache->EntryCount());
+
+  // Entries are released with their last user
+  other.reset();
+  EXPECT_EQ(entries + 3, cache->EntryCount());
+  data.reset();
+  scaled.reset();
+  sub.reset();
+  EXPECT_EQ(entries, cache->EntryCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CollisionMeshCacheTest, EngineData)
+{
+  std::unique_ptr<common::Mesh> mesh = TriangleMesh("engine_test_mesh");
+  physics::CollisionMeshDataPtr data =
+      physics::CollisionMeshCache::Build(mesh.get(), nullptr,
+      ignition::math::Vector3d::One);
+  ASSERT_NE(nullptr, data);
+
+  int created = 0;
+  auto create = [&created]()
+  {
+    ++created;
+    return std::make_shared<int>(created);
+  };
+
+  std::shared_ptr<void> first = data->EngineData("engine", create);
+  std::shared_ptr<void> second = data->EngineData("engine", create);
+  EXPECT_EQ(1, created);
+  EXPECT_EQ(first, second);
+
+  data->EngineData("other", create);
+  EXPECT_EQ(2, created);
+
+  // Engine data lives as long as its users
+  std::weak_ptr<void> weak = first;
+  first.reset();
+  second.reset();
+  EXPECT_FALSE(weak.expired());
+  data.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+/////////////////////////////////////////////////
+TEST_F(CollisionMeshCacheTest, ConvexHulls)
+{
+  // The flat triangle is extruded into a prism
+  std::unique_ptr<common::Mesh> mesh = TriangleMesh("hull_test_mesh");
+  physics::CollisionMeshDataPtr data =
+      physics::CollisionMeshCache::Build(mesh.get(), nullptr,
+      ignition::math::Vector3d::One, 4, 64);
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(1u, data->HullCount());
+  EXPECT_EQ(6u, data->HullSizes()[0]);
+  EXPECT_EQ(24u, data->HullSizes()[1]);
+  EXPECT_EQ(6u, data->VertexCount());
+  EXPECT_EQ(24u, data->IndexCount());
+  EXPECT_EQ(18 * sizeof(float) + 24 * sizeof(int) + 2 * sizeof(unsigned int),
+      data->MemorySize());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
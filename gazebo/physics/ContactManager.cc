@@ -272,6 +272,7 @@ void ContactManager::Clear()
     delete this->contacts[i];
 
   this->contacts.clear();
+  this->filterContacts.clear();
 
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
@@ -312,26 +313,38 @@ void ContactManager::PublishContacts()
     this->contactPub->Publish(msg);
   }
 
-  // publish to other custom topics
+  // publish to other custom topics, and deliver to in-process consumers
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  const common::Time simTime = this->world->SimTime();
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
+
+    this->filterContacts.clear();
     for (unsigned int j = 0;
         j < contactPublisher->contacts.size(); ++j)
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
-
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      if (contactPublisher->contacts[j]->count != 0)
+        this->filterContacts.push_back(contactPublisher->contacts[j]);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
+
+    if (contactPublisher->callback)
+      contactPublisher->callback(this->filterContacts, simTime);
+
+    // Filters with an in-process consumer are only converted to messages
+    // when someone else listens.
+    if (!contactPublisher->callback ||
+        contactPublisher->publisher->HasConnections())
+    {
+      msgs::Contacts msg2;
+      for (auto const &contact : this->filterContacts)
+        contact->FillMsg(*msg2.add_contact());
+      msgs::Set(msg2.mutable_time(), simTime);
+      contactPublisher->publisher->Publish(msg2);
+    }
   }
 }
 
@@ -424,6 +437,23 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   return topic;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const ContactCallback &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter
+      = this->customContactPublishers.find(name);
+  if (iter == this->customContactPublishers.end())
+    return false;
+
+  iter->second->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(const std::string &_name)
 {
@@ -439,6 +469,7 @@ void ContactManager::RemoveFilter(const std::string &_name)
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
+    contactPublisher->callback = nullptr;
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
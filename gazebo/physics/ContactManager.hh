@@ -18,6 +18,7 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
@@ -29,6 +30,8 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/common/Time.hh"
+
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/util/system.hh"
@@ -37,6 +40,13 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \def ContactCallback
+    /// \brief Callback receiving the contacts of a filter in process. The
+    /// contacts only hold at least one contact point, and are only valid
+    /// during the call. The second argument is the simulation time.
+    typedef std::function<void (const std::vector<Contact *> &,
+        const common::Time &)> ContactCallback;
+
     /// \brief A custom contact publisher created for each contact filter
     /// in the Contact Manager.
     class GZ_PHYSICS_VISIBLE ContactPublisher
@@ -56,6 +66,9 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief In-process consumer of the contacts, may be empty.
+      public: ContactCallback callback;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -191,6 +204,20 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Deliver the contacts of a filter to a function in process,
+      /// in addition to its topic. The function is called by
+      /// PublishContacts, from the physics thread, after every physics
+      /// update. Unlike subscribers to the topic, it gets the contacts
+      /// without any conversion to messages, and can identify their
+      /// collisions by pointer or by id. The filter topic is then only
+      /// published when it has subscribers.
+      /// param[in] _name Filter name.
+      /// param[in] _callback Function receiving the contacts, an empty
+      /// function to stop delivering them.
+      /// \return False if the filter doesn't exist.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const ContactCallback &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
@@ -217,6 +244,10 @@ namespace gazebo
 
       private: std::vector<Contact*> contacts;
 
+      /// \brief Contacts of a filter with contact points, reused by
+      /// PublishContacts.
+      private: std::vector<Contact*> filterContacts;
+
       private: unsigned int contactIndex;
 
       /// \brief Node for communication.
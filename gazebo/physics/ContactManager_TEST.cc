@@ -194,6 +194,64 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  // world needs to be paused in order to use World::Step()
+  // function correctly (second parameter true)
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  physics::CollisionPtr box = boost::dynamic_pointer_cast<physics::Collision>(
+      world->EntityByName("box::link::collision"));
+  ASSERT_TRUE(box != nullptr);
+
+  // No filter yet
+  auto callback = [](const std::vector<physics::Contact *> &,
+      const common::Time &) {};
+  EXPECT_FALSE(manager->SetFilterCallback("box_filter", callback));
+
+  std::vector<std::string> collisions;
+  collisions.push_back("box::link::collision");
+  std::string topic = manager->CreateFilter("box_filter", collisions);
+  EXPECT_FALSE(topic.empty());
+
+  // The contacts of the box are handed over after every step
+  unsigned int calls = 0;
+  unsigned int contacts = 0;
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter",
+      [&](const std::vector<physics::Contact *> &_contacts,
+          const common::Time &_time)
+      {
+        ++calls;
+        EXPECT_EQ(world->SimTime(), _time);
+        for (auto const &contact : _contacts)
+        {
+          EXPECT_GT(contact->count, 0);
+          EXPECT_TRUE(contact->collision1->GetId() == box->GetId() ||
+                      contact->collision2->GetId() == box->GetId());
+          ++contacts;
+        }
+      }));
+
+  world->Step(10);
+  EXPECT_EQ(10u, calls);
+  EXPECT_GT(contacts, 0u);
+
+  // Nothing is handed over once the filter is removed
+  manager->RemoveFilter("box_filter");
+  world->Step(10);
+  EXPECT_EQ(10u, calls);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "gazebo/physics/ConvexDecomposition.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace
+{
+/// \brief Triangle of a hull under construction.
+struct HullFace
+{
+  /// \brief Vertex indices, counter-clockwise seen from outside.
+  std::array<unsigned int, 3> v;
+
+  /// \brief Outward unit normal.
+  ignition::math::Vector3d normal;
+
+  /// \brief Plane offset, normal.Dot(x) == offset on the plane.
+  double offset;
+
+  /// \brief True once the face is no longer part of the hull.
+  bool removed;
+};
+
+/// \brief Part of a mesh approximated by a single hull.
+struct HullPart
+{
+  /// \brief Indices of the mesh triangles in this part.
+  std::vector<unsigned int> triangles;
+
+  /// \brief Hull vertices.
+  std::vector<ignition::math::Vector3d> vertices;
+
+  /// \brief Hull triangles, three indices per triangle.
+  std::vector<unsigned int> indices;
+
+  /// \brief True if no hull could be built for the part, in which case it
+  /// is left out.
+  bool flat = false;
+
+  /// \brief Largest distance between the triangles and the hull surface.
+  double concavity = 0;
+};
+}
+
+//////////////////////////////////////////////////
+/// \brief Create a hull face.
+static HullFace MakeFace(const std::vector<ignition::math::Vector3d> &_points,
+    const unsigned int _a, const unsigned int _b, const unsigned int _c)
+{
+  HullFace face;
+  face.v = {{_a, _b, _c}};
+  face.normal = (_points[_b] - _points[_a]).Cross(_points[_c] - _points[_a]);
+  face.normal.Normalize();
+  face.offset = face.normal.Dot(_points[_a]);
+  face.removed = false;
+  return face;
+}
+
+//////////////////////////////////////////////////
+bool physics::ConvexHull(const std::vector<ignition::math::Vector3d> &_points,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  _indices.clear();
+  if (_points.size() < 4)
+    return false;
+
+  // Distances below this tolerance count as zero
+  ignition::math::Vector3d min = _points[0];
+  ignition::math::Vector3d max = _points[0];
+  for (const auto &p : _points)
+  {
+    min.Min(p);
+    max.Max(p);
+  }
+  const double eps = 1e-9 * (max - min).Length();
+  if (eps <= 0)
+    return false;
+
+  // Initial tetrahedron from extreme points
+  unsigned int i0 = 0;
+  for (unsigned int i = 1; i < _points.size(); ++i)
+  {
+    if (_points[i].X() < _points[i0].X())
+      i0 = i;
+  }
+
+  unsigned int i1 = i0;
+  double best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double dist = _points[i].Distance(_points[i0]);
+    if (dist > best)
+    {
+      best = dist;
+      i1 = i;
+    }
+  }
+  if (best <= eps)
+    return false;
+
+  const ignition::math::Vector3d dir =
+      (_points[i1] - _points[i0]).Normalized();
+  unsigned int i2 = i0;
+  best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double dist = (_points[i] - _points[i0]).Cross(dir).Length();
+    if (dist > best)
+    {
+      best = dist;
+      i2 = i;
+    }
+  }
+  if (best <= eps)
+    return false;
+
+  const ignition::math::Vector3d normal = (_points[i1] - _points[i0]).Cross(
+      _points[i2] - _points[i0]).Normalized();
+  unsigned int i3 = i0;
+  best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double dist = std::fabs(normal.Dot(_points[i] - _points[i0]));
+    if (dist > best)
+    {
+      best = dist;
+      i3 = i;
+    }
+  }
+  if (best <= eps)
+    return false;
+
+  std::vector<HullFace> faces;
+  const ignition::math::Vector3d centroid =
+      (_points[i0] + _points[i1] + _points[i2] + _points[i3]) * 0.25;
+  const std::array<std::array<unsigned int, 3>, 4> simplex =
+      {{{{i0, i1, i2}}, {{i0, i1, i3}}, {{i1, i2, i3}}, {{i2, i0, i3}}}};
+  for (const auto &tri : simplex)
+  {
+    HullFace face = MakeFace(_points, tri[0], tri[1], tri[2]);
+    if (face.normal.Dot(centroid) > face.offset)
+      face = MakeFace(_points, tri[0], tri[2], tri[1]);
+    faces.push_back(face);
+  }
+
+  // Add the remaining points one at a time. The faces a point sees are
+  // replaced by a fan connecting the point to their horizon.
+  std::set<std::pair<unsigned int, unsigned int>> edges;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    if (i == i0 || i == i1 || i == i2 || i == i3)
+      continue;
+
+    edges.clear();
+    for (auto &face : faces)
+    {
+      if (face.removed || face.normal.Dot(_points[i]) - face.offset <= eps)
+        continue;
+      face.removed = true;
+      edges.insert(std::make_pair(face.v[0], face.v[1]));
+      edges.insert(std::make_pair(face.v[1], face.v[2]));
+      edges.insert(std::make_pair(face.v[2], face.v[0]));
+    }
+    if (edges.empty())
+      continue;
+
+    for (const auto &edge : edges)
+    {
+      if (!edges.count(std::make_pair(edge.second, edge.first)))
+        faces.push_back(MakeFace(_points, edge.first, edge.second, i));
+    }
+
+    faces.erase(std::remove_if(faces.begin(), faces.end(),
+          [](const HullFace &_f) {return _f.removed;}), faces.end());
+  }
+
+  // Keep only the points used by the hull
+  std::map<unsigned int, unsigned int> remap;
+  for (const auto &face : faces)
+  {
+    for (const auto v : face.v)
+    {
+      auto iter = remap.find(v);
+      if (iter == remap.end())
+      {
+        iter = remap.insert(std::make_pair(v,
+              static_cast<unsigned int>(_vertices.size()))).first;
+        _vertices.push_back(_points[v]);
+      }
+      _indices.push_back(iter->second);
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Reduce a point set to at most _maxCount extreme points, picked
+/// along directions spread evenly over the sphere.
+/// \param[in] _points Input points.
+/// \param[in] _maxCount Maximum number of points to keep.
+/// \return The reduced point set.
+static std::vector<ignition::math::Vector3d> ExtremePoints(
+    const std::vector<ignition::math::Vector3d> &_points,
+    const unsigned int _maxCount)
+{
+  if (_points.size() <= _maxCount)
+    return _points;
+
+  // Fibonacci sphere directions
+  const double golden = M_PI * (3.0 - std::sqrt(5.0));
+  std::set<unsigned int> selected;
+  for (unsigned int d = 0; d < _maxCount; ++d)
+  {
+    const double z = 1.0 - (2.0 * d + 1.0) / _maxCount;
+    const double r = std::sqrt(std::max(0.0, 1.0 - z * z));
+    const ignition::math::Vector3d dir(
+        r * std::cos(golden * d), r * std::sin(golden * d), z);
+
+    unsigned int best = 0;
+    double bestDot = dir.Dot(_points[0]);
+    for (unsigned int i = 1; i < _points.size(); ++i)
+    {
+      const double dot = dir.Dot(_points[i]);
+      if (dot > bestDot)
+      {
+        bestDot = dot;
+        best = i;
+      }
+    }
+    selected.insert(best);
+  }
+
+  std::vector<ignition::math::Vector3d> result;
+  for (const auto i : selected)
+    result.push_back(_points[i]);
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the hull of a part and its concavity.
+/// \param[in] _points Mesh vertices.
+/// \param[in] _indices Mesh triangles.
+/// \param[in] _maxHullVertices Maximum number of hull vertices.
+/// \param[in] _winding 1 if the triangles are counter-clockwise seen from
+/// outside, -1 if they are clockwise.
+/// \param[in] _thickness Thickness given to flat parts.
+/// \param[in,out] _part Part to update.
+static void BuildPart(const std::vector<ignition::math::Vector3d> &_points,
+    const std::vector<int> &_indices, const unsigned int _maxHullVertices,
+    const double _winding, const double _thickness, HullPart &_part)
+{
+  std::set<unsigned int> used;
+  for (const auto t : _part.triangles)
+  {
+    used.insert(_indices[t * 3]);
+    used.insert(_indices[t * 3 + 1]);
+    used.insert(_indices[t * 3 + 2]);
+  }
+
+  std::vector<ignition::math::Vector3d> points;
+  points.reserve(used.size());
+  for (const auto v : used)
+    points.push_back(_points[v]);
+
+  _part.flat = !ConvexHull(ExtremePoints(points, _maxHullVertices),
+      _part.vertices, _part.indices);
+  _part.concavity = 0;
+
+  // Flat parts are extruded inwards, so that they still get a hull
+  if (_part.flat)
+  {
+    ignition::math::Vector3d normal;
+    for (const auto t : _part.triangles)
+    {
+      const ignition::math::Vector3d &a = _points[_indices[t * 3]];
+      normal += (_points[_indices[t * 3 + 1]] - a).Cross(
+          _points[_indices[t * 3 + 2]] - a) * _winding;
+    }
+    if (normal.Length() <= 0)
+      return;
+    normal.Normalize();
+
+    const size_t count = points.size();
+    for (size_t i = 0; i < count; ++i)
+      points.push_back(points[i] - normal * _thickness);
+
+    _part.flat = !ConvexHull(ExtremePoints(points, _maxHullVertices),
+        _part.vertices, _part.indices);
+    return;
+  }
+
+  std::vector<HullFace> faces;
+  for (unsigned int i = 0; i < _part.indices.size(); i += 3)
+  {
+    faces.push_back(MakeFace(_part.vertices, _part.indices[i],
+          _part.indices[i + 1], _part.indices[i + 2]));
+  }
+
+  // Distance from a point to the hull surface along a direction
+  auto exitDistance = [&faces](const ignition::math::Vector3d &_p,
+      const ignition::math::Vector3d &_dir)
+  {
+    double dist = std::numeric_limits<double>::max();
+    for (const auto &face : faces)
+    {
+      const double speed = face.normal.Dot(_dir);
+      if (speed > 0)
+        dist = std::min(dist, (face.offset - face.normal.Dot(_p)) / speed);
+    }
+    return std::max(0.0, dist);
+  };
+
+  // Cast rays outwards from the triangle centroids
+  for (const auto t : _part.triangles)
+  {
+    const ignition::math::Vector3d &a = _points[_indices[t * 3]];
+    const ignition::math::Vector3d &b = _points[_indices[t * 3 + 1]];
+    const ignition::math::Vector3d &c = _points[_indices[t * 3 + 2]];
+    ignition::math::Vector3d normal = (b - a).Cross(c - a) * _winding;
+    if (normal.Length() <= 0)
+      continue;
+    normal.Normalize();
+
+    _part.concavity = std::max(_part.concavity,
+        exitDistance((a + b + c) / 3.0, normal));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Split the triangles of a part in two halves along the longest
+/// axis of their centroids.
+/// \param[in] _points Mesh vertices.
+/// \param[in] _indices Mesh triangles.
+/// \param[in,out] _part Part to split, keeps the first half.
+/// \param[out] _other Receives the second half.
+static void SplitPart(const std::vector<ignition::math::Vector3d> &_points,
+    const std::vector<int> &_indices, HullPart &_part, HullPart &_other)
+{
+  auto centroid = [&](const unsigned int _t)
+  {
+    return _points[_indices[_t * 3]] + _points[_indices[_t * 3 + 1]] +
+        _points[_indices[_t * 3 + 2]];
+  };
+
+  ignition::math::Vector3d min = centroid(_part.triangles[0]);
+  ignition::math::Vector3d max = min;
+  for (const auto t : _part.triangles)
+  {
+    min.Min(centroid(t));
+    max.Max(centroid(t));
+  }
+
+  const ignition::math::Vector3d extent = max - min;
+  unsigned int axis = 0;
+  if (extent.Y() > extent[axis])
+    axis = 1;
+  if (extent.Z() > extent[axis])
+    axis = 2;
+
+  auto mid = _part.triangles.begin() + _part.triangles.size() / 2;
+  std::nth_element(_part.triangles.begin(), mid, _part.triangles.end(),
+      [&](const unsigned int _a, const unsigned int _b)
+      {
+        return centroid(_a)[axis] < centroid(_b)[axis];
+      });
+
+  _other.triangles.assign(mid, _part.triangles.end());
+  _part.triangles.erase(mid, _part.triangles.end());
+}
+
+//////////////////////////////////////////////////
+unsigned int physics::ConvexDecomposition(const std::vector<float> &_vertices,
+    const std::vector<int> &_indices, const unsigned int _maxHulls,
+    const unsigned int _maxHullVertices,
+    std::vector<float> &_hullVertices, std::vector<int> &_hullIndices,
+    std::vector<unsigned int> &_hullSizes)
+{
+  _hullVertices.clear();
+  _hullIndices.clear();
+  _hullSizes.clear();
+  if (_maxHulls == 0 || _maxHullVertices < 4)
+    return 0;
+
+  std::vector<ignition::math::Vector3d> points(_vertices.size() / 3);
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    points[i].Set(_vertices[i * 3], _vertices[i * 3 + 1],
+        _vertices[i * 3 + 2]);
+  }
+
+  std::vector<HullPart> parts(1);
+  const int vertexCount = static_cast<int>(points.size());
+  for (unsigned int t = 0; t < _indices.size() / 3; ++t)
+  {
+    bool valid = true;
+    for (unsigned int k = 0; k < 3; ++k)
+      valid = valid && _indices[t * 3 + k] >= 0 &&
+          _indices[t * 3 + k] < vertexCount;
+    if (valid)
+      parts[0].triangles.push_back(t);
+  }
+  if (parts[0].triangles.empty())
+    return 0;
+
+  // Parts within 1% of the mesh size of their hull are not split. The
+  // sign of the enclosed volume tells the winding of the triangles.
+  ignition::math::Vector3d min = points[_indices[parts[0].triangles[0] * 3]];
+  ignition::math::Vector3d max = min;
+  double volume = 0;
+  for (const auto t : parts[0].triangles)
+  {
+    const ignition::math::Vector3d &a = points[_indices[t * 3]];
+    const ignition::math::Vector3d &b = points[_indices[t * 3 + 1]];
+    const ignition::math::Vector3d &c = points[_indices[t * 3 + 2]];
+    min.Min(a);
+    min.Min(b);
+    min.Min(c);
+    max.Max(a);
+    max.Max(b);
+    max.Max(c);
+    volume += a.Dot(b.Cross(c));
+  }
+  const double tolerance = 0.01 * (max - min).Length();
+  const double winding = volume < 0 ? -1.0 : 1.0;
+
+  BuildPart(points, _indices, _maxHullVertices, winding, tolerance,
+      parts[0]);
+  while (parts.size() < _maxHulls)
+  {
+    // Split the most concave part
+    size_t worst = parts.size();
+    double concavity = tolerance;
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+      if (parts[i].triangles.size() > 1 && parts[i].concavity > concavity)
+      {
+        concavity = parts[i].concavity;
+        worst = i;
+      }
+    }
+    if (worst == parts.size())
+      break;
+
+    HullPart other;
+    SplitPart(points, _indices, parts[worst], other);
+    BuildPart(points, _indices, _maxHullVertices, winding, tolerance,
+        parts[worst]);
+    BuildPart(points, _indices, _maxHullVertices, winding, tolerance, other);
+    parts.push_back(std::move(other));
+  }
+
+  unsigned int count = 0;
+  for (const auto &part : parts)
+  {
+    // Parts without a volume, such as a single line, are left out
+    if (part.flat)
+      continue;
+
+    const int offset = static_cast<int>(_hullVertices.size() / 3);
+    for (const auto &v : part.vertices)
+    {
+      _hullVertices.insert(_hullVertices.end(), {static_cast<float>(v.X()),
+          static_cast<float>(v.Y()), static_cast<float>(v.Z())});
+    }
+    for (const auto i : part.indices)
+      _hullIndices.push_back(offset + static_cast<int>(i));
+
+    _hullSizes.push_back(part.vertices.size());
+    _hullSizes.push_back(part.indices.size());
+    ++count;
+  }
+
+  return count;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_CONVEXDECOMPOSITION_HH_
+#define GAZEBO_PHYSICS_CONVEXDECOMPOSITION_HH_
+
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \brief Compute the convex hull of a set of points.
+    /// \param[in] _points Input points.
+    /// \param[out] _vertices Hull vertices, a subset of _points.
+    /// \param[out] _indices Vertex indices of the hull triangles, three per
+    /// triangle, counter-clockwise when seen from outside.
+    /// \return False if the points don't span a volume, in which case the
+    /// outputs are empty.
+    GZ_PHYSICS_VISIBLE
+    bool ConvexHull(const std::vector<ignition::math::Vector3d> &_points,
+        std::vector<ignition::math::Vector3d> &_vertices,
+        std::vector<unsigned int> &_indices);
+
+    /// \brief Approximate a triangle mesh with a set of convex hulls, to
+    /// be used as a cheaper collision proxy.
+    ///
+    /// The triangles are split recursively along the longest axis of the
+    /// most concave part, until every part is within 1% of the mesh size of
+    /// its hull or _maxHulls parts exist. The concavity of a part is the
+    /// largest distance from its triangles to the surface of its hull,
+    /// measured outwards along the triangle normals. The winding of the
+    /// triangles is deduced from the sign of the enclosed volume and must
+    /// be consistent. Parts that are flat are extruded inwards by the same
+    /// 1% of the mesh size, so that every part is a closed convex hull.
+    /// \param[in] _vertices Vertex coordinates, three per vertex.
+    /// \param[in] _indices Vertex indices, three per triangle.
+    /// \param[in] _maxHulls Maximum number of hulls.
+    /// \param[in] _maxHullVertices Maximum number of vertices per hull.
+    /// Larger point sets are reduced to their extreme points along evenly
+    /// spread directions.
+    /// \param[out] _hullVertices Vertex coordinates of all the hulls. The
+    /// vertices of a hull follow those of the previous hull.
+    /// \param[out] _hullIndices Vertex indices of all the hull triangles,
+    /// counter-clockwise when seen from outside, in the same hull order.
+    /// \param[out] _hullSizes Number of vertices and number of indices of
+    /// each hull, two values per hull.
+    /// \return Number of hulls generated.
+    GZ_PHYSICS_VISIBLE
+    unsigned int ConvexDecomposition(const std::vector<float> &_vertices,
+        const std::vector<int> &_indices, const unsigned int _maxHulls,
+        const unsigned int _maxHullVertices,
+        std::vector<float> &_hullVertices, std::vector<int> &_hullIndices,
+        std::vector<unsigned int> &_hullSizes);
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "gazebo/physics/ConvexDecomposition.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ConvexDecompositionTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Append the 12 triangles of an axis aligned box to a mesh.
+/// \param[in] _min Minimum corner.
+/// \param[in] _max Maximum corner.
+/// \param[in,out] _vertices Vertex coordinates.
+/// \param[in,out] _indices Triangle indices.
+void AddBox(const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max, std::vector<float> &_vertices,
+    std::vector<int> &_indices)
+{
+  const int offset = static_cast<int>(_vertices.size() / 3);
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    _vertices.push_back(i & 1 ? _max.X() : _min.X());
+    _vertices.push_back(i & 2 ? _max.Y() : _min.Y());
+    _vertices.push_back(i & 4 ? _max.Z() : _min.Z());
+  }
+
+  const int faces[12][3] =
+  {
+    {0, 2, 1}, {1, 2, 3}, {4, 5, 6}, {5, 7, 6},
+    {0, 1, 4}, {1, 5, 4}, {2, 6, 3}, {3, 6, 7},
+    {0, 4, 2}, {2, 4, 6}, {1, 3, 5}, {3, 7, 5}
+  };
+  for (const auto &face : faces)
+  {
+    for (const auto v : face)
+      _indices.push_back(offset + v);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Volume enclosed by a closed, outward oriented triangle mesh.
+double Volume(const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  double volume = 0;
+  for (unsigned int i = 0; i < _indices.size(); i += 3)
+  {
+    volume += _vertices[_indices[i]].Dot(
+        _vertices[_indices[i + 1]].Cross(_vertices[_indices[i + 2]])) / 6.0;
+  }
+  return volume;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Hull)
+{
+  // Corners of a unit cube plus points inside and on its faces
+  std::vector<ignition::math::Vector3d> points;
+  for (unsigned int i = 0; i < 8; ++i)
+    points.emplace_back(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+  points.emplace_back(0.5, 0.5, 0.5);
+  points.emplace_back(0.2, 0.7, 0.1);
+  points.emplace_back(0.5, 0.5, 1.0);
+
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(physics::ConvexHull(points, vertices, indices));
+  EXPECT_EQ(8u, vertices.size());
+  EXPECT_EQ(36u, indices.size());
+  EXPECT_NEAR(1.0, Volume(vertices, indices), 1e-9);
+
+  // Every edge is used once in each direction
+  std::map<std::pair<unsigned int, unsigned int>, int> edges;
+  for (unsigned int i = 0; i < indices.size(); i += 3)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+      ++edges[std::make_pair(indices[i + k], indices[i + (k + 1) % 3])];
+  }
+  for (const auto &edge : edges)
+  {
+    EXPECT_EQ(1, edge.second);
+    EXPECT_EQ(1u, edges.count(
+          std::make_pair(edge.first.second, edge.first.first)));
+  }
+
+  // Coplanar points don't have a hull
+  std::vector<ignition::math::Vector3d> flat =
+      {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0.5, 0.2, 0}};
+  EXPECT_FALSE(physics::ConvexHull(flat, vertices, indices));
+  EXPECT_TRUE(vertices.empty());
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, ConvexMesh)
+{
+  std::vector<float> vertices;
+  std::vector<int> indices;
+  AddBox(ignition::math::Vector3d(-1, -2, -3),
+      ignition::math::Vector3d(1, 2, 3), vertices, indices);
+
+  // A convex mesh is its own hull and isn't split
+  std::vector<float> hullVertices;
+  std::vector<int> hullIndices;
+  std::vector<unsigned int> hullSizes;
+  EXPECT_EQ(1u, physics::ConvexDecomposition(vertices, indices, 8, 64,
+        hullVertices, hullIndices, hullSizes));
+  EXPECT_EQ(24u, hullVertices.size());
+  EXPECT_EQ(36u, hullIndices.size());
+  ASSERT_EQ(2u, hullSizes.size());
+  EXPECT_EQ(8u, hullSizes[0]);
+  EXPECT_EQ(36u, hullSizes[1]);
+
+  EXPECT_EQ(0u, physics::ConvexDecomposition(vertices, indices, 0, 64,
+        hullVertices, hullIndices, hullSizes));
+  EXPECT_TRUE(hullIndices.empty());
+  EXPECT_TRUE(hullSizes.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, ConcaveMesh)
+{
+  // A U shape: a base and two pillars, leaving a notch between the pillars
+  std::vector<float> vertices;
+  std::vector<int> indices;
+  AddBox(ignition::math::Vector3d(0, 0, 0), ignition::math::Vector3d(3, 1, 1),
+      vertices, indices);
+  AddBox(ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(1, 1, 3),
+      vertices, indices);
+  AddBox(ignition::math::Vector3d(2, 0, 1), ignition::math::Vector3d(3, 1, 3),
+      vertices, indices);
+
+  std::vector<float> hullVertices;
+  std::vector<int> hullIndices;
+  std::vector<unsigned int> hullSizes;
+
+  // A single hull fills the notch
+  EXPECT_EQ(1u, physics::ConvexDecomposition(vertices, indices, 1, 64,
+        hullVertices, hullIndices, hullSizes));
+
+  const unsigned int maxHulls = 16;
+  const unsigned int count = physics::ConvexDecomposition(vertices, indices,
+      maxHulls, 64, hullVertices, hullIndices, hullSizes);
+  EXPECT_GT(count, 1u);
+  EXPECT_LE(count, maxHulls);
+  ASSERT_EQ(count * 2, hullSizes.size());
+
+  std::vector<ignition::math::Vector3d> points;
+  for (unsigned int i = 0; i < hullVertices.size(); i += 3)
+  {
+    points.emplace_back(
+        hullVertices[i], hullVertices[i + 1], hullVertices[i + 2]);
+  }
+
+  // Every hull is closed, uses its own vertices and doesn't cover the
+  // middle of the notch
+  const ignition::math::Vector3d notch(1.5, 0.5, 2.5);
+  unsigned int firstVertex = 0;
+  unsigned int firstIndex = 0;
+  for (unsigned int h = 0; h < count; ++h)
+  {
+    const unsigned int vertexCount = hullSizes[h * 2];
+    const unsigned int indexCount = hullSizes[h * 2 + 1];
+    ASSERT_LE((firstVertex + vertexCount) * 3, hullVertices.size());
+    ASSERT_LE(firstIndex + indexCount, hullIndices.size());
+
+    std::vector<unsigned int> hull(hullIndices.begin() + firstIndex,
+        hullIndices.begin() + firstIndex + indexCount);
+    std::set<std::pair<unsigned int, unsigned int>> edges;
+    for (unsigned int i = 0; i < hull.size(); i += 3)
+    {
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        EXPECT_GE(hull[i + k], firstVertex);
+        EXPECT_LT(hull[i + k], firstVertex + vertexCount);
+        edges.insert(std::make_pair(hull[i + k], hull[i + (k + 1) % 3]));
+      }
+    }
+    for (const auto &edge : edges)
+      EXPECT_TRUE(edges.count(std::make_pair(edge.second, edge.first)));
+    EXPECT_GT(Volume(points, hull), 0.0);
+
+    bool inside = true;
+    for (unsigned int i = 0; i < hull.size(); i += 3)
+    {
+      const ignition::math::Vector3d normal =
+          (points[hull[i + 1]] - points[hull[i]]).Cross(
+          points[hull[i + 2]] - points[hull[i]]);
+      inside = inside && normal.Dot(notch - points[hull[i]]) <= 0;
+    }
+    EXPECT_FALSE(inside);
+
+    firstVertex += vertexCount;
+    firstIndex += indexCount;
+  }
+  EXPECT_EQ(hullVertices.size(), firstVertex * 3);
+  EXPECT_EQ(hullIndices.size(), firstIndex);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, MaxHullVertices)
+{
+  // A finely tessellated sphere
+  std::vector<float> vertices;
+  std::vector<int> indices;
+  const unsigned int rings = 32;
+  const unsigned int segments = 64;
+  for (unsigned int r = 0; r <= rings; ++r)
+  {
+    const double theta = M_PI * r / rings;
+    for (unsigned int s = 0; s < segments; ++s)
+    {
+      const double phi = 2.0 * M_PI * s / segments;
+      vertices.push_back(std::sin(theta) * std::cos(phi));
+      vertices.push_back(std::sin(theta) * std::sin(phi));
+      vertices.push_back(std::cos(theta));
+    }
+  }
+  for (unsigned int r = 0; r < rings; ++r)
+  {
+    for (unsigned int s = 0; s < segments; ++s)
+    {
+      const int a = r * segments + s;
+      const int b = r * segments + (s + 1) % segments;
+      const int n = segments;
+      indices.insert(indices.end(), {a, a + n, b});
+      indices.insert(indices.end(), {b, a + n, b + n});
+    }
+  }
+
+  std::vector<float> hullVertices;
+  std::vector<int> hullIndices;
+  std::vector<unsigned int> hullSizes;
+  EXPECT_EQ(1u, physics::ConvexDecomposition(vertices, indices, 1, 32,
+        hullVertices, hullIndices, hullSizes));
+  EXPECT_LE(hullVertices.size(), 32u * 3u);
+  EXPECT_LT(hullIndices.size(), indices.size() / 10);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,18 +17,14 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 
-#include "gazebo/msgs/msgs.hh"
-
 #include "gazebo/common/Events.hh"
 
-#include "gazebo/transport/Node.hh"
-#include "gazebo/transport/Subscriber.hh"
-
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Joint.hh"
@@ -47,8 +43,10 @@ using namespace physics;
 class gazebo::physics::GripperPrivate
 {
   /// \brief Callback used when the gripper contacts an object.
-  /// \param[in] _msg Message that contains contact information.
-  public: void OnContacts(ConstContactsPtr &_msg);
+  /// \param[in] _contacts Contacts of the gripper collisions.
+  /// \param[in] _time Simulation time.
+  public: void OnContacts(const std::vector<Contact *> &_contacts,
+              const common::Time &_time);
 
   /// \brief Update the gripper.
   public: void OnUpdate();
@@ -80,8 +78,15 @@ class gazebo::physics::GripperPrivate
   /// \brief The collisions for the links in the gripper.
   public: std::map<std::string, physics::CollisionPtr> collisions;
 
-  /// \brief The current contacts.
-  public: std::vector<msgs::Contact> contacts;
+  /// \brief Ids of the collisions for the links in the gripper.
+  public: std::unordered_set<uint32_t> collisionIds;
+
+  /// \brief Number of current contacts.
+  public: unsigned int contactCount = 0;
+
+  /// \brief Collisions outside the gripper in the current contacts, once
+  /// per contact.
+  public: std::vector<CollisionPtr> contactCollisions;
 
   /// \brief Mutex used to protect reading/writing the contact message.
   public: std::mutex mutexContacts;
@@ -124,12 +129,6 @@ class gazebo::physics::GripperPrivate
 
   /// \brief Name of the gripper.
   public: std::string name;
-
-  /// \brief Node for communication.
-  public: transport::NodePtr node;
-
-  /// \brief Subscription to contact messages from the physics engine.
-  public: transport::SubscriberPtr contactSub;
 };
 
 /////////////////////////////////////////////////
@@ -145,14 +144,14 @@ Gripper::Gripper(ModelPtr _model) : dataPtr(new GripperPrivate)
   this->dataPtr->attached = false;
 
   this->dataPtr->updateRate = common::Time(0, common::Time::SecToNano(0.75));
-
-  this->dataPtr->node = transport::NodePtr(new transport::Node());
 }
 
 /////////////////////////////////////////////////
 Gripper::~Gripper()
 {
-  if (this->dataPtr->world && this->dataPtr->world->Running())
+  // The filter calls back this gripper, remove it as long as the contact
+  // manager exists
+  if (this->dataPtr->world && this->dataPtr->world->Physics())
   {
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
@@ -167,8 +166,6 @@ Gripper::~Gripper()
 /////////////////////////////////////////////////
 void Gripper::Load(sdf::ElementPtr _sdf)
 {
-  this->dataPtr->node->Init(this->dataPtr->world->Name());
-
   this->dataPtr->name = _sdf->Get<std::string>("name");
   this->dataPtr->fixedJoint =
       this->dataPtr->world->Physics()->CreateJoint("fixed",
@@ -208,23 +205,21 @@ void Gripper::Load(sdf::ElementPtr _sdf)
         continue;
 
       this->dataPtr->collisions[collision->GetScopedName()] = collision;
+      this->dataPtr->collisionIds.insert(collision->GetId());
     }
     gripperLinkElem = gripperLinkElem->GetNextElement("gripper_link");
   }
 
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to hand the contacts of the collisions
+    // to this gripper
     physics::ContactManager *mgr =
         this->dataPtr->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->Name(),
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->dataPtr->node->Subscribe(topic,
-          &GripperPrivate::OnContacts, this->dataPtr.get());
-    }
+    mgr->CreateFilter(this->Name(), this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->Name(),
+        std::bind(&GripperPrivate::OnContacts, this->dataPtr.get(),
+          std::placeholders::_1, std::placeholders::_2));
   }
   this->dataPtr->connections.push_back(event::Events::ConnectWorldUpdateEnd(
           std::bind(&GripperPrivate::OnUpdate, this->dataPtr.get())));
@@ -260,7 +255,7 @@ void GripperPrivate::OnUpdate()
   }
 
   // @todo: should package the decision into a function
-  if (this->contacts.size() >= this->minContactCount)
+  if (this->contactCount >= this->minContactCount)
   {
     this->posCount++;
     this->zeroCount = 0;
@@ -282,7 +277,8 @@ void GripperPrivate::OnUpdate()
 
   {
     std::lock_guard<std::mutex> lock(this->mutexContacts);
-    this->contacts.clear();
+    this->contactCount = 0;
+    this->contactCollisions.clear();
   }
 
   this->prevUpdateTime = common::Time::GetWallTime();
@@ -297,32 +293,18 @@ void GripperPrivate::HandleAttach()
     return;
   }
 
-  std::map<std::string, physics::CollisionPtr> cc;
-  std::map<std::string, int> contactCounts;
-  std::map<std::string, int>::iterator iter;
+  std::map<uint32_t, physics::CollisionPtr> cc;
+  std::map<uint32_t, int> contactCounts;
+  std::map<uint32_t, int>::iterator iter;
 
   // This function is only called from the OnUpdate function so
-  // the call to contacts.clear() is not going to happen in
+  // the call to contactCollisions.clear() is not going to happen in
   // parallel with the reads in the following code, no mutex
   // needed.
-  for (unsigned int i = 0; i < this->contacts.size(); ++i)
+  for (auto const &collision : this->contactCollisions)
   {
-    std::string name1 = this->contacts[i].collision1();
-    std::string name2 = this->contacts[i].collision2();
-
-    if (this->collisions.find(name1) == this->collisions.end())
-    {
-      cc[name1] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name1));
-      contactCounts[name1] += 1;
-    }
-
-    if (this->collisions.find(name2) == this->collisions.end())
-    {
-      cc[name2] = boost::dynamic_pointer_cast<Collision>(
-          this->world->EntityByName(name2));
-      contactCounts[name2] += 1;
-    }
+    cc[collision->GetId()] = collision;
+    contactCounts[collision->GetId()] += 1;
   }
 
   iter = contactCounts.begin();
@@ -371,20 +353,24 @@ void GripperPrivate::HandleDetach()
 }
 
 /////////////////////////////////////////////////
-void GripperPrivate::OnContacts(ConstContactsPtr &_msg)
+void GripperPrivate::OnContacts(const std::vector<Contact *> &_contacts,
+    const common::Time &/*_time*/)
 {
-  for (int i = 0; i < _msg->contact_size(); ++i)
+  std::lock_guard<std::mutex> lock(this->mutexContacts);
+  for (auto const &contact : _contacts)
   {
-    CollisionPtr collision1 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision1()));
-    CollisionPtr collision2 = boost::dynamic_pointer_cast<Collision>(
-        this->world->EntityByName(_msg->contact(i).collision2()));
+    if (contact->collision1->IsStatic() || contact->collision2->IsStatic())
+      continue;
 
-    if ((collision1 && !collision1->IsStatic()) &&
-        (collision2 && !collision2->IsStatic()))
+    ++this->contactCount;
+    for (Collision *collision : {contact->collision1, contact->collision2})
     {
-      std::lock_guard<std::mutex> lock(this->mutexContacts);
-      this->contacts.push_back(_msg->contact(i));
+      if (this->collisionIds.count(collision->GetId()) == 0)
+      {
+        this->contactCollisions.push_back(
+            boost::static_pointer_cast<Collision>(
+              collision->shared_from_this()));
+      }
     }
   }
 }
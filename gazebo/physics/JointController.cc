@@ -15,6 +15,9 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -84,6 +87,21 @@ void JointController::RemoveJoint(Joint *_joint)
     this->dataPtr->joints.erase(_joint->GetScopedName());
     this->dataPtr->posPids.erase(_joint->GetScopedName());
     this->dataPtr->velPids.erase(_joint->GetScopedName());
+
+    // Groups are indexed like their joints, disable the ones that lost one
+    for (auto &group : this->dataPtr->groups)
+    {
+      bool found = false;
+      for (auto const &joint : group.joints)
+        found = found || joint.get() == _joint;
+
+      if (found)
+      {
+        gzwarn << "Joint[" << _joint->GetScopedName() << "] removed, "
+               << "its group is no longer commanded\n";
+        group = JointControllerGroup();
+      }
+    }
   }
 }
 
@@ -108,6 +126,9 @@ void JointController::Reset()
   {
     iter->second.Reset();
   }
+
+  for (auto &group : this->dataPtr->groups)
+    group.Reset();
 }
 
 /////////////////////////////////////////////////
@@ -160,6 +181,13 @@ void JointController::Update()
         this->dataPtr->joints[iter->first]->SetForce(0, cmd);
       }
     }
+
+    const double dt = stepTime.Double();
+    for (auto &group : this->dataPtr->groups)
+    {
+      if (group.active)
+        group.Update(dt);
+    }
   }
 
   /* enable below if we want to set position kinematically
@@ -535,3 +563,152 @@ bool JointController::SetForce(const std::string &_jointName,
 
   return result;
 }
+
+/////////////////////////////////////////////////
+int JointController::CreateGroup(const std::vector<std::string> &_jointNames,
+    const CommandType _type)
+{
+  JointControllerGroup group;
+  group.type = _type;
+
+  for (auto const &name : _jointNames)
+  {
+    std::map<std::string, JointPtr>::iterator iter =
+      this->dataPtr->joints.find(name);
+    if (iter == this->dataPtr->joints.end())
+    {
+      gzerr << "Unable to find joint with name[" << name << "]\n";
+      return -1;
+    }
+
+    const common::PID &pid = _type == VELOCITY ?
+      this->dataPtr->velPids[name] : this->dataPtr->posPids[name];
+
+    group.joints.push_back(iter->second);
+    group.pGain.push_back(pid.GetPGain());
+    group.iGain.push_back(pid.GetIGain());
+    group.dGain.push_back(pid.GetDGain());
+    group.iMax.push_back(pid.GetIMax());
+    group.iMin.push_back(pid.GetIMin());
+    group.cmdMax.push_back(pid.GetCmdMax());
+    group.cmdMin.push_back(pid.GetCmdMin());
+  }
+
+  const size_t count = group.joints.size();
+  group.commands.resize(count);
+  group.pErrLast.resize(count);
+  group.iErr.resize(count);
+  group.scratch.resize(count);
+  group.Reset();
+
+  this->dataPtr->groups.push_back(std::move(group));
+  return static_cast<int>(this->dataPtr->groups.size()) - 1;
+}
+
+/////////////////////////////////////////////////
+unsigned int JointController::GroupCount() const
+{
+  return this->dataPtr->groups.size();
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetCommands(const int _group, const double *_commands,
+    const size_t _count)
+{
+  if (_group < 0 ||
+      static_cast<size_t>(_group) >= this->dataPtr->groups.size())
+  {
+    gzerr << "Unable to find joint group[" << _group << "]\n";
+    return false;
+  }
+
+  JointControllerGroup &group = this->dataPtr->groups[_group];
+  if (_count != group.joints.size() || group.joints.empty())
+  {
+    gzerr << "Joint group[" << _group << "] expects "
+          << group.joints.size() << " commands, got " << _count << "\n";
+    return false;
+  }
+
+  std::copy(_commands, _commands + _count, group.commands.begin());
+  group.active = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetCommands(const int _group,
+    const std::vector<double> &_commands)
+{
+  return this->SetCommands(_group, _commands.data(), _commands.size());
+}
+
+/////////////////////////////////////////////////
+void JointControllerGroup::Update(const double _dt)
+{
+  const size_t count = this->joints.size();
+
+  if (this->type == JointController::FORCE)
+  {
+    for (size_t i = 0; i < count; ++i)
+      this->joints[i]->SetForce(0, this->commands[i]);
+    return;
+  }
+
+  // Gather the errors
+  double *err = this->scratch.data();
+  if (this->type == JointController::POSITION)
+  {
+    for (size_t i = 0; i < count; ++i)
+      err[i] = this->joints[i]->Position(0) - this->commands[i];
+  }
+  else
+  {
+    for (size_t i = 0; i < count; ++i)
+      err[i] = this->joints[i]->GetVelocity(0) - this->commands[i];
+  }
+
+  // Same arithmetic as common::PID::Update, written without branches
+  // over plain arrays so that the compiler can vectorize it.
+  const double *pGain = this->pGain.data();
+  const double *iGain = this->iGain.data();
+  const double *dGain = this->dGain.data();
+  const double *iMax = this->iMax.data();
+  const double *iMin = this->iMin.data();
+  const double *cmdMax = this->cmdMax.data();
+  const double *cmdMin = this->cmdMin.data();
+  double *pErrLast = this->pErrLast.data();
+  double *iErr = this->iErr.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double e = err[i];
+    const bool valid = std::isfinite(e);
+
+    double ie = iErr[i] + _dt * e;
+    const double iTerm = iGain[i] * ie;
+    const double iLimited = iTerm > iMax[i] ? iMax[i] :
+      (iTerm < iMin[i] ? iMin[i] : iTerm);
+    ie = iLimited != iTerm ? iLimited / iGain[i] : ie;
+
+    const double dTerm = dGain[i] * ((e - pErrLast[i]) / _dt);
+    double cmd = -pGain[i] * e - iLimited - dTerm;
+    cmd = cmdMax[i] >= cmdMin[i] ?
+      std::max(std::min(cmd, cmdMax[i]), cmdMin[i]) : cmd;
+
+    iErr[i] = valid ? ie : iErr[i];
+    pErrLast[i] = valid ? e : pErrLast[i];
+    err[i] = valid ? cmd : 0.0;
+  }
+
+  // Scatter the forces
+  for (size_t i = 0; i < count; ++i)
+    this->joints[i]->SetForce(0, err[i]);
+}
+
+/////////////////////////////////////////////////
+void JointControllerGroup::Reset()
+{
+  this->active = false;
+  std::fill(this->commands.begin(), this->commands.end(), 0.0);
+  std::fill(this->pErrLast.begin(), this->pErrLast.end(), 0.0);
+  std::fill(this->iErr.begin(), this->iErr.end(), 0.0);
+}
@@ -41,8 +41,26 @@ namespace gazebo
 
     /// \class JointController JointController.hh physics/physics.hh
     /// \brief A class for manipulating physics::Joint
+    ///
+    /// Joints are commanded one by one by name, or together in groups.
+    /// A group resolves the names of its joints once, when it's created,
+    /// and keeps the commands and the PID controller states of its joints
+    /// in contiguous arrays, which are updated in a single pass.
     class GZ_PHYSICS_VISIBLE JointController
     {
+      /// \brief Type of the commands of a group of joints.
+      public: enum CommandType
+      {
+        /// \brief Forces, applied as is.
+        FORCE,
+
+        /// \brief Targets of position PID controllers.
+        POSITION,
+
+        /// \brief Targets of velocity PID controllers.
+        VELOCITY
+      };
+
       /// \brief Constructor
       /// \param[in] _model Model that uses this joint controller.
       public: explicit JointController(ModelPtr _model);
@@ -141,6 +159,41 @@ namespace gazebo
       /// set by the user of the JointController.
       public: std::map<std::string, double> GetVelocities() const;
 
+      /// \brief Create a group of joints commanded together. The PID
+      /// controllers of the group start from the gains set with
+      /// SetPositionPID or SetVelocityPID, and from a reset state.
+      /// The group is commanded with SetCommands, after the joints
+      /// commanded by name on each update.
+      /// \param[in] _jointNames Scoped names of joints added with AddJoint.
+      /// \param[in] _type Type of the commands.
+      /// \return Index of the new group, -1 if a joint was not found.
+      public: int CreateGroup(const std::vector<std::string> &_jointNames,
+                  const CommandType _type);
+
+      /// \brief Get the number of groups.
+      /// \return Number of groups created with CreateGroup.
+      public: unsigned int GroupCount() const;
+
+      /// \brief Set the commands of all the joints of a group. They persist
+      /// across time steps, until the next call or a Reset.
+      /// \param[in] _group Index of the group.
+      /// \param[in] _commands Commands, in the order of the joint names
+      /// passed to CreateGroup.
+      /// \param[in] _count Number of commands, which must be the number of
+      /// joints in the group.
+      /// \return False if the group doesn't exist or the count is wrong.
+      public: bool SetCommands(const int _group, const double *_commands,
+                  const size_t _count);
+
+      /// \brief Set the commands of all the joints of a group.
+      /// \param[in] _group Index of the group.
+      /// \param[in] _commands Commands, in the order of the joint names
+      /// passed to CreateGroup.
+      /// \return False if the group doesn't exist or the size is wrong.
+      /// \sa SetCommands(const int, const double *, const size_t)
+      public: bool SetCommands(const int _group,
+                  const std::vector<double> &_commands);
+
       /// \brief Callback for service to request the current control parameters.
       /// \param[in] _req The service request. The service expects a joint
       /// name.
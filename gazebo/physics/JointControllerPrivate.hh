@@ -19,17 +19,73 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/common/PID.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/physics/JointController.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief Joints commanded together, with the commands and the PID
+    /// controller states stored in arrays indexed like the joints.
+    class JointControllerGroup
+    {
+      /// \brief Apply the commands to the joints.
+      /// \param[in] _dt Time since the previous update, positive.
+      public: void Update(const double _dt);
+
+      /// \brief Reset the commands and the PID controller states.
+      public: void Reset();
+
+      /// \brief Type of the commands.
+      public: JointController::CommandType type = JointController::FORCE;
+
+      /// \brief True once commands were set.
+      public: bool active = false;
+
+      /// \brief Joints of the group.
+      public: std::vector<JointPtr> joints;
+
+      /// \brief Commands, forces or PID targets.
+      public: std::vector<double> commands;
+
+      /// \brief Proportional gains.
+      public: std::vector<double> pGain;
+
+      /// \brief Integral gains.
+      public: std::vector<double> iGain;
+
+      /// \brief Derivative gains.
+      public: std::vector<double> dGain;
+
+      /// \brief Maximum integral terms.
+      public: std::vector<double> iMax;
+
+      /// \brief Minimum integral terms.
+      public: std::vector<double> iMin;
+
+      /// \brief Maximum forces, unlimited if lower than cmdMin.
+      public: std::vector<double> cmdMax;
+
+      /// \brief Minimum forces.
+      public: std::vector<double> cmdMin;
+
+      /// \brief Errors at the previous update.
+      public: std::vector<double> pErrLast;
+
+      /// \brief Integral errors.
+      public: std::vector<double> iErr;
+
+      /// \brief Errors at the current update, then the forces applied.
+      public: std::vector<double> scratch;
+    };
+
     class JointControllerPrivate
     {
       /// \brief Model to control.
@@ -68,6 +124,9 @@ namespace gazebo
 
       /// \brief Last time the controller was updated.
       public: common::Time prevUpdateTime;
+
+      /// \brief Groups of joints commanded together.
+      public: std::vector<JointControllerGroup> groups;
     };
   }
 }
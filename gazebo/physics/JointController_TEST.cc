@@ -350,6 +350,62 @@ TEST_F(JointControllerTest, JointCmd)
   EXPECT_DOUBLE_EQ(rep.velocity().d_gain_optional().data(), 9);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, Groups)
+{
+  // Create a dummy model
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  EXPECT_TRUE(model != NULL);
+
+  // Create the joint controller
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+  EXPECT_TRUE(jointController != NULL);
+  EXPECT_EQ(jointController->GroupCount(), 0u);
+
+  physics::JointPtr joint1(new FakeJoint(model));
+  joint1->SetName("joint1");
+  physics::JointPtr joint2(new FakeJoint(model));
+  joint2->SetName("joint2");
+  jointController->AddJoint(joint1);
+  jointController->AddJoint(joint2);
+
+  // Unknown joint
+  std::vector<std::string> names = {joint1->GetScopedName(), "my_bad_name"};
+  EXPECT_EQ(jointController->CreateGroup(names,
+        physics::JointController::POSITION), -1);
+  EXPECT_EQ(jointController->GroupCount(), 0u);
+
+  names = {joint2->GetScopedName(), joint1->GetScopedName()};
+  EXPECT_EQ(jointController->CreateGroup(names,
+        physics::JointController::POSITION), 0);
+  EXPECT_EQ(jointController->CreateGroup({joint1->GetScopedName()},
+        physics::JointController::FORCE), 1);
+  EXPECT_EQ(jointController->GroupCount(), 2u);
+
+  // One command per joint
+  EXPECT_TRUE(jointController->SetCommands(0, {1.2, 2.3}));
+  EXPECT_FALSE(jointController->SetCommands(0, {1.2}));
+  EXPECT_TRUE(jointController->SetCommands(1, {4.5}));
+  const double commands[] = {1.0, 2.0};
+  EXPECT_TRUE(jointController->SetCommands(0, commands, 2));
+  EXPECT_FALSE(jointController->SetCommands(0, commands, 1));
+
+  // Unknown group
+  EXPECT_FALSE(jointController->SetCommands(-1, {1.0}));
+  EXPECT_FALSE(jointController->SetCommands(2, {1.0}));
+
+  // Groups don't show up in the commands by name
+  EXPECT_TRUE(jointController->GetPositions().empty());
+  EXPECT_TRUE(jointController->GetForces().empty());
+
+  // Groups that lose a joint are disabled
+  jointController->RemoveJoint(joint1.get());
+  EXPECT_EQ(jointController->GroupCount(), 2u);
+  EXPECT_FALSE(jointController->SetCommands(0, {1.2, 2.3}));
+  EXPECT_FALSE(jointController->SetCommands(1, {4.5}));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
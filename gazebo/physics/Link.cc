@@ -16,6 +16,8 @@
 */
 
 #include <boost/algorithm/string.hpp>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <sstream>
@@ -46,6 +48,67 @@
 #include "gazebo/util/OpenAL.hh"
 #include "gazebo/util/UtilTypes.hh"
 
+/// \brief Wrench received by a link, in the link frame.
+class LinkWrench
+{
+  /// \brief Force.
+  public: ignition::math::Vector3d force;
+
+  /// \brief Torque.
+  public: ignition::math::Vector3d torque;
+
+  /// \brief Position where the force is applied.
+  public: ignition::math::Vector3d offset;
+};
+
+/// \brief Ring of the wrenches received by a link, with preallocated
+/// storage. Transport threads push, the world update thread pops without
+/// locking.
+class LinkWrenchQueue
+{
+  /// \brief Capacity, a power of two.
+  public: static const uint64_t kCapacity = 64;
+
+  /// \brief Add a wrench.
+  /// \param[in] _wrench Wrench to add.
+  /// \return False if the ring is full and the wrench was dropped.
+  public: bool Push(const LinkWrench &_wrench)
+  {
+    // Serializes the transport threads only
+    std::lock_guard<std::mutex> lock(this->pushMutex);
+
+    const uint64_t h = this->head.load(std::memory_order_relaxed);
+    if (h - this->tail.load(std::memory_order_acquire) >= kCapacity)
+      return false;
+    this->wrenches[h & (kCapacity - 1)] = _wrench;
+    this->head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// \brief Pass all the pending wrenches to a function, and remove them.
+  /// \param[in] _func Function called for each wrench.
+  public: template<typename F> void Drain(F _func)
+  {
+    uint64_t t = this->tail.load(std::memory_order_relaxed);
+    const uint64_t h = this->head.load(std::memory_order_acquire);
+    for (; t != h; ++t)
+      _func(this->wrenches[t & (kCapacity - 1)]);
+    this->tail.store(h, std::memory_order_release);
+  }
+
+  /// \brief Wrenches.
+  public: std::array<LinkWrench, kCapacity> wrenches;
+
+  /// \brief Number of wrenches pushed.
+  public: std::atomic<uint64_t> head{0};
+
+  /// \brief Number of wrenches popped.
+  public: std::atomic<uint64_t> tail{0};
+
+  /// \brief Protects pushing.
+  public: std::mutex pushMutex;
+};
+
 /// \brief Private data for the Link class
 class gazebo::physics::LinkPrivate
 {
@@ -88,17 +151,21 @@ class gazebo::physics::LinkPrivate
   /// \brief Wrench subscriber.
   public: transport::SubscriberPtr wrenchSub;
 
-  /// \brief Vector of wrench messages to be processed.
-  public: std::vector<msgs::Wrench> wrenchMsgs;
+  /// \brief Wrenches to be applied.
+  public: LinkWrenchQueue wrenches;
+
+  /// \brief True once the link was woken up to apply the wrenches it
+  /// received, until it applies them.
+  public: std::atomic_bool wrenchPending{false};
 
-  /// \brief Mutex to protect the wrenchMsgs variable.
-  public: std::mutex wrenchMsgMutex;
+  /// \brief True if the world updates the link every step.
+  public: std::atomic_bool active{false};
 
   /// \brief Wind velocity.
   public: ignition::math::Vector3d windLinearVel;
 
-  /// \brief Update connection to calculate wind velocity.
-  public: event::ConnectionPtr updateConnection;
+  /// \brief True to calculate the wind velocity every step.
+  public: bool windEnabled = false;
 
   /// \brief All the attached batteries.
   public: std::vector<common::BatteryPtr> batteries;
@@ -295,10 +362,7 @@ void Link::Load(sdf::ElementPtr _sdf)
   this->sdf->GetElement("enable_wind")->GetValue()->SetUpdateFunc(
       std::bind(&Link::WindMode, this));
 
-  this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
-      std::bind(
-      static_cast<void(Link::*)(const common::UpdateInfo &)>(&Link::Update),
-      this, std::placeholders::_1)));
+  this->UpdateActive();
 
   this->SetStatic(this->IsStatic());
 }
@@ -344,8 +408,6 @@ void Link::Init()
 //////////////////////////////////////////////////
 void Link::Fini()
 {
-  this->dataPtr->updateConnection.reset();
-
   this->dataPtr->attachedModels.clear();
   this->dataPtr->parentJoints.clear();
   this->dataPtr->childJoints.clear();
@@ -412,6 +474,12 @@ void Link::Fini()
   }
   this->connections.clear();
 
+  // Stop being updated by the world
+  if (this->world)
+    this->world->_SetLinkActive(this, false);
+  this->dataPtr->active = false;
+  this->dataPtr->windEnabled = false;
+
   delete this->dataPtr->publishDataMutex;
   this->dataPtr->publishDataMutex = NULL;
 
@@ -584,7 +652,7 @@ void Link::SetLaserRetro(float _retro)
 }
 
 //////////////////////////////////////////////////
-void Link::Update(const common::UpdateInfo & /*_info*/)
+void Link::Update(const common::UpdateInfo &_info)
 {
 #ifdef HAVE_OPENAL
   if (this->dataPtr->audioSink)
@@ -610,19 +678,15 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
      this->dataPtr->enabledSignal(this->dataPtr->enabled);
    }*/
 
-  if (!this->IsStatic() && !this->dataPtr->wrenchMsgs.empty())
+  // Apply the wrenches received since the last update
+  this->dataPtr->wrenchPending = false;
+  if (!this->IsStatic())
   {
-    std::vector<msgs::Wrench> messages;
-    {
-      std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
-      messages = this->dataPtr->wrenchMsgs;
-      this->dataPtr->wrenchMsgs.clear();
-    }
-
-    for (auto it : messages)
-    {
-      this->ProcessWrenchMsg(it);
-    }
+    this->dataPtr->wrenches.Drain([this](const LinkWrench &_wrench)
+        {
+          this->AddLinkForce(_wrench.force, _wrench.offset);
+          this->AddRelativeTorque(_wrench.torque);
+        });
   }
 
   // Update the batteries.
@@ -630,6 +694,9 @@ void Link::Update(const common::UpdateInfo & /*_info*/)
   {
     battery->Update();
   }
+
+  if (this->dataPtr->windEnabled)
+    this->UpdateWind(_info);
 }
 
 //////////////////////////////////////////////////
@@ -840,28 +907,49 @@ ignition::math::AxisAlignedBox Link::BoundingBox() const
 //////////////////////////////////////////////////
 void Link::SetWindMode(const bool _mode)
 {
+  const bool changed = this->WindMode() != _mode;
   this->sdf->GetElement("enable_wind")->Set(_mode);
 
-  if (!this->WindMode() && this->dataPtr->updateConnection)
+  if (!this->WindMode() && this->dataPtr->windEnabled)
     this->SetWindEnabled(false);
-  else if (this->WindMode() && !this->dataPtr->updateConnection)
+  else if (this->WindMode() && !this->dataPtr->windEnabled)
     this->SetWindEnabled(true);
+
+  if (changed)
+    event::Events::windModeChanged(this->GetScopedName());
 }
 
 /////////////////////////////////////////////////
 void Link::SetWindEnabled(const bool _enable)
 {
-  if (_enable)
-  {
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&Link::UpdateWind, this, std::placeholders::_1));
-  }
-  else
-  {
-    this->dataPtr->updateConnection.reset();
-    // Make sure wind velocity is null
+  this->dataPtr->windEnabled = _enable;
+
+  // Make sure wind velocity is null
+  if (!_enable)
     this->dataPtr->windLinearVel.Set(0, 0, 0);
-  }
+
+  this->UpdateActive();
+}
+
+//////////////////////////////////////////////////
+void Link::UpdateActive()
+{
+  bool active = this->dataPtr->windEnabled ||
+      !this->dataPtr->batteries.empty();
+#ifdef HAVE_OPENAL
+  active = active || this->dataPtr->audioSink ||
+      !this->dataPtr->audioSources.empty();
+#endif
+
+  if (!this->world || active == this->dataPtr->active)
+    return;
+
+  this->dataPtr->active = active;
+  this->world->_SetLinkActive(this, active);
+
+  // Don't lose the wrenches received while active
+  if (!active && this->dataPtr->wrenchPending)
+    this->world->_WakeLink(this);
 }
 
 //////////////////////////////////////////////////
@@ -1799,8 +1887,24 @@ void Link::OnWrenchMsg(ConstWrenchPtr &_msg)
     return;
   }
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->wrenchMsgMutex);
-  this->dataPtr->wrenchMsgs.push_back(*_msg);
+  LinkWrench wrench;
+  wrench.force = msgs::ConvertIgn(_msg->force());
+  wrench.torque = msgs::ConvertIgn(_msg->torque());
+  if (_msg->has_force_offset())
+    wrench.offset = msgs::ConvertIgn(_msg->force_offset());
+
+  if (!this->dataPtr->wrenches.Push(wrench))
+  {
+    gzwarn << "Link [" << this->GetName() << "] received more than ["
+        << LinkWrenchQueue::kCapacity << "] wrenches in one step, "
+        << "dropping one." << std::endl;
+    return;
+  }
+
+  // Have the world apply it in its next update, unless it updates this
+  // link anyway
+  if (!this->dataPtr->wrenchPending.exchange(true) && !this->dataPtr->active)
+    this->world->_WakeLink(this);
 }
 
 //////////////////////////////////////////////////
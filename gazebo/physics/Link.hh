@@ -79,7 +79,10 @@ namespace gazebo
       /// \param[in] _sdf SDF values to load from.
       public: virtual void UpdateParameters(sdf::ElementPtr _sdf) override;
 
-      /// \brief Update the collision.
+      /// \brief Update the audio, batteries and wind, and apply the
+      /// wrenches received. The world calls it at the beginning of its
+      /// update, every step for links with batteries, audio or wind, and
+      /// otherwise only after the link received a wrench.
       /// \param[in] _info Update information.
       public: void Update(const common::UpdateInfo &_info);
       using Base::Update;
@@ -672,6 +675,10 @@ namespace gazebo
       /// \param[in] _sdf SDF parameter.
       private: void LoadBattery(const sdf::ElementPtr _sdf);
 
+      /// \brief Tell the world whether to update this link every step,
+      /// depending on its batteries, audio and wind.
+      private: void UpdateActive();
+
       /// \brief Register items in the introspection service.
       protected: virtual void RegisterIntrospectionItems() override;
 
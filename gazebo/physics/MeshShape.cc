@@ -24,6 +24,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/CollisionMeshCache.hh"
 #include "gazebo/physics/MeshShape.hh"
 
 using namespace gazebo;
@@ -34,6 +35,8 @@ MeshShape::MeshShape(CollisionPtr _parent)
   : Shape(_parent)
 {
   this->submesh = NULL;
+  this->maxConvexHulls = 0;
+  this->maxHullVertices = 64;
   this->AddType(Base::MESH_SHAPE);
   sdf::initFile("mesh_shape.sdf", this->sdf);
 }
@@ -94,6 +97,62 @@ void MeshShape::Init()
       }
     }
   }
+
+  // Optional convex decomposition, a custom element of the mesh geometry
+  if (this->sdf->HasElement("gz:convex_decomposition"))
+  {
+    sdf::ElementPtr elem = this->sdf->GetElement("gz:convex_decomposition");
+    unsigned int maxHulls = 16;
+    unsigned int maxVertices = 64;
+    if (elem->HasElement("max_convex_hulls"))
+      maxHulls = elem->Get<unsigned int>("max_convex_hulls");
+    if (elem->HasElement("max_hull_vertices"))
+      maxVertices = elem->Get<unsigned int>("max_hull_vertices");
+    this->SetConvexDecomposition(maxHulls, maxVertices);
+  }
+}
+
+//////////////////////////////////////////////////
+void MeshShape::SetConvexDecomposition(const unsigned int _maxConvexHulls,
+    const unsigned int _maxHullVertices)
+{
+  if (_maxConvexHulls > 0 && _maxHullVertices < 4)
+  {
+    gzerr << "A convex hull needs at least 4 vertices, got ["
+          << _maxHullVertices << "]\n";
+    return;
+  }
+
+  this->maxConvexHulls = _maxConvexHulls;
+  this->maxHullVertices = _maxHullVertices;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshShape::MaxConvexHulls() const
+{
+  return this->maxConvexHulls;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshShape::MaxHullVertices() const
+{
+  return this->maxHullVertices;
+}
+
+//////////////////////////////////////////////////
+CollisionMeshDataPtr MeshShape::CollisionData() const
+{
+  bool centered = false;
+  if (this->submesh && this->sdf->HasElement("submesh"))
+  {
+    sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+    centered = submeshElem->HasElement("center") &&
+        submeshElem->Get<bool>("center");
+  }
+
+  return CollisionMeshCache::Instance()->Data(this->mesh, this->submesh,
+      this->sdf->Get<ignition::math::Vector3d>("scale"), centered,
+      this->maxConvexHulls, this->maxHullVertices);
 }
 
 //////////////////////////////////////////////////
@@ -69,6 +69,40 @@ namespace gazebo
       /// \param[in] _scale Scaling factor.
       public: void SetScale(const ignition::math::Vector3d &_scale);
 
+      /// \brief Replace the collision triangles by a set of convex hulls,
+      /// which is much cheaper for mesh to mesh contacts. The hulls are
+      /// generated when the shape is initialized and shared with the other
+      /// collisions that use the same mesh, scale and settings. The same
+      /// settings can be given in SDF:
+      ///
+      ///     <mesh>
+      ///       <uri>...</uri>
+      ///       <gz:convex_decomposition>
+      ///         <max_convex_hulls>16</max_convex_hulls>
+      ///         <max_hull_vertices>64</max_hull_vertices>
+      ///       </gz:convex_decomposition>
+      ///     </mesh>
+      ///
+      /// ODE creates one convex geom per hull, which collides with
+      /// primitives, planes, heightmaps and other hulls but not with
+      /// triangle meshes. Bullet groups the hulls in a compound shape.
+      ///
+      /// \param[in] _maxConvexHulls Maximum number of hulls, zero to use
+      /// the mesh triangles.
+      /// \param[in] _maxHullVertices Maximum number of vertices per hull.
+      /// \sa ConvexDecomposition
+      public: void SetConvexDecomposition(const unsigned int _maxConvexHulls,
+                  const unsigned int _maxHullVertices = 64);
+
+      /// \brief Get the maximum number of convex hulls used for collision.
+      /// \return Maximum number of hulls, zero if the mesh triangles are
+      /// used.
+      public: unsigned int MaxConvexHulls() const;
+
+      /// \brief Get the maximum number of vertices per convex hull.
+      /// \return Maximum number of vertices per hull.
+      public: unsigned int MaxHullVertices() const;
+
       /// \brief Populate a msgs::Geometry message with data from this
       /// shape.
       /// \param[out] _msg Message to fill.
@@ -78,11 +112,24 @@ namespace gazebo
       /// \param[in] _msg Message that contains triangle mesh info.
       public: virtual void ProcessMsg(const msgs::Geometry &_msg);
 
+      /// \brief Get the scaled triangle data of the mesh or submesh, or of
+      /// its convex hulls if enabled. The data is shared through
+      /// CollisionMeshCache with every collision that uses the same mesh,
+      /// submesh, scale and convex decomposition.
+      /// \return The collision data, null if the mesh isn't loaded.
+      protected: CollisionMeshDataPtr CollisionData() const;
+
       /// \brief Pointer to the mesh data.
       protected: const common::Mesh *mesh;
 
       /// \brief The submesh to use from within the parent mesh.
       protected: common::SubMesh *submesh;
+
+      /// \brief Maximum number of convex hulls, zero to use the triangles.
+      protected: unsigned int maxConvexHulls;
+
+      /// \brief Maximum number of vertices per convex hull.
+      protected: unsigned int maxHullVertices;
     };
     /// \}
   }
@@ -126,6 +126,10 @@ void Model::Load(sdf::ElementPtr _sdf)
   if (this->sdf->HasElement("allow_auto_disable"))
     this->SetAutoDisable(this->sdf->Get<bool>("allow_auto_disable"));
 
+  // Optional rate group, a custom element of the model
+  if (this->sdf->HasElement("gz:step_multiple"))
+    this->SetStepMultiple(this->sdf->Get<unsigned int>("gz:step_multiple"));
+
   this->LoadLinks();
 
   this->LoadModels();
@@ -1454,6 +1458,33 @@ bool Model::GetAutoDisable() const
   return this->sdf->Get<bool>("allow_auto_disable");
 }
 
+/////////////////////////////////////////////////
+void Model::SetStepMultiple(const unsigned int _multiple)
+{
+  if (_multiple == 0)
+  {
+    gzerr << "Step multiple of model [" << this->GetScopedName()
+          << "] must be at least 1" << std::endl;
+    return;
+  }
+
+  if (_multiple > 1 && this->world->Physics()->GetType() != "ode")
+  {
+    gzwarn << "Physics engine [" << this->world->Physics()->GetType()
+           << "] doesn't support rate groups, model ["
+           << this->GetScopedName() << "] is stepped with the world"
+           << std::endl;
+  }
+
+  this->stepMultiple = _multiple;
+}
+
+/////////////////////////////////////////////////
+unsigned int Model::StepMultiple() const
+{
+  return this->stepMultiple;
+}
+
 /////////////////////////////////////////////////
 void Model::SetSelfCollide(bool _self_collide)
 {
@@ -344,6 +344,21 @@ namespace gazebo
       /// \return True if auto disable is allowed for this model.
       public: bool GetAutoDisable() const;
 
+      /// \brief Put the model in a rate group, whose physics step lasts a
+      /// multiple of the world step. The model is integrated once every
+      /// _multiple world steps, under the average of the forces applied
+      /// meanwhile. Models of other groups look frozen to it between their
+      /// steps, and the other way around. Set from the <gz:step_multiple>
+      /// custom element. Only top level models of ODE worlds use it; it
+      /// applies to their nested models too.
+      /// \param[in] _multiple Number of world steps per step of the model,
+      /// 1 to step it with the world.
+      public: void SetStepMultiple(const unsigned int _multiple);
+
+      /// \brief Get the number of world steps per step of the model.
+      /// \return Number of world steps per step of the model.
+      public: unsigned int StepMultiple() const;
+
       /// \brief Load all plugins
       ///
       /// Load all plugins specified in the SDF for the model.
@@ -559,6 +574,9 @@ namespace gazebo
 
       /// \brief SDF Model DOM object
       private: const sdf::Model *modelSDFDom = nullptr;
+
+      /// \brief Number of world steps per step of the model.
+      private: unsigned int stepMultiple = 1;
     };
     /// \}
   }
@@ -42,6 +42,7 @@ namespace gazebo
     class Light;
     class Link;
     class Collision;
+    class CollisionMeshData;
     class FrictionPyramid;
     class Gripper;
     class Joint;
@@ -50,8 +51,11 @@ namespace gazebo
     class PresetManager;
     class UserCmd;
     class UserCmdManager;
+    class UpdateScheduler;
+    class SleepManager;
     class PhysicsEngine;
     class Wind;
+    class WindField;
     class Atmosphere;
     class Mass;
     class Road;
@@ -137,6 +141,22 @@ namespace gazebo
     /// \brief Shared pointer to a UserCmdManager object
     typedef std::shared_ptr<UserCmdManager> UserCmdManagerPtr;
 
+    /// \def  UpdateSchedulerPtr
+    /// \brief Shared pointer to an UpdateScheduler object
+    typedef std::shared_ptr<UpdateScheduler> UpdateSchedulerPtr;
+
+    /// \def  SleepManagerPtr
+    /// \brief Shared pointer to a SleepManager object
+    typedef std::shared_ptr<SleepManager> SleepManagerPtr;
+
+    /// \def  WindFieldPtr
+    /// \brief Shared pointer to a WindField object
+    typedef std::shared_ptr<WindField> WindFieldPtr;
+
+    /// \def  CollisionMeshDataPtr
+    /// \brief Shared pointer to a CollisionMeshData object
+    typedef std::shared_ptr<CollisionMeshData> CollisionMeshDataPtr;
+
     /// \def ShapePtr
     /// \brief Boost shared pointer to a Shape object
     typedef boost::shared_ptr<Shape> ShapePtr;
@@ -17,7 +17,6 @@
 
 #include <string>
 #include <vector>
-#include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <ignition/math/Kmeans.hh>
 #include <ignition/math/Rand.hh>
@@ -101,36 +100,14 @@ bool Population::PopulateOne(const sdf::ElementPtr _population)
     return false;
   }
 
-  // Create an sdf containing the model description.
-  sdf::SDF sdf;
-  sdf.SetFromString("<sdf version ='" + std::string(SDF_PROTOCOL_VERSION) +
-    "'>" + params.modelSdf + "</sdf>");
+  // Insert all the clones at once, copying the model description.
+  std::vector<ignition::math::Pose3d> poses;
+  poses.reserve(objects.size());
+  for (auto const &object : objects)
+    poses.emplace_back(object, ignition::math::Quaterniond::Identity);
 
-  for (size_t i = 0; i < objects.size(); ++i)
-  {
-    ignition::math::Vector3d p(objects[i].X(), objects[i].Y(), objects[i].Z());
-
-    // Create a unique model for each clone.
-    std::string cloneSdf = sdf.ToString();
-    std::string delim = "model name='";
-    size_t first = cloneSdf.find(delim) + delim.size();
-    size_t last = cloneSdf.find("'", first);
-    std::string newName = params.modelName + std::string("_clone_") +
-      boost::lexical_cast<std::string>(i);
-    cloneSdf.replace(first, last - first, newName);
-
-    // Insert the <pose> element.
-    std::string endDelim = "'>";
-    first = cloneSdf.find(delim) + delim.size();
-    last = cloneSdf.find(endDelim, first);
-    std::string pose = "\n    <pose>" +
-      boost::lexical_cast<std::string>(p.X()) + " " +
-      boost::lexical_cast<std::string>(p.Y()) + " " +
-      boost::lexical_cast<std::string>(p.Z()) + " 0 0 0</pose>";
-    cloneSdf.insert(last + endDelim.size(), pose);
-
-    this->dataPtr->world->InsertModelString(cloneSdf);
-  }
+  this->dataPtr->world->InsertModels(params.modelElem, poses,
+      params.modelName + "_clone_");
 
   return true;
 }
@@ -160,6 +137,7 @@ bool Population::ParseSdf(sdf::ElementPtr _population,
   if (!this->ElementFromSdf(_population, "model", model))
     return false;
 
+  _params.modelElem = model;
   _params.modelSdf = model->ToString("");
   _params.modelName = model->Get<std::string>("name");
 
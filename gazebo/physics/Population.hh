@@ -68,6 +68,9 @@ namespace gazebo
       /// \brief Contains the sdf representation of the model.
       public: std::string modelSdf;
 
+      /// \brief The model element, copied for each model.
+      public: sdf::ElementPtr modelElem;
+
       /// \brief Number of models to spawn.
       public: int modelCount;
 
@@ -0,0 +1,514 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/physics/World.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Sleep state of a top level model.
+    class ModelSleep
+    {
+      /// \brief How long the model rested, in seconds.
+      public: double restTime = 0;
+
+      /// \brief True if the model sleeps.
+      public: bool sleeping = false;
+
+      /// \brief Simulation time the model fell asleep.
+      public: common::Time since;
+
+      /// \brief Id of the island the model fell asleep with.
+      public: uint64_t island = 0;
+
+      /// \brief Last update the model was found in the world.
+      public: uint64_t update = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for SleepManager.
+    class SleepManagerPrivate
+    {
+      /// \brief Wake up the models of the world which sleep.
+      public: void WakeAll();
+
+      /// \brief World whose models sleep.
+      public: World *world = nullptr;
+
+      /// \brief True to put resting models to sleep.
+      public: bool enabled = false;
+
+      /// \brief Value of ContactManager::NeverDropContacts before sleeping
+      /// was enabled.
+      public: bool neverDropContacts = false;
+
+      /// \brief Linear velocity under which a link rests.
+      public: double linearThreshold = 0.01;
+
+      /// \brief Angular velocity under which a link rests.
+      public: double angularThreshold = 0.01;
+
+      /// \brief Time an island rests before it falls asleep.
+      public: double restTime = 0.5;
+
+      /// \brief Sleep state of the models, by model id.
+      public: std::unordered_map<uint32_t, ModelSleep> states;
+
+      /// \brief Number of sleeping models.
+      public: unsigned int sleepingCount = 0;
+
+      /// \brief Id of the next island to fall asleep.
+      public: uint64_t nextIsland = 1;
+
+      /// \brief Number of updates.
+      public: uint64_t updateCount = 0;
+
+      /// \brief Islands to wake up in the next update.
+      public: std::vector<uint64_t> wakeIslands;
+
+      /// \brief Dynamic models of the current update, reused.
+      public: std::vector<Model *> models;
+
+      /// \brief Sleep states of the models of the current update, reused.
+      public: std::vector<ModelSleep *> modelStates;
+
+      /// \brief Index of the models of the current update, by id.
+      public: std::unordered_map<uint32_t, unsigned int> indices;
+
+      /// \brief Union-find parents of the models, for the islands.
+      public: std::vector<unsigned int> parents;
+
+      /// \brief True for the islands holding a moving model.
+      public: std::vector<char> moving;
+
+      /// \brief True for the islands whose awake models all rested long
+      /// enough.
+      public: std::vector<char> rested;
+
+      /// \brief Ids given to the islands falling asleep, reused.
+      public: std::vector<uint64_t> sleepIslands;
+
+      /// \brief Sleeping islands merged into an island falling asleep, as
+      /// pairs of previous and new ids, reused.
+      public: std::vector<std::pair<uint64_t, uint64_t>> mergedIslands;
+
+      /// \brief Protects the sleep states.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Call a function for every link of a model, including the links
+/// of its nested models.
+/// \param[in] _model Model.
+/// \param[in] _func Function called for each link.
+template<typename F>
+static void ForEachLink(const Model &_model, F _func)
+{
+  for (auto const &link : _model.GetLinks())
+    _func(*link);
+  for (auto const &nested : _model.NestedModels())
+    ForEachLink(*nested, _func);
+}
+
+/////////////////////////////////////////////////
+/// \brief Enable or disable every link of a model.
+/// \param[in] _model Model.
+/// \param[in] _enable True to enable the links.
+static void SetLinksEnabled(const Model &_model, const bool _enable)
+{
+  ForEachLink(_model, [_enable](const Link &_link)
+      {
+        _link.SetEnabled(_enable);
+      });
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a link of a model is enabled.
+/// \param[in] _model Model.
+/// \return True if a link is enabled.
+static bool AnyLinkEnabled(const Model &_model)
+{
+  bool enabled = false;
+  ForEachLink(_model, [&enabled](const Link &_link)
+      {
+        enabled = enabled || _link.GetEnabled();
+      });
+  return enabled;
+}
+
+/////////////////////////////////////////////////
+void SleepManagerPrivate::WakeAll()
+{
+  for (unsigned int i = 0; i < this->world->ModelCount(); ++i)
+  {
+    ModelPtr model = this->world->ModelByIndex(i);
+    auto iter = this->states.find(model->GetId());
+    if (iter != this->states.end() && iter->second.sleeping)
+      SetLinksEnabled(*model, true);
+  }
+  this->states.clear();
+  this->wakeIslands.clear();
+  this->sleepingCount = 0;
+}
+
+/////////////////////////////////////////////////
+SleepManager::SleepManager(World *_world)
+  : dataPtr(new SleepManagerPrivate)
+{
+  this->dataPtr->world = _world;
+}
+
+/////////////////////////////////////////////////
+SleepManager::~SleepManager()
+{
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetEnabled(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_enable == this->dataPtr->enabled)
+    return;
+  this->dataPtr->enabled = _enable;
+
+  // Contacts are needed every step to find the islands
+  ContactManager *contactManager =
+      this->dataPtr->world->Physics()->GetContactManager();
+  if (_enable)
+  {
+    this->dataPtr->neverDropContacts = contactManager->NeverDropContacts();
+    contactManager->SetNeverDropContacts(true);
+  }
+  else
+  {
+    contactManager->SetNeverDropContacts(this->dataPtr->neverDropContacts);
+    this->dataPtr->WakeAll();
+  }
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::Enabled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetLinearThreshold(const double _vel)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->linearThreshold = _vel;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::LinearThreshold() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->linearThreshold;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetAngularThreshold(const double _vel)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->angularThreshold = _vel;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::AngularThreshold() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->angularThreshold;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::SetRestTime(const double _time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->restTime = _time;
+}
+
+/////////////////////////////////////////////////
+double SleepManager::RestTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->restTime;
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::Sleeping(const Model &_model) const
+{
+  common::Time since;
+  return this->Sleeping(_model, since);
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::Sleeping(const Model &_model, common::Time &_since) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->states.find(_model.GetId());
+  if (iter == this->dataPtr->states.end() || !iter->second.sleeping)
+    return false;
+
+  _since = iter->second.since;
+  return true;
+}
+
+/////////////////////////////////////////////////
+unsigned int SleepManager::SleepingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->sleepingCount;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Wake(const Model &_model)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->states.find(_model.GetId());
+  if (iter == this->dataPtr->states.end())
+    return;
+
+  ModelSleep &state = iter->second;
+  state.restTime = 0;
+  if (!state.sleeping)
+    return;
+
+  // The rest of the island wakes up in the next update
+  SetLinksEnabled(_model, true);
+  state.sleeping = false;
+  --this->dataPtr->sleepingCount;
+  this->dataPtr->wakeIslands.push_back(state.island);
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->WakeAll();
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Update(const common::Time &_simTime, const double _dt)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  SleepManagerPrivate &d = *this->dataPtr;
+  if (!d.enabled)
+    return;
+  ++d.updateCount;
+
+  // Dynamic top level models
+  d.models.clear();
+  d.modelStates.clear();
+  d.indices.clear();
+  for (unsigned int i = 0; i < d.world->ModelCount(); ++i)
+  {
+    Model *model = d.world->ModelByIndex(i).get();
+    if (model->IsStatic() || model->HasType(Base::ACTOR))
+      continue;
+
+    d.indices[model->GetId()] = d.models.size();
+    d.models.push_back(model);
+    ModelSleep &state = d.states[model->GetId()];
+    state.update = d.updateCount;
+    d.modelStates.push_back(&state);
+  }
+
+  // Forget the models which were removed
+  for (auto iter = d.states.begin(); iter != d.states.end();)
+  {
+    if (iter->second.update != d.updateCount)
+    {
+      if (iter->second.sleeping)
+        --d.sleepingCount;
+      iter = d.states.erase(iter);
+    }
+    else
+      ++iter;
+  }
+
+  // Islands of models touching each other
+  const unsigned int count = d.models.size();
+  d.parents.resize(count);
+  for (unsigned int i = 0; i < count; ++i)
+    d.parents[i] = i;
+  auto find = [&d](unsigned int _i)
+  {
+    while (d.parents[_i] != _i)
+    {
+      d.parents[_i] = d.parents[d.parents[_i]];
+      _i = d.parents[_i];
+    }
+    return _i;
+  };
+
+  ContactManager *contactManager = d.world->Physics()->GetContactManager();
+  const std::vector<Contact *> &contacts = contactManager->GetContacts();
+  for (unsigned int i = 0; i < contactManager->GetContactCount(); ++i)
+  {
+    const Contact *contact = contacts[i];
+    if (!contact->collision1 || !contact->collision2)
+      continue;
+
+    auto index1 =
+        d.indices.find(contact->collision1->GetParentModel()->GetId());
+    auto index2 =
+        d.indices.find(contact->collision2->GetParentModel()->GetId());
+    if (index1 != d.indices.end() && index2 != d.indices.end())
+      d.parents[find(index1->second)] = find(index2->second);
+  }
+
+  // Rest times, and islands disturbed
+  d.moving.assign(count, 0);
+  d.rested.assign(count, 1);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const Model &model = *d.models[i];
+    ModelSleep &state = *d.modelStates[i];
+    const unsigned int root = find(i);
+
+    if (state.sleeping)
+    {
+      // Woken up by the physics engine
+      if (AnyLinkEnabled(model))
+      {
+        d.moving[root] = 1;
+        d.wakeIslands.push_back(state.island);
+      }
+      continue;
+    }
+
+    bool resting = true;
+    ForEachLink(model, [&](const Link &_link)
+        {
+          resting = resting &&
+              _link.WorldCoGLinearVel().Length() < d.linearThreshold &&
+              _link.WorldAngularVel().Length() < d.angularThreshold;
+        });
+
+    state.restTime = resting ? state.restTime + _dt : 0;
+    if (!resting)
+      d.moving[root] = 1;
+    if (state.restTime < d.restTime)
+      d.rested[root] = 0;
+  }
+
+  // Wake up the sleeping models touched by moving ones, and the islands
+  // they fell asleep with
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ModelSleep &state = *d.modelStates[i];
+    if (!state.sleeping)
+      continue;
+
+    const unsigned int root = find(i);
+    if (d.moving[root] || std::find(d.wakeIslands.begin(),
+        d.wakeIslands.end(), state.island) != d.wakeIslands.end())
+    {
+      d.moving[root] = 1;
+      SetLinksEnabled(*d.models[i], true);
+      state.sleeping = false;
+      state.restTime = 0;
+      --d.sleepingCount;
+    }
+  }
+  d.wakeIslands.clear();
+
+  // Islands which rested long enough to sleep
+  std::vector<uint64_t> &islands = d.sleepIslands;
+  islands.assign(count, 0);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const unsigned int root = find(i);
+    if (!d.modelStates[i]->sleeping && !d.moving[root] && d.rested[root] &&
+        !islands[root])
+    {
+      islands[root] = d.nextIsland++;
+    }
+  }
+
+  // Sleeping models touching them join them, along with their islands.
+  // Islands only asleep keep their ids, even if their models stopped
+  // touching once disabled.
+  d.mergedIslands.clear();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const ModelSleep &state = *d.modelStates[i];
+    const unsigned int root = find(i);
+    if (state.sleeping && islands[root] && state.island != islands[root])
+      d.mergedIslands.emplace_back(state.island, islands[root]);
+  }
+  for (unsigned int i = 0; i < count && !d.mergedIslands.empty(); ++i)
+  {
+    ModelSleep &state = *d.modelStates[i];
+    if (!state.sleeping)
+      continue;
+    for (const auto &merged : d.mergedIslands)
+    {
+      if (state.island == merged.first)
+      {
+        state.island = merged.second;
+        break;
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    ModelSleep &state = *d.modelStates[i];
+    const unsigned int root = find(i);
+    if (state.sleeping || !islands[root])
+      continue;
+
+    d.models[i]->ResetPhysicsStates();
+    SetLinksEnabled(*d.models[i], false);
+    if (AnyLinkEnabled(*d.models[i]))
+    {
+      gzwarn << "Physics engine [" << d.world->Physics()->GetType()
+          << "] can't disable links, models won't sleep." << std::endl;
+      d.enabled = false;
+      contactManager->SetNeverDropContacts(d.neverDropContacts);
+      d.WakeAll();
+      return;
+    }
+
+    state.island = islands[root];
+    state.sleeping = true;
+    state.since = _simTime;
+    ++d.sleepingCount;
+  }
+}
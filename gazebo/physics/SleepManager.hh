@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+#define GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class SleepManagerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SleepManager SleepManager.hh physics/physics.hh
+    /// \brief Puts resting models to sleep, whatever the physics engine.
+    ///
+    /// Models touching each other form an island. Once every model of an
+    /// island moved slower than the thresholds for the rest time, the
+    /// links of the island are disabled with Link::SetEnabled. The physics
+    /// engine then stops simulating them and reporting their poses, so
+    /// that the world neither updates, publishes nor logs them.
+    ///
+    /// A sleeping island wakes up as a whole when one of its links is
+    /// enabled again: by the physics engine when a force is applied or an
+    /// awake body touches it, or through Wake. An awake model moving while
+    /// it touches a sleeping model also wakes the sleeping model's island.
+    ///
+    /// Sleeping is disabled by default. It requires the contacts of every
+    /// step, see ContactManager::SetNeverDropContacts, and a physics engine
+    /// which can disable links.
+    class GZ_PHYSICS_VISIBLE SleepManager
+    {
+      /// \brief Constructor.
+      /// \param[in] _world World whose models sleep.
+      public: explicit SleepManager(World *_world);
+
+      /// \brief Destructor.
+      public: virtual ~SleepManager();
+
+      /// \brief Set whether resting models are put to sleep. Disabling it
+      /// wakes every sleeping model.
+      /// \param[in] _enable True to put resting models to sleep.
+      public: void SetEnabled(const bool _enable);
+
+      /// \brief Get whether resting models are put to sleep.
+      /// \return True if resting models are put to sleep.
+      public: bool Enabled() const;
+
+      /// \brief Set the linear velocity under which a link rests.
+      /// \param[in] _vel Velocity in m/s.
+      public: void SetLinearThreshold(const double _vel);
+
+      /// \brief Get the linear velocity under which a link rests.
+      /// \return Velocity in m/s.
+      public: double LinearThreshold() const;
+
+      /// \brief Set the angular velocity under which a link rests.
+      /// \param[in] _vel Velocity in rad/s.
+      public: void SetAngularThreshold(const double _vel);
+
+      /// \brief Get the angular velocity under which a link rests.
+      /// \return Velocity in rad/s.
+      public: double AngularThreshold() const;
+
+      /// \brief Set how long an island rests before it falls asleep.
+      /// \param[in] _time Time in seconds of simulation.
+      public: void SetRestTime(const double _time);
+
+      /// \brief Get how long an island rests before it falls asleep.
+      /// \return Time in seconds of simulation.
+      public: double RestTime() const;
+
+      /// \brief Get whether a model sleeps.
+      /// \param[in] _model Top level model.
+      /// \return True if the model sleeps.
+      public: bool Sleeping(const Model &_model) const;
+
+      /// \brief Get whether a model sleeps, and since when.
+      /// \param[in] _model Top level model.
+      /// \param[out] _since Simulation time the model fell asleep, set only
+      /// if it sleeps.
+      /// \return True if the model sleeps.
+      public: bool Sleeping(const Model &_model, common::Time &_since) const;
+
+      /// \brief Get the number of sleeping models.
+      /// \return Number of top level models asleep.
+      public: unsigned int SleepingCount() const;
+
+      /// \brief Wake a model up, along with its island.
+      /// \param[in] _model Top level model.
+      public: void Wake(const Model &_model);
+
+      /// \brief Wake every model up, and forget how long they rested.
+      public: void Reset();
+
+      /// \brief Update the islands after a physics step, put those resting
+      /// to sleep and wake up those disturbed. Called by the world.
+      /// \param[in] _simTime Current simulation time.
+      /// \param[in] _dt Duration of the step, in seconds.
+      public: void Update(const common::Time &_simTime, const double _dt);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SleepManagerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class SleepManagerTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(SleepManagerTest, Parameters)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::SleepManagerPtr mgr = world->SleepMgr();
+  ASSERT_TRUE(mgr != nullptr);
+  physics::ContactManager *contactManager =
+      world->Physics()->GetContactManager();
+
+  // Disabled by default
+  EXPECT_FALSE(mgr->Enabled());
+  EXPECT_FALSE(contactManager->NeverDropContacts());
+  EXPECT_EQ(0u, mgr->SleepingCount());
+
+  // Islands need the contacts of every step
+  mgr->SetEnabled(true);
+  EXPECT_TRUE(mgr->Enabled());
+  EXPECT_TRUE(contactManager->NeverDropContacts());
+  mgr->SetEnabled(false);
+  EXPECT_FALSE(contactManager->NeverDropContacts());
+
+  mgr->SetLinearThreshold(0.1);
+  mgr->SetAngularThreshold(0.2);
+  mgr->SetRestTime(1.5);
+  EXPECT_DOUBLE_EQ(0.1, mgr->LinearThreshold());
+  EXPECT_DOUBLE_EQ(0.2, mgr->AngularThreshold());
+  EXPECT_DOUBLE_EQ(1.5, mgr->RestTime());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SleepManagerTest, Islands)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Two stacked boxes, and one on its own
+  this->SpawnBox("box1", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  this->SpawnBox("box2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 1.5));
+  this->SpawnBox("box3", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5));
+  physics::ModelPtr box1 = world->ModelByName("box1");
+  physics::ModelPtr box2 = world->ModelByName("box2");
+  physics::ModelPtr box3 = world->ModelByName("box3");
+  ASSERT_TRUE(box1 != nullptr);
+  ASSERT_TRUE(box2 != nullptr);
+  ASSERT_TRUE(box3 != nullptr);
+
+  physics::SleepManagerPtr mgr = world->SleepMgr();
+  mgr->SetRestTime(0.2);
+  mgr->SetEnabled(true);
+
+  // The boxes settle, then fall asleep
+  world->Step(1000);
+  EXPECT_EQ(3u, mgr->SleepingCount());
+  for (auto box : {box1, box2, box3})
+  {
+    common::Time since;
+    EXPECT_TRUE(mgr->Sleeping(*box, since));
+    EXPECT_GT(since, common::Time::Zero);
+    EXPECT_LE(since, world->SimTime());
+    EXPECT_FALSE(box->GetLink()->GetEnabled());
+  }
+
+  // Sleeping boxes don't move
+  const ignition::math::Pose3d pose2 = box2->WorldPose();
+  world->Step(100);
+  EXPECT_EQ(pose2, box2->WorldPose());
+
+  // A force wakes the box up, but not the other island
+  box3->GetLink()->AddForce(ignition::math::Vector3d(0, 0, 1));
+  world->Step(1);
+  EXPECT_FALSE(mgr->Sleeping(*box3));
+  EXPECT_TRUE(box3->GetLink()->GetEnabled());
+  EXPECT_TRUE(mgr->Sleeping(*box1));
+  EXPECT_TRUE(mgr->Sleeping(*box2));
+  EXPECT_EQ(2u, mgr->SleepingCount());
+
+  // Waking a box wakes its island
+  mgr->Wake(*box1);
+  EXPECT_FALSE(mgr->Sleeping(*box1));
+  world->Step(1);
+  EXPECT_FALSE(mgr->Sleeping(*box2));
+  EXPECT_TRUE(box2->GetLink()->GetEnabled());
+
+  // A box dropped on a sleeping one lands on it
+  world->Step(1000);
+  EXPECT_TRUE(mgr->Sleeping(*box3));
+  this->SpawnBox("box4", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 3));
+  physics::ModelPtr box4 = world->ModelByName("box4");
+  ASSERT_TRUE(box4 != nullptr);
+  world->Step(2000);
+  EXPECT_NEAR(1.5, box4->WorldPose().Pos().Z(), 0.01);
+  EXPECT_NEAR(0.5, box3->WorldPose().Pos().Z(), 0.01);
+
+  // Disabling sleeping wakes everything up
+  mgr->SetEnabled(false);
+  EXPECT_EQ(0u, mgr->SleepingCount());
+  for (auto box : {box1, box2, box3, box4})
+  {
+    EXPECT_FALSE(mgr->Sleeping(*box));
+    EXPECT_TRUE(box->GetLink()->GetEnabled());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SleepManagerTest, Reset)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+
+  physics::SleepManagerPtr mgr = world->SleepMgr();
+  mgr->SetRestTime(0.2);
+  mgr->SetEnabled(true);
+  world->Step(500);
+  EXPECT_TRUE(mgr->Sleeping(*box));
+
+  // Resetting the world wakes the models up
+  world->Reset();
+  EXPECT_FALSE(mgr->Sleeping(*box));
+  EXPECT_TRUE(box->GetLink()->GetEnabled());
+  EXPECT_TRUE(mgr->Enabled());
+
+  // Removed models are forgotten
+  world->Step(500);
+  EXPECT_EQ(1u, mgr->SleepingCount());
+  world->RemoveModel("box");
+  world->Step(1);
+  EXPECT_EQ(0u, mgr->SleepingCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
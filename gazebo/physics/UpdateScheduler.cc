@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/UpdateScheduler.hh"
+#include "gazebo/util/ProfileManager.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief An update connected to the scheduler.
+    class UpdateTask
+    {
+      /// \brief Connection id.
+      public: int id = -1;
+
+      /// \brief Update function.
+      public: std::function<void (const common::UpdateInfo &)> update;
+
+      /// \brief Resources read, sorted.
+      public: std::vector<std::string> reads;
+
+      /// \brief Resources written, sorted.
+      public: std::vector<std::string> writes;
+
+      /// \brief True if the update is profiled.
+      public: bool profiled = false;
+
+      /// \brief Scope id of the update in the ProfileManager.
+      public: uint32_t profileId = 0;
+
+      /// \brief False once disconnected. An update disconnected while the
+      /// scheduler runs is skipped.
+      public: std::atomic_bool on{true};
+    };
+
+    /// \internal
+    /// \brief Private data for UpdateScheduler.
+    class UpdateSchedulerPrivate
+    {
+      /// \brief Connected updates, in connection order.
+      public: std::vector<std::shared_ptr<UpdateTask>> tasks;
+
+      /// \brief Updates split in stages, built again from the tasks after
+      /// they change.
+      public: std::vector<std::vector<std::shared_ptr<UpdateTask>>> stages;
+
+      /// \brief True when the stages need to be built again.
+      public: bool dirty = false;
+
+      /// \brief Id of the next connection.
+      public: int nextId = 0;
+
+      /// \brief True to run the updates of a stage in parallel.
+      public: std::atomic_bool parallel{true};
+
+      /// \brief Protects the tasks and the stages.
+      public: mutable std::mutex mutex;
+
+      /// \brief Makes sure only one thread runs the updates at a time.
+      public: std::mutex updateMutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Check whether two resources overlap, which is when they're the
+/// same or one is scoped under the other.
+/// \param[in] _a First resource.
+/// \param[in] _b Second resource.
+/// \return True if the resources overlap.
+static bool Overlap(const std::string &_a, const std::string &_b)
+{
+  const std::string &shorter = _a.size() <= _b.size() ? _a : _b;
+  const std::string &longer = _a.size() <= _b.size() ? _b : _a;
+  if (longer.compare(0, shorter.size(), shorter) != 0)
+    return false;
+  return longer.size() == shorter.size() ||
+      longer.compare(shorter.size(), 2, "::") == 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether any resource of a list overlaps one of another.
+/// \param[in] _a First list.
+/// \param[in] _b Second list.
+/// \return True if the lists overlap.
+static bool Overlap(const std::vector<std::string> &_a,
+    const std::vector<std::string> &_b)
+{
+  for (const auto &a : _a)
+  {
+    for (const auto &b : _b)
+    {
+      if (Overlap(a, b))
+        return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether two updates must not run at the same time.
+/// \param[in] _a First update.
+/// \param[in] _b Second update.
+/// \return True if the updates conflict.
+static bool Conflict(const UpdateTask &_a, const UpdateTask &_b)
+{
+  return Overlap(_a.writes, _b.writes) || Overlap(_a.writes, _b.reads) ||
+      Overlap(_a.reads, _b.writes);
+}
+
+/////////////////////////////////////////////////
+/// \brief Split updates in stages. An update goes in the stage after the
+/// last stage holding a conflicting update connected before it.
+/// \param[in] _tasks Updates, in connection order.
+/// \return Updates of each stage, in connection order.
+static std::vector<std::vector<std::shared_ptr<UpdateTask>>> Stages(
+    const std::vector<std::shared_ptr<UpdateTask>> &_tasks)
+{
+  std::vector<std::vector<std::shared_ptr<UpdateTask>>> stages;
+  std::vector<unsigned int> stage(_tasks.size(), 0);
+  for (size_t i = 0; i < _tasks.size(); ++i)
+  {
+    for (size_t j = 0; j < i; ++j)
+    {
+      if (stage[j] >= stage[i] && Conflict(*_tasks[i], *_tasks[j]))
+        stage[i] = stage[j] + 1;
+    }
+    if (stage[i] >= stages.size())
+      stages.resize(stage[i] + 1);
+    stages[stage[i]].push_back(_tasks[i]);
+  }
+  return stages;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run an update unless it was disconnected.
+/// \param[in] _task Update to run.
+/// \param[in] _info World update information.
+static void Run(const UpdateTask &_task, const common::UpdateInfo &_info)
+{
+  if (!_task.on)
+    return;
+
+  if (_task.profiled)
+  {
+    util::ProfileScope scope(_task.profileId);
+    _task.update(_info);
+  }
+  else
+    _task.update(_info);
+}
+
+/////////////////////////////////////////////////
+UpdateScheduler::UpdateScheduler()
+  : dataPtr(new UpdateSchedulerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+UpdateScheduler::~UpdateScheduler()
+{
+}
+
+/////////////////////////////////////////////////
+event::ConnectionPtr UpdateScheduler::Connect(
+    const std::function<void (const common::UpdateInfo &)> &_update,
+    const std::vector<std::string> &_reads,
+    const std::vector<std::string> &_writes, const std::string &_name)
+{
+  if (!_update)
+  {
+    gzerr << "Can't connect an empty update function\n";
+    return event::ConnectionPtr();
+  }
+
+  std::shared_ptr<UpdateTask> task(new UpdateTask);
+  task->update = _update;
+  task->reads = _reads;
+  task->writes = _writes;
+  std::sort(task->reads.begin(), task->reads.end());
+  std::sort(task->writes.begin(), task->writes.end());
+  if (!_name.empty())
+  {
+    task->profiled = true;
+    task->profileId =
+        util::ProfileManager::Instance()->ScopeId("plugin::" + _name);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  task->id = this->dataPtr->nextId++;
+  this->dataPtr->tasks.push_back(task);
+  this->dataPtr->dirty = true;
+
+  return event::ConnectionPtr(new event::Connection(this, task->id));
+}
+
+/////////////////////////////////////////////////
+void UpdateScheduler::Disconnect(int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &tasks = this->dataPtr->tasks;
+  auto iter = std::find_if(tasks.begin(), tasks.end(),
+      [_id](const std::shared_ptr<UpdateTask> &_task)
+      {
+        return _task->id == _id;
+      });
+  if (iter == tasks.end())
+    return;
+
+  (*iter)->on = false;
+  tasks.erase(iter);
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+unsigned int UpdateScheduler::ConnectionCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->tasks.size());
+}
+
+/////////////////////////////////////////////////
+unsigned int UpdateScheduler::StageCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->dirty)
+  {
+    this->dataPtr->stages = Stages(this->dataPtr->tasks);
+    this->dataPtr->dirty = false;
+  }
+  return static_cast<unsigned int>(this->dataPtr->stages.size());
+}
+
+/////////////////////////////////////////////////
+void UpdateScheduler::SetParallel(const bool _parallel)
+{
+  this->dataPtr->parallel = _parallel;
+}
+
+/////////////////////////////////////////////////
+bool UpdateScheduler::Parallel() const
+{
+  return this->dataPtr->parallel;
+}
+
+/////////////////////////////////////////////////
+void UpdateScheduler::Update(const common::UpdateInfo &_info)
+{
+  std::lock_guard<std::mutex> updateLock(this->dataPtr->updateMutex);
+  this->SetSignaled(true);
+
+  const bool parallel = this->dataPtr->parallel;
+
+  // Take a copy of the updates, so that they can connect and disconnect
+  // while running
+  std::vector<std::shared_ptr<UpdateTask>> tasks;
+  std::vector<std::vector<std::shared_ptr<UpdateTask>>> stages;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!parallel)
+    {
+      tasks = this->dataPtr->tasks;
+    }
+    else
+    {
+      if (this->dataPtr->dirty)
+      {
+        this->dataPtr->stages = Stages(this->dataPtr->tasks);
+        this->dataPtr->dirty = false;
+      }
+      stages = this->dataPtr->stages;
+    }
+  }
+
+  for (const auto &task : tasks)
+    Run(*task, _info);
+
+  for (const auto &stage : stages)
+  {
+    if (stage.size() == 1)
+    {
+      Run(*stage[0], _info);
+      continue;
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, stage.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            Run(*stage[i], _info);
+        });
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_UPDATESCHEDULER_HH_
+#define GAZEBO_PHYSICS_UPDATESCHEDULER_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class UpdateSchedulerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class UpdateScheduler UpdateScheduler.hh physics/physics.hh
+    /// \brief Runs plugin updates in parallel when they don't touch the same
+    /// data.
+    ///
+    /// Each update declares the resources it reads and the resources it
+    /// writes. A resource is a name, usually the scoped name of an entity
+    /// optionally followed by an aspect, e.g. "robot::joints". A name also
+    /// covers the names scoped under it, so "robot" conflicts with
+    /// "robot::joints". Two updates conflict when one writes a resource the
+    /// other reads or writes.
+    ///
+    /// Updates are grouped in stages: an update goes in the stage after the
+    /// last stage holding an update that was connected before it and
+    /// conflicts with it. Stages run one after the other, the updates of a
+    /// stage run in parallel. Conflicting updates therefore always run in
+    /// connection order, and the results match running every update in
+    /// connection order, whatever the number of threads.
+    ///
+    /// The world runs its scheduler after the worldUpdateBegin event and
+    /// before the models are updated.
+    class GZ_PHYSICS_VISIBLE UpdateScheduler : public event::Event
+    {
+      /// \brief Constructor.
+      public: UpdateScheduler();
+
+      /// \brief Destructor.
+      public: virtual ~UpdateScheduler();
+
+      /// \brief Connect an update.
+      /// \param[in] _update Update function. It's called from a worker
+      /// thread and must only access the resources it declares.
+      /// \param[in] _reads Resources read by the update.
+      /// \param[in] _writes Resources written by the update.
+      /// \param[in] _name Name of the update, usually the name of the
+      /// plugin. Named updates are profiled as "plugin::<name>" by the
+      /// util::ProfileManager.
+      /// \return A Connection object, which will automatically call
+      /// Disconnect when it goes out of scope.
+      public: event::ConnectionPtr Connect(
+                  const std::function<void (const common::UpdateInfo &)>
+                  &_update, const std::vector<std::string> &_reads,
+                  const std::vector<std::string> &_writes,
+                  const std::string &_name = "");
+
+      /// \brief Disconnect an update.
+      /// \param[in] _id The id of the connection to disconnect.
+      public: virtual void Disconnect(int _id);
+
+      /// \brief Get the number of connected updates.
+      /// \return Number of updates.
+      public: unsigned int ConnectionCount() const;
+
+      /// \brief Get the number of stages the updates are split in.
+      /// \return Number of stages.
+      public: unsigned int StageCount() const;
+
+      /// \brief Set whether the updates of a stage run in parallel. When
+      /// false, every update runs in connection order on the calling thread.
+      /// \param[in] _parallel True to run in parallel.
+      public: void SetParallel(const bool _parallel);
+
+      /// \brief Get whether the updates of a stage run in parallel.
+      /// \return True if the updates run in parallel.
+      public: bool Parallel() const;
+
+      /// \brief Run all the updates, and wait for them to complete.
+      /// \param[in] _info World update information.
+      public: void Update(const common::UpdateInfo &_info);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<UpdateSchedulerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
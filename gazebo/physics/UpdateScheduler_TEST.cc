@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/UpdateScheduler.hh"
+#include "gazebo/util/ProfileManager.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class UpdateSchedulerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, Connect)
+{
+  physics::UpdateScheduler scheduler;
+  EXPECT_TRUE(scheduler.Parallel());
+  EXPECT_EQ(0u, scheduler.ConnectionCount());
+  EXPECT_EQ(0u, scheduler.StageCount());
+
+  // Empty updates are refused
+  EXPECT_EQ(nullptr, scheduler.Connect(nullptr, {}, {}));
+  EXPECT_EQ(0u, scheduler.ConnectionCount());
+
+  int count = 0;
+  common::UpdateInfo info;
+  info.worldName = "default";
+  event::ConnectionPtr conn = scheduler.Connect(
+      [&](const common::UpdateInfo &_info)
+      {
+        EXPECT_EQ("default", _info.worldName);
+        ++count;
+      }, {}, {"a"});
+  ASSERT_NE(nullptr, conn);
+  EXPECT_EQ(1u, scheduler.ConnectionCount());
+  EXPECT_EQ(1u, scheduler.StageCount());
+
+  scheduler.Update(info);
+  scheduler.Update(info);
+  EXPECT_EQ(2, count);
+
+  // Disconnected when the connection goes away
+  conn.reset();
+  EXPECT_EQ(0u, scheduler.ConnectionCount());
+  scheduler.Update(info);
+  EXPECT_EQ(2, count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, Stages)
+{
+  physics::UpdateScheduler scheduler;
+  std::vector<event::ConnectionPtr> connections;
+  auto connect = [&](const std::vector<std::string> &_reads,
+      const std::vector<std::string> &_writes)
+  {
+    connections.push_back(scheduler.Connect(
+        [](const common::UpdateInfo &) {}, _reads, _writes));
+  };
+
+  // Independent writers share a stage, as do readers of the same resource
+  connect({"box::links"}, {"box::joints"});
+  connect({"sphere::links"}, {"sphere::joints"});
+  connect({"world"}, {});
+  connect({"world"}, {});
+  EXPECT_EQ(1u, scheduler.StageCount());
+
+  // Writing a resource scoped under a read one conflicts
+  connect({}, {"world::gravity"});
+  EXPECT_EQ(2u, scheduler.StageCount());
+
+  // Only the scope separator makes a resource part of another
+  connect({}, {"boxes"});
+  EXPECT_EQ(2u, scheduler.StageCount());
+  connect({}, {"box::joints::hinge"});
+  EXPECT_EQ(2u, scheduler.StageCount());
+  connect({}, {"box::joints::hinge"});
+  EXPECT_EQ(3u, scheduler.StageCount());
+
+  // Removing the update in the middle of a chain shortens it
+  connections[6].reset();
+  EXPECT_EQ(2u, scheduler.StageCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, Order)
+{
+  // A chain of updates passing a value along, with independent updates in
+  // between. The chain must run in connection order, whether the
+  // scheduler runs in parallel or not.
+  for (const bool parallel : {true, false})
+  {
+    physics::UpdateScheduler scheduler;
+    scheduler.SetParallel(parallel);
+    EXPECT_EQ(parallel, scheduler.Parallel());
+
+    std::vector<int> values(8, 0);
+    std::vector<event::ConnectionPtr> connections;
+    for (int i = 0; i < 4; ++i)
+    {
+      connections.push_back(scheduler.Connect(
+          [&values, i](const common::UpdateInfo &)
+          {
+            values[0] = values[0] * 10 + i;
+          }, {}, {"chain"}));
+
+      const std::string name = "model" + std::to_string(i);
+      connections.push_back(scheduler.Connect(
+          [&values, i](const common::UpdateInfo &)
+          {
+            values[i + 1] += 1;
+          }, {}, {name}));
+    }
+    EXPECT_EQ(4u, scheduler.StageCount());
+
+    common::UpdateInfo info;
+    scheduler.Update(info);
+    EXPECT_EQ(123, values[0]);
+    for (int i = 1; i <= 4; ++i)
+      EXPECT_EQ(1, values[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, Parallel)
+{
+  physics::UpdateScheduler scheduler;
+
+  // Updates of a stage don't run at the same time as updates of other
+  // stages
+  std::atomic<int> running(0);
+  std::atomic_bool overlap(false);
+  std::vector<double> results(64, 0.0);
+  std::vector<event::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < results.size(); ++i)
+  {
+    connections.push_back(scheduler.Connect(
+        [&, i](const common::UpdateInfo &)
+        {
+          ++running;
+          double sum = 0;
+          for (int k = 1; k < 10000; ++k)
+            sum += 1.0 / k;
+          results[i] += sum;
+          --running;
+        }, {"world"}, {"model" + std::to_string(i)}));
+  }
+  connections.push_back(scheduler.Connect(
+      [&](const common::UpdateInfo &)
+      {
+        if (running != 0)
+          overlap = true;
+      }, {}, {"world"}));
+  EXPECT_EQ(2u, scheduler.StageCount());
+
+  common::UpdateInfo info;
+  for (int i = 0; i < 10; ++i)
+    scheduler.Update(info);
+  EXPECT_FALSE(overlap);
+  for (const double result : results)
+    EXPECT_DOUBLE_EQ(results[0], result);
+}
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, DisconnectWhileRunning)
+{
+  physics::UpdateScheduler scheduler;
+  int first = 0;
+  int second = 0;
+  event::ConnectionPtr secondConn;
+
+  // The first update disconnects the second one, which runs in a later
+  // stage
+  event::ConnectionPtr firstConn = scheduler.Connect(
+      [&](const common::UpdateInfo &)
+      {
+        ++first;
+        secondConn.reset();
+      }, {}, {"a"});
+  secondConn = scheduler.Connect(
+      [&](const common::UpdateInfo &)
+      {
+        ++second;
+      }, {"a"}, {});
+  EXPECT_EQ(2u, scheduler.StageCount());
+
+  common::UpdateInfo info;
+  scheduler.Update(info);
+  scheduler.Update(info);
+  EXPECT_EQ(2, first);
+  EXPECT_EQ(0, second);
+  EXPECT_EQ(1u, scheduler.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(UpdateSchedulerTest, Profiled)
+{
+  util::ProfileManager *profiler = util::ProfileManager::Instance();
+  profiler->SetEnabled(true);
+  profiler->Clear();
+
+  // Named updates are profiled, in parallel or not
+  physics::UpdateScheduler scheduler;
+  std::vector<event::ConnectionPtr> connections;
+  for (const std::string name : {"first", "second"})
+  {
+    connections.push_back(scheduler.Connect(
+        [](const common::UpdateInfo &) {}, {}, {name}, name));
+  }
+  connections.push_back(scheduler.Connect(
+      [](const common::UpdateInfo &) {}, {}, {"third"}));
+
+  common::UpdateInfo info;
+  scheduler.Update(info);
+  scheduler.SetParallel(false);
+  scheduler.Update(info);
+
+  msgs::ProfileStats msg;
+  profiler->Stats(msg);
+  profiler->SetEnabled(false);
+
+  std::map<std::string, uint64_t> counts;
+  for (int i = 0; i < msg.scope_size(); ++i)
+    counts[msg.scope(i).name()] += msg.scope(i).count();
+  EXPECT_EQ(2u, counts["plugin::first"]);
+  EXPECT_EQ(2u, counts["plugin::second"]);
+  EXPECT_EQ(0u, counts.count("plugin::third"));
+  EXPECT_EQ(0u, counts.count("plugin::"));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,11 +14,15 @@
  * limitations under the License.
  *
  */
+#include <set>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 #include "gazebo/transport/transport.hh"
 
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -28,6 +32,86 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Number of model and link states in a model state, including
+/// nested models.
+/// \param[in] _state Model state.
+/// \return Number of states.
+static unsigned int ModelStateCount(const ModelState &_state)
+{
+  unsigned int count = 1 + _state.GetLinkStateCount();
+  for (auto const &nested : _state.NestedModelStates())
+    count += ModelStateCount(nested.second);
+  return count;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record the current state of the models and lights named in the
+/// given states.
+/// \param[in] _world Pointer to the world.
+/// \param[in] _models States whose models are recorded.
+/// \param[in] _lights States whose lights are recorded.
+/// \param[out] _modelStates Current model states.
+/// \param[out] _lightStates Current light states.
+static void RecordStates(const WorldPtr &_world,
+    const std::vector<ModelState> &_models,
+    const std::vector<LightState> &_lights,
+    std::vector<ModelState> &_modelStates,
+    std::vector<LightState> &_lightStates)
+{
+  _modelStates.clear();
+  for (auto const &state : _models)
+  {
+    ModelPtr model = _world->ModelByName(state.GetName());
+    if (model)
+      _modelStates.push_back(ModelState(model));
+  }
+
+  _lightStates.clear();
+  for (auto const &state : _lights)
+  {
+    LightPtr light = _world->LightByName(state.GetName());
+    if (light)
+    {
+      _lightStates.push_back(LightState(light, _world->RealTime(),
+          _world->SimTime(), _world->Iterations()));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Set the state of the models and lights named in the given
+/// states, leaving the rest of the world untouched.
+/// \param[in] _world Pointer to the world.
+/// \param[in] _modelStates Model states to set.
+/// \param[in] _lightStates Light states to set.
+static void RestoreStates(const WorldPtr &_world,
+    const std::vector<ModelState> &_modelStates,
+    const std::vector<LightState> &_lightStates)
+{
+  for (auto const &state : _modelStates)
+  {
+    ModelPtr model = _world->ModelByName(state.GetName());
+    if (!model)
+    {
+      gzwarn << "Unable to find model[" << state.GetName() << "]\n";
+      continue;
+    }
+    model->ResetPhysicsStates();
+    model->SetState(state);
+  }
+
+  for (auto const &state : _lightStates)
+  {
+    LightPtr light = _world->LightByName(state.GetName());
+    if (!light)
+    {
+      gzwarn << "Unable to find light[" << state.GetName() << "]\n";
+      continue;
+    }
+    light->SetState(state);
+  }
+}
 
 /////////////////////////////////////////////////
 UserCmd::UserCmd(const unsigned int _id,
@@ -43,6 +127,56 @@ UserCmd::UserCmd(const unsigned int _id,
 
   // Record current world state
   this->dataPtr->startState = WorldState(this->dataPtr->world);
+
+  // Keep room for the state recorded on undo
+  for (auto const &state : this->dataPtr->startState.GetModelStates())
+    this->dataPtr->stateCount += 2 * ModelStateCount(state.second);
+  this->dataPtr->stateCount += 2 * this->dataPtr->startState.LightStateCount();
+}
+
+/////////////////////////////////////////////////
+UserCmd::UserCmd(const unsigned int _id,
+                 physics::WorldPtr _world,
+                 const std::string &_description,
+                 const msgs::UserCmd::Type &_type,
+                 const std::vector<std::string> &_models,
+                 const std::vector<std::string> &_lights)
+  : dataPtr(new UserCmdPrivate())
+{
+  this->dataPtr->id = _id;
+  this->dataPtr->world = _world;
+  this->dataPtr->description = _description;
+  this->dataPtr->type = _type;
+  this->dataPtr->wholeWorld = false;
+
+  // Record the current state of the affected entities only
+  for (auto const &name : std::set<std::string>(_models.begin(),
+      _models.end()))
+  {
+    ModelPtr model = _world->ModelByName(name);
+    if (!model)
+    {
+      gzwarn << "Unable to find model[" << name << "]\n";
+      continue;
+    }
+    this->dataPtr->startModelStates.push_back(ModelState(model));
+    this->dataPtr->stateCount +=
+        2 * ModelStateCount(this->dataPtr->startModelStates.back());
+  }
+
+  for (auto const &name : std::set<std::string>(_lights.begin(),
+      _lights.end()))
+  {
+    LightPtr light = _world->LightByName(name);
+    if (!light)
+    {
+      gzwarn << "Unable to find light[" << name << "]\n";
+      continue;
+    }
+    this->dataPtr->startLightStates.push_back(LightState(light,
+        _world->RealTime(), _world->SimTime(), _world->Iterations()));
+    this->dataPtr->stateCount += 2;
+  }
 }
 
 /////////////////////////////////////////////////
@@ -59,6 +193,19 @@ UserCmd::~UserCmd()
 /////////////////////////////////////////////////
 void UserCmd::Undo()
 {
+  if (!this->dataPtr->wholeWorld)
+  {
+    // Record / override the state of the affected entities for redo
+    RecordStates(this->dataPtr->world, this->dataPtr->startModelStates,
+        this->dataPtr->startLightStates, this->dataPtr->endModelStates,
+        this->dataPtr->endLightStates);
+
+    // Set them back to the moment the command was executed
+    RestoreStates(this->dataPtr->world, this->dataPtr->startModelStates,
+        this->dataPtr->startLightStates);
+    return;
+  }
+
   // Record / override the state for redo
   this->dataPtr->endState = WorldState(this->dataPtr->world);
 
@@ -72,6 +219,14 @@ void UserCmd::Undo()
 /////////////////////////////////////////////////
 void UserCmd::Redo()
 {
+  if (!this->dataPtr->wholeWorld)
+  {
+    // Set the affected entities to the moment undo was triggered
+    RestoreStates(this->dataPtr->world, this->dataPtr->endModelStates,
+        this->dataPtr->endLightStates);
+    return;
+  }
+
   // Reset physics states for the whole world
   this->dataPtr->world->ResetPhysicsStates();
 
@@ -97,6 +252,12 @@ msgs::UserCmd::Type UserCmd::Type() const
   return this->dataPtr->type;
 }
 
+/////////////////////////////////////////////////
+unsigned int UserCmd::StateCount() const
+{
+  return this->dataPtr->stateCount;
+}
+
 /////////////////////////////////////////////////
 UserCmdManager::UserCmdManager(const WorldPtr _world)
   : dataPtr(new UserCmdManagerPrivate())
@@ -154,15 +315,84 @@ UserCmdManager::~UserCmdManager()
   this->dataPtr = NULL;
 }
 
+/////////////////////////////////////////////////
+void UserCmdManager::SetHistoryLimit(const unsigned int _limit)
+{
+  this->dataPtr->historyLimit = _limit;
+  this->TrimHistory();
+}
+
+/////////////////////////////////////////////////
+unsigned int UserCmdManager::HistoryLimit() const
+{
+  return this->dataPtr->historyLimit;
+}
+
 /////////////////////////////////////////////////
 void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
 {
   // Generate unique id
   unsigned int id = this->dataPtr->idCounter++;
 
+  // Names of the entities affected by the command
+  std::vector<std::string> models;
+  std::vector<std::string> lights;
+  bool wholeWorld = false;
+  switch (_msg->type())
+  {
+    case msgs::UserCmd::MOVING:
+    case msgs::UserCmd::SCALING:
+    {
+      for (int i = 0; i < _msg->model_size(); ++i)
+        models.push_back(_msg->model(i).name());
+
+      for (int i = 0; i < _msg->light_size(); ++i)
+        lights.push_back(_msg->light(i).name());
+
+      break;
+    }
+    case msgs::UserCmd::WRENCH:
+    {
+      EntityPtr entity = this->dataPtr->world->EntityByName(
+          _msg->entity_name());
+      // States are recorded per top level model, and GetParentModel
+      // returns a nested model itself
+      BasePtr model;
+      if (entity)
+        model = entity->GetParentModel();
+      while (model && model->GetParent() &&
+          model->GetParent()->HasType(Base::MODEL))
+      {
+        model = model->GetParent();
+      }
+
+      if (model)
+        models.push_back(model->GetName());
+      else
+        wholeWorld = true;
+
+      break;
+    }
+    default:
+    {
+      // World control may affect everything
+      wholeWorld = true;
+      break;
+    }
+  }
+
   // Create command
-  UserCmdPtr cmd(new UserCmd(id, this->dataPtr->world, _msg->description(),
-      _msg->type()));
+  UserCmdPtr cmd;
+  if (wholeWorld)
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type()));
+  }
+  else
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type(), models, lights));
+  }
 
   // Forward message after we've saved the current state
   switch (_msg->type())
@@ -226,6 +456,8 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
   // Clear redo list
   this->dataPtr->redoCmds.clear();
 
+  this->TrimHistory();
+
   // Publish stats
   this->PublishCurrentStats();
 }
@@ -331,6 +563,33 @@ void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
   this->PublishCurrentStats();
 }
 
+/////////////////////////////////////////////////
+void UserCmdManager::TrimHistory()
+{
+  unsigned int count = 0;
+  for (auto const &cmd : this->dataPtr->undoCmds)
+    count += cmd->StateCount();
+  for (auto const &cmd : this->dataPtr->redoCmds)
+    count += cmd->StateCount();
+
+  // Drop the oldest commands which can be undone first, then the redo
+  // commands furthest from the current state, always keeping one command
+  while (count > this->dataPtr->historyLimit &&
+      this->dataPtr->undoCmds.size() + this->dataPtr->redoCmds.size() > 1)
+  {
+    if (!this->dataPtr->undoCmds.empty())
+    {
+      count -= this->dataPtr->undoCmds.front()->StateCount();
+      this->dataPtr->undoCmds.erase(this->dataPtr->undoCmds.begin());
+    }
+    else
+    {
+      count -= this->dataPtr->redoCmds.front()->StateCount();
+      this->dataPtr->redoCmds.erase(this->dataPtr->redoCmds.begin());
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void UserCmdManager::PublishCurrentStats()
 {
@@ -18,6 +18,7 @@
 #define GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 
 #include <string>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -45,6 +46,23 @@ namespace gazebo
                       const std::string &_description,
                       const msgs::UserCmd::Type &_type);
 
+      /// \brief Constructor which only records the state of the given
+      /// models and lights, instead of the whole world. Undo and redo only
+      /// affect these entities.
+      /// \param[in] _id Unique ID for this command
+      /// \param[in] _world Pointer to the world
+      /// \param[in] _description Description for the command, such as
+      /// "Rotate box", "Delete sphere", etc.
+      /// \param[in] _type Type of command, such as MOVING, DELETING, etc.
+      /// \param[in] _models Names of the models affected by the command.
+      /// \param[in] _lights Names of the lights affected by the command.
+      public: UserCmd(const unsigned int _id,
+                      physics::WorldPtr _world,
+                      const std::string &_description,
+                      const msgs::UserCmd::Type &_type,
+                      const std::vector<std::string> &_models,
+                      const std::vector<std::string> &_lights);
+
       /// \brief Destructor
       public: virtual ~UserCmd();
 
@@ -66,6 +84,11 @@ namespace gazebo
       /// \return Command type
       public: msgs::UserCmd::Type Type() const;
 
+      /// \brief Return the number of model, link and light states kept by
+      /// this command for undo and redo.
+      /// \return Number of states.
+      public: unsigned int StateCount() const;
+
       /// \internal
       /// \brief Pointer to private data.
       protected: UserCmdPrivate *dataPtr;
@@ -83,6 +106,18 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~UserCmdManager();
 
+      /// \brief Set the maximum number of states kept by the commands in
+      /// the undo and redo history. The oldest commands are dropped when
+      /// the history grows past it.
+      /// \param[in] _limit Maximum number of model, link and light states.
+      /// \sa UserCmd::StateCount
+      public: void SetHistoryLimit(const unsigned int _limit);
+
+      /// \brief Get the maximum number of states kept by the commands in
+      /// the undo and redo history.
+      /// \return Maximum number of model, link and light states.
+      public: unsigned int HistoryLimit() const;
+
       /// \brief Callback when a UserCmd message is received, notifying that
       /// a new command has been executed by a user.
       /// \param[in] _msg Incoming message
@@ -96,6 +131,10 @@ namespace gazebo
       /// \brief Publish a message about current user command statistics.
       private: void PublishCurrentStats();
 
+      /// \brief Drop the oldest commands until the history fits in the
+      /// history limit.
+      private: void TrimHistory();
+
       /// \internal
       /// \brief Pointer to private data.
       private: UserCmdManagerPrivate *dataPtr;
@@ -23,6 +23,8 @@
 
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
+#include "gazebo/physics/LightState.hh"
+#include "gazebo/physics/ModelState.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 
 namespace gazebo
@@ -45,6 +47,30 @@ namespace gazebo
       /// triggered undo for this command.
       public: WorldState endState;
 
+      /// \brief True if the command records the whole world state, false
+      /// if it only records the state of the entities it affects.
+      public: bool wholeWorld = true;
+
+      /// \brief State of the affected models the moment the user command
+      /// was executed.
+      public: std::vector<ModelState> startModelStates;
+
+      /// \brief State of the affected models for the most recent time the
+      /// user has triggered undo for this command.
+      public: std::vector<ModelState> endModelStates;
+
+      /// \brief State of the affected lights the moment the user command
+      /// was executed.
+      public: std::vector<LightState> startLightStates;
+
+      /// \brief State of the affected lights for the most recent time the
+      /// user has triggered undo for this command.
+      public: std::vector<LightState> endLightStates;
+
+      /// \brief Number of model, link and light states kept, counting the
+      /// ones recorded on undo.
+      public: unsigned int stateCount = 0;
+
       /// \brief Unique ID identifying this command in the server.
       public: unsigned int id;
 
@@ -93,6 +119,10 @@ namespace gazebo
 
       /// \brief List of commands which can be redone.
       public: std::vector<UserCmdPtr> redoCmds;
+
+      /// \brief Maximum number of states kept by the commands in the undo
+      /// and redo lists.
+      public: unsigned int historyLimit = 100000;
     };
   }
 }
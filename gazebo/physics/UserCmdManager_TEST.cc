@@ -15,6 +15,9 @@
  *
 */
 
+#include <map>
+#include <mutex>
+
 #include <sdf/sdf.hh>
 
 #include "gazebo/test/ServerFixture.hh"
@@ -26,6 +29,23 @@ using namespace gazebo;
 /////////////////////////////////////////////////
 class UserCmdManagerTest : public ServerFixture
 {
+  /// \brief Callback for user command statistics.
+  /// \param[in] _msg Statistics message.
+  public: void OnStats(ConstUserCmdStatsPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->undoCounts[_msg->undo_cmd_count()];
+    ++this->statsCount;
+  }
+
+  /// \brief Protects the statistics.
+  protected: std::mutex mutex;
+
+  /// \brief Number of statistics messages received per undo count.
+  protected: std::map<unsigned int, unsigned int> undoCounts;
+
+  /// \brief Number of statistics messages received.
+  protected: unsigned int statsCount = 0;
 };
 
 /////////////////////////////////////////////////
@@ -61,6 +81,105 @@ TEST_F(UserCmdManagerTest, CreateCmd)
   manager = NULL;
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, EntityCmd)
+{
+  Load("test/worlds/empty_test.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box1", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  SpawnBox("box2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 2, 0.5));
+  physics::ModelPtr box1 = world->ModelByName("box1");
+  physics::ModelPtr box2 = world->ModelByName("box2");
+  ASSERT_TRUE(box1 != NULL);
+  ASSERT_TRUE(box2 != NULL);
+  const ignition::math::Pose3d box1Pose = box1->WorldPose();
+
+  // A command on the whole world and one on box1 only, which keeps the
+  // model and link states before and after undo
+  physics::UserCmd worldCmd(1, world, "Move", msgs::UserCmd::MOVING);
+  physics::UserCmd cmd(2, world, "Move box1", msgs::UserCmd::MOVING,
+      {"box1", "box1"}, {});
+  EXPECT_EQ(4u, cmd.StateCount());
+  EXPECT_LT(cmd.StateCount(), worldCmd.StateCount());
+
+  // Move both boxes
+  const ignition::math::Pose3d box1Moved(5, 0, 0.5, 0, 0, 0);
+  const ignition::math::Pose3d box2Moved(5, 2, 0.5, 0, 0, 0);
+  box1->SetWorldPose(box1Moved);
+  box2->SetWorldPose(box2Moved);
+
+  // Undo only restores box1
+  cmd.Undo();
+  EXPECT_EQ(box1Pose, box1->WorldPose());
+  EXPECT_EQ(box2Moved, box2->WorldPose());
+
+  // Redo moves it again
+  cmd.Redo();
+  EXPECT_EQ(box1Moved, box1->WorldPose());
+  EXPECT_EQ(box2Moved, box2->WorldPose());
+}
+
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, HistoryLimit)
+{
+  Load("test/worlds/empty_test.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  ASSERT_TRUE(world->ModelByName("box") != NULL);
+
+  // A second manager, next to the world's own, keeping 3 commands of 4
+  // states each
+  physics::UserCmdManager manager(world);
+  EXPECT_EQ(100000u, manager.HistoryLimit());
+  manager.SetHistoryLimit(12);
+  EXPECT_EQ(12u, manager.HistoryLimit());
+
+  auto statsSub = this->node->Subscribe("~/user_cmd_stats",
+      &UserCmdManagerTest::OnStats, this);
+  auto userCmdPub = this->node->Advertise<msgs::UserCmd>("~/user_cmd");
+  userCmdPub->WaitForConnection();
+
+  const unsigned int cmdCount = 6;
+  for (unsigned int i = 0; i < cmdCount; ++i)
+  {
+    msgs::UserCmd msg;
+    msg.set_description("Move box");
+    msg.set_type(msgs::UserCmd::MOVING);
+    msgs::Model *modelMsg = msg.add_model();
+    modelMsg->set_name("box");
+    msgs::Set(modelMsg->mutable_pose(),
+        ignition::math::Pose3d(i + 1, 0, 0.5, 0, 0, 0));
+    userCmdPub->Publish(msg);
+  }
+
+  // Both managers publish statistics for each command
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->statsCount >= 2 * cmdCount)
+        break;
+    }
+    common::Time::MSleep(50);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ASSERT_EQ(2 * cmdCount, this->statsCount);
+
+  // The world's manager keeps every command, while the other one stops
+  // growing at 3
+  EXPECT_EQ(cmdCount, this->undoCounts.rbegin()->first);
+  EXPECT_EQ(cmdCount - 3 + 2, this->undoCounts[3]);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
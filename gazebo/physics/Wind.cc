@@ -57,6 +57,9 @@ namespace gazebo
       public: std::function< ignition::math::Vector3d (
                   const Wind *, const Entity *)> linearVelFunc;
 
+      /// \brief Spatially varying wind field, may be null.
+      public: WindFieldPtr field;
+
       // Transport is declared last.
       /// \brief Node for communication.
       public: transport::NodePtr node;
@@ -240,3 +243,15 @@ void Wind::SetLinearVelFunc(std::function< ignition::math::Vector3d (
 {
   this->dataPtr->linearVelFunc = _linearVelFunc;
 }
+
+/////////////////////////////////////////////////
+void Wind::SetField(WindFieldPtr _field)
+{
+  this->dataPtr->field = _field;
+}
+
+/////////////////////////////////////////////////
+WindFieldPtr Wind::Field() const
+{
+  return this->dataPtr->field;
+}
@@ -114,6 +114,16 @@ namespace gazebo
       public: void SetLinearVelFunc(std::function< ignition::math::Vector3d (
           const Wind *_wind, const Entity *_entity) > _linearVelFunc);
 
+      /// \brief Set a spatially varying wind field. The field isn't part
+      /// of WorldLinearVel, so that it can be sampled for many entities at
+      /// once with WindField::Velocities, as WindPlugin does.
+      /// \param[in] _field The wind field, nullptr to remove the field.
+      public: void SetField(WindFieldPtr _field);
+
+      /// \brief Get the spatially varying wind field.
+      /// \return The wind field, nullptr if none is set.
+      public: WindFieldPtr Field() const;
+
       /// \brief Get the global wind velocity, ignoring the entity.
       /// \param[in] _wind Reference to the wind.
       /// \param[in] _entity Pointer to an entity at which location the wind
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/WindField.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the WindField class
+    class WindFieldPrivate
+    {
+      /// \brief Interpolate the velocity at a position.
+      /// \param[in] _x X coordinate.
+      /// \param[in] _y Y coordinate.
+      /// \param[in] _z Z coordinate.
+      /// \param[out] _vel Interpolated velocity.
+      public: void Sample(const double _x, const double _y, const double _z,
+                  double _vel[3]) const;
+
+      /// \brief Position of the first node.
+      public: ignition::math::Vector3d origin;
+
+      /// \brief Distance between nodes.
+      public: ignition::math::Vector3d spacing;
+
+      /// \brief Inverse of the distance between nodes.
+      public: double invSpacing[3] = {0, 0, 0};
+
+      /// \brief Number of nodes along each axis.
+      public: unsigned int size[3] = {0, 0, 0};
+
+      /// \brief Node velocities stored as one array per component, with X
+      /// varying fastest.
+      public: std::vector<double> vel[3];
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+namespace
+{
+  /// \brief Compute the lower node index and interpolation weight along
+  /// one axis.
+  /// \param[in] _coord Position in grid units, relative to the origin.
+  /// \param[in] _count Number of nodes along the axis.
+  /// \param[out] _index Index of the lower node.
+  /// \param[out] _t Weight of the upper node, in [0, 1].
+  inline void Locate(const double _coord, const unsigned int _count,
+      unsigned int &_index, double &_t)
+  {
+    if (_count < 2 || !(_coord > 0.0))
+    {
+      _index = 0;
+      _t = 0.0;
+      return;
+    }
+
+    const double last = static_cast<double>(_count - 1);
+    if (_coord >= last)
+    {
+      _index = _count - 2;
+      _t = 1.0;
+      return;
+    }
+
+    _index = static_cast<unsigned int>(_coord);
+    _t = _coord - _index;
+  }
+}
+
+//////////////////////////////////////////////////
+void WindFieldPrivate::Sample(const double _x, const double _y,
+    const double _z, double _vel[3]) const
+{
+  unsigned int ix, iy, iz;
+  double tx, ty, tz;
+  Locate((_x - this->origin.X()) * this->invSpacing[0], this->size[0],
+      ix, tx);
+  Locate((_y - this->origin.Y()) * this->invSpacing[1], this->size[1],
+      iy, ty);
+  Locate((_z - this->origin.Z()) * this->invSpacing[2], this->size[2],
+      iz, tz);
+
+  // Offsets to the next node along each axis, zero for flat axes
+  const size_t sx = this->size[0] > 1 ? 1 : 0;
+  const size_t sy = this->size[1] > 1 ? this->size[0] : 0;
+  const size_t sz = this->size[2] > 1 ?
+    static_cast<size_t>(this->size[0]) * this->size[1] : 0;
+
+  const size_t i000 = ix + this->size[0] *
+    (static_cast<size_t>(iy) + static_cast<size_t>(this->size[1]) * iz);
+
+  const double w000 = (1 - tx) * (1 - ty) * (1 - tz);
+  const double w100 = tx * (1 - ty) * (1 - tz);
+  const double w010 = (1 - tx) * ty * (1 - tz);
+  const double w110 = tx * ty * (1 - tz);
+  const double w001 = (1 - tx) * (1 - ty) * tz;
+  const double w101 = tx * (1 - ty) * tz;
+  const double w011 = (1 - tx) * ty * tz;
+  const double w111 = tx * ty * tz;
+
+  for (int c = 0; c < 3; ++c)
+  {
+    const double *v = this->vel[c].data() + i000;
+    _vel[c] =
+      w000 * v[0] + w100 * v[sx] + w010 * v[sy] + w110 * v[sx + sy] +
+      w001 * v[sz] + w101 * v[sx + sz] + w011 * v[sy + sz] +
+      w111 * v[sx + sy + sz];
+  }
+}
+
+//////////////////////////////////////////////////
+WindField::WindField()
+  : dataPtr(new WindFieldPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+WindField::~WindField()
+{
+}
+
+//////////////////////////////////////////////////
+bool WindField::SetGrid(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_spacing, const unsigned int _nx,
+    const unsigned int _ny, const unsigned int _nz,
+    const std::vector<ignition::math::Vector3d> &_velocities)
+{
+  if (_spacing.X() <= 0 || _spacing.Y() <= 0 || _spacing.Z() <= 0)
+  {
+    gzerr << "Wind field spacing must be positive, got ["
+          << _spacing << "]" << std::endl;
+    return false;
+  }
+
+  const size_t count = static_cast<size_t>(_nx) * _ny * _nz;
+  if (count == 0 || count != _velocities.size())
+  {
+    gzerr << "Wind field of size [" << _nx << " " << _ny << " " << _nz
+          << "] needs " << count << " velocities, got "
+          << _velocities.size() << std::endl;
+    return false;
+  }
+
+  this->dataPtr->origin = _origin;
+  this->dataPtr->spacing = _spacing;
+  this->dataPtr->invSpacing[0] = 1.0 / _spacing.X();
+  this->dataPtr->invSpacing[1] = 1.0 / _spacing.Y();
+  this->dataPtr->invSpacing[2] = 1.0 / _spacing.Z();
+  this->dataPtr->size[0] = _nx;
+  this->dataPtr->size[1] = _ny;
+  this->dataPtr->size[2] = _nz;
+
+  for (int c = 0; c < 3; ++c)
+    this->dataPtr->vel[c].resize(count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    this->dataPtr->vel[0][i] = _velocities[i].X();
+    this->dataPtr->vel[1][i] = _velocities[i].Y();
+    this->dataPtr->vel[2][i] = _velocities[i].Z();
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool WindField::Load(const std::string &_filename)
+{
+  std::ifstream in(_filename);
+  if (!in.is_open())
+  {
+    gzerr << "Unable to open wind field file[" << _filename << "]\n";
+    return false;
+  }
+
+  ignition::math::Vector3d origin;
+  ignition::math::Vector3d spacing;
+  unsigned int size[3] = {0, 0, 0};
+  bool hasOrigin = false, hasSpacing = false, hasSize = false;
+  std::vector<ignition::math::Vector3d> velocities;
+
+  std::string line;
+  unsigned int lineNumber = 0;
+  while (std::getline(in, line))
+  {
+    ++lineNumber;
+    std::istringstream stream(line);
+    std::string first;
+    if (!(stream >> first) || first[0] == '#')
+      continue;
+
+    bool ok = true;
+    if (first == "origin")
+    {
+      ok = static_cast<bool>(stream >> origin);
+      hasOrigin = true;
+    }
+    else if (first == "spacing")
+    {
+      ok = static_cast<bool>(stream >> spacing);
+      hasSpacing = true;
+    }
+    else if (first == "size")
+    {
+      ok = static_cast<bool>(stream >> size[0] >> size[1] >> size[2]);
+      hasSize = true;
+      if (ok)
+        velocities.reserve(static_cast<size_t>(size[0]) * size[1] * size[2]);
+    }
+    else
+    {
+      std::istringstream values(line);
+      ignition::math::Vector3d vel;
+      ok = static_cast<bool>(values >> vel);
+      velocities.push_back(vel);
+    }
+
+    if (!ok)
+    {
+      gzerr << "Unable to parse line " << lineNumber << " of wind field file["
+            << _filename << "]\n";
+      return false;
+    }
+  }
+
+  if (!hasOrigin || !hasSpacing || !hasSize)
+  {
+    gzerr << "Wind field file[" << _filename << "] must specify origin, "
+          << "spacing and size\n";
+    return false;
+  }
+
+  return this->SetGrid(origin, spacing, size[0], size[1], size[2],
+      velocities);
+}
+
+//////////////////////////////////////////////////
+bool WindField::GenerateTurbulence(const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max, const double _resolution,
+    const double _intensity, const double _lengthScale,
+    const unsigned int _modes, const unsigned int _seed)
+{
+  if (_resolution <= 0 || _lengthScale <= 0 || _modes == 0 ||
+      _max.X() < _min.X() || _max.Y() < _min.Y() || _max.Z() < _min.Z())
+  {
+    gzerr << "Invalid wind turbulence parameters" << std::endl;
+    return false;
+  }
+
+  // Each mode is a plane wave a * cos(k d.x + phi) whose amplitude a is
+  // perpendicular to its direction d, which makes the field divergence
+  // free. The normalization gives each velocity component a standard
+  // deviation of _intensity on average.
+  struct Mode
+  {
+    ignition::math::Vector3d waveVector;
+    ignition::math::Vector3d amplitude;
+    double phase;
+  };
+
+  std::mt19937 gen(_seed);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  const double scale = _intensity * std::sqrt(6.0 / _modes);
+  const double baseWaveNumber = 2.0 * M_PI / _lengthScale;
+
+  std::vector<Mode> modes(_modes);
+  for (auto &mode : modes)
+  {
+    ignition::math::Vector3d dir;
+    do
+    {
+      dir.Set(normal(gen), normal(gen), normal(gen));
+    } while (dir.SquaredLength() < 1e-12);
+    dir.Normalize();
+
+    ignition::math::Vector3d amp;
+    do
+    {
+      ignition::math::Vector3d r(normal(gen), normal(gen), normal(gen));
+      amp = dir.Cross(r);
+    } while (amp.SquaredLength() < 1e-12);
+    amp.Normalize();
+
+    // Spread the wave numbers over two octaves around the length scale
+    const double waveNumber = baseWaveNumber * std::pow(2.0,
+        2.0 * uniform(gen) - 1.0);
+
+    mode.waveVector = dir * waveNumber;
+    mode.amplitude = amp * scale;
+    mode.phase = 2.0 * M_PI * uniform(gen);
+  }
+
+  const ignition::math::Vector3d extent = _max - _min;
+  const unsigned int nx =
+    static_cast<unsigned int>(std::floor(extent.X() / _resolution)) + 1;
+  const unsigned int ny =
+    static_cast<unsigned int>(std::floor(extent.Y() / _resolution)) + 1;
+  const unsigned int nz =
+    static_cast<unsigned int>(std::floor(extent.Z() / _resolution)) + 1;
+
+  std::vector<ignition::math::Vector3d> velocities(
+      static_cast<size_t>(nx) * ny * nz);
+
+  size_t i = 0;
+  for (unsigned int z = 0; z < nz; ++z)
+  {
+    for (unsigned int y = 0; y < ny; ++y)
+    {
+      for (unsigned int x = 0; x < nx; ++x, ++i)
+      {
+        const ignition::math::Vector3d pos = _min +
+          ignition::math::Vector3d(x, y, z) * _resolution;
+        ignition::math::Vector3d vel;
+        for (const auto &mode : modes)
+          vel += mode.amplitude * std::cos(mode.waveVector.Dot(pos) +
+              mode.phase);
+        velocities[i] = vel;
+      }
+    }
+  }
+
+  return this->SetGrid(_min,
+      ignition::math::Vector3d(_resolution, _resolution, _resolution),
+      nx, ny, nz, velocities);
+}
+
+//////////////////////////////////////////////////
+bool WindField::Valid() const
+{
+  return !this->dataPtr->vel[0].empty();
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Velocity(
+    const ignition::math::Vector3d &_pos) const
+{
+  if (!this->Valid())
+    return ignition::math::Vector3d::Zero;
+
+  double vel[3];
+  this->dataPtr->Sample(_pos.X(), _pos.Y(), _pos.Z(), vel);
+  return ignition::math::Vector3d(vel[0], vel[1], vel[2]);
+}
+
+//////////////////////////////////////////////////
+void WindField::Velocities(const std::vector<ignition::math::Vector3d> &_pos,
+    std::vector<ignition::math::Vector3d> &_vel) const
+{
+  _vel.resize(_pos.size());
+  if (!this->Valid())
+  {
+    std::fill(_vel.begin(), _vel.end(), ignition::math::Vector3d::Zero);
+    return;
+  }
+
+  for (size_t i = 0; i < _pos.size(); ++i)
+  {
+    double vel[3];
+    this->dataPtr->Sample(_pos[i].X(), _pos[i].Y(), _pos[i].Z(), vel);
+    _vel[i].Set(vel[0], vel[1], vel[2]);
+  }
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Origin() const
+{
+  return this->dataPtr->origin;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d WindField::Spacing() const
+{
+  return this->dataPtr->spacing;
+}
+
+//////////////////////////////////////////////////
+void WindField::Size(unsigned int &_nx, unsigned int &_ny,
+    unsigned int &_nz) const
+{
+  _nx = this->dataPtr->size[0];
+  _ny = this->dataPtr->size[1];
+  _nz = this->dataPtr->size[2];
+}
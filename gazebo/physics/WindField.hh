@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WINDFIELD_HH_
+#define GAZEBO_PHYSICS_WINDFIELD_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class WindFieldPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WindField WindField.hh physics/physics.hh
+    /// \brief A spatially varying wind velocity field sampled on a regular
+    /// 3D grid. Velocities between grid nodes are computed with trilinear
+    /// interpolation. Positions outside of the grid use the value of the
+    /// closest boundary node.
+    ///
+    /// A field can be set from data, loaded from a text file or generated
+    /// as synthetic turbulence. See physics::Wind::SetField.
+    class GZ_PHYSICS_VISIBLE WindField
+    {
+      /// \brief Constructor. The field is empty until one of SetGrid,
+      /// Load or GenerateTurbulence succeeds.
+      public: WindField();
+
+      /// \brief Destructor.
+      public: virtual ~WindField();
+
+      /// \brief Set the grid and its node velocities.
+      /// \param[in] _origin World position of the first node.
+      /// \param[in] _spacing Distance between nodes along each axis. All
+      /// components must be positive.
+      /// \param[in] _nx Number of nodes along X.
+      /// \param[in] _ny Number of nodes along Y.
+      /// \param[in] _nz Number of nodes along Z.
+      /// \param[in] _velocities _nx * _ny * _nz node velocities, with X
+      /// varying fastest and Z slowest.
+      /// \return False if the arguments are inconsistent.
+      public: bool SetGrid(const ignition::math::Vector3d &_origin,
+                  const ignition::math::Vector3d &_spacing,
+                  const unsigned int _nx, const unsigned int _ny,
+                  const unsigned int _nz,
+                  const std::vector<ignition::math::Vector3d> &_velocities);
+
+      /// \brief Load a field from a text file. Lines starting with '#' are
+      /// ignored. The file has the following layout:
+      ///
+      ///     origin <x> <y> <z>
+      ///     spacing <dx> <dy> <dz>
+      ///     size <nx> <ny> <nz>
+      ///     <vx> <vy> <vz>
+      ///     ...
+      ///
+      /// followed by nx * ny * nz velocities in the order of SetGrid.
+      /// \param[in] _filename Path to the file.
+      /// \return True on success.
+      public: bool Load(const std::string &_filename);
+
+      /// \brief Fill the grid with synthetic, divergence free turbulence
+      /// built from a sum of random Fourier modes.
+      /// \param[in] _min Minimum corner of the region.
+      /// \param[in] _max Maximum corner of the region.
+      /// \param[in] _resolution Spacing of the grid nodes.
+      /// \param[in] _intensity Standard deviation of each velocity
+      /// component, in m/s.
+      /// \param[in] _lengthScale Characteristic size of the eddies, in
+      /// meters.
+      /// \param[in] _modes Number of Fourier modes.
+      /// \param[in] _seed Seed of the random generator. The same seed
+      /// produces the same field.
+      /// \return False if the arguments are invalid.
+      public: bool GenerateTurbulence(const ignition::math::Vector3d &_min,
+                  const ignition::math::Vector3d &_max,
+                  const double _resolution, const double _intensity,
+                  const double _lengthScale, const unsigned int _modes = 64,
+                  const unsigned int _seed = 0);
+
+      /// \brief Get whether the field holds any data.
+      /// \return True if the grid has at least one node.
+      public: bool Valid() const;
+
+      /// \brief Get the wind velocity at a position.
+      /// \param[in] _pos World position.
+      /// \return Interpolated velocity, zero if the field is not valid.
+      public: ignition::math::Vector3d Velocity(
+                  const ignition::math::Vector3d &_pos) const;
+
+      /// \brief Get the wind velocity at many positions at once, without
+      /// per position call overhead.
+      /// \param[in] _pos World positions.
+      /// \param[out] _vel Interpolated velocities, resized to match _pos.
+      public: void Velocities(
+                  const std::vector<ignition::math::Vector3d> &_pos,
+                  std::vector<ignition::math::Vector3d> &_vel) const;
+
+      /// \brief Get the world position of the first grid node.
+      /// \return Grid origin.
+      public: ignition::math::Vector3d Origin() const;
+
+      /// \brief Get the distance between grid nodes.
+      /// \return Grid spacing along each axis.
+      public: ignition::math::Vector3d Spacing() const;
+
+      /// \brief Get the number of grid nodes along each axis.
+      /// \param[out] _nx Number of nodes along X.
+      /// \param[out] _ny Number of nodes along Y.
+      /// \param[out] _nz Number of nodes along Z.
+      public: void Size(unsigned int &_nx, unsigned int &_ny,
+                  unsigned int &_nz) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<WindFieldPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
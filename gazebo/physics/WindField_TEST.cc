@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "gazebo/physics/WindField.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class WindFieldTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Empty)
+{
+  physics::WindField field;
+  EXPECT_FALSE(field.Valid());
+  EXPECT_EQ(ignition::math::Vector3d::Zero,
+      field.Velocity(ignition::math::Vector3d(1, 2, 3)));
+
+  // Inconsistent grids are rejected
+  std::vector<ignition::math::Vector3d> vel(7);
+  EXPECT_FALSE(field.SetGrid(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::One, 2, 2, 2, vel));
+  vel.resize(8);
+  EXPECT_FALSE(field.SetGrid(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(1, 0, 1), 2, 2, 2, vel));
+  EXPECT_FALSE(field.Valid());
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Trilinear)
+{
+  // A linear field is reproduced exactly by trilinear interpolation
+  auto linear = [](const ignition::math::Vector3d &_p)
+  {
+    return ignition::math::Vector3d(
+        1 + 2 * _p.X(), -_p.Y() + 0.5 * _p.Z(), _p.X() - _p.Z());
+  };
+
+  const ignition::math::Vector3d origin(-2, 1, 0);
+  const ignition::math::Vector3d spacing(0.5, 2, 1);
+  const unsigned int nx = 5, ny = 3, nz = 4;
+  std::vector<ignition::math::Vector3d> vel;
+  for (unsigned int z = 0; z < nz; ++z)
+    for (unsigned int y = 0; y < ny; ++y)
+      for (unsigned int x = 0; x < nx; ++x)
+        vel.push_back(linear(origin + ignition::math::Vector3d(x, y, z) *
+              spacing));
+
+  physics::WindField field;
+  ASSERT_TRUE(field.SetGrid(origin, spacing, nx, ny, nz, vel));
+  EXPECT_TRUE(field.Valid());
+  EXPECT_EQ(origin, field.Origin());
+  EXPECT_EQ(spacing, field.Spacing());
+  unsigned int sx, sy, sz;
+  field.Size(sx, sy, sz);
+  EXPECT_EQ(nx, sx);
+  EXPECT_EQ(ny, sy);
+  EXPECT_EQ(nz, sz);
+
+  std::vector<ignition::math::Vector3d> points =
+  {
+    {-2, 1, 0}, {-1.3, 2.2, 0.7}, {0, 5, 3}, {-0.1, 4.9, 2.5}
+  };
+  for (const auto &p : points)
+    EXPECT_TRUE(linear(p).Equal(field.Velocity(p), 1e-9)) << p;
+
+  // Outside of the grid the boundary value is used
+  EXPECT_TRUE(linear(ignition::math::Vector3d(0, 5, 3)).Equal(
+        field.Velocity(ignition::math::Vector3d(10, 50, 30)), 1e-9));
+  EXPECT_TRUE(linear(origin).Equal(
+        field.Velocity(ignition::math::Vector3d(-10, -50, -30)), 1e-9));
+
+  // The batch version matches the single position version
+  std::vector<ignition::math::Vector3d> batch;
+  field.Velocities(points, batch);
+  ASSERT_EQ(points.size(), batch.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(field.Velocity(points[i]), batch[i]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, FlatGrid)
+{
+  // A single layer of nodes behaves as a 2D field
+  std::vector<ignition::math::Vector3d> vel =
+  {
+    {0, 0, 0}, {2, 0, 0}, {0, 2, 0}, {2, 2, 0}
+  };
+  physics::WindField field;
+  ASSERT_TRUE(field.SetGrid(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::One, 2, 2, 1, vel));
+  EXPECT_EQ(ignition::math::Vector3d(1, 1, 0),
+      field.Velocity(ignition::math::Vector3d(0.5, 0.5, 100)));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Load)
+{
+  const std::string filename = "wind_field_test.txt";
+  {
+    std::ofstream out(filename);
+    out << "# Two by one by one field\n"
+        << "origin 1 0 0\n"
+        << "spacing 2 1 1\n"
+        << "size 2 1 1\n"
+        << "0 0 0\n"
+        << "4 -2 1\n";
+  }
+
+  physics::WindField field;
+  EXPECT_FALSE(field.Load("/file/that/does/not/exist"));
+  ASSERT_TRUE(field.Load(filename));
+  EXPECT_EQ(ignition::math::Vector3d(2, -1, 0.5),
+      field.Velocity(ignition::math::Vector3d(2, 0, 0)));
+
+  // Missing velocities
+  {
+    std::ofstream out(filename);
+    out << "origin 0 0 0\nspacing 1 1 1\nsize 2 2 2\n0 0 0\n";
+  }
+  EXPECT_FALSE(field.Load(filename));
+
+  std::remove(filename.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST_F(WindFieldTest, Turbulence)
+{
+  const ignition::math::Vector3d min(0, 0, 0);
+  const ignition::math::Vector3d max(40, 40, 20);
+  const double intensity = 2.0;
+
+  physics::WindField field;
+  EXPECT_FALSE(field.GenerateTurbulence(max, min, 1, intensity, 10));
+  ASSERT_TRUE(field.GenerateTurbulence(min, max, 1, intensity, 10, 64, 3));
+
+  unsigned int nx, ny, nz;
+  field.Size(nx, ny, nz);
+  EXPECT_EQ(41u, nx);
+  EXPECT_EQ(41u, ny);
+  EXPECT_EQ(21u, nz);
+
+  // Same seed gives the same field
+  physics::WindField other;
+  ASSERT_TRUE(other.GenerateTurbulence(min, max, 1, intensity, 10, 64, 3));
+  const ignition::math::Vector3d p(12.3, 7.7, 4.1);
+  EXPECT_EQ(field.Velocity(p), other.Velocity(p));
+
+  // The spread of the velocities is in the order of the intensity and the
+  // mean is close to zero
+  double sum = 0, sumSq = 0;
+  unsigned int count = 0;
+  for (double x = 0; x <= 40; x += 2)
+  {
+    for (double y = 0; y <= 40; y += 2)
+    {
+      for (double z = 0; z <= 20; z += 2)
+      {
+        double v = field.Velocity(ignition::math::Vector3d(x, y, z)).X();
+        sum += v;
+        sumSq += v * v;
+        ++count;
+      }
+    }
+  }
+  const double mean = sum / count;
+  const double stddev = std::sqrt(sumSq / count - mean * mean);
+  EXPECT_LT(std::fabs(mean), intensity);
+  EXPECT_GT(stddev, 0.25 * intensity);
+  EXPECT_LT(stddev, 4 * intensity);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -22,10 +22,13 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <array>
 #include <deque>
 #include <list>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -63,6 +66,7 @@
 #include "gazebo/util/Diagnostics.hh"
 #include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/util/LogRecord.hh"
+#include "gazebo/util/ProfileManager.hh"
 
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
@@ -73,6 +77,8 @@
 #include "gazebo/physics/Atmosphere.hh"
 #include "gazebo/physics/AtmosphereFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/physics/UpdateScheduler.hh"
 #include "gazebo/physics/UserCmdManager.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
@@ -136,9 +142,13 @@ World::World(const std::string &_name)
   this->dataPtr->stateToggle = 0;
 
   this->dataPtr->pluginsLoaded = false;
+  this->dataPtr->packedPoseDelta = true;
 
   this->dataPtr->name = _name;
 
+  this->dataPtr->updateScheduler.reset(new UpdateScheduler);
+  this->dataPtr->sleepManager.reset(new SleepManager(this));
+
   this->dataPtr->needsReset = false;
   this->dataPtr->resetAll = true;
   this->dataPtr->resetTimeOnly = false;
@@ -225,6 +235,12 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact pose stream keyed by entity id. The rate is capped by World, so
+  // that no pose change is dropped between delta encoded messages.
+  this->dataPtr->packedPosePub =
+    this->dataPtr->node->Advertise<msgs::PackedPoses>(
+    "~/pose/packed/info", 100);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -439,6 +455,7 @@ void World::Init(UpdateScenePosesFunc _func)
   this->dataPtr->logPrevIteration = 0;
 
   util::DiagnosticManager::Instance()->Init(this->Name());
+  util::ProfileManager::Instance()->Init(this->Name());
 
   util::LogRecord::Instance()->Add(this->Name(), "state.log",
       std::bind(&World::OnLog, this, std::placeholders::_1));
@@ -677,8 +694,8 @@ void World::Step()
 {
   DIAG_TIMER_START("World::Step");
 
-  IGN_PROFILE("World::Step");
-  IGN_PROFILE_BEGIN("loadPlugins");
+  GZ_PROFILE_SCOPE("World::Step");
+  GZ_PROFILE_BEGIN("loadPlugins");
   /// need this because ODE does not call dxReallocateWorldProcessContext()
   /// until dWorld.*Step
   /// Plugins that manipulate joints (and probably other properties) require
@@ -689,17 +706,17 @@ void World::Step()
     this->dataPtr->pluginsLoaded = true;
   }
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "loadPlugins");
 
-  IGN_PROFILE_BEGIN("publishWorldStats");
+  GZ_PROFILE_BEGIN("publishWorldStats");
   // Send statistics about the world simulation
   this->PublishWorldStats();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 
   DIAG_TIMER_LAP("World::Step", "publishWorldStats");
 
-  IGN_PROFILE_BEGIN("sleepOffset");
+  GZ_PROFILE_BEGIN("sleepOffset");
   if (this->dataPtr->waitForSensors)
     this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
         this->dataPtr->physicsEngine->GetMaxStepSize());
@@ -723,10 +740,10 @@ void World::Step()
   this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
                       this->dataPtr->sleepOffset * 0.99;
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
 
-  IGN_PROFILE_BEGIN("worldUpdateMutex");
+  GZ_PROFILE_BEGIN("worldUpdateMutex");
   // throttling update rate, with sleepOffset as tolerance
   // the tolerance is needed as the sleep time is not exact
   if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
@@ -761,9 +778,9 @@ void World::Step()
       this->dataPtr->pauseTime += stepTime;
     }
   }
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 
-  IGN_PROFILE_BEGIN("Step");
+  GZ_PROFILE_BEGIN("Step");
 
   gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
 
@@ -773,7 +790,7 @@ void World::Step()
 
   if (g_clearModels)
     this->ClearModels();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 }
 
 //////////////////////////////////////////////////
@@ -806,8 +823,8 @@ void World::Update()
 {
   DIAG_TIMER_START("World::Update");
 
-  IGN_PROFILE("World::Update");
-  IGN_PROFILE_BEGIN("needsReset");
+  GZ_PROFILE_SCOPE("World::Update");
+  GZ_PROFILE_BEGIN("needsReset");
   if (this->dataPtr->needsReset)
   {
     if (this->dataPtr->resetAll)
@@ -819,29 +836,49 @@ void World::Update()
     this->dataPtr->needsReset = false;
     return;
   }
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
 
-  IGN_PROFILE_BEGIN("worldUpdateBegin");
+  GZ_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
   event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
 
-  IGN_PROFILE_BEGIN("Update");
+  GZ_PROFILE_BEGIN("UpdateLinks");
+  // Only update the links with batteries, audio, wind or pending wrenches
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->activeLinksMutex);
+    this->dataPtr->updateLinks.assign(this->dataPtr->activeLinks.begin(),
+        this->dataPtr->activeLinks.end());
+    this->dataPtr->updateLinks.insert(this->dataPtr->updateLinks.end(),
+        this->dataPtr->wokenLinks.begin(), this->dataPtr->wokenLinks.end());
+    this->dataPtr->wokenLinks.clear();
+  }
+  for (auto link : this->dataPtr->updateLinks)
+    link->Update(this->dataPtr->updateInfo);
+  GZ_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "Link::Update");
+
+  GZ_PROFILE_BEGIN("UpdateScheduler");
+  this->dataPtr->updateScheduler->Update(this->dataPtr->updateInfo);
+  GZ_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "UpdateScheduler::Update");
+
+  GZ_PROFILE_BEGIN("Update");
   // Update all the models
   (*this.*dataPtr->modelUpdateFunc)();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Model::Update");
 
-  IGN_PROFILE_BEGIN("UpdateCollision");
+  GZ_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
   this->dataPtr->physicsEngine->UpdateCollision();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
 
-  IGN_PROFILE_BEGIN("beforePhysicsUpdate");
+  GZ_PROFILE_BEGIN("beforePhysicsUpdate");
   // Wait for logging to finish, if it's running.
   if (util::LogRecord::Instance()->Running())
   {
@@ -862,24 +899,24 @@ void World::Update()
   this->dataPtr->updateInfo.realTime = this->RealTime();
   event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
 
   // Update the physics engine
   if (this->dataPtr->enablePhysicsEngine && this->dataPtr->physicsEngine)
   {
-    IGN_PROFILE_BEGIN("UpdatePhysics");
+    GZ_PROFILE_BEGIN("UpdatePhysics");
     // This must be called directly after PhysicsEngine::UpdateCollision.
     this->dataPtr->physicsEngine->UpdatePhysics();
 
-    IGN_PROFILE_END();
+    GZ_PROFILE_END();
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
 
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
     //           and we need to propagate it into Entity::worldPose
     {
-      IGN_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
+      GZ_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
       // block any other pose updates (e.g. Joint::SetPosition)
       boost::recursive_mutex::scoped_lock plock(
           *this->Physics()->GetPhysicsUpdateMutex());
@@ -890,24 +927,32 @@ void World::Update()
       }
 
       this->dataPtr->dirtyPoses.clear();
-      IGN_PROFILE_END();
+      GZ_PROFILE_END();
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+
+    // Put resting islands to sleep, so that the next steps neither move
+    // nor publish them
+    GZ_PROFILE_BEGIN("SleepManager");
+    this->dataPtr->sleepManager->Update(this->SimTime(),
+        this->dataPtr->physicsEngine->GetMaxStepSize());
+    GZ_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "SleepManager::Update");
   }
 
-  IGN_PROFILE_BEGIN("LogRecordNotify");
+  GZ_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
     this->dataPtr->logCondition.notify_one();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
 
-  IGN_PROFILE_BEGIN("PublishContacts");
+  GZ_PROFILE_BEGIN("PublishContacts");
   // Output the contact information
   this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
 
   event::Events::worldUpdateEnd();
@@ -932,6 +977,7 @@ void World::Fini()
     this->dataPtr->deleteEntity.clear();
     this->dataPtr->requestMsgs.clear();
     this->dataPtr->factoryMsgs.clear();
+    this->dataPtr->modelInstances.clear();
     this->dataPtr->modelMsgs.clear();
     this->dataPtr->lightFactoryMsgs.clear();
     this->dataPtr->lightModifyMsgs.clear();
@@ -939,6 +985,7 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->packedPosePub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
@@ -971,6 +1018,9 @@ void World::Fini()
   this->dataPtr->publishModelPoses.clear();
   this->dataPtr->publishModelScales.clear();
   this->dataPtr->publishLightPoses.clear();
+  this->dataPtr->packedPoseModels.clear();
+  this->dataPtr->packedPoseLights.clear();
+  this->dataPtr->packedPoseLast.clear();
 
   // Clean entities
   for (auto &model : this->dataPtr->models)
@@ -1019,6 +1069,7 @@ void World::Fini()
 
   // Clear singletons whose states are tied to this world
   util::DiagnosticManager::Instance()->Fini();
+  util::ProfileManager::Instance()->Fini();
   util::LogRecord::Instance()->Fini();
 
   // End world run thread
@@ -1092,6 +1143,18 @@ PresetManagerPtr World::PresetMgr() const
   return this->dataPtr->presetManager;
 }
 
+//////////////////////////////////////////////////
+UpdateSchedulerPtr World::Scheduler() const
+{
+  return this->dataPtr->updateScheduler;
+}
+
+//////////////////////////////////////////////////
+SleepManagerPtr World::SleepMgr() const
+{
+  return this->dataPtr->sleepManager;
+}
+
 //////////////////////////////////////////////////
 common::SphericalCoordinatesPtr World::SphericalCoords() const
 {
@@ -1168,6 +1231,13 @@ EntityPtr World::EntityByName(const std::string &_name) const
 
 //////////////////////////////////////////////////
 ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
+{
+  return this->LoadModel(_sdf, _parent, true);
+}
+
+//////////////////////////////////////////////////
+ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent,
+    const bool _enableAll)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->loadModelMutex);
   ModelPtr model;
@@ -1196,7 +1266,8 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
     model->FillMsg(msg);
     this->dataPtr->modelPub->Publish(msg);
 
-    this->EnableAllModels();
+    if (_enableAll)
+      this->EnableAllModels();
   }
   else
   {
@@ -1398,6 +1469,7 @@ void World::Reset()
     this->dataPtr->physicsEngine->SetSeed(ignition::math::Rand::Seed());
 
     this->ResetTime();
+    this->dataPtr->sleepManager->Reset();
     this->ResetEntities(Base::BASE);
     for (auto &plugin : this->dataPtr->plugins)
     {
@@ -1683,9 +1755,52 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
 {
-  // Update all the models
+  // Evaluate the animations of the actors in parallel. Actor::Update then
+  // moves their links in order.
+  std::vector<Actor *> &actors = this->dataPtr->updateActors;
+  actors.clear();
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
-    this->dataPtr->rootElement->GetChild(i)->Update();
+  {
+    Base *child = this->dataPtr->rootElement->GetChild(i).get();
+    if (child->HasType(Base::ACTOR))
+      actors.push_back(static_cast<Actor *>(child));
+  }
+  if (actors.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, actors.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            actors[i]->UpdateAnimation();
+        });
+  }
+
+  util::ProfileManager *profiler = util::ProfileManager::Instance();
+  if (!profiler->Enabled())
+  {
+    // Update all the models
+    for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount();
+        ++i)
+    {
+      this->dataPtr->rootElement->GetChild(i)->Update();
+    }
+    return;
+  }
+
+  // Same, timing each model
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    auto iter = this->dataPtr->modelProfileIds.find(child->GetId());
+    if (iter == this->dataPtr->modelProfileIds.end())
+    {
+      iter = this->dataPtr->modelProfileIds.insert(std::make_pair(
+          child->GetId(),
+          profiler->ScopeId("model::" + child->GetScopedName()))).first;
+    }
+    util::ProfileScope scope(iter->second);
+    child->Update();
+  }
 }
 
 
@@ -2080,6 +2195,7 @@ void World::ProcessFactoryMsgs()
   std::list<sdf::ElementPtr> modelsToLoad, lightsToLoad;
 
   std::list<msgs::Factory> factoryMsgsCopy;
+  std::list<ModelInstances> modelInstances;
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
 
@@ -2087,6 +2203,7 @@ void World::ProcessFactoryMsgs()
       this->dataPtr->factoryMsgs.end(),
       std::back_inserter(factoryMsgsCopy));
     this->dataPtr->factoryMsgs.clear();
+    modelInstances.swap(this->dataPtr->modelInstances);
   }
 
   for (auto const &factoryMsg : factoryMsgsCopy)
@@ -2255,6 +2372,36 @@ void World::ProcessFactoryMsgs()
     }
   }
 
+  // Clone the copies of models, with names unique among the models
+  // already loaded and the ones about to be
+  if (!modelInstances.empty())
+  {
+    std::unordered_set<std::string> names;
+    for (auto const &model : this->dataPtr->models)
+      names.insert(model->GetName());
+    for (auto const &elem : modelsToLoad)
+      names.insert(elem->Get<std::string>("name"));
+
+    for (auto const &instances : modelInstances)
+    {
+      for (size_t i = 0; i < instances.poses.size(); ++i)
+      {
+        const std::string name = instances.namePrefix + std::to_string(i);
+        std::string uniqueName = name;
+        for (int j = 0; names.count(uniqueName) > 0; ++j)
+          uniqueName = name + "_" + std::to_string(j);
+        names.insert(uniqueName);
+
+        sdf::ElementPtr elem = instances.sdf->Clone();
+        elem->GetAttribute("name")->Set(uniqueName);
+        elem->GetElement("pose")->Set(instances.poses[i]);
+        elem->SetParent(this->dataPtr->sdf);
+        elem->GetParent()->InsertElement(elem);
+        modelsToLoad.push_back(elem);
+      }
+    }
+  }
+
   // Load models
   for (auto const &elem : modelsToLoad)
   {
@@ -2262,7 +2409,8 @@ void World::ProcessFactoryMsgs()
     {
       std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
-      ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
+      ModelPtr model =
+        this->LoadModel(elem, this->dataPtr->rootElement, false);
       if (model != nullptr)
       {
         model->Init();
@@ -2275,6 +2423,9 @@ void World::ProcessFactoryMsgs()
     }
   }
 
+  if (!modelsToLoad.empty())
+    this->EnableAllModels();
+
   // Load lights
   for (auto const &elem : lightsToLoad)
   {
@@ -2479,6 +2630,26 @@ void World::InsertModelString(const std::string &_sdfString)
   this->dataPtr->factoryMsgs.push_back(msg);
 }
 
+//////////////////////////////////////////////////
+void World::InsertModels(const sdf::ElementPtr &_modelSdf,
+    const std::vector<ignition::math::Pose3d> &_poses,
+    const std::string &_namePrefix)
+{
+  if (!_modelSdf || _modelSdf->GetName() != "model")
+  {
+    gzerr << "Unable to insert copies of a model without a <model> element\n";
+    return;
+  }
+
+  ModelInstances instances;
+  instances.sdf = _modelSdf->Clone();
+  instances.poses = _poses;
+  instances.namePrefix = _namePrefix;
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->modelInstances.push_back(std::move(instances));
+}
+
 //////////////////////////////////////////////////
 std::string World::StripWorldName(const std::string &_name) const
 {
@@ -2768,6 +2939,17 @@ void World::ProcessMessages()
       }
     }
 
+    if (this->dataPtr->packedPosePub &&
+        this->dataPtr->packedPosePub->HasConnections())
+    {
+      this->PublishPackedPoses();
+    }
+    else
+    {
+      // Start over with every pose when a subscriber connects
+      this->dataPtr->packedPoseKeyTime = common::Time::Zero;
+    }
+
     this->dataPtr->publishModelPoses.clear();
     this->dataPtr->publishLightPoses.clear();
   }
@@ -2892,6 +3074,112 @@ bool World::IsLoaded() const
   return this->dataPtr->loaded;
 }
 
+//////////////////////////////////////////////////
+void World::PublishPackedPoses()
+{
+  // Pose changes are collected between messages, so that none is lost when
+  // the rate is capped
+  this->dataPtr->packedPoseModels.insert(
+      this->dataPtr->publishModelPoses.begin(),
+      this->dataPtr->publishModelPoses.end());
+  this->dataPtr->packedPoseLights.insert(
+      this->dataPtr->publishLightPoses.begin(),
+      this->dataPtr->publishLightPoses.end());
+
+  const common::Time now = common::Time::GetWallTime();
+  if ((now - this->dataPtr->packedPoseTime).Double() < 1.0 / 60.0)
+    return;
+  this->dataPtr->packedPoseTime = now;
+
+  // Send every pose once per second, so that subscribers that joined late
+  // or fell behind catch up
+  const bool delta = this->dataPtr->packedPoseDelta &&
+      (now - this->dataPtr->packedPoseKeyTime).Double() < 1.0;
+  if (!delta)
+  {
+    this->dataPtr->packedPoseKeyTime = now;
+    this->dataPtr->packedPoseLast.clear();
+    this->dataPtr->packedPoseModels.insert(this->dataPtr->models.begin(),
+        this->dataPtr->models.end());
+    this->dataPtr->packedPoseLights.insert(this->dataPtr->lights.begin(),
+        this->dataPtr->lights.end());
+  }
+
+  msgs::PackedPoses &msg = this->dataPtr->packedPoseMsg;
+  msg.clear_id();
+  msg.clear_pose();
+  msg.set_delta(delta);
+  msgs::Set(msg.mutable_time(), this->SimTime());
+
+  auto add = [&](const uint32_t _id, const ignition::math::Pose3d &_pose)
+  {
+    const std::array<float, 7> packed =
+    {{
+      static_cast<float>(_pose.Pos().X()),
+      static_cast<float>(_pose.Pos().Y()),
+      static_cast<float>(_pose.Pos().Z()),
+      static_cast<float>(_pose.Rot().W()),
+      static_cast<float>(_pose.Rot().X()),
+      static_cast<float>(_pose.Rot().Y()),
+      static_cast<float>(_pose.Rot().Z())
+    }};
+
+    if (this->dataPtr->packedPoseDelta)
+    {
+      auto iter = this->dataPtr->packedPoseLast.find(_id);
+      if (iter == this->dataPtr->packedPoseLast.end())
+        this->dataPtr->packedPoseLast.emplace(_id, packed);
+      else if (delta && iter->second == packed)
+        return;
+      else
+        iter->second = packed;
+    }
+
+    msg.add_id(_id);
+    for (const float value : packed)
+      msg.add_pose(value);
+  };
+
+  std::vector<ModelPtr> stack(this->dataPtr->packedPoseModels.begin(),
+      this->dataPtr->packedPoseModels.end());
+  while (!stack.empty())
+  {
+    ModelPtr model = stack.back();
+    stack.pop_back();
+
+    add(model->GetId(), model->RelativePose());
+    for (auto const &link : model->GetLinks())
+      add(link->GetId(), link->RelativePose());
+
+    Model_V nested = model->NestedModels();
+    stack.insert(stack.end(), nested.begin(), nested.end());
+  }
+
+  for (auto const &light : this->dataPtr->packedPoseLights)
+    add(light->GetId(), light->RelativePose());
+
+  this->dataPtr->packedPoseModels.clear();
+  this->dataPtr->packedPoseLights.clear();
+
+  if (msg.id_size() > 0)
+    this->dataPtr->packedPosePub->Publish(msg);
+}
+
+//////////////////////////////////////////////////
+void World::SetPackedPoseDelta(const bool _delta)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  this->dataPtr->packedPoseDelta = _delta;
+  this->dataPtr->packedPoseLast.clear();
+}
+
+//////////////////////////////////////////////////
+bool World::PackedPoseDelta() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  return this->dataPtr->packedPoseDelta;
+}
+
 //////////////////////////////////////////////////
 void World::PublishModelPose(physics::ModelPtr _model)
 {
@@ -3125,6 +3413,15 @@ void World::RemoveModel(const std::string &_name)
         break;
       }
     }
+    for (auto model = this->dataPtr->packedPoseModels.begin();
+             model != this->dataPtr->packedPoseModels.end(); ++model)
+    {
+      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
+      {
+        this->dataPtr->packedPoseModels.erase(model);
+        break;
+      }
+    }
   }
 
   // Cleanup the publishLightPoses list.
@@ -3138,6 +3435,14 @@ void World::RemoveModel(const std::string &_name)
         break;
       }
     }
+    for (auto light : this->dataPtr->packedPoseLights)
+    {
+      if (light->GetName() == _name || light->GetScopedName() == _name)
+      {
+        this->dataPtr->packedPoseLights.erase(light);
+        break;
+      }
+    }
   }
 }
 
@@ -3223,6 +3528,36 @@ void World::_AddDirty(Entity *_entity)
   this->dataPtr->dirtyPoses.push_back(_entity);
 }
 
+/////////////////////////////////////////////////
+void World::_SetLinkActive(Link *_link, const bool _active)
+{
+  GZ_ASSERT(_link != nullptr, "_link is nullptr");
+  std::lock_guard<std::mutex> lock(this->dataPtr->activeLinksMutex);
+
+  auto &active = this->dataPtr->activeLinks;
+  auto &woken = this->dataPtr->wokenLinks;
+  if (_active)
+  {
+    if (std::find(active.begin(), active.end(), _link) == active.end())
+      active.push_back(_link);
+    woken.erase(std::remove(woken.begin(), woken.end(), _link), woken.end());
+  }
+  else
+  {
+    active.erase(std::remove(active.begin(), active.end(), _link),
+        active.end());
+    woken.erase(std::remove(woken.begin(), woken.end(), _link), woken.end());
+  }
+}
+
+/////////////////////////////////////////////////
+void World::_WakeLink(Link *_link)
+{
+  GZ_ASSERT(_link != nullptr, "_link is nullptr");
+  std::lock_guard<std::mutex> lock(this->dataPtr->activeLinksMutex);
+  this->dataPtr->wokenLinks.push_back(_link);
+}
+
 /////////////////////////////////////////////////
 void World::ResetPhysicsStates()
 {
@@ -25,6 +25,7 @@
 #include <memory>
 
 #include <boost/enable_shared_from_this.hpp>
+#include <ignition/math/Pose3.hh>
 
 #include <sdf/sdf.hh>
 
@@ -151,6 +152,18 @@ namespace gazebo
       /// \return Pointer to the preset manager.
       public: PresetManagerPtr PresetMgr() const;
 
+      /// \brief Return the update scheduler. Plugins connect their updates
+      /// to it, along with the resources they access, so that independent
+      /// updates run in parallel. The updates run after the
+      /// worldUpdateBegin event and before the models are updated.
+      /// \return Pointer to the update scheduler.
+      public: UpdateSchedulerPtr Scheduler() const;
+
+      /// \brief Return the sleep manager, which puts resting models to
+      /// sleep so that they are neither simulated nor published.
+      /// \return Pointer to the sleep manager.
+      public: SleepManagerPtr SleepMgr() const;
+
       /// \brief Get a reference to the wind used by the world.
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
@@ -312,6 +325,19 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert copies of a model at several poses. The model
+      /// element is cloned for each copy, and the copies are loaded
+      /// together in the next world update, without going through strings
+      /// or parsing SDF again. This is much faster than inserting each
+      /// copy with InsertModelString.
+      /// \param[in] _modelSdf The <model> element to copy.
+      /// \param[in] _poses Pose of each copy.
+      /// \param[in] _namePrefix Each copy is named with this prefix followed
+      /// by its index in _poses, and made unique if needed.
+      public: void InsertModels(const sdf::ElementPtr &_modelSdf,
+                  const std::vector<ignition::math::Pose3d> &_poses,
+                  const std::string &_namePrefix);
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -400,6 +426,17 @@ namespace gazebo
       /// \param[in] _light Pointer to the light to publish.
       public: void PublishLightPose(const physics::LightPtr _light);
 
+      /// \brief Set whether the compact pose stream published on
+      /// ~/pose/packed/info leaves out the entities whose pose didn't change
+      /// since the previous message. Enabled by default.
+      /// \param[in] _delta True to enable delta encoding.
+      /// \sa msgs::PackedPoses
+      public: void SetPackedPoseDelta(const bool _delta);
+
+      /// \brief Get whether the compact pose stream is delta encoded.
+      /// \return True if delta encoding is enabled.
+      public: bool PackedPoseDelta() const;
+
       /// \brief Get the total number of iterations.
       /// \return Number of iterations that simulation has taken.
       public: uint32_t Iterations() const;
@@ -438,6 +475,24 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \internal
+      /// \brief Set whether a link is updated at the beginning of every
+      /// world update, because it has batteries, audio or wind. Inactive
+      /// links are only updated when woken up. Only Link should call this
+      /// function.
+      /// \param[in] _link Link to update.
+      /// \param[in] _active True to update the link every step, false to
+      /// stop updating it, also when it was woken up.
+      /// \sa _WakeLink
+      public: void _SetLinkActive(Link *_link, const bool _active);
+
+      /// \internal
+      /// \brief Update a link once at the beginning of the next world
+      /// update, to apply the wrenches it received. Can be called from any
+      /// thread. Only Link should call this function.
+      /// \param[in] _link Link to update.
+      public: void _WakeLink(Link *_link);
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
@@ -489,6 +544,15 @@ namespace gazebo
       /// \return Pointer to the newly created Model.
       private: ModelPtr LoadModel(sdf::ElementPtr _sdf, BasePtr _parent);
 
+      /// \brief Load a model.
+      /// \param[in] _sdf SDF element containing the Model description.
+      /// \param[in] _parent Parent of the model.
+      /// \param[in] _enableAll True to enable all the models once loaded,
+      /// false if the caller enables them after loading several models.
+      /// \return Pointer to the newly created Model.
+      private: ModelPtr LoadModel(sdf::ElementPtr _sdf, BasePtr _parent,
+                   const bool _enableAll);
+
       /// \brief Load a light.
       /// \param[in] _sdf SDF element containing the Light description.
       /// \param[in] _parent Parent of the light.
@@ -610,6 +674,10 @@ namespace gazebo
       /// \brief Process all incoming messages.
       private: void ProcessMessages();
 
+      /// \brief Publish the compact pose stream. Called by ProcessMessages
+      /// while the models and lights to publish are locked.
+      private: void PublishPackedPoses();
+
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
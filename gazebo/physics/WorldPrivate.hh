@@ -17,8 +17,10 @@
 #ifndef GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 #define GAZEBO_PHYSICS_WORLDPRIVATE_HH_
 
+#include <array>
 #include <atomic>
 #include <deque>
+#include <unordered_map>
 #include <vector>
 #include <list>
 #include <memory>
@@ -29,6 +31,7 @@
 #include <thread>
 #include <condition_variable>
 
+#include <ignition/math/Pose3.hh>
 #include <ignition/transport.hh>
 
 #include "gazebo/common/Event.hh"
@@ -46,6 +49,19 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief Copies of a model waiting to be inserted in the world.
+    class ModelInstances
+    {
+      /// \brief The <model> element copied.
+      public: sdf::ElementPtr sdf;
+
+      /// \brief Pose of each copy.
+      public: std::vector<ignition::math::Pose3d> poses;
+
+      /// \brief Prefix of the names of the copies.
+      public: std::string namePrefix;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -122,6 +138,33 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher for packed pose messages.
+      public: transport::PublisherPtr packedPosePub;
+
+      /// \brief Packed pose message, reused to avoid reallocations.
+      public: msgs::PackedPoses packedPoseMsg;
+
+      /// \brief True to leave unchanged poses out of packed pose messages.
+      public: bool packedPoseDelta;
+
+      /// \brief Last packed pose sent for each entity id, used for delta
+      /// encoding.
+      public: std::unordered_map<uint32_t, std::array<float, 7>>
+              packedPoseLast;
+
+      /// \brief Models whose pose waits for the next packed pose message.
+      public: std::set<ModelPtr> packedPoseModels;
+
+      /// \brief Lights whose pose waits for the next packed pose message.
+      public: std::set<LightPtr> packedPoseLights;
+
+      /// \brief Wall time of the last packed pose message.
+      public: common::Time packedPoseTime;
+
+      /// \brief Wall time of the last packed pose message that held every
+      /// pose.
+      public: common::Time packedPoseKeyTime;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -205,6 +248,10 @@ namespace gazebo
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
+      /// \brief Copies of models to insert, inserted along with the factory
+      /// messages.
+      public: std::list<ModelInstances> modelInstances;
+
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
 
@@ -349,6 +396,32 @@ namespace gazebo
       /// \brief Class to manage user commands.
       public: UserCmdManagerPtr userCmdManager;
 
+      /// \brief Runs the plugin updates that declare what they access,
+      /// in parallel when possible.
+      public: UpdateSchedulerPtr updateScheduler;
+
+      /// \brief Puts resting islands of models to sleep.
+      public: SleepManagerPtr sleepManager;
+
+      /// \brief Profiler scope ids of the models, indexed by entity id.
+      public: std::unordered_map<uint32_t, uint32_t> modelProfileIds;
+
+      /// \brief Actors animated during the model update, reused.
+      public: std::vector<Actor *> updateActors;
+
+      /// \brief Protects activeLinks and wokenLinks.
+      public: std::mutex activeLinksMutex;
+
+      /// \brief Links updated at the beginning of every world update.
+      public: std::vector<Link *> activeLinks;
+
+      /// \brief Links updated once at the beginning of the next world
+      /// update.
+      public: std::vector<Link *> wokenLinks;
+
+      /// \brief Links updated in the current world update, reused.
+      public: std::vector<Link *> updateLinks;
+
       /// \brief True if sensors have been initialized. This should be set
       /// by the SensorManager.
       public: std::atomic_bool sensorsInitialized;
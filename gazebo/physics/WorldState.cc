@@ -24,6 +24,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Light.hh"
+#include "gazebo/physics/SleepManager.hh"
 #include "gazebo/physics/WorldState.hh"
 
 using namespace gazebo;
@@ -114,6 +115,7 @@ void WorldState::Load(const WorldPtr _world)
 
   // Add a state for all the models that match the filter
   Model_V models = _world->Models();
+  SleepManagerPtr sleepManager = _world->SleepMgr();
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
@@ -129,10 +131,27 @@ void WorldState::Load(const WorldPtr _world)
       add = boost::regex_match((*iter)->GetName(), regex);
     }
 
-    if (add)
+    if (!add)
+      continue;
+
+    // A model asleep since it was last loaded hasn't moved, unless it was
+    // teleported, only its times change
+    ModelState &modelState = this->modelStates[(*iter)->GetName()];
+    common::Time since;
+    if (sleepManager && sleepManager->Sleeping(**iter, since) &&
+        modelState.GetName() == (*iter)->GetName() &&
+        modelState.GetSimTime() >= since &&
+        modelState.Pose() == (*iter)->WorldPose())
     {
-      this->modelStates[(*iter)->GetName()].Load(*iter, this->realTime,
-          this->simTime, this->iterations);
+      modelState.SetWallTime(this->wallTime);
+      modelState.SetRealTime(this->realTime);
+      modelState.SetSimTime(this->simTime);
+      modelState.SetIterations(this->iterations);
+    }
+    else
+    {
+      modelState.Load(*iter, this->realTime, this->simTime,
+          this->iterations);
     }
   }
 
@@ -338,23 +338,36 @@ void BulletLink::OnPoseChange()
 //////////////////////////////////////////////////
 bool BulletLink::GetEnabled() const
 {
-  // This function and its counterpart BulletLink::SetEnabled
-  // don't do anything yet.
-  return true;
+  if (!this->rigidLink)
+    return true;
+
+  return this->rigidLink->isActive();
 }
 
 //////////////////////////////////////////////////
-void BulletLink::SetEnabled(bool /*_enable*/) const
+void BulletLink::SetEnabled(bool _enable) const
 {
-  /*
   if (!this->rigidLink)
     return;
 
   if (_enable)
+  {
+    if (this->rigidLink->isActive())
+      return;
+
+    // Restore the activation state set in Init
+    if (this->GetModel()->GetAutoDisable() &&
+        this->GetModel()->GetJointCount() == 0 &&
+        this->GetSensorCount() == 0)
+    {
+      this->rigidLink->forceActivationState(ACTIVE_TAG);
+    }
+    else
+      this->rigidLink->forceActivationState(DISABLE_DEACTIVATION);
     this->rigidLink->activate(true);
+  }
   else
-    this->rigidLink->setActivationState(WANTS_DEACTIVATION);
-    */
+    this->rigidLink->forceActivationState(ISLAND_SLEEPING);
 }
 
 //////////////////////////////////////////////////
@@ -367,6 +380,7 @@ void BulletLink::SetLinearVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->SetEnabled(true);
   this->rigidLink->setLinearVelocity(BulletTypes::ConvertVector3(_vel));
 }
 
@@ -441,6 +455,7 @@ void BulletLink::SetAngularVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->SetEnabled(true);
   this->rigidLink->setAngularVelocity(BulletTypes::ConvertVector3(_vel));
 }
 
@@ -466,6 +481,7 @@ void BulletLink::SetForce(const ignition::math::Vector3d &_force)
   if (!this->rigidLink)
     return;
 
+  this->SetEnabled(true);
   this->rigidLink->applyCentralForce(
     btVector3(_force.X(), _force.Y(), _force.Z()));
 }
@@ -493,6 +509,7 @@ void BulletLink::SetTorque(const ignition::math::Vector3d &_torque)
     return;
   }
 
+  this->SetEnabled(true);
   this->rigidLink->applyTorque(BulletTypes::ConvertVector3(_torque));
 }
 
@@ -15,13 +15,40 @@
  *
 */
 
+#include <memory>
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 
+#include "gazebo/physics/CollisionMeshCache.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/physics/bullet/BulletCollision.hh"
 #include "gazebo/physics/bullet/BulletPhysics.hh"
 #include "gazebo/physics/bullet/BulletMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Bullet shape built from collision mesh data.
+    class BulletMeshData
+    {
+      /// \brief Triangles referenced by the shape.
+      public: std::unique_ptr<btTriangleMesh> triMesh;
+
+      /// \brief The collision shape.
+      public: std::unique_ptr<btGImpactMeshShape> gimpactMeshShape;
+
+      /// \brief Convex hulls, children of compoundShape.
+      public: std::vector<std::unique_ptr<btConvexHullShape>> hullShapes;
+
+      /// \brief The collision shape of data made of convex hulls.
+      public: std::unique_ptr<btCompoundShape> compoundShape;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
@@ -40,20 +67,9 @@ void BulletMesh::Init(const common::SubMesh *_subMesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&vertices, &indices);
-
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
-
-  delete [] vertices;
-  delete [] indices;
+  // Without the parent mesh, the submesh can't be identified in the cache
+  this->Init(CollisionMeshCache::Build(nullptr, _subMesh, _scale),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -61,58 +77,81 @@ void BulletMesh::Init(const common::Mesh *_mesh,
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale)
 {
-  float *vertices = nullptr;
-  int *indices = nullptr;
-
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&vertices, &indices);
-
-  this->CreateMesh(vertices, indices, numVertices,
-                   numIndices, _collision, _scale);
-
-  delete [] vertices;
-  delete [] indices;
+  this->Init(CollisionMeshCache::Instance()->Data(_mesh, nullptr, _scale),
+      _collision);
 }
 
 /////////////////////////////////////////////////
-void BulletMesh::CreateMesh(float *_vertices, int *_indices,
-    unsigned int _numVertices, unsigned int _numIndices,
-    BulletCollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void BulletMesh::Init(const CollisionMeshDataPtr &_data,
+    BulletCollisionPtr _collision)
 {
-  btTriangleMesh *mTriMesh = new btTriangleMesh();
-
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; ++j)
-  {
-    _vertices[j*3+0] = _vertices[j*3+0] * _scale.X();
-    _vertices[j*3+1] = _vertices[j*3+1] * _scale.Y();
-    _vertices[j*3+2] = _vertices[j*3+2] * _scale.Z();
-  }
-
-  // Create the Bullet trimesh
-  for (unsigned int j = 0; j < _numIndices; j += 3)
-  {
-    btVector3 bv0(_vertices[_indices[j]*3+0],
-                  _vertices[_indices[j]*3+1],
-                  _vertices[_indices[j]*3+2]);
-
-    btVector3 bv1(_vertices[_indices[j+1]*3+0],
-                  _vertices[_indices[j+1]*3+1],
-                  _vertices[_indices[j+1]*3+2]);
-
-    btVector3 bv2(_vertices[_indices[j+2]*3+0],
-                  _vertices[_indices[j+2]*3+1],
-                  _vertices[_indices[j+2]*3+2]);
-
-    mTriMesh->addTriangle(bv0, bv1, bv2);
-  }
-
-  btGImpactMeshShape *gimpactMeshShape =
-    new btGImpactMeshShape(mTriMesh);
-  gimpactMeshShape->updateBound();
-
-  _collision->SetCollisionShape(gimpactMeshShape);
+  if (!_data)
+    return;
+
+  this->meshData = _data;
+
+  // Build the Bullet trimesh once for all collisions sharing the data
+  CollisionMeshData *data = _data.get();
+  this->shape = _data->EngineData("bullet", [data]()
+      {
+        std::shared_ptr<BulletMeshData> meshShape(new BulletMeshData);
+        const float *vertices = data->Vertices();
+        const int *indices = data->Indices();
+
+        // One convex hull shape per hull, grouped in a compound shape
+        if (data->HullCount() > 0)
+        {
+          meshShape->compoundShape.reset(new btCompoundShape());
+          const unsigned int *sizes = data->HullSizes();
+          unsigned int firstVertex = 0;
+          for (unsigned int h = 0; h < data->HullCount(); ++h)
+          {
+            const unsigned int vertexCount = sizes[h * 2];
+            std::unique_ptr<btConvexHullShape> hull(new btConvexHullShape());
+            for (unsigned int v = firstVertex;
+                v < firstVertex + vertexCount; ++v)
+            {
+              hull->addPoint(btVector3(vertices[v*3+0], vertices[v*3+1],
+                    vertices[v*3+2]), false);
+            }
+            hull->recalcLocalAabb();
+
+            btTransform identity;
+            identity.setIdentity();
+            meshShape->compoundShape->addChildShape(identity, hull.get());
+            meshShape->hullShapes.push_back(std::move(hull));
+            firstVertex += vertexCount;
+          }
+          return std::shared_ptr<void>(meshShape);
+        }
+
+        meshShape->triMesh.reset(new btTriangleMesh());
+        for (unsigned int j = 0; j + 2 < data->IndexCount(); j += 3)
+        {
+          btVector3 bv0(vertices[indices[j]*3+0],
+                        vertices[indices[j]*3+1],
+                        vertices[indices[j]*3+2]);
+
+          btVector3 bv1(vertices[indices[j+1]*3+0],
+                        vertices[indices[j+1]*3+1],
+                        vertices[indices[j+1]*3+2]);
+
+          btVector3 bv2(vertices[indices[j+2]*3+0],
+                        vertices[indices[j+2]*3+1],
+                        vertices[indices[j+2]*3+2]);
+
+          meshShape->triMesh->addTriangle(bv0, bv1, bv2);
+        }
+
+        meshShape->gimpactMeshShape.reset(
+            new btGImpactMeshShape(meshShape->triMesh.get()));
+        meshShape->gimpactMeshShape->updateBound();
+        return std::shared_ptr<void>(meshShape);
+      });
+
+  BulletMeshData *meshShape = static_cast<BulletMeshData *>(this->shape.get());
+  if (meshShape->compoundShape)
+    _collision->SetCollisionShape(meshShape->compoundShape.get());
+  else
+    _collision->SetCollisionShape(meshShape->gimpactMeshShape.get());
 }
@@ -18,8 +18,11 @@
 #ifndef GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 #define GAZEBO_PHYSICS_BULLET_BULLETMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
+#include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/bullet/BulletTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -56,17 +59,20 @@ namespace gazebo
                       BulletCollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
-      /// \brief Helper function to create the collision shape.
-      /// \param[in] _vertices Array of vertices.
-      /// \param[in] _indices Array of indices.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \brief Create a mesh collision shape from shared collision data.
+      /// The Bullet shape is built once per collision data and shared by all
+      /// collisions using it. Data made of convex hulls gives a compound of
+      /// convex hull shapes.
+      /// \param[in] _data Scaled triangle data.
       /// \param[in] _collision Pointer to the collision object.
-      /// \param[in] _scale Scaling factor.
-      private: void CreateMesh(float *_vertices, int *_indices,
-                   unsigned int _numVertices, unsigned int _numIndices,
-                   BulletCollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      public: void Init(const CollisionMeshDataPtr &_data,
+                      BulletCollisionPtr _collision);
+
+      /// \brief Triangle data, shared with other collisions.
+      private: CollisionMeshDataPtr meshData;
+
+      /// \brief Keeps the shared Bullet shape alive.
+      private: std::shared_ptr<void> shape;
     };
     /// \}
   }
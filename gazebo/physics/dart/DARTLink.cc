@@ -335,16 +335,22 @@ void DARTLink::OnPoseChange()
 }
 
 //////////////////////////////////////////////////
-void DARTLink::SetEnabled(bool /*_enable*/) const
+void DARTLink::SetEnabled(bool _enable) const
 {
-  // TODO: DART does not support this functionality.
+  // DART doesn't disable bodies, so the whole skeleton stops moving
+  if (!this->dataPtr->IsInitialized() || this->IsStatic())
+    return;
+
+  this->dataPtr->dtBodyNode->getSkeleton()->setMobile(_enable);
 }
 
 //////////////////////////////////////////////////
 bool DARTLink::GetEnabled() const
 {
-  // TODO: DART does not support this functionality.
-  return true;
+  if (!this->dataPtr->IsInitialized() || this->IsStatic())
+    return true;
+
+  return this->dataPtr->dtBodyNode->getSkeleton()->isMobile();
 }
 
 //////////////////////////////////////////////////
@@ -358,6 +364,7 @@ void DARTLink::SetLinearVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->SetEnabled(true);
   // DART body node always have its parent joint.
   dart::dynamics::Joint *joint = this->dataPtr->dtBodyNode->getParentJoint();
 
@@ -425,6 +432,7 @@ void DARTLink::SetAngularVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->SetEnabled(true);
   // DART body node always have its parent joint.
   dart::dynamics::Joint *joint = this->dataPtr->dtBodyNode->getParentJoint();
 
@@ -495,6 +503,7 @@ void DARTLink::SetForce(const ignition::math::Vector3d &_force)
     return;
   }
 
+  this->SetEnabled(true);
   // DART assume that _force is external force.
   this->dataPtr->dtBodyNode->setExtForce(DARTTypes::ConvVec3(_force));
 }
@@ -509,6 +518,7 @@ void DARTLink::SetTorque(const ignition::math::Vector3d &_torque)
     return;
   }
 
+  this->SetEnabled(true);
   // DART assume that _torque is external torque.
   this->dataPtr->dtBodyNode->setExtTorque(DARTTypes::ConvVec3(_torque));
 }
@@ -523,6 +533,7 @@ void DARTLink::AddForce(const ignition::math::Vector3d &_force)
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtForce(DARTTypes::ConvVec3(_force));
 }
 
@@ -537,6 +548,7 @@ void DARTLink::AddRelativeForce(const ignition::math::Vector3d &_force)
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtForce(DARTTypes::ConvVec3(_force),
                                 Eigen::Vector3d::Zero(),
                                 true, true);
@@ -554,6 +566,7 @@ void DARTLink::AddForceAtWorldPosition(const ignition::math::Vector3d &_force,
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtForce(DARTTypes::ConvVec3(_pos),
                                 DARTTypes::ConvVec3(_force),
                                 false, false);
@@ -573,6 +586,7 @@ void DARTLink::AddForceAtRelativePosition(
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtForce(
         DARTTypes::ConvVec3(_force),
         DARTTypes::ConvVec3(_relpos) + this->dataPtr->dtBodyNode->getLocalCOM(),
@@ -593,6 +607,7 @@ void DARTLink::AddLinkForce(
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtForce(
         DARTTypes::ConvVec3(_force),
         DARTTypes::ConvVec3(_offset),
@@ -609,6 +624,7 @@ void DARTLink::AddTorque(const ignition::math::Vector3d &_torque)
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtTorque(DARTTypes::ConvVec3(_torque));
 }
 
@@ -623,6 +639,7 @@ void DARTLink::AddRelativeTorque(const ignition::math::Vector3d &_torque)
     return;
   }
 
+  this->SetEnabled(true);
   this->dataPtr->dtBodyNode->addExtTorque(DARTTypes::ConvVec3(_torque), true);
 }
 
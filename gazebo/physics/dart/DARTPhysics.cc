@@ -468,6 +468,11 @@ void DARTPhysics::UpdatePhysics()
     {
       dartLinkItr
           = boost::dynamic_pointer_cast<DARTLink>(links.at(j));
+
+      // Sleeping links don't move, see SleepManager
+      if (!dartLinkItr->GetEnabled())
+        continue;
+
       dartLinkItr->updateDirtyPoseFromDARTTransformation();
     }
   }
@@ -49,8 +49,8 @@ ODECollision::ODECollision(LinkPtr _link)
 //////////////////////////////////////////////////
 ODECollision::~ODECollision()
 {
-  if (this->collisionId)
-    dGeomDestroy(this->collisionId);
+  for (auto id : this->CollisionIds())
+    dGeomDestroy(id);
   this->collisionId = nullptr;
 
   this->Fini();
@@ -138,6 +138,27 @@ dGeomID ODECollision::GetCollisionId() const
   return this->collisionId;
 }
 
+//////////////////////////////////////////////////
+std::vector<dGeomID> ODECollision::CollisionIds() const
+{
+  std::vector<dGeomID> ids;
+  if (!this->collisionId)
+    return ids;
+  ids.push_back(this->collisionId);
+
+  // Only mesh collisions have more than one geom
+  if (!this->HasType(Base::MESH_SHAPE) || !this->spaceId)
+    return ids;
+
+  for (int i = 0; i < dSpaceGetNumGeoms(this->spaceId); ++i)
+  {
+    dGeomID id = dSpaceGetGeom(this->spaceId, i);
+    if (id != this->collisionId && dGeomGetData(id) == this)
+      ids.push_back(id);
+  }
+  return ids;
+}
+
 //////////////////////////////////////////////////
 int ODECollision::GetCollisionClass() const
 {
@@ -154,8 +175,8 @@ int ODECollision::GetCollisionClass() const
 //////////////////////////////////////////////////
 void ODECollision::SetCategoryBits(unsigned int _bits)
 {
-  if (this->collisionId)
-    dGeomSetCategoryBits(this->collisionId, _bits);
+  for (auto id : this->CollisionIds())
+    dGeomSetCategoryBits(id, _bits);
   if (this->spaceId)
     dGeomSetCategoryBits((dGeomID)this->spaceId, _bits);
 }
@@ -163,8 +184,8 @@ void ODECollision::SetCategoryBits(unsigned int _bits)
 //////////////////////////////////////////////////
 void ODECollision::SetCollideBits(unsigned int _bits)
 {
-  if (this->collisionId)
-    dGeomSetCollideBits(this->collisionId, _bits);
+  for (auto id : this->CollisionIds())
+    dGeomSetCollideBits(id, _bits);
   if (this->spaceId)
     dGeomSetCollideBits((dGeomID)this->spaceId, _bits);
 }
@@ -182,6 +203,16 @@ ignition::math::AxisAlignedBox ODECollision::BoundingBox() const
       ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
       ignition::math::Vector3d(aabb[1], aabb[3], aabb[5]));
 
+  // Merge the boxes of the other convex hulls
+  const std::vector<dGeomID> ids = this->CollisionIds();
+  for (size_t i = 1; i < ids.size(); ++i)
+  {
+    dGeomGetAABB(ids[i], aabb);
+    box.Merge(ignition::math::AxisAlignedBox(
+        ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
+        ignition::math::Vector3d(aabb[1], aabb[3], aabb[5])));
+  }
+
   return box;
 }
 
@@ -224,9 +255,12 @@ void ODECollision::OnPoseChangeGlobal()
   q[2] = localPose.Rot().Y();
   q[3] = localPose.Rot().Z();
 
-  dGeomSetPosition(this->collisionId, localPose.Pos().X(),
-      localPose.Pos().Y(), localPose.Pos().Z());
-  dGeomSetQuaternion(this->collisionId, q);
+  for (auto id : this->CollisionIds())
+  {
+    dGeomSetPosition(id, localPose.Pos().X(), localPose.Pos().Y(),
+        localPose.Pos().Z());
+    dGeomSetQuaternion(id, q);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -251,9 +285,12 @@ void ODECollision::OnPoseChangeRelative()
 
   // Set the pose of the encapsulated collision; this is always relative
   // to the CoM
-  dGeomSetOffsetPosition(this->collisionId,
-      localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
-  dGeomSetOffsetQuaternion(this->collisionId, q);
+  for (auto id : this->CollisionIds())
+  {
+    dGeomSetOffsetPosition(id,
+        localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
+    dGeomSetOffsetQuaternion(id, q);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -22,6 +22,8 @@
 #ifndef _ODECOLLISION_HH_
 #define _ODECOLLISION_HH_
 
+#include <vector>
+
 #include "gazebo/physics/ode/ode_inc.h"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -61,6 +63,13 @@ namespace gazebo
       /// \return The collision id.
       public: dGeomID GetCollisionId() const;
 
+      /// \brief Get all the ODE geoms of the collision. A mesh collision
+      /// made of convex hulls has one geom per hull, all in the space of
+      /// the collision.
+      /// \return The geoms, starting with the collision id. Empty if there
+      /// is no collision id.
+      public: std::vector<dGeomID> CollisionIds() const;
+
       /// \brief Get the ODE collision class.
       /// \return The ODE collision class.
       public: int GetCollisionClass() const;
@@ -33,9 +33,23 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the ODELink class
+    class ODELinkPrivate
+    {
+      /// \brief True if the link is flagged as moving fast.
+      public: bool fast = false;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 ODELink::ODELink(EntityPtr _parent)
-    : Link(_parent)
+    : Link(_parent), dataPtr(new ODELinkPrivate)
 {
   this->linkId = nullptr;
 }
@@ -56,6 +70,9 @@ void ODELink::Load(sdf::ElementPtr _sdf)
     gzthrow("Not using the ode physics engine");
 
   Link::Load(_sdf);
+
+  if (_sdf->HasElement("gz:fast"))
+    this->SetFast(_sdf->Get<bool>("gz:fast"));
 }
 
 //////////////////////////////////////////////////
@@ -100,7 +117,8 @@ void ODELink::Init()
         ODECollisionPtr g = boost::static_pointer_cast<ODECollision>(child);
         if (g->IsPlaceable() && g->GetCollisionId())
         {
-          dGeomSetBody(g->GetCollisionId(), this->linkId);
+          for (auto id : g->CollisionIds())
+            dGeomSetBody(id, this->linkId);
         }
       }
     }
@@ -133,50 +151,70 @@ void ODELink::Init()
 }
 
 //////////////////////////////////////////////////
-void ODELink::DisabledCallback(dBodyID /*_id*/)
+void ODELink::DisabledCallback(dBodyID _id)
 {
+  // A body moved by earlier substeps can be disabled at the start of a
+  // later one, and not move anymore. Report the pose it reached.
+  ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
+  if (self->odePhysics && self->odePhysics->Substep() > 0)
+    self->UpdateDirtyPose();
 }
 
 //////////////////////////////////////////////////
 void ODELink::MoveCallback(dBodyID _id)
+{
+  ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
+
+  // The pose is reported once, after the last substep of a step
+  if (self->odePhysics &&
+      self->odePhysics->Substep() + 1 < self->odePhysics->Substeps())
+  {
+    return;
+  }
+
+  self->UpdateDirtyPose();
+}
+
+//////////////////////////////////////////////////
+void ODELink::UpdateDirtyPose()
 {
   const dReal *p;
   const dReal *r;
-  ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
-  // self->poseMutex->lock();
+  // this->poseMutex->lock();
 
-  p = dBodyGetPosition(_id);
-  r = dBodyGetQuaternion(_id);
+  p = dBodyGetPosition(this->linkId);
+  r = dBodyGetQuaternion(this->linkId);
 
-  self->dirtyPose.Pos().Set(p[0], p[1], p[2]);
-  self->dirtyPose.Rot().Set(r[0], r[1], r[2], r[3]);
+  this->dirtyPose.Pos().Set(p[0], p[1], p[2]);
+  this->dirtyPose.Rot().Set(r[0], r[1], r[2], r[3]);
 
   // subtracting cog location from ode pose
-  GZ_ASSERT(self->inertial != nullptr, "Inertial pointer is null");
-  ignition::math::Vector3d cog = self->dirtyPose.Rot().RotateVector(
-      self->inertial->CoG());
+  GZ_ASSERT(this->inertial != nullptr, "Inertial pointer is null");
+  ignition::math::Vector3d cog = this->dirtyPose.Rot().RotateVector(
+      this->inertial->CoG());
 
-  self->dirtyPose.Pos() -= cog;
+  this->dirtyPose.Pos() -= cog;
 
   // Tell the world that our pose has changed.
-  self->world->_AddDirty(self);
+  this->world->_AddDirty(this);
 
-  // self->poseMutex->unlock();
+  // this->poseMutex->unlock();
 
   // get force and applied to this body
-  if (_id)
-  {
-    const dReal *dforce = dBodyGetForce(_id);
-    self->force.Set(dforce[0], dforce[1], dforce[2]);
+  const dReal *dforce = dBodyGetForce(this->linkId);
+  this->force.Set(dforce[0], dforce[1], dforce[2]);
 
-    const dReal *dtorque = dBodyGetTorque(_id);
-    self->torque.Set(dtorque[0], dtorque[1], dtorque[2]);
-  }
+  const dReal *dtorque = dBodyGetTorque(this->linkId);
+  this->torque.Set(dtorque[0], dtorque[1], dtorque[2]);
 }
 
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
+  if (this->dataPtr->fast && this->odePhysics)
+    this->odePhysics->SetFastLink(this, false);
+  this->dataPtr->fast = false;
+
   if (this->linkId)
     dBodyDestroy(this->linkId);
   this->linkId = nullptr;
@@ -333,9 +371,12 @@ void ODELink::UpdateCollisionOffsets()
 
           // Set the pose of the encapsulated collision; this is always relative
           // to the CoM
-          dGeomSetOffsetPosition(g->GetCollisionId(),
-              localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
-          dGeomSetOffsetQuaternion(g->GetCollisionId(), q);
+          for (auto id : g->CollisionIds())
+          {
+            dGeomSetOffsetPosition(id, localPose.Pos().X(),
+                localPose.Pos().Y(), localPose.Pos().Z());
+            dGeomSetOffsetQuaternion(id, q);
+          }
         }
       }
     }
@@ -777,6 +818,29 @@ void ODELink::SetAutoDisable(bool _disable)
     gzlog << "ODE model has joints, unable to SetAutoDisable" << std::endl;
 }
 
+//////////////////////////////////////////////////
+void ODELink::SetFast(const bool _fast)
+{
+  if (_fast == this->dataPtr->fast)
+    return;
+
+  if (!this->odePhysics)
+  {
+    gzerr << "Link [" << this->GetScopedName() << "] isn't loaded, "
+          << "unable to SetFast" << std::endl;
+    return;
+  }
+
+  this->dataPtr->fast = _fast;
+  this->odePhysics->SetFastLink(this, _fast);
+}
+
+//////////////////////////////////////////////////
+bool ODELink::Fast() const
+{
+  return this->dataPtr->fast;
+}
+
 //////////////////////////////////////////////////
 void ODELink::SetLinkStatic(bool /*_static*/)
 {
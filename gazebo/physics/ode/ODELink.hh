@@ -17,6 +17,8 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODELINK_HH_
 #define GAZEBO_PHYSICS_ODE_ODELINK_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ode_inc.h"
@@ -28,6 +30,9 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data class
+    class ODELinkPrivate;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
@@ -158,6 +163,18 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetAutoDisable(bool _disable);
 
+      /// \brief Flag the link as moving fast. Steps in which a fast link
+      /// would travel more than half its size are split in substeps, so
+      /// that it doesn't tunnel through thin obstacles. A link can also be
+      /// flagged in SDF with <gz:fast>true</gz:fast>.
+      /// \param[in] _fast True if the link moves fast.
+      /// \sa ODEPhysics::SetParam("fast_link_max_substeps")
+      public: void SetFast(const bool _fast);
+
+      /// \brief Get whether the link is flagged as moving fast.
+      /// \return True if the link moves fast.
+      public: bool Fast() const;
+
       /// \brief Return the ID of this link
       /// \return ODE link id
       public: dBodyID GetODEId() const;
@@ -182,6 +199,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      /// \brief Propagate the pose and forces of the ODE body to Gazebo.
+      private: void UpdateDirtyPose();
+
       /// \brief ODE link handle
       private: dBodyID linkId;
 
@@ -196,6 +216,10 @@ namespace gazebo
 
       /// \brief Cache torque applied on body
       private: ignition::math::Vector3d torque;
+
+      /// \internal
+      /// \brief Pointer to private data
+      private: std::unique_ptr<ODELinkPrivate> dataPtr;
     };
     /// \}
   }
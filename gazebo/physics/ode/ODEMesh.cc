@@ -14,14 +14,37 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
+#include "gazebo/physics/CollisionMeshCache.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief ODE data of a convex hull. dGeomConvex keeps pointers to it.
+    class ODEConvexHull
+    {
+      /// \brief Face planes, normal and offset, four values per face.
+      public: std::vector<dReal> planes;
+
+      /// \brief Vertex coordinates, three per vertex.
+      public: std::vector<dReal> points;
+
+      /// \brief Faces, each a vertex count followed by the vertex indices.
+      public: std::vector<unsigned int> polygons;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace physics;
 
@@ -29,16 +52,11 @@ using namespace physics;
 ODEMesh::ODEMesh()
 {
   this->odeData = nullptr;
-  this->vertices = nullptr;
-  this->indices = nullptr;
 }
 
 //////////////////////////////////////////////////
 ODEMesh::~ODEMesh()
 {
-  delete [] this->vertices;
-  delete [] this->indices;
-  dGeomTriMeshDataDestroy(this->odeData);
 }
 
 //////////////////////////////////////////////////
@@ -49,6 +67,10 @@ void ODEMesh::Update()
   // tell the tri-tri collider the current transform of the trimesh --
   // this is fairly important for good results.
 
+  // Convex hulls don't need the previous transform
+  if (!this->odeData)
+    return;
+
   // Fill in the (4x4) matrix.
   dReal *matrix = this->transform + (this->transformIndex * 16);
   const dReal *Pos = dGeomGetPosition(this->collisionId);
@@ -86,18 +108,9 @@ void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
   if (!_subMesh)
     return;
 
-  unsigned int numVertices = _subMesh->GetVertexCount();
-  unsigned int numIndices = _subMesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
-
-  this->collisionId = _collision->GetCollisionId();
-
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  // Without the parent mesh, the submesh can't be identified in the cache
+  this->Init(CollisionMeshCache::Build(nullptr, _subMesh, _scale),
+      _collision);
 }
 
 //////////////////////////////////////////////////
@@ -107,39 +120,36 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   if (!_mesh)
     return;
 
-  unsigned int numVertices = _mesh->GetVertexCount();
-  unsigned int numIndices = _mesh->GetIndexCount();
-
-  this->vertices = nullptr;
-  this->indices = nullptr;
-
-  // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
-
-  this->collisionId = _collision->GetCollisionId();
-  this->CreateMesh(numVertices, numIndices, _collision, _scale);
+  this->Init(CollisionMeshCache::Instance()->Data(_mesh, nullptr, _scale),
+      _collision);
 }
 
 //////////////////////////////////////////////////
-void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
-    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+void ODEMesh::Init(const CollisionMeshDataPtr &_data,
+    ODECollisionPtr _collision)
 {
-  /// This will hold the vertex data of the triangle mesh
-  if (this->odeData == nullptr)
-    this->odeData = dGeomTriMeshDataCreate();
+  if (!_data)
+    return;
+
+  this->meshData = _data;
 
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
+  if (_data->HullCount() > 0)
   {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    this->InitConvex(_data, _collision);
+    return;
   }
 
-  // Build the ODE triangle mesh
-  dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+  // Build the ODE triangle mesh once for all collisions sharing the data
+  CollisionMeshData *data = _data.get();
+  this->odeDataPtr = _data->EngineData("ode", [data]()
+      {
+        dTriMeshDataID triMeshData = dGeomTriMeshDataCreate();
+        dGeomTriMeshDataBuildSingle(triMeshData,
+            data->Vertices(), 3*sizeof(float), data->VertexCount(),
+            data->Indices(), data->IndexCount(), 3*sizeof(int));
+        return std::shared_ptr<void>(triMeshData, dGeomTriMeshDataDestroy);
+      });
+  this->odeData = static_cast<dTriMeshDataID>(this->odeDataPtr.get());
 
   if (_collision->GetCollisionId() == nullptr)
   {
@@ -152,6 +162,98 @@ void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
     dGeomTriMeshSetData(_collision->GetCollisionId(), this->odeData);
   }
 
+  this->collisionId = _collision->GetCollisionId();
+
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
 }
+
+//////////////////////////////////////////////////
+void ODEMesh::InitConvex(const CollisionMeshDataPtr &_data,
+    ODECollisionPtr _collision)
+{
+  // Build the hull data once for all collisions sharing the data
+  CollisionMeshData *data = _data.get();
+  this->odeDataPtr = _data->EngineData("ode_convex", [data]()
+      {
+        auto hulls = std::make_shared<std::vector<ODEConvexHull>>(
+            data->HullCount());
+        const float *vertices = data->Vertices();
+        const int *indices = data->Indices();
+        const unsigned int *sizes = data->HullSizes();
+        unsigned int firstVertex = 0;
+        unsigned int firstIndex = 0;
+        for (auto &hull : *hulls)
+        {
+          const unsigned int vertexCount = *sizes++;
+          const unsigned int indexCount = *sizes++;
+
+          hull.points.assign(vertices + firstVertex * 3,
+              vertices + (firstVertex + vertexCount) * 3);
+
+          for (unsigned int i = 0; i + 2 < indexCount; i += 3)
+          {
+            const int *tri = indices + firstIndex + i;
+            const ignition::math::Vector3d a(vertices[tri[0]*3],
+                vertices[tri[0]*3+1], vertices[tri[0]*3+2]);
+            const ignition::math::Vector3d b(vertices[tri[1]*3],
+                vertices[tri[1]*3+1], vertices[tri[1]*3+2]);
+            const ignition::math::Vector3d c(vertices[tri[2]*3],
+                vertices[tri[2]*3+1], vertices[tri[2]*3+2]);
+            ignition::math::Vector3d normal = (b - a).Cross(c - a);
+            if (normal.Length() <= 0)
+              continue;
+            normal.Normalize();
+
+            hull.planes.push_back(normal.X());
+            hull.planes.push_back(normal.Y());
+            hull.planes.push_back(normal.Z());
+            hull.planes.push_back(normal.Dot(a));
+            hull.polygons.insert(hull.polygons.end(), {3u,
+                tri[0] - firstVertex, tri[1] - firstVertex,
+                tri[2] - firstVertex});
+          }
+
+          firstVertex += vertexCount;
+          firstIndex += indexCount;
+        }
+        return std::shared_ptr<void>(hulls);
+      });
+
+  this->odeData = nullptr;
+  auto hulls =
+      static_cast<std::vector<ODEConvexHull> *>(this->odeDataPtr.get());
+
+  // Replace the geoms of a collision that was already initialized
+  dBodyID body = nullptr;
+  if (_collision->GetCollisionId() == nullptr)
+  {
+    _collision->SetSpaceId(dSimpleSpaceCreate(_collision->GetSpaceId()));
+  }
+  else
+  {
+    body = dGeomGetBody(_collision->GetCollisionId());
+    for (auto id : _collision->CollisionIds())
+      dGeomDestroy(id);
+  }
+
+  // One geom per hull, the first one being the collision id. They all
+  // point back to the collision, so that contacts are reported for it.
+  for (size_t i = 0; i < hulls->size(); ++i)
+  {
+    ODEConvexHull &hull = (*hulls)[i];
+    dGeomID id = dCreateConvex(_collision->GetSpaceId(),
+        hull.planes.data(), hull.planes.size() / 4,
+        hull.points.data(), hull.points.size() / 3,
+        hull.polygons.data());
+    if (i == 0)
+      _collision->SetCollision(id, true);
+    else
+      dGeomSetData(id, _collision.get());
+
+    if (body)
+      dGeomSetBody(id, body);
+  }
+
+  this->collisionId = _collision->GetCollisionId();
+}
@@ -18,6 +18,8 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <memory>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -57,16 +59,24 @@ namespace gazebo
                       ODECollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create a mesh collision shape from shared collision data.
+      /// The ODE triangle mesh data, including its OPCODE tree, is built
+      /// once per collision data and shared by all collisions using it.
+      /// Data made of convex hulls gives one convex geom per hull instead.
+      /// \param[in] _data Scaled triangle data.
+      /// \param[in] _collision Pointer to the collision object.
+      public: void Init(const CollisionMeshDataPtr &_data,
+                      ODECollisionPtr _collision);
+
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
-      /// \brief Helper function to create the collision shape.
-      /// \param[in] _numVertices Number of vertices.
-      /// \param[in] _numIndices Number of indices.
+      /// \brief Create one convex geom per hull of the collision data, in
+      /// the space of the collision.
+      /// \param[in] _data Scaled triangle data made of convex hulls.
       /// \param[in] _collision Pointer to the collision object.
-      private: void CreateMesh(unsigned int _numVertices,
-                   unsigned int _numIndices, ODECollisionPtr _collision,
-                   const ignition::math::Vector3d &_scale);
+      private: void InitConvex(const CollisionMeshDataPtr &_data,
+                               ODECollisionPtr _collision);
 
       /// \brief Transform matrix.
       private: dReal transform[16*2];
@@ -74,11 +84,11 @@ namespace gazebo
       /// \brief Transform matrix index.
       private: int transformIndex;
 
-      /// \brief Array of vertex values.
-      private: float *vertices;
+      /// \brief Triangle data, shared with other collisions.
+      private: CollisionMeshDataPtr meshData;
 
-      /// \brief Array of index values.
-      private: int *indices;
+      /// \brief Keeps the shared ODE trimesh data alive.
+      private: std::shared_ptr<void> odeDataPtr;
 
       /// \brief ODE trimesh data.
       private: dTriMeshDataID odeData;
@@ -57,16 +57,6 @@ void ODEMeshShape::Init()
   if (!this->mesh)
     return;
 
-  if (this->submesh)
-  {
-    this->odeMesh->Init(this->submesh,
-        boost::static_pointer_cast<ODECollision>(this->collisionParent),
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
-  }
-  else
-  {
-    this->odeMesh->Init(this->mesh,
-        boost::static_pointer_cast<ODECollision>(this->collisionParent),
-        this->sdf->Get<ignition::math::Vector3d>("scale"));
-  }
+  this->odeMesh->Init(this->CollisionData(),
+      boost::static_pointer_cast<ODECollision>(this->collisionParent));
 }
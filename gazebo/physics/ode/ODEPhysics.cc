@@ -21,6 +21,7 @@
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
@@ -136,6 +137,11 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 {
   this->dataPtr->physicsStepFunc = nullptr;
   this->dataPtr->maxContacts = 0;
+  this->dataPtr->fastLinkMaxSubsteps = 16;
+  this->dataPtr->substeps = 1;
+  this->dataPtr->multiRate = false;
+  this->dataPtr->rateStep = 0;
+  this->dataPtr->rateUpdate = 0;
 
   // Collision detection init
   dInitODE2(0);
@@ -375,6 +381,18 @@ void ODEPhysics::UpdateCollision()
   // Reset the contact count
   this->contactManager->ResetCount();
 
+  // With rate groups, the contact joints are attached group by group
+  this->dataPtr->multiRate = false;
+  this->dataPtr->rateContacts.clear();
+  for (unsigned int m = 0; m < this->world->ModelCount(); ++m)
+  {
+    if (this->world->ModelByIndex(m)->StepMultiple() > 1)
+    {
+      this->dataPtr->multiRate = true;
+      break;
+    }
+  }
+
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
@@ -398,7 +416,10 @@ void ODEPhysics::UpdateCollision()
   {
     ODECollision *collision1 = this->dataPtr->trimeshColliders[i].first;
     ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
-    this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
+    this->Collide(collision1, collision2,
+        this->dataPtr->trimeshGeoms[i].first,
+        this->dataPtr->trimeshGeoms[i].second,
+        this->dataPtr->contactCollisions);
   }
   DIAG_TIMER_LAP("UpdateCollision", "collideTrimeshes");
   IGN_PROFILE_END();
@@ -416,9 +437,40 @@ void ODEPhysics::UpdatePhysics()
   {
     boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
 
-    // Update the dynamical model
-    (*(this->dataPtr->physicsStepFunc))
-      (this->dataPtr->worldId, this->maxStepSize);
+    if (this->dataPtr->multiRate)
+    {
+      // Each rate group steps with its own step size, fast links don't
+      // substep
+      this->dataPtr->substeps = 1;
+      this->UpdateRateGroups();
+    }
+    else
+    {
+      // Split the step when a fast link would tunnel through thin
+      // obstacles
+      const unsigned int substeps = this->FastLinkSubsteps();
+      this->dataPtr->substeps = substeps;
+      if (substeps > 1)
+        this->SaveBodyForces();
+
+      for (unsigned int i = 0; i < substeps; ++i)
+      {
+        // ODE clears the forces after each step. The next substeps collide
+        // at the new poses, under the same forces.
+        if (i > 0)
+        {
+          this->UpdateCollision();
+          this->RestoreBodyForces();
+        }
+
+        // Update the dynamical model. Poses are only reported to the world
+        // after the last substep.
+        this->dataPtr->substep = i;
+        (*(this->dataPtr->physicsStepFunc))
+          (this->dataPtr->worldId, this->maxStepSize / substeps);
+      }
+      this->dataPtr->substep = 0;
+    }
 
     ignition::math::Vector3d f1, f2, t1, t2;
 
@@ -456,6 +508,292 @@ void ODEPhysics::UpdatePhysics()
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SetFastLink(ODELink *_link, const bool _fast)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  auto &links = this->dataPtr->fastLinks;
+  auto iter = std::find(links.begin(), links.end(), _link);
+  if (_fast && iter == links.end())
+    links.push_back(_link);
+  else if (!_fast && iter != links.end())
+    links.erase(iter);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::Substep() const
+{
+  return this->dataPtr->substep;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::Substeps() const
+{
+  return this->dataPtr->substeps;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::FastLinkSubsteps() const
+{
+  unsigned int substeps = 1;
+  for (ODELink *link : this->dataPtr->fastLinks)
+  {
+    dBodyID body = link->GetODEId();
+    if (!body || !dBodyIsEnabled(body))
+      continue;
+
+    const ignition::math::Vector3d size = link->BoundingBox().Size();
+    const double minSize = std::min(size.X(), std::min(size.Y(), size.Z()));
+    if (minSize <= 0)
+      continue;
+
+    // Travel of the points of the link furthest from its center
+    const dReal *linearVel = dBodyGetLinearVel(body);
+    const dReal *angularVel = dBodyGetAngularVel(body);
+    const double travel = this->maxStepSize *
+        (ignition::math::Vector3d(linearVel[0], linearVel[1],
+                                  linearVel[2]).Length() +
+         ignition::math::Vector3d(angularVel[0], angularVel[1],
+                                  angularVel[2]).Length() *
+         size.Length() * 0.5);
+
+    const double linkSubsteps = std::ceil(travel / (0.5 * minSize));
+    if (linkSubsteps >= this->dataPtr->fastLinkMaxSubsteps)
+      return std::max(1u, this->dataPtr->fastLinkMaxSubsteps);
+    substeps = std::max(substeps, static_cast<unsigned int>(linkSubsteps));
+  }
+  return substeps;
+}
+
+//////////////////////////////////////////////////
+/// \brief Store the forces accumulated on the bodies of models.
+/// \param[in] _models Models.
+/// \param[out] _forces Forces of the bodies.
+static void CollectBodyForces(const Model_V &_models,
+    std::vector<ODEBodyForce> &_forces)
+{
+  for (const auto &model : _models)
+  {
+    for (const auto &link : model->GetLinks())
+    {
+      dBodyID body = boost::static_pointer_cast<ODELink>(link)->GetODEId();
+      if (!body)
+        continue;
+
+      const dReal *force = dBodyGetForce(body);
+      const dReal *torque = dBodyGetTorque(body);
+      if (!force[0] && !force[1] && !force[2] &&
+          !torque[0] && !torque[1] && !torque[2])
+      {
+        continue;
+      }
+
+      ODEBodyForce bodyForce;
+      bodyForce.body = body;
+      std::copy(force, force + 3, bodyForce.force);
+      std::copy(torque, torque + 3, bodyForce.torque);
+      _forces.push_back(bodyForce);
+    }
+    CollectBodyForces(model->NestedModels(), _forces);
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SaveBodyForces()
+{
+  this->dataPtr->bodyForces.clear();
+  CollectBodyForces(this->world->Models(), this->dataPtr->bodyForces);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::RestoreBodyForces()
+{
+  for (const auto &bodyForce : this->dataPtr->bodyForces)
+  {
+    dBodySetForce(bodyForce.body, bodyForce.force[0], bodyForce.force[1],
+        bodyForce.force[2]);
+    dBodySetTorque(bodyForce.body, bodyForce.torque[0], bodyForce.torque[1],
+        bodyForce.torque[2]);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Find the bodies of a model and its nested models.
+/// \param[in] _model Model.
+/// \param[in] _multiple Step multiple of the top level model.
+/// \param[in,out] _data ODE physics private data, holding the bodies.
+static void UpdateRateBodies(const Model &_model, const unsigned int _multiple,
+    ODEPhysicsPrivate &_data)
+{
+  for (const auto &link : _model.GetLinks())
+  {
+    dBodyID body = boost::static_pointer_cast<ODELink>(link)->GetODEId();
+    if (!body)
+      continue;
+
+    ODERateBody &rateBody = _data.rateBodies[body];
+    rateBody.multiple = _multiple;
+    rateBody.enabled = dBodyIsEnabled(body);
+    rateBody.update = _data.rateUpdate;
+  }
+
+  for (const auto &model : _model.NestedModels())
+    UpdateRateBodies(*model, _multiple, _data);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::UpdateRateGroups()
+{
+  ODEPhysicsPrivate &d = *this->dataPtr;
+
+  ++d.rateUpdate;
+  for (unsigned int m = 0; m < this->world->ModelCount(); ++m)
+  {
+    ModelPtr model = this->world->ModelByIndex(m);
+    UpdateRateBodies(*model, model->StepMultiple(), d);
+  }
+
+  d.dueMultiples.clear();
+  for (auto iter = d.rateBodies.begin(); iter != d.rateBodies.end();)
+  {
+    // Forget the bodies which were removed
+    ODERateBody &rateBody = iter->second;
+    if (rateBody.update != d.rateUpdate)
+    {
+      iter = d.rateBodies.erase(iter);
+      continue;
+    }
+
+    // Bodies of slow groups accumulate the forces until they are due
+    if (rateBody.multiple > 1)
+    {
+      const dReal *force = dBodyGetForce(iter->first);
+      const dReal *torque = dBodyGetTorque(iter->first);
+      for (int i = 0; i < 3; ++i)
+      {
+        rateBody.force[i] += force[i];
+        rateBody.torque[i] += torque[i];
+      }
+      dBodySetForce(iter->first, 0, 0, 0);
+      dBodySetTorque(iter->first, 0, 0, 0);
+    }
+
+    if (d.rateStep % rateBody.multiple == 0 &&
+        std::find(d.dueMultiples.begin(), d.dueMultiples.end(),
+                  rateBody.multiple) == d.dueMultiples.end())
+    {
+      d.dueMultiples.push_back(rateBody.multiple);
+    }
+    ++iter;
+  }
+  std::sort(d.dueMultiples.begin(), d.dueMultiples.end());
+
+  for (const unsigned int multiple : d.dueMultiples)
+  {
+    auto stepped = [&d, multiple](dBodyID _body)
+    {
+      if (!_body)
+        return false;
+      auto iter = d.rateBodies.find(_body);
+      return iter != d.rateBodies.end() &&
+          iter->second.multiple == multiple && iter->second.enabled;
+    };
+
+    // Contacts are only attached to the stepped bodies, so ODE doesn't
+    // enable the disabled bodies they touch. Wake them as ODE would wake
+    // an island, through the bodies of the group woken on the way.
+    auto wake = [&d, &stepped](dBodyID _body, dBodyID _other)
+    {
+      if (!_body || !stepped(_other))
+        return false;
+      auto iter = d.rateBodies.find(_body);
+      if (iter == d.rateBodies.end() || iter->second.enabled)
+        return false;
+      dBodyEnable(_body);
+      iter->second.enabled = true;
+      return true;
+    };
+    bool woken = true;
+    while (woken)
+    {
+      woken = false;
+      for (const auto &contact : d.rateContacts)
+      {
+        woken = wake(contact.body1, contact.body2) || woken;
+        woken = wake(contact.body2, contact.body1) || woken;
+      }
+    }
+
+    // Only the enabled bodies of the group move. Enabling a body resets
+    // its auto disable counters, so enabled bodies are left untouched.
+    for (auto &entry : d.rateBodies)
+    {
+      ODERateBody &rateBody = entry.second;
+      if (rateBody.multiple != multiple || !rateBody.enabled)
+      {
+        // Disabled bodies of the group drop the forces of the period
+        if (rateBody.multiple == multiple)
+        {
+          std::fill(rateBody.force, rateBody.force + 3, 0);
+          std::fill(rateBody.torque, rateBody.torque + 3, 0);
+        }
+        dBodyDisable(entry.first);
+        continue;
+      }
+
+      if (!dBodyIsEnabled(entry.first))
+        dBodyEnable(entry.first);
+
+      // Under the average force of the period
+      if (multiple > 1)
+      {
+        dBodySetForce(entry.first, rateBody.force[0] / multiple,
+            rateBody.force[1] / multiple, rateBody.force[2] / multiple);
+        dBodySetTorque(entry.first, rateBody.torque[0] / multiple,
+            rateBody.torque[1] / multiple, rateBody.torque[2] / multiple);
+        std::fill(rateBody.force, rateBody.force + 3, 0);
+        std::fill(rateBody.torque, rateBody.torque + 3, 0);
+      }
+    }
+
+    // Bodies of the other groups act as static obstacles
+    for (const auto &contact : d.rateContacts)
+    {
+      const bool stepped1 = stepped(contact.body1);
+      const bool stepped2 = stepped(contact.body2);
+      if (!stepped1 && !stepped2)
+      {
+        dJointDisable(contact.joint);
+        continue;
+      }
+
+      dJointEnable(contact.joint);
+      dJointAttach(contact.joint, stepped1 ? contact.body1 : nullptr,
+          stepped2 ? contact.body2 : nullptr);
+    }
+
+    (*(d.physicsStepFunc))(d.worldId, multiple * this->maxStepSize);
+
+    // The bodies may have been auto disabled
+    for (auto &entry : d.rateBodies)
+    {
+      if (entry.second.multiple == multiple && entry.second.enabled)
+        entry.second.enabled = dBodyIsEnabled(entry.first);
+    }
+  }
+
+  // Restore the bodies of the groups which weren't due
+  for (const auto &entry : d.rateBodies)
+  {
+    if (!entry.second.enabled)
+      dBodyDisable(entry.first);
+    else if (!dBodyIsEnabled(entry.first))
+      dBodyEnable(entry.first);
+  }
+
+  ++d.rateStep;
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
@@ -494,6 +832,11 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+  this->dataPtr->rateContacts.clear();
+
+  // Rate groups start their periods again
+  this->dataPtr->rateStep = 0;
+  this->dataPtr->rateBodies.clear();
 }
 
 //////////////////////////////////////////////////
@@ -999,7 +1342,7 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
       // Add either a tri-mesh collider or a regular collider.
       if (collision1->HasType(Base::MESH_SHAPE) ||
           collision2->HasType(Base::MESH_SHAPE))
-        self->AddTrimeshCollider(collision1, collision2);
+        self->AddTrimeshCollider(collision1, collision2, _o1, _o2);
       else
       {
         self->AddCollider(collision1, collision2);
@@ -1012,6 +1355,15 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
                          dContactGeom *_contactCollisions)
+{
+  this->Collide(_collision1, _collision2, _collision1->GetCollisionId(),
+      _collision2->GetCollisionId(), _contactCollisions);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
+                         dGeomID _geom1, dGeomID _geom2,
+                         dContactGeom *_contactCollisions)
 {
   // Filter collisions based on collide bitmask.
   if ((_collision1->GetSurface()->collideBitmask &
@@ -1063,7 +1415,7 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     maxCollide = _collision2->GetMaxContacts();
 
   // Generate the contacts
-  numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
+  numc = dCollide(_geom1, _geom2,
       MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
 
   // Return if no contacts.
@@ -1327,23 +1679,34 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     // Attach the contact joint if collideWithoutContact flags aren't set.
     if (!_collision1->GetSurface()->collideWithoutContact &&
         !_collision2->GetSurface()->collideWithoutContact)
+    {
       dJointAttach(contactJoint, b1, b2);
+      if (this->dataPtr->multiRate)
+        this->dataPtr->rateContacts.push_back({contactJoint, b1, b2});
+    }
   }
 }
 
 /////////////////////////////////////////////////
 void ODEPhysics::AddTrimeshCollider(ODECollision *_collision1,
-                                    ODECollision *_collision2)
+                                    ODECollision *_collision2,
+                                    dGeomID _geom1, dGeomID _geom2)
 {
   if (this->dataPtr->trimeshCollidersCount >=
       this->dataPtr->trimeshColliders.size())
+  {
     this->dataPtr->trimeshColliders.resize(
       this->dataPtr->trimeshColliders.size() + 100);
+    this->dataPtr->trimeshGeoms.resize(
+      this->dataPtr->trimeshColliders.size());
+  }
 
   this->dataPtr->trimeshColliders[this->dataPtr->trimeshCollidersCount].first  =
     _collision1;
   this->dataPtr->trimeshColliders[this->dataPtr->trimeshCollidersCount].second =
     _collision2;
+  this->dataPtr->trimeshGeoms[this->dataPtr->trimeshCollidersCount] =
+    std::make_pair(_geom1, _geom2);
   this->dataPtr->trimeshCollidersCount++;
 }
 
@@ -1555,6 +1918,16 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "fast_link_max_substeps")
+    {
+      const int value = any_cast<int>(_value);
+      if (value < 1)
+      {
+        gzerr << "fast_link_max_substeps must be at least 1" << std::endl;
+        return false;
+      }
+      this->dataPtr->fastLinkMaxSubsteps = value;
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet = any_cast<bool>(_value);
@@ -1664,6 +2037,10 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
+  else if (_key == "fast_link_max_substeps")
+    _value = static_cast<int>(this->dataPtr->fastLinkMaxSubsteps);
+  else if (_key == "substeps")
+    _value = static_cast<int>(this->dataPtr->substeps);
   else if (_key == "world_step_solver")
     _value = this->GetWorldStepSolverType();
   else
@@ -291,6 +291,21 @@ namespace gazebo
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
+      /// \brief Register a link flagged as moving fast, or unregister it.
+      /// Called by ODELink::SetFast.
+      /// \param[in] _link Link.
+      /// \param[in] _fast True to register the link, false to unregister.
+      public: void SetFastLink(ODELink *_link, const bool _fast);
+
+      /// \brief Get the index of the substep being simulated. Links only
+      /// report their pose to the world after the last substep.
+      /// \return Substep index, 0 when the step isn't split.
+      public: unsigned int Substep() const;
+
+      /// \brief Get the number of substeps of the current step.
+      /// \return Number of substeps, at least 1.
+      public: unsigned int Substeps() const;
+
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
@@ -306,8 +321,39 @@ namespace gazebo
       /// \brief Create a triangle mesh object collider.
       /// \param[in] _collision1 The first collision object.
       /// \param[in] _collision2 The second collision object.
+      /// \param[in] _geom1 Geom of the first collision to test.
+      /// \param[in] _geom2 Geom of the second collision to test.
       private: void AddTrimeshCollider(ODECollision *_collision1,
-                                       ODECollision *_collision2);
+                                       ODECollision *_collision2,
+                                       dGeomID _geom1, dGeomID _geom2);
+
+      /// \brief Collide two geoms of two collision objects.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _geom1 Geom of the first collision object.
+      /// \param[in] _geom2 Geom of the second collision object.
+      /// \param[in,out] _contactCollision Array of contacts.
+      private: void Collide(ODECollision *_collision1,
+                            ODECollision *_collision2,
+                            dGeomID _geom1, dGeomID _geom2,
+                            dContactGeom *_contactCollision);
+
+      /// \brief Get the number of substeps the next step needs, so that no
+      /// fast link travels more than half its size in a substep.
+      /// \return Number of substeps, at least 1.
+      private: unsigned int FastLinkSubsteps() const;
+
+      /// \brief Store the forces accumulated on the bodies, to apply them
+      /// again in each substep.
+      private: void SaveBodyForces();
+
+      /// \brief Apply the stored forces to the bodies again.
+      private: void RestoreBodyForces();
+
+      /// \brief Step the rate groups due, each with its own step size.
+      /// Bodies of the other groups are disabled, and the contact joints
+      /// touching them attached to the static environment instead.
+      private: void UpdateRateGroups();
 
       /// \brief Create a normal object collider.
       /// \param[in] _collision1 The first collision object.
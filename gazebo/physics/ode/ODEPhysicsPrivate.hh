@@ -18,8 +18,10 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -45,6 +47,55 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Force and torque accumulated on a body before a step,
+    /// applied again in each substep.
+    class ODEBodyForce
+    {
+      /// \brief Body.
+      public: dBodyID body;
+
+      /// \brief Force, in the world frame.
+      public: dReal force[3];
+
+      /// \brief Torque, in the world frame.
+      public: dReal torque[3];
+    };
+
+    /// \brief Body of a model in a rate group.
+    class ODERateBody
+    {
+      /// \brief Number of world steps per step of the body.
+      public: unsigned int multiple = 1;
+
+      /// \brief True if the body was enabled before the step.
+      public: bool enabled = true;
+
+      /// \brief Force applied since the last step of the body, in the
+      /// world frame.
+      public: dReal force[3] = {0, 0, 0};
+
+      /// \brief Torque applied since the last step of the body, in the
+      /// world frame.
+      public: dReal torque[3] = {0, 0, 0};
+
+      /// \brief Last update the body was found in.
+      public: uint64_t update = 0;
+    };
+
+    /// \brief Contact joint between two bodies, attached to the bodies of
+    /// the rate group being stepped only.
+    class ODERateContact
+    {
+      /// \brief Contact joint.
+      public: dJointID joint;
+
+      /// \brief First body, null if static.
+      public: dBodyID body1;
+
+      /// \brief Second body, null if static.
+      public: dBodyID body2;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -75,6 +126,10 @@ namespace gazebo
       public: std::vector< std::pair<ODECollision*, ODECollision*> >
                trimeshColliders;
 
+      /// \brief Geoms of the triangle mesh colliders, which differ from
+      /// the collision ids for mesh collisions made of convex hulls.
+      public: std::vector< std::pair<dGeomID, dGeomID> > trimeshGeoms;
+
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
@@ -92,6 +147,40 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief Links flagged as moving fast.
+      public: std::vector<ODELink *> fastLinks;
+
+      /// \brief Maximum number of substeps a step is split in, for the
+      /// fast links.
+      public: unsigned int fastLinkMaxSubsteps;
+
+      /// \brief Number of substeps of the last step.
+      public: unsigned int substeps;
+
+      /// \brief Index of the substep being simulated.
+      public: unsigned int substep = 0;
+
+      /// \brief Forces of the bodies applied in each substep, reused.
+      public: std::vector<ODEBodyForce> bodyForces;
+
+      /// \brief True if a model steps slower than the world.
+      public: bool multiRate;
+
+      /// \brief Bodies of the rate groups.
+      public: std::unordered_map<dBodyID, ODERateBody> rateBodies;
+
+      /// \brief Contact joints of the current step, with rate groups.
+      public: std::vector<ODERateContact> rateContacts;
+
+      /// \brief Step multiples of the groups due in the current step.
+      public: std::vector<unsigned int> dueMultiples;
+
+      /// \brief Number of world steps taken with rate groups.
+      public: uint64_t rateStep;
+
+      /// \brief Number of rate group updates, to find removed bodies.
+      public: uint64_t rateUpdate;
     };
   }
 }
@@ -19,6 +19,7 @@
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -490,6 +491,154 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that fast links don't tunnel through thin obstacles
+TEST_F(ODEPhysics_TEST, FastLinks)
+{
+  Load("test/worlds/fast_projectile.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::static_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+  EXPECT_EQ(16, boost::any_cast<int>(
+      odePhysics->GetParam("fast_link_max_substeps")));
+  EXPECT_FALSE(odePhysics->SetParam("fast_link_max_substeps", 0));
+
+  ModelPtr model = world->ModelByName("projectile");
+  ASSERT_TRUE(model != nullptr);
+  ODELinkPtr link = boost::static_pointer_cast<ODELink>(model->GetLink());
+  ASSERT_TRUE(link != nullptr);
+
+  // Flagged as fast in the world file
+  EXPECT_TRUE(link->Fast());
+
+  // Not fast, 0.5 m per step, five times the projectile size: it goes
+  // through the wall
+  link->SetFast(false);
+  EXPECT_FALSE(link->Fast());
+  link->SetLinearVel(ignition::math::Vector3d(50, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(1, boost::any_cast<int>(odePhysics->GetParam("substeps")));
+  world->Step(19);
+  EXPECT_GT(link->WorldPose().Pos().X(), 5.0);
+
+  // Flagged as fast, its steps are split in ten and it hits the wall
+  world->Reset();
+  link->SetFast(true);
+  EXPECT_TRUE(link->Fast());
+  link->SetLinearVel(ignition::math::Vector3d(50, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(10, boost::any_cast<int>(odePhysics->GetParam("substeps")));
+  EXPECT_NEAR(0.5, link->WorldPose().Pos().X(), 1e-6);
+  world->Step(19);
+  EXPECT_LT(link->WorldPose().Pos().X(), 5.0);
+
+  // Fewer substeps than needed
+  world->Reset();
+  EXPECT_TRUE(odePhysics->SetParam("fast_link_max_substeps", 4));
+  link->SetLinearVel(ignition::math::Vector3d(50, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(4, boost::any_cast<int>(odePhysics->GetParam("substeps")));
+
+  // No longer fast
+  link->SetFast(false);
+  world->Step(1);
+  EXPECT_EQ(1, boost::any_cast<int>(odePhysics->GetParam("substeps")));
+}
+
+/////////////////////////////////////////////////
+/// Test models stepping slower than the world
+TEST_F(ODEPhysics_TEST, RateGroups)
+{
+  Load("test/worlds/rate_groups.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ModelPtr fastBox = world->ModelByName("fast_box");
+  ModelPtr slowBox = world->ModelByName("slow_box");
+  ModelPtr stackBottom = world->ModelByName("stack_bottom");
+  ModelPtr stackTop = world->ModelByName("stack_top");
+  ModelPtr fastPushed = world->ModelByName("fast_pushed");
+  ModelPtr slowPushed = world->ModelByName("slow_pushed");
+  ASSERT_TRUE(fastBox != nullptr);
+  ASSERT_TRUE(slowBox != nullptr);
+  ASSERT_TRUE(stackBottom != nullptr);
+  ASSERT_TRUE(stackTop != nullptr);
+  ASSERT_TRUE(fastPushed != nullptr);
+  ASSERT_TRUE(slowPushed != nullptr);
+
+  // Set from SDF
+  EXPECT_EQ(1u, fastBox->StepMultiple());
+  EXPECT_EQ(4u, slowBox->StepMultiple());
+  slowBox->SetStepMultiple(0);
+  EXPECT_EQ(4u, slowBox->StepMultiple());
+
+  // The slow box moves on the first of every four steps, by a step four
+  // times longer
+  const double dt = world->Physics()->GetMaxStepSize();
+  const double g = -world->Gravity().Z();
+  world->Step(1);
+  EXPECT_NEAR(2 - g * dt * dt, fastBox->WorldPose().Pos().Z(), 1e-9);
+  const double slowZ = slowBox->WorldPose().Pos().Z();
+  EXPECT_NEAR(2 - g * 16 * dt * dt, slowZ, 1e-9);
+  world->Step(3);
+  EXPECT_DOUBLE_EQ(slowZ, slowBox->WorldPose().Pos().Z());
+  world->Step(1);
+  EXPECT_LT(slowBox->WorldPose().Pos().Z(), slowZ);
+
+  // The slow box sees the forces averaged over its period
+  for (unsigned int i = 0; i < 400; ++i)
+  {
+    fastPushed->GetLink()->AddForce(ignition::math::Vector3d(1, 0, 0));
+    slowPushed->GetLink()->AddForce(ignition::math::Vector3d(1, 0, 0));
+    world->Step(1);
+  }
+  EXPECT_NEAR(fastPushed->WorldPose().Pos().X(),
+      slowPushed->WorldPose().Pos().X(), 0.01);
+  EXPECT_NEAR(fastPushed->WorldLinearVel().X(),
+      slowPushed->WorldLinearVel().X(), 0.02);
+
+  // Boxes land and rest, including across groups
+  world->Step(3000);
+  for (auto model : {fastBox, slowBox, stackBottom})
+  {
+    EXPECT_NEAR(0.5, model->WorldPose().Pos().Z(), 0.01);
+    EXPECT_LT(model->WorldLinearVel().Length(), 0.01);
+  }
+  EXPECT_NEAR(1.5, stackTop->WorldPose().Pos().Z(), 0.02);
+  EXPECT_NEAR(3.0, stackTop->WorldPose().Pos().X(), 0.02);
+  EXPECT_LT(stackTop->WorldLinearVel().Length(), 0.01);
+
+  // Let the resting slow box auto disable at its next step
+  dBodyID slowBody = boost::static_pointer_cast<ODELink>(
+      slowBox->GetLink())->GetODEId();
+  ASSERT_TRUE(slowBody != nullptr);
+  dBodySetAutoDisableSteps(slowBody, 1);
+  dBodySetAutoDisableTime(slowBody, 0);
+  world->Step(4);
+  EXPECT_FALSE(slowBox->GetLink()->GetEnabled());
+  dBodySetAutoDisableSteps(slowBody, 5);
+  dBodySetAutoDisableTime(slowBody, 1);
+
+  // The fast box pushes it instead of hitting a wall
+  for (unsigned int i = 0; i < 3000; ++i)
+  {
+    fastBox->GetLink()->SetLinearVel(ignition::math::Vector3d(0, 1, 0));
+    world->Step(1);
+  }
+  EXPECT_TRUE(slowBox->GetLink()->GetEnabled());
+  EXPECT_GT(slowBox->WorldPose().Pos().Y(), 3.5);
+  EXPECT_LT(fastBox->WorldPose().Pos().Y(), slowBox->WorldPose().Pos().Y());
+
+  // Stepped with the world again
+  slowBox->SetStepMultiple(1);
+  world->Reset();
+  world->Step(1);
+  EXPECT_NEAR(2 - g * dt * dt, slowBox->WorldPose().Pos().Z(), 1e-9);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
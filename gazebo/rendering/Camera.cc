@@ -36,6 +36,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/PixelFormatConversion.hh"
 #include "gazebo/common/VideoEncoder.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -1311,106 +1312,19 @@ void Camera::ConvertRGBToBAYER(unsigned char *_dst,
     const unsigned char *_src, const std::string &_format, const int _width,
     const int _height)
 {
-  if (_src)
-  {
-    // do last minute conversion if Bayer pattern is requested, go from R8G8B8
-    if (_format == "BAYER_RGGB8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // RG
-          // GB
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-          else  // odd column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-        }
-      }
-    }
-    else if (_format == "BAYER_BGGR8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // BG
-          // GR
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-          else  // odd column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-        }
-      }
-    }
-    else if (_format == "BAYER_GBRG8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // GB
-          // RG
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-          else  // odd column
-            if (i%2)  // even row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-        }
-      }
-    }
-    else if (_format == "BAYER_GRBG8")
-    {
-      for (int i = 0; i < _width; i++)
-      {
-        for (int j = 0; j < _height; j++)
-        {
-          //
-          // GR
-          // BG
-          //
-          // determine position
-          if (j%2)  // even column
-            if (i%2)  // even row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-            else  // odd row, red
-              _dst[i+j*_width] = _src[i*3+j*_width*3+0];
-          else  // odd column
-            if (i%2)  // even row, blue
-              _dst[i+j*_width] = _src[i*3+j*_width*3+2];
-            else  // odd row, green
-              _dst[i+j*_width] = _src[i*3+j*_width*3+1];
-        }
-      }
-    }
-  }
+  if (!_src || _width <= 0 || _height <= 0)
+    return;
+
+  // Cameras have always published BAYER_GBRG8 and BAYER_GRBG8 with each
+  // other's cell layout. Keep that output unchanged for existing consumers.
+  common::Image::PixelFormat format =
+    common::Image::ConvertPixelFormat(_format);
+  if (format == common::Image::BAYER_GBRG8)
+    format = common::Image::BAYER_GRBG8;
+  else if (format == common::Image::BAYER_GRBG8)
+    format = common::Image::BAYER_GBRG8;
+
+  common::ConvertRGBToBayer(_src, _dst, _width, _height, format);
 }
 
 //////////////////////////////////////////////////
@@ -1429,6 +1343,9 @@ void Camera::SetCaptureDataOnce()
 bool Camera::StartVideo(const std::string &_format,
                         const std::string &_filename)
 {
+  // Encode on a separate thread so recording does not stall rendering
+  if (!this->dataPtr->videoEncoder.IsEncoding())
+    this->dataPtr->videoEncoder.SetAsync(true);
   return this->dataPtr->videoEncoder.Start(_format, _filename,
       this->ImageWidth(), this->ImageHeight());
 }
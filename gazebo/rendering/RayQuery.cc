@@ -18,7 +18,7 @@
 #include <ignition/math/Triangle.hh>
 #include <ignition/math/Vector3.hh>
 
-#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/MeshBVH.hh"
 
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/UserCamera.hh"
@@ -72,55 +72,36 @@ bool RayQuery::SelectMeshTriangle(const int _x, const int _y,
 
   for (unsigned int i = 0; i < visuals.size(); ++i)
   {
-    const common::Mesh *mesh =
-        common::MeshManager::Instance()->GetMesh(visuals[i]->GetMeshName());
-
-    if (!mesh)
+    std::shared_ptr<const common::MeshBVH> bvh = visuals[i]->MeshBVH();
+    if (!bvh)
       continue;
 
+    // Cast the ray in the mesh frame. The transform is affine, so distances
+    // along the transformed direction match those along the world ray.
     Ogre::Matrix4 transform = visuals[i]->GetSceneNode()->_getFullTransform();
-    // test for hitting individual triangles on the mesh
-    for (unsigned int j = 0; j < mesh->GetSubMeshCount(); ++j)
+    Ogre::Matrix4 inverse = transform.inverseAffine();
+    Ogre::Matrix3 inverseLinear;
+    inverse.extract3x3Matrix(inverseLinear);
+
+    double distance;
+    ignition::math::Triangle3d triangle;
+    if (!bvh->Intersect(Conversions::ConvertIgn(inverse * ray.getOrigin()),
+        Conversions::ConvertIgn(inverseLinear * ray.getDirection()),
+        distance, triangle))
+    {
+      continue;
+    }
+
+    // if it was a hit check if its the closest
+    if (closestDistance < 0.0f || distance < closestDistance)
     {
-      const common::SubMesh *submesh = mesh->GetSubMesh(j);
-      if (submesh->GetVertexCount() < 3u)
-        continue;
-      unsigned int indexCount = submesh->GetIndexCount();
-      for (unsigned int k = 0; k < indexCount; k += 3)
-      {
-        if (indexCount <= k+2)
-          continue;
-
-        ignition::math::Vector3d vertexA =
-          submesh->Vertex(submesh->GetIndex(k));
-        ignition::math::Vector3d vertexB =
-          submesh->Vertex(submesh->GetIndex(k+1));
-        ignition::math::Vector3d vertexC =
-          submesh->Vertex(submesh->GetIndex(k+2));
-
-        Ogre::Vector3 worldVertexA = transform * Conversions::Convert(vertexA);
-        Ogre::Vector3 worldVertexB = transform * Conversions::Convert(vertexB);
-        Ogre::Vector3 worldVertexC = transform * Conversions::Convert(vertexC);
-
-        // check for a hit against this triangle
-        std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(ray,
-            worldVertexA, worldVertexB, worldVertexC,
-           (worldVertexB - worldVertexA).crossProduct(
-           worldVertexC - worldVertexA));
-
-        // if it was a hit check if its the closest
-        if (hit.first &&
-            (closestDistance < 0.0f || hit.second < closestDistance))
-        {
-          // this is the closest so far, save it off
-          closestDistance = hit.second;
-          vertices.clear();
-          vertices.push_back(worldVertexA);
-          vertices.push_back(worldVertexB);
-          vertices.push_back(worldVertexC);
-          newClosestFound = true;
-        }
-      }
+      // this is the closest so far, save it off
+      closestDistance = static_cast<Ogre::Real>(distance);
+      vertices.clear();
+      vertices.push_back(transform * Conversions::Convert(triangle[0]));
+      vertices.push_back(transform * Conversions::Convert(triangle[1]));
+      vertices.push_back(transform * Conversions::Convert(triangle[2]));
+      newClosestFound = true;
     }
   }
 
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
 
 #include <boost/lexical_cast.hpp>
@@ -28,6 +29,7 @@
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/MeshBVH.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/Road2d.hh"
@@ -169,14 +171,18 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   // uncomment the following line and delete the if and else directly above
   if (!_isServer)
   {
-    this->dataPtr->poseSub = this->dataPtr->node->Subscribe("~/pose/info",
-        &Scene::OnPoseMsg, this);
+    this->dataPtr->poseSub = this->dataPtr->node->Subscribe(
+        "~/pose/packed/info", &Scene::OnPackedPoseMsg, this);
+
+    // Servers that don't publish packed poses still publish ~/pose/info
+    this->dataPtr->fallbackPoseSub = this->dataPtr->node->Subscribe(
+        "~/pose/info", &Scene::OnFallbackPoseMsg, this);
   }
 
   this->dataPtr->jointSub =
       this->dataPtr->node->Subscribe("~/joint", &Scene::OnJointMsg, this);
   this->dataPtr->skeletonPoseSub =
-      this->dataPtr->node->Subscribe("~/skeleton_pose/info",
+      this->dataPtr->node->Subscribe("~/skeleton_pose/packed/info",
       &Scene::OnSkeletonPoseMsg, this);
   this->dataPtr->skySub =
       this->dataPtr->node->Subscribe("~/sky", &Scene::OnSkyMsg, this);
@@ -215,6 +221,7 @@ void Scene::Clear()
   this->dataPtr->connections.clear();
 
   this->dataPtr->poseSub.reset();
+  this->dataPtr->fallbackPoseSub.reset();
   this->dataPtr->jointSub.reset();
   this->dataPtr->sensorSub.reset();
   this->dataPtr->sceneSub.reset();
@@ -250,6 +257,13 @@ void Scene::Clear()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
     this->dataPtr->poseMsgs.clear();
+    this->dataPtr->packedPoseSlots.clear();
+    this->dataPtr->packedPoseIds.clear();
+    this->dataPtr->packedPoses.clear();
+    this->dataPtr->packedPoseQueued.clear();
+    this->dataPtr->packedPoseQueue.clear();
+    this->dataPtr->packedPoseFreeSlots.clear();
+    this->dataPtr->packedPosesReceived = false;
   }
 
   this->dataPtr->joints.clear();
@@ -1093,6 +1107,47 @@ Ogre::Entity *Scene::OgreEntityAt(CameraPtr _camera,
 
       Ogre::Entity *ogreEntity = static_cast<Ogre::Entity*>(iter->movable);
 
+      // Use the cached triangle hierarchy of the visual when the entity
+      // shows its whole mesh
+      std::shared_ptr<const common::MeshBVH> bvh;
+      if (!ogreEntity->getUserObjectBindings().getUserAny().isEmpty())
+      {
+        try
+        {
+          VisualPtr vis = this->GetVisual(Ogre::any_cast<std::string>(
+                ogreEntity->getUserObjectBindings().getUserAny()));
+          if (vis && vis->GetSubMeshName().empty())
+            bvh = vis->MeshBVH();
+        }
+        catch(Ogre::Exception &e)
+        {
+          gzerr << "Ogre any_cast error:" << e.what() << "\n";
+        }
+      }
+
+      if (bvh)
+      {
+        // The transform is affine, so distances along the transformed
+        // direction match those along the mouse ray
+        Ogre::Matrix4 inverse =
+            ogreEntity->getParentNode()->_getFullTransform().inverseAffine();
+        Ogre::Matrix3 inverseLinear;
+        inverse.extract3x3Matrix(inverseLinear);
+
+        double distance;
+        ignition::math::Triangle3d triangle;
+        if (bvh->Intersect(
+              Conversions::ConvertIgn(inverse * mouseRay.getOrigin()),
+              Conversions::ConvertIgn(inverseLinear * mouseRay.getDirection()),
+              distance, triangle, false) &&
+            (closest_distance < 0.0f || distance < closest_distance))
+        {
+          closest_distance = static_cast<Ogre::Real>(distance);
+          closestEntity = ogreEntity;
+        }
+        continue;
+      }
+
       // mesh data to retrieve
       size_t vertex_count;
       size_t index_count;
@@ -1812,7 +1867,7 @@ void Scene::PreRender()
   static VisualMsgs_L::iterator visualIter;
   static LightMsgs_L::iterator lightIter;
   static PoseMsgs_M::iterator pIter;
-  static SkeletonPoseMsgs_L::iterator spIter;
+  static SkeletonPoseMsgs_M::iterator spIter;
   static JointMsgs_L::iterator jointIter;
   static SensorMsgs_L::iterator sensorIter;
   static LinkMsgs_L::iterator linkIter;
@@ -1829,6 +1884,7 @@ void Scene::PreRender()
   JointMsgs_L jointMsgsCopy;
   LinkMsgs_L linkMsgsCopy;
   RoadMsgs_L roadMsgsCopy;
+  bool packedPosesReceived = false;
 
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
@@ -2096,41 +2152,83 @@ void Scene::PreRender()
       }
     }
 
-    // process skeleton pose msgs
-    spIter = this->dataPtr->skeletonPoseMsgs.begin();
-    while (spIter != this->dataPtr->skeletonPoseMsgs.end())
+    // Process the packed poses the same way, keeping those that don't have
+    // a visual or light yet in the queue
+    size_t kept = 0;
+    for (const auto slot : this->dataPtr->packedPoseQueue)
     {
-      Visual_M::iterator iter =
-          this->dataPtr->visuals.find((*spIter)->model_id());
-      for (int i = 0; i < (*spIter)->pose_size(); ++i)
+      const float *p = &this->dataPtr->packedPoses[7 * slot];
+      const ignition::math::Pose3d pose(p[0], p[1], p[2], p[3], p[4], p[5],
+          p[6]);
+      const uint32_t id = this->dataPtr->packedPoseIds[slot];
+
+      bool applied = false;
+      Visual_M::iterator iter = this->dataPtr->visuals.find(id);
+      if (iter != this->dataPtr->visuals.end() && iter->second)
       {
-        const msgs::Pose& pose_msg = (*spIter)->pose(i);
-        if (pose_msg.has_id())
+        // If an object is selected, don't let the physics engine move it.
+        if (!this->dataPtr->selectedVis
+            || this->dataPtr->selectionMode != "move" ||
+            (iter->first != this->dataPtr->selectedVis->GetId() &&
+            !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
         {
-          Visual_M::iterator iter2 = this->dataPtr->visuals.find(pose_msg.id());
-          if (iter2 != this->dataPtr->visuals.end())
-          {
-            // If an object is selected, don't let the physics engine move it.
-            if (!this->dataPtr->selectedVis ||
-                this->dataPtr->selectionMode != "move" ||
-                (iter->first != this->dataPtr->selectedVis->GetId()&&
-                !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
-            {
-              ignition::math::Pose3d pose = msgs::ConvertIgn(pose_msg);
-              iter2->second->SetPose(pose);
-            }
-          }
+          iter->second->SetPose(pose);
+          applied = true;
         }
       }
-
-      if (iter != this->dataPtr->visuals.end())
+      else
       {
-        iter->second->SetSkeletonPose(*(*spIter).get());
-        SkeletonPoseMsgs_L::iterator prev = spIter++;
-        this->dataPtr->skeletonPoseMsgs.erase(prev);
+        auto lIter = this->dataPtr->lights.find(id);
+        if (lIter != this->dataPtr->lights.end())
+        {
+          lIter->second->SetPosition(pose.Pos());
+          lIter->second->SetRotation(pose.Rot());
+          applied = true;
+        }
       }
+
+      if (applied)
+        this->dataPtr->packedPoseQueued[slot] = 0;
       else
+        this->dataPtr->packedPoseQueue[kept++] = slot;
+    }
+    this->dataPtr->packedPoseQueue.resize(kept);
+
+    // Process the skeleton pose msgs, keeping those of actors that don't
+    // have a visual yet
+    spIter = this->dataPtr->skeletonPoseMsgs.begin();
+    while (spIter != this->dataPtr->skeletonPoseMsgs.end())
+    {
+      Visual_M::iterator iter = this->dataPtr->visuals.find(spIter->first);
+      if (iter == this->dataPtr->visuals.end() || !iter->second)
+      {
         ++spIter;
+        continue;
+      }
+
+      const msgs::PackedSkeletonPose &skelMsg = *spIter->second;
+      const int count = std::min(skelMsg.id_size(), skelMsg.pose_size() / 7);
+      for (int i = 0; i < count; ++i)
+      {
+        Visual_M::iterator iter2 = this->dataPtr->visuals.find(skelMsg.id(i));
+        if (iter2 == this->dataPtr->visuals.end() || !iter2->second)
+          continue;
+
+        // If an object is selected, don't let the physics engine move it.
+        if (!this->dataPtr->selectedVis ||
+            this->dataPtr->selectionMode != "move" ||
+            (iter2->first != this->dataPtr->selectedVis->GetId() &&
+            !this->dataPtr->selectedVis->IsAncestorOf(iter2->second)))
+        {
+          const float *p = skelMsg.pose().data() + 7 * i;
+          iter2->second->SetPose(ignition::math::Pose3d(p[0], p[1], p[2],
+              p[3], p[4], p[5], p[6]));
+        }
+      }
+
+      iter->second->SetSkeletonPose(skelMsg.bone_pose().data(),
+          skelMsg.bone_pose_size() / 7);
+      spIter = this->dataPtr->skeletonPoseMsgs.erase(spIter);
     }
 
     // Process the road messages.
@@ -2158,7 +2256,15 @@ void Scene::PreRender()
     // official time stamp of approval
     this->dataPtr->sceneSimTimePosesApplied =
         this->dataPtr->sceneSimTimePosesReceived;
+
+    packedPosesReceived = this->dataPtr->packedPosesReceived;
   }
+
+  // Once the server is known to publish packed poses, stop receiving the
+  // fallback ones. Released outside of the pose lock, which its callback
+  // takes.
+  if (packedPosesReceived && this->dataPtr->fallbackPoseSub)
+    this->dataPtr->fallbackPoseSub.reset();
 }
 
 /////////////////////////////////////////////////
@@ -2881,6 +2987,107 @@ void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
   }
 }
 
+/////////////////////////////////////////////////
+void Scene::OnPackedPoseMsg(ConstPackedPosesPtr &_msg)
+{
+  this->StorePackedPoses(*_msg);
+}
+
+/////////////////////////////////////////////////
+void Scene::OnFallbackPoseMsg(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  if (this->dataPtr->packedPosesReceived)
+    return;
+
+  this->OnPoseMsg(_msg);
+}
+
+/////////////////////////////////////////////////
+void Scene::StorePackedPoses(const msgs::PackedPoses &_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  this->dataPtr->packedPosesReceived = true;
+  this->dataPtr->sceneSimTimePosesReceived =
+    common::Time(_msg.time().sec(), _msg.time().nsec());
+
+  if (_msg.pose_size() != 7 * _msg.id_size())
+  {
+    gzerr << "Packed pose message with " << _msg.id_size() << " ids and "
+          << _msg.pose_size() << " values, ignoring it\n";
+    return;
+  }
+
+  // Poses are copied into a flat buffer, only entities received for the
+  // first time are added to the slot map, in a released slot if any
+  const float *values = _msg.pose().data();
+  for (int i = 0; i < _msg.id_size(); ++i)
+  {
+    const uint32_t id = _msg.id(i);
+    uint32_t slot;
+    auto iter = this->dataPtr->packedPoseSlots.find(id);
+    if (iter != this->dataPtr->packedPoseSlots.end())
+    {
+      slot = iter->second;
+    }
+    else if (!this->dataPtr->packedPoseFreeSlots.empty())
+    {
+      slot = this->dataPtr->packedPoseFreeSlots.back();
+      this->dataPtr->packedPoseFreeSlots.pop_back();
+      this->dataPtr->packedPoseSlots.emplace(id, slot);
+      this->dataPtr->packedPoseIds[slot] = id;
+    }
+    else
+    {
+      slot = static_cast<uint32_t>(this->dataPtr->packedPoseIds.size());
+      this->dataPtr->packedPoseSlots.emplace(id, slot);
+      this->dataPtr->packedPoseIds.push_back(id);
+      this->dataPtr->packedPoses.resize(this->dataPtr->packedPoses.size() + 7);
+      this->dataPtr->packedPoseQueued.push_back(0);
+    }
+
+    std::copy(values + 7 * i, values + 7 * (i + 1),
+        this->dataPtr->packedPoses.begin() + 7 * slot);
+    if (!this->dataPtr->packedPoseQueued[slot])
+    {
+      this->dataPtr->packedPoseQueued[slot] = 1;
+      this->dataPtr->packedPoseQueue.push_back(slot);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void Scene::RemovePackedPose(const uint32_t _id)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
+  auto iter = this->dataPtr->packedPoseSlots.find(_id);
+  if (iter == this->dataPtr->packedPoseSlots.end())
+    return;
+
+  const uint32_t slot = iter->second;
+  this->dataPtr->packedPoseSlots.erase(iter);
+
+  // Drop a pose that hasn't been applied yet, so that the slot isn't
+  // applied to the next entity that reuses it
+  if (this->dataPtr->packedPoseQueued[slot])
+  {
+    auto &queue = this->dataPtr->packedPoseQueue;
+    queue.erase(std::remove(queue.begin(), queue.end(), slot), queue.end());
+    this->dataPtr->packedPoseQueued[slot] = 0;
+  }
+  this->dataPtr->packedPoseFreeSlots.push_back(slot);
+}
+
+/////////////////////////////////////////////////
+void Scene::UpdatePoses(const msgs::PackedPoses &_msg)
+{
+  this->StorePackedPoses(_msg);
+
+  std::unique_lock<std::mutex> lck(this->dataPtr->newPoseMutex);
+  this->dataPtr->newPoseAvailable = true;
+  this->dataPtr->newPoseCondition.notify_all();
+}
+
 /////////////////////////////////////////////////
 void Scene::UpdatePoses(const msgs::PosesStamped &_msg)
 {
@@ -2911,23 +3118,12 @@ bool Scene::WaitForRenderRequest(double _timeoutsec)
 }
 
 /////////////////////////////////////////////////
-void Scene::OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg)
+void Scene::OnSkeletonPoseMsg(ConstPackedSkeletonPosePtr &_msg)
 {
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-  SkeletonPoseMsgs_L::iterator iter;
-
-  // Find an old model message, and remove them
-  for (iter = this->dataPtr->skeletonPoseMsgs.begin();
-        iter != this->dataPtr->skeletonPoseMsgs.end(); ++iter)
-  {
-    if ((*iter)->model_name() == _msg->model_name())
-    {
-      this->dataPtr->skeletonPoseMsgs.erase(iter);
-      break;
-    }
-  }
 
-  this->dataPtr->skeletonPoseMsgs.push_back(_msg);
+  // Only the latest frame of each actor is kept
+  this->dataPtr->skeletonPoseMsgs[_msg->visual_id()] = _msg;
 }
 
 /////////////////////////////////////////////////
@@ -3319,6 +3515,7 @@ void Scene::RemoveVisual(uint32_t _id)
         ++piter;
     }
     this->dataPtr->visuals.erase(iter);
+    this->RemovePackedPose(_id);
 
     this->RemoveVisualizations(vis);
     vis->Fini();
@@ -3367,6 +3564,7 @@ void Scene::RemoveLight(LightPtr _light)
   {
     // Delete the light
     this->dataPtr->lights.erase(_light->Id());
+    this->RemovePackedPose(_light->Id());
   }
 }
 
@@ -568,6 +568,11 @@ namespace gazebo
       /// \param[in] _msg The message data.
       public: void UpdatePoses(const msgs::PosesStamped& _msg);
 
+      /// \brief Update Poses of objects in the scene from a compact pose
+      /// message via direct API call instead of transport.
+      /// \param[in] _msg The message data.
+      public: void UpdatePoses(const msgs::PackedPoses &_msg);
+
       /// \brief Get the number of visuals.
       /// \return The number of visuals in the Scene.
       public: uint32_t VisualCount() const;
@@ -730,9 +735,26 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnPoseMsg(ConstPosesStampedPtr &_msg);
 
+      /// \brief Packed pose message callback.
+      /// \param[in] _msg The message data.
+      private: void OnPackedPoseMsg(ConstPackedPosesPtr &_msg);
+
+      /// \brief Callback of the ~/pose/info fallback, ignored once packed
+      /// poses have been received.
+      /// \param[in] _msg The message data.
+      private: void OnFallbackPoseMsg(ConstPosesStampedPtr &_msg);
+
+      /// \brief Store packed poses until they are applied by PreRender.
+      /// \param[in] _msg The message data.
+      private: void StorePackedPoses(const msgs::PackedPoses &_msg);
+
+      /// \brief Release the packed pose slot of a removed visual or light.
+      /// \param[in] _id Id of the visual or light.
+      private: void RemovePackedPose(const uint32_t _id);
+
       /// \brief Skeleton animation callback.
       /// \param[in] _msg The message data.
-      private: void OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg);
+      private: void OnSkeletonPoseMsg(ConstPackedSkeletonPosePtr &_msg);
 
       /// \brief Road message callback.
       /// \param[in] _msg The message data.
@@ -20,6 +20,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
@@ -104,10 +105,11 @@ namespace gazebo
     /// \brief Map of lights
     typedef std::map<uint32_t, LightPtr> Light_M;
 
-    /// \def SkeletonPoseMsgs_L
-    /// \brief List of skeleton messages.
-    typedef std::list<boost::shared_ptr<msgs::PoseAnimation const> >
-                                                        SkeletonPoseMsgs_L;
+    /// \def SkeletonPoseMsgs_M
+    /// \brief Latest skeleton message of each actor, indexed by the id of
+    /// its skin visual.
+    typedef std::unordered_map<uint32_t,
+        boost::shared_ptr<msgs::PackedSkeletonPose const> > SkeletonPoseMsgs_M;
 
     /// \def JointMsgs_M
     /// \brief Map of joint names to joint messages.
@@ -187,6 +189,32 @@ namespace gazebo
       /// \brief List of pose message to process.
       public: LightPoseMsgs_M lightPoseMsgs;
 
+      /// \brief Slot of each entity id in the packed pose buffers. An entry
+      /// is added the first time an entity is received, and removed with
+      /// its visual or light.
+      public: std::unordered_map<uint32_t, uint32_t> packedPoseSlots;
+
+      /// \brief Entity id of each packed pose slot.
+      public: std::vector<uint32_t> packedPoseIds;
+
+      /// \brief Latest received pose of each slot, packed as in
+      /// msgs::PackedPoses.
+      public: std::vector<float> packedPoses;
+
+      /// \brief Whether each slot is in packedPoseQueue.
+      public: std::vector<char> packedPoseQueued;
+
+      /// \brief Slots with a pose that hasn't been applied yet.
+      public: std::vector<uint32_t> packedPoseQueue;
+
+      /// \brief Slots released by removed entities, reused before the
+      /// buffers grow.
+      public: std::vector<uint32_t> packedPoseFreeSlots;
+
+      /// \brief True once a packed pose message has been received, after
+      /// which messages on the ~/pose/info fallback are ignored.
+      public: bool packedPosesReceived = false;
+
       /// \brief List of scene message to process.
       public: SceneMsgs_L sceneMsgs;
 
@@ -211,8 +239,8 @@ namespace gazebo
       /// \brief Map of all the lights in this scene.
       public: Light_M lights;
 
-      /// \brief List of skeleton message to process.
-      public: SkeletonPoseMsgs_L skeletonPoseMsgs;
+      /// \brief Skeleton messages to process.
+      public: SkeletonPoseMsgs_M skeletonPoseMsgs;
 
       /// \brief List of road messages to process.
       public: RoadMsgs_L roadMsgs;
@@ -256,6 +284,10 @@ namespace gazebo
       /// \brief Subscribe to pose updates
       public: transport::SubscriberPtr poseSub;
 
+      /// \brief Subscribe to ~/pose/info, for servers that don't publish
+      /// packed poses. Released once packed poses are received.
+      public: transport::SubscriberPtr fallbackPoseSub;
+
       /// \brief Subscribe to joint updates.
       public: transport::SubscriberPtr jointSub;
 
@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <utility>
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -402,6 +403,58 @@ TEST_F(Scene_TEST, AddRemoveLights)
   EXPECT_FALSE(scene->LightByName("light1"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, PackedPoses)
+{
+  Load("worlds/empty.world");
+
+  // Get the scene
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::VisualPtr visual1;
+  visual1.reset(new rendering::Visual("visual1", scene));
+  scene->AddVisual(visual1);
+  const uint32_t lateId = visual1->GetId() + 100000;
+
+  // Poses of the visual and of a visual that doesn't exist yet
+  const ignition::math::Pose3d pose1(1, 2, 3, 0.1, 0.2, 0.3);
+  const ignition::math::Pose3d pose2(-4, 5, -6, 0, 0, 1.5);
+  msgs::PackedPoses msg;
+  msgs::Set(msg.mutable_time(), common::Time(4, 0));
+  for (const auto &entry : {std::make_pair(visual1->GetId(), pose1),
+      std::make_pair(lateId, pose2)})
+  {
+    msg.add_id(entry.first);
+    msg.add_pose(entry.second.Pos().X());
+    msg.add_pose(entry.second.Pos().Y());
+    msg.add_pose(entry.second.Pos().Z());
+    msg.add_pose(entry.second.Rot().W());
+    msg.add_pose(entry.second.Rot().X());
+    msg.add_pose(entry.second.Rot().Y());
+    msg.add_pose(entry.second.Rot().Z());
+  }
+  scene->UpdatePoses(msg);
+  scene->PreRender();
+  EXPECT_TRUE(visual1->Pose().Pos().Equal(pose1.Pos(), 1e-5));
+  EXPECT_TRUE(visual1->Pose().Rot().Equal(pose1.Rot(), 1e-5));
+
+  // The pose of the other visual is applied once it is added
+  rendering::VisualPtr visual2;
+  visual2.reset(new rendering::Visual("visual2", scene));
+  visual2->SetId(lateId);
+  scene->AddVisual(visual2);
+  scene->PreRender();
+  EXPECT_TRUE(visual2->Pose().Pos().Equal(pose2.Pos(), 1e-5));
+  EXPECT_TRUE(visual2->Pose().Rot().Equal(pose2.Rot(), 1e-5));
+
+  // Messages with a mismatched number of values are ignored
+  msg.mutable_pose()->Set(0, 10);
+  msg.add_pose(0);
+  scene->UpdatePoses(msg);
+  scene->PreRender();
+  EXPECT_TRUE(visual1->Pose().Pos().Equal(pose1.Pos(), 1e-5));
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
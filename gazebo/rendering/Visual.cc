@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
@@ -29,6 +31,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshBVH.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/Skeleton.hh"
 
@@ -2957,6 +2960,23 @@ std::string Visual::GetMeshName() const
   return std::string();
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<const common::MeshBVH> Visual::MeshBVH() const
+{
+  const std::string meshName = this->GetMeshName();
+  const common::Mesh *mesh = meshName.empty() ? nullptr :
+      common::MeshManager::Instance()->GetMesh(meshName);
+
+  if (mesh != this->dataPtr->meshBVHSource || !this->dataPtr->meshBVH)
+  {
+    this->dataPtr->meshBVHSource = mesh;
+    this->dataPtr->meshBVH.reset();
+    if (mesh)
+      this->dataPtr->meshBVH = std::make_shared<common::MeshBVH>(*mesh);
+  }
+  return this->dataPtr->meshBVH;
+}
+
 //////////////////////////////////////////////////
 std::string Visual::GetSubMeshName() const
 {
@@ -3399,6 +3419,29 @@ void Visual::SetSkeletonPose(const msgs::PoseAnimation &_pose)
   }
 }
 
+//////////////////////////////////////////////////
+void Visual::SetSkeletonPose(const float *_poses, const unsigned int _count)
+{
+  if (!this->dataPtr->skeleton)
+  {
+    gzerr << "Visual " << this->Name() << " has no skeleton.\n";
+    return;
+  }
+
+  // The bones are created in the order of the handles of the mesh skeleton
+  const unsigned int count = std::min(_count,
+      static_cast<unsigned int>(this->dataPtr->skeleton->getNumBones()));
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const float *p = _poses + 7 * i;
+    Ogre::Bone *bone = this->dataPtr->skeleton->getBone(
+        static_cast<uint16_t>(i));
+    bone->setManuallyControlled(true);
+    bone->setPosition(Ogre::Vector3(p[0], p[1], p[2]));
+    bone->setOrientation(Ogre::Quaternion(p[3], p[4], p[5], p[6]));
+  }
+}
+
 
 //////////////////////////////////////////////////
 void Visual::LoadPlugins()
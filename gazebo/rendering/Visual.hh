@@ -19,6 +19,7 @@
 
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -573,6 +574,15 @@ namespace gazebo
       /// \param[in] _pose Skelton message
       public: void SetSkeletonPose(const msgs::PoseAnimation &_pose);
 
+      /// \brief Set animation skeleton pose from packed bone poses, as in
+      /// msgs::PackedSkeletonPose.
+      /// \param[in] _poses Pose of each bone relative to its parent, in the
+      /// order of the bone handles, as seven floats: the position x, y, z
+      /// followed by the orientation w, x, y, z.
+      /// \param[in] _count Number of bones in _poses.
+      public: void SetSkeletonPose(const float *_poses,
+                                   const unsigned int _count);
+
       /// \brief Load a plugin
       /// \param _filename The filename of the plugin
       /// \param _name A unique name for the plugin
@@ -608,6 +618,14 @@ namespace gazebo
       /// specified.
       public: std::string GetSubMeshName() const;
 
+      /// \brief Get a bounding volume hierarchy over the triangles of the
+      /// visual's mesh, for ray queries that are logarithmic in the number
+      /// of triangles. It is built on first use, cached and rebuilt when the
+      /// mesh changes.
+      /// \return The hierarchy, in the mesh frame. Null if the mesh isn't
+      /// known by the common::MeshManager.
+      public: std::shared_ptr<const common::MeshBVH> MeshBVH() const;
+
       /// \brief Clear parents.
       public: void ClearParent();
 
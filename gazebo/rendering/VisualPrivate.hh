@@ -176,6 +176,13 @@ namespace gazebo
       /// \brief The visual's submesh name.
       public: std::string subMeshName;
 
+      /// \brief Ray query hierarchy over the mesh triangles, built on first
+      /// use.
+      public: std::shared_ptr<const common::MeshBVH> meshBVH;
+
+      /// \brief Mesh that meshBVH was built from.
+      public: const common::Mesh *meshBVHSource = nullptr;
+
       /// \brief Ambient color of the visual.
       public: ignition::math::Color ambient = ignition::math::Color(0, 0, 0, 0);
 
@@ -20,6 +20,7 @@
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
+#include "gazebo/common/MeshBVH.hh"
 #include "gazebo/rendering/RenderingIface.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/Visual.hh"
@@ -2047,6 +2048,41 @@ TEST_F(Visual_TEST, Pose)
   EXPECT_EQ(sphereVis->InitialRelativePose(), spherePose);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Visual_TEST, MeshBVH)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // A visual without a mesh doesn't have a hierarchy
+  gazebo::rendering::VisualPtr vis(
+      new gazebo::rendering::Visual("bvh_visual", scene));
+  vis->Load();
+  EXPECT_TRUE(vis->MeshBVH() == nullptr);
+
+  // The hierarchy is built once and cached
+  vis->AttachMesh("unit_box");
+  std::shared_ptr<const common::MeshBVH> bvh = vis->MeshBVH();
+  ASSERT_TRUE(bvh != nullptr);
+  EXPECT_EQ(12u, bvh->TriangleCount());
+  EXPECT_EQ(bvh, vis->MeshBVH());
+
+  double distance;
+  ignition::math::Triangle3d triangle;
+  EXPECT_TRUE(bvh->Intersect(ignition::math::Vector3d(0.1, 0.2, 2),
+      -ignition::math::Vector3d::UnitZ, distance, triangle));
+  EXPECT_DOUBLE_EQ(1.5, distance);
+
+  // It follows a change of mesh
+  vis->DetachObjects();
+  vis->AttachMesh("unit_sphere");
+  ASSERT_TRUE(vis->MeshBVH() != nullptr);
+  EXPECT_NE(bvh, vis->MeshBVH());
+  EXPECT_GT(vis->MeshBVH()->TriangleCount(), 12u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -15,6 +15,7 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <functional>
 #include <sstream>
 
 #include <ignition/common/Profiler.hh>
@@ -111,16 +112,13 @@ void ContactSensor::Load(const std::string &_worldName)
 
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to hand the contacts of the collisions
+    // to this sensor
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
-    }
+    mgr->CreateFilter(this->dataPtr->filterName, this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->dataPtr->filterName,
+        std::bind(&ContactSensor::OnContacts, this,
+          std::placeholders::_1, std::placeholders::_2));
   }
 }
 
@@ -139,55 +137,46 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Don't do anything if there is no new data to process.
-  if (this->dataPtr->incomingContacts.empty())
+  if (this->dataPtr->incomingCounts.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
-
-  // Clear the outgoing contact message.
+  // The contacts were filtered by the contact manager, build the outgoing
+  // message from them. Cleared protobuf entries are reused.
   this->dataPtr->contactsMsg.clear_contact();
-
-  // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-       iter != this->dataPtr->incomingContacts.end(); ++iter)
+  const std::string worldName = this->world->Name();
+  auto point = this->dataPtr->incomingPoints.cbegin();
+  for (auto const &contact : this->dataPtr->incomingContacts)
   {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
+    const std::string &name1 =
+        this->dataPtr->collisionNames[contact.collision1];
+    const std::string &name2 =
+        this->dataPtr->collisionNames[contact.collision2];
+
+    msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
+    contactMsg->set_world(worldName);
+    contactMsg->set_collision1(name1);
+    contactMsg->set_collision2(name2);
+    msgs::Set(contactMsg->mutable_time(), contact.time);
+
+    for (int j = 0; j < contact.pointCount; ++j, ++point)
     {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->dataPtr->collisions.begin(),
-          this->dataPtr->collisions.end(), collision1);
-
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->dataPtr->collisions.end())
-      {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->dataPtr->collisions.begin(),
-            this->dataPtr->collisions.end(), collision1);
-      }
-
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->dataPtr->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
+      contactMsg->add_depth(point->depth);
+      msgs::Set(contactMsg->add_position(), point->position);
+      msgs::Set(contactMsg->add_normal(), point->normal);
+
+      msgs::JointWrench *jntWrench = contactMsg->add_wrench();
+      jntWrench->set_body_1_name(name1);
+      jntWrench->set_body_1_id(contact.collision1);
+      jntWrench->set_body_2_name(name2);
+      jntWrench->set_body_2_id(contact.collision2);
+
+      msgs::Wrench *wrenchMsg = jntWrench->mutable_body_1_wrench();
+      msgs::Set(wrenchMsg->mutable_force(), point->wrench.body1Force);
+      msgs::Set(wrenchMsg->mutable_torque(), point->wrench.body1Torque);
+
+      wrenchMsg = jntWrench->mutable_body_2_wrench();
+      msgs::Set(wrenchMsg->mutable_force(), point->wrench.body2Force);
+      msgs::Set(wrenchMsg->mutable_torque(), point->wrench.body2Torque);
     }
   }
 
@@ -196,6 +185,8 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 
   // Clear the incoming contact list.
   this->dataPtr->incomingContacts.clear();
+  this->dataPtr->incomingPoints.clear();
+  this->dataPtr->incomingCounts.clear();
 
   this->lastMeasurementTime = this->world->SimTime();
   msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
@@ -215,14 +206,15 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 void ContactSensor::Fini()
 {
-  if (this->world && this->world->Running())
+  // The filter calls back this sensor, remove it as long as the contact
+  // manager exists
+  if (this->world && this->world->Physics())
   {
     physics::ContactManager *mgr =
         this->world->Physics()->GetContactManager();
     mgr->RemoveFilter(this->dataPtr->filterName);
   }
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
 }
@@ -304,19 +296,65 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::Contacts(
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::OnContacts(ConstContactsPtr &_msg)
+void ContactSensor::OnContacts(
+    const std::vector<physics::Contact *> &_contacts,
+    const common::Time &/*_time*/)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Only store information if the sensor is active
   if (this->IsActive())
   {
-    // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
+    // Store the contact data, the message is built in UpdateImpl
+    for (auto const &contact : _contacts)
+    {
+      ContactSensorContact stored;
+      stored.collision1 = contact->collision1->GetId();
+      stored.collision2 = contact->collision2->GetId();
+      stored.pointCount = contact->count;
+      stored.time = contact->time;
+      this->dataPtr->incomingContacts.push_back(stored);
+
+      // Names are looked up once per collision
+      if (!this->dataPtr->collisionNames.count(stored.collision1))
+      {
+        this->dataPtr->collisionNames[stored.collision1] =
+            contact->collision1->GetScopedName();
+      }
+      if (!this->dataPtr->collisionNames.count(stored.collision2))
+      {
+        this->dataPtr->collisionNames[stored.collision2] =
+            contact->collision2->GetScopedName();
+      }
 
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->dataPtr->incomingContacts.size() > 100)
-      this->dataPtr->incomingContacts.pop_front();
+      for (int j = 0; j < contact->count; ++j)
+      {
+        ContactSensorPoint point;
+        point.position = contact->positions[j];
+        point.normal = contact->normals[j];
+        point.depth = contact->depths[j];
+        point.wrench = contact->wrench[j];
+        this->dataPtr->incomingPoints.push_back(point);
+      }
+    }
+    this->dataPtr->incomingCounts.push_back(
+        static_cast<int>(_contacts.size()));
+
+    // Prevent the incoming contacts to grow indefinitely.
+    if (this->dataPtr->incomingCounts.size() > 100)
+    {
+      auto first = this->dataPtr->incomingContacts.begin();
+      auto last = first + this->dataPtr->incomingCounts.front();
+      int points = 0;
+      for (auto iter = first; iter != last; ++iter)
+        points += iter->pointCount;
+
+      this->dataPtr->incomingContacts.erase(first, last);
+      this->dataPtr->incomingPoints.erase(
+          this->dataPtr->incomingPoints.begin(),
+          this->dataPtr->incomingPoints.begin() + points);
+      this->dataPtr->incomingCounts.pop_front();
+    }
   }
 }
 
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -94,10 +95,12 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor creates a filter in the ContactManager, which
+      /// hands it the contact pairs involving the <collision> bodies
+      /// specified by the ContactSensor SDF after every time step, in
+      /// process, through ContactSensor::OnContacts. The contact data is
+      /// only copied there; the message is built in UpdateImpl, at the
+      /// sensor update rate.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -133,8 +136,11 @@ namespace gazebo
       // Documentation inherited.
       public: virtual bool IsActive() const;
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
+      /// \brief Callback for contacts from the physics engine.
+      /// \param[in] _contacts Contacts of the monitored collisions.
+      /// \param[in] _time Simulation time.
+      private: void OnContacts(const std::vector<physics::Contact *> &_contacts,
+                   const common::Time &_time);
 
       /// \internal
       /// \brief Private data pointer
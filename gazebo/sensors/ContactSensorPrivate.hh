@@ -17,11 +17,17 @@
 #ifndef _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 
+#include <cstdint>
+#include <deque>
 #include <vector>
-#include <list>
 #include <string>
 #include <mutex>
+#include <unordered_map>
 
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/JointWrench.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 
@@ -29,6 +35,42 @@ namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief Contact point received from the contact manager, kept until
+    /// the next sensor update.
+    class ContactSensorPoint
+    {
+      /// \brief Contact position in the world frame.
+      public: ignition::math::Vector3d position;
+
+      /// \brief Contact normal in the world frame.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Penetration depth.
+      public: double depth = 0;
+
+      /// \brief Force and torque applied on both bodies.
+      public: physics::JointWrench wrench;
+    };
+
+    /// \internal
+    /// \brief Contact between two collisions received from the contact
+    /// manager, kept until the next sensor update.
+    class ContactSensorContact
+    {
+      /// \brief Id of the first collision.
+      public: uint32_t collision1 = 0;
+
+      /// \brief Id of the second collision.
+      public: uint32_t collision2 = 0;
+
+      /// \brief Number of points of the contact in incomingPoints.
+      public: int pointCount = 0;
+
+      /// \brief Time of the contact.
+      public: common::Time time;
+    };
+
     /// \internal
     /// \brief Contact sensor private data.
     class ContactSensorPrivate
@@ -39,21 +81,25 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
-
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
 
       /// \brief Contacts message used to output sensor data.
       public: msgs::Contacts contactsMsg;
 
-      /// \type ContactMsgs_L
-      /// List of contact messages
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
+      /// \brief Contacts received since the last update, oldest first.
+      /// The message is built from them in UpdateImpl.
+      public: std::vector<ContactSensorContact> incomingContacts;
+
+      /// \brief Points of incomingContacts, in the same order.
+      public: std::vector<ContactSensorPoint> incomingPoints;
+
+      /// \brief Scoped names of the collisions seen in contact, by id.
+      public: std::unordered_map<uint32_t, std::string> collisionNames;
 
-      /// \brief List of incoming messages.
-      public: ContactMsgs_L incomingContacts;
+      /// \brief Number of contacts in each of the physics updates received
+      /// since the last update, oldest first.
+      public: std::deque<int> incomingCounts;
 
       /// \brief Name of filter used to filter contact messages.
       public: std::string filterName;
@@ -41,6 +41,7 @@
 #include "gazebo/sensors/SensorPrivate.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/util/ProfileManager.hh"
 
 using namespace gazebo;
 using namespace sensors;
@@ -162,6 +163,9 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  this->dataPtr->profileId = util::ProfileManager::Instance()->ScopeId(
+      "sensor::" + this->ScopedName());
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -238,6 +242,7 @@ void Sensor::Update(const bool _force)
   {
     if (this->useStrictRate)
     {
+      util::ProfileScope profileScope(this->dataPtr->profileId);
       if (this->UpdateImpl(_force))
         this->updated();
     }
@@ -276,6 +281,7 @@ void Sensor::Update(const bool _force)
           this->dataPtr->updateDelay = common::Time::Zero;
       }
 
+      util::ProfileScope profileScope(this->dataPtr->profileId);
       if (this->UpdateImpl(_force))
       {
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
@@ -17,6 +17,10 @@
 /* Desc: Handles pushing messages out on a named topic
  * Author: Nate Koenig
  */
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 #include <boost/bind.hpp>
 
 #include <ignition/math/Helpers.hh>
@@ -32,11 +36,41 @@ using namespace transport;
 
 uint32_t Publisher::idCounter = 0;
 
+/// \brief Private data for Publisher
+class gazebo::transport::PublisherPrivate
+{
+  /// \brief How messages are queued. Guarded by Publisher::mutex.
+  public: PublishPolicy policy = PublishPolicy::QUEUE;
+
+  /// \brief Number of messages per batch. Guarded by Publisher::mutex.
+  public: unsigned int batchSize = 1;
+
+  /// \brief True to send an incomplete batch. Guarded by
+  /// Publisher::mutex.
+  public: bool flushRequested = false;
+
+  /// \brief Clock used to throttle the publication rate, wall time when
+  /// null. Accessed with std::atomic_load and std::atomic_store.
+  public: std::shared_ptr<const std::function<common::Time()>> rateClock;
+
+  /// \brief True to count the bytes sent.
+  public: std::atomic<bool> countBytes{false};
+
+  /// \brief Number of messages sent.
+  public: std::atomic<uint64_t> sentCount{0};
+
+  /// \brief Number of messages dropped.
+  public: std::atomic<uint64_t> droppedCount{0};
+
+  /// \brief Number of bytes sent.
+  public: std::atomic<uint64_t> sentBytes{0};
+};
+
 //////////////////////////////////////////////////
 Publisher::Publisher(const std::string &_topic, const std::string &_msgType,
                      unsigned int _limit, double _hzRate)
   : topic(_topic), msgType(_msgType), queueLimit(_limit),
-    updatePeriod(0)
+    updatePeriod(0), dataPtr(new PublisherPrivate)
 {
   if (!ignition::math::equal(_hzRate, 0.0))
     this->updatePeriod = 1.0 / _hzRate;
@@ -102,13 +136,18 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
   if (this->updatePeriod > 0)
   {
     // Get the current time
-    this->currentTime = common::Time::GetWallTime();
+    auto clock = std::atomic_load(&this->dataPtr->rateClock);
+    this->currentTime = clock ? (*clock)() : common::Time::GetWallTime();
 
     // Skip publication if the time difference is less than the update period.
+    // A clock going backwards, such as simulation time after a reset,
+    // restarts the throttling.
     if (this->prevPublishTime != common::Time(0, 0) &&
+        this->currentTime >= this->prevPublishTime &&
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
+      ++this->dataPtr->droppedCount;
       return;
     }
 
@@ -125,11 +164,22 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    // Replace the message that is still waiting to be sent
+    if (this->dataPtr->policy == PublishPolicy::LATEST &&
+        !this->messages.empty())
+    {
+      this->messages.back() = msgPtr;
+      ++this->dataPtr->droppedCount;
+    }
+    else
+    {
+      this->messages.push_back(msgPtr);
+    }
 
     if (this->messages.size() > this->queueLimit)
     {
       this->messages.pop_front();
+      ++this->dataPtr->droppedCount;
 
       if (!queueLimitWarned)
       {
@@ -168,6 +218,15 @@ void Publisher::SendMessage()
       return;
     }
 
+    // Wait for a complete batch, unless a flush was requested
+    if (this->dataPtr->policy == PublishPolicy::BATCH &&
+        this->messages.size() < this->dataPtr->batchSize &&
+        !this->dataPtr->flushRequested)
+    {
+      return;
+    }
+    this->dataPtr->flushRequested = false;
+
     for (unsigned int i = 0; i < this->messages.size(); ++i)
     {
       this->pubId = (this->pubId + 1) % 10000;
@@ -175,9 +234,7 @@ void Publisher::SendMessage()
       localIds.push_back(this->pubId);
     }
 
-    std::copy(this->messages.begin(), this->messages.end(),
-        std::back_inserter(localBuffer));
-    this->messages.clear();
+    localBuffer.swap(this->messages);
   }
 
   // Only send messages if there is something to send
@@ -246,6 +303,23 @@ void Publisher::SendMessage()
       }
     }
 
+    this->dataPtr->sentCount += localBuffer.size();
+
+    // Measuring the serialized size costs time, only do it when asked to
+    if (this->dataPtr->countBytes)
+    {
+      uint64_t bytes = 0;
+      for (const auto &msg : localBuffer)
+      {
+#if GOOGLE_PROTOBUF_VERSION < 3001000
+        bytes += msg->ByteSize();
+#else
+        bytes += msg->ByteSizeLong();
+#endif
+      }
+      this->dataPtr->sentBytes += bytes;
+    }
+
     // Clear the local buffer.
     localBuffer.clear();
     localIds.clear();
@@ -317,7 +391,7 @@ unsigned int Publisher::GetRemoteSubscriptionCount()
 void Publisher::Fini()
 {
   if (!this->messages.empty())
-    this->SendMessage();
+    this->Flush();
   this->messages.clear();
 
   if (!this->topic.empty())
@@ -354,3 +428,77 @@ uint32_t Publisher::Id() const
 {
   return this->id;
 }
+
+//////////////////////////////////////////////////
+void Publisher::SetPolicy(const PublishPolicy _policy,
+    const unsigned int _batchSize)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  this->dataPtr->policy = _policy;
+  this->dataPtr->batchSize =
+      std::max(1u, std::min(_batchSize, this->queueLimit));
+
+  if (_policy == PublishPolicy::BATCH && _batchSize > this->queueLimit)
+  {
+    gzwarn << "Batch size [" << _batchSize << "] of topic [" << this->topic
+           << "] exceeds the queue limit, using ["
+           << this->dataPtr->batchSize << "]" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+PublishPolicy Publisher::Policy() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->dataPtr->policy;
+}
+
+//////////////////////////////////////////////////
+unsigned int Publisher::BatchSize() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->dataPtr->batchSize;
+}
+
+//////////////////////////////////////////////////
+void Publisher::Flush()
+{
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    this->dataPtr->flushRequested = true;
+  }
+  this->SendMessage();
+}
+
+//////////////////////////////////////////////////
+void Publisher::SetRateClock(const std::function<common::Time()> &_clock)
+{
+  std::shared_ptr<const std::function<common::Time()>> clock;
+  if (_clock)
+    clock = std::make_shared<const std::function<common::Time()>>(_clock);
+  std::atomic_store(&this->dataPtr->rateClock, clock);
+}
+
+//////////////////////////////////////////////////
+uint64_t Publisher::SentCount() const
+{
+  return this->dataPtr->sentCount;
+}
+
+//////////////////////////////////////////////////
+uint64_t Publisher::DroppedCount() const
+{
+  return this->dataPtr->droppedCount;
+}
+
+//////////////////////////////////////////////////
+void Publisher::SetCountBytes(const bool _count)
+{
+  this->dataPtr->countBytes = _count;
+}
+
+//////////////////////////////////////////////////
+uint64_t Publisher::SentBytes() const
+{
+  return this->dataPtr->sentBytes;
+}
@@ -24,6 +24,9 @@
 #include <google/protobuf/message.h>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <list>
 #include <map>
@@ -39,6 +42,26 @@ namespace gazebo
     /// \addtogroup gazebo_transport
     /// \{
 
+    /// \brief How a publisher queues messages before they are sent.
+    enum class PublishPolicy
+    {
+      /// \brief Queue every message, dropping the oldest one when the queue
+      /// limit is reached. This is the default.
+      QUEUE,
+
+      /// \brief Keep only the latest message that has not been sent yet.
+      /// Suited to state topics where stale values are useless.
+      LATEST,
+
+      /// \brief Hold messages until a batch is complete, then send the
+      /// batch at once. Messages of a batch are written back to back, so
+      /// remote connections send them in as few socket writes as possible.
+      BATCH
+    };
+
+    // Forward declare private data class
+    class PublisherPrivate;
+
     /// \class Publisher Publisher.hh transport/transport.hh
     /// \brief A publisher of messages on a topic
     class GZ_TRANSPORT_VISIBLE Publisher :
@@ -140,6 +163,53 @@ namespace gazebo
       /// \return Unique id of this publisher.
       public: uint32_t Id() const;
 
+      /// \brief Set how messages are queued before they are sent.
+      /// \param[in] _policy Queueing policy.
+      /// \param[in] _batchSize Number of messages per batch, used with
+      /// PublishPolicy::BATCH. It is clamped to the queue limit.
+      public: void SetPolicy(const PublishPolicy _policy,
+                  const unsigned int _batchSize = 1);
+
+      /// \brief Get the queueing policy.
+      /// \return The queueing policy.
+      public: PublishPolicy Policy() const;
+
+      /// \brief Get the number of messages per batch.
+      /// \return Batch size, used with PublishPolicy::BATCH.
+      public: unsigned int BatchSize() const;
+
+      /// \brief Send all queued messages, including an incomplete batch.
+      public: void Flush();
+
+      /// \brief Set the clock used to throttle the publication rate. By
+      /// default, wall time is used. Use this to throttle with simulation
+      /// time, so that the rate holds at any real time factor.
+      /// \param[in] _clock Function returning the current time. An empty
+      /// function restores wall time.
+      public: void SetRateClock(const std::function<common::Time()> &_clock);
+
+      /// \brief Get the number of messages sent since the publisher was
+      /// created.
+      /// \return Number of messages sent.
+      public: uint64_t SentCount() const;
+
+      /// \brief Get the number of messages that were not sent, because of
+      /// the queue limit, the queueing policy or the rate limit.
+      /// \return Number of messages dropped.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Enable or disable counting the bytes sent. Disabled by
+      /// default, since measuring the serialized size of every message
+      /// sent takes time.
+      /// \param[in] _count True to count the bytes sent.
+      public: void SetCountBytes(const bool _count);
+
+      /// \brief Get the serialized size of the messages sent while byte
+      /// counting was enabled.
+      /// \return Number of bytes sent.
+      /// \sa SetCountBytes
+      public: uint64_t SentBytes() const;
+
       /// \brief Implementation of Publish.
       /// \param[in] _message Message to be published.
       /// \param[in] _block Whether to block until the message is actually
@@ -196,6 +266,10 @@ namespace gazebo
 
       /// \brief Counter to create unique ID for publishers.
       private: static uint32_t idCounter;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PublisherPrivate> dataPtr;
     };
     /// \}
   }
@@ -24,6 +24,7 @@
 #include "gazebo/transport/transport.hh"
 #include "gazebo/util/DiagnosticsPrivate.hh"
 #include "gazebo/util/Diagnostics.hh"
+#include "gazebo/util/ProfileManager.hh"
 
 using namespace gazebo;
 using namespace util;
@@ -130,6 +131,11 @@ void DiagnosticManager::AddTime(const std::string &_name,
   time->set_name(_name);
   msgs::Set(time->mutable_elapsed(), _elapsedTime);
   msgs::Set(time->mutable_wall(), _wallTime);
+
+  // Also aggregate the timings along with the profiled scopes
+  ProfileManager *profiler = ProfileManager::Instance();
+  if (profiler->Enabled())
+    profiler->Record(profiler->ScopeId(_name), _elapsedTime);
 }
 
 //////////////////////////////////////////////////
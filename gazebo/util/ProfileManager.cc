@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/transport.hh"
+#include "gazebo/util/ProfileManagerPrivate.hh"
+#include "gazebo/util/ProfileManager.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Id of the parent of top level scopes.
+static const uint32_t kNoScope = std::numeric_limits<uint32_t>::max();
+
+/// \brief Number of slices in the rolling window.
+static const unsigned int kSlices = 5;
+
+/// \brief Duration of a slice, which is also the publication period.
+static const int64_t kSliceDuration = 1000000000;
+
+/// \brief Period of the background thread, in milliseconds.
+static const int kDrainPeriod = 10;
+
+/////////////////////////////////////////////////
+/// \brief Get the current time of the monotonic clock.
+/// \return Time in nanoseconds.
+static int64_t Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// \brief Profiling state of a thread.
+class ProfileThread
+{
+  /// \brief Destructor, lets the aggregator release the buffer.
+  public: ~ProfileThread()
+  {
+    if (this->buffer)
+      this->buffer->exited = true;
+  }
+
+  /// \brief Scopes currently timed, with their start time. The start
+  /// time is negative when the scope started while recording was
+  /// disabled.
+  public: std::vector<std::pair<uint32_t, int64_t>> stack;
+
+  /// \brief Buffer of records, created on the first record.
+  public: std::shared_ptr<ProfileBuffer> buffer;
+};
+
+/// \brief Profiling state of the calling thread.
+static thread_local ProfileThread tlsProfileThread;
+
+/////////////////////////////////////////////////
+/// \brief Add a record to the buffer of the calling thread, creating the
+/// buffer on the first record.
+/// \param[in] _data Profile manager data.
+/// \param[in] _record Record to add.
+static void Push(ProfileManagerPrivate &_data, const ProfileRecord &_record)
+{
+  auto &buffer = tlsProfileThread.buffer;
+  if (!buffer)
+  {
+    buffer.reset(new ProfileBuffer);
+    std::lock_guard<std::mutex> lock(_data.mutex);
+    _data.buffers.push_back(buffer);
+  }
+  buffer->Push(_record);
+}
+
+/////////////////////////////////////////////////
+void ProfileHistogram::Add(const int64_t _duration)
+{
+  ++this->count;
+  this->sum += _duration;
+  this->max = std::max(this->max, _duration);
+
+  unsigned int bucket = 0;
+  if (_duration > 1)
+  {
+    bucket = std::min(kBuckets - 1, static_cast<unsigned int>(
+        std::log2(static_cast<double>(_duration)) * 4));
+  }
+  ++this->buckets[bucket];
+}
+
+/////////////////////////////////////////////////
+void ProfileHistogram::Merge(const ProfileHistogram &_other)
+{
+  this->count += _other.count;
+  this->sum += _other.sum;
+  this->max = std::max(this->max, _other.max);
+  for (unsigned int i = 0; i < kBuckets; ++i)
+    this->buckets[i] += _other.buckets[i];
+}
+
+/////////////////////////////////////////////////
+double ProfileHistogram::Quantile(const double _q) const
+{
+  if (this->count == 0)
+    return 0;
+
+  // Middle of the bucket holding the quantile, on a log scale
+  const uint64_t target = std::max<uint64_t>(1,
+      static_cast<uint64_t>(std::ceil(_q * this->count)));
+  uint64_t total = 0;
+  for (unsigned int i = 0; i < kBuckets; ++i)
+  {
+    total += this->buckets[i];
+    if (total >= target)
+    {
+      return std::min(static_cast<double>(this->max),
+          std::exp2((i + 0.5) / 4.0));
+    }
+  }
+  return static_cast<double>(this->max);
+}
+
+/////////////////////////////////////////////////
+ProfileManager::ProfileManager()
+: dataPtr(new ProfileManagerPrivate)
+{
+  this->dataPtr->slices.resize(kSlices);
+}
+
+/////////////////////////////////////////////////
+ProfileManager::~ProfileManager()
+{
+  this->Fini();
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Init(const std::string &_worldName)
+{
+  this->Fini();
+
+  this->dataPtr->node.reset(new transport::Node());
+  this->dataPtr->node->Init(_worldName);
+  this->dataPtr->pub =
+    this->dataPtr->node->Advertise<msgs::ProfileStats>("~/profile");
+
+  this->dataPtr->stop = false;
+  this->dataPtr->thread.reset(
+      new std::thread(std::bind(&ProfileManager::Run, this)));
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Fini()
+{
+  if (this->dataPtr->thread)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->runMutex);
+      this->dataPtr->stop = true;
+    }
+    this->dataPtr->condition.notify_all();
+    this->dataPtr->thread->join();
+    this->dataPtr->thread.reset();
+  }
+
+  this->dataPtr->enabled = this->dataPtr->forced.load();
+
+  this->dataPtr->pub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+  this->dataPtr->node.reset();
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::SetEnabled(const bool _enabled)
+{
+  this->dataPtr->forced = _enabled;
+  this->dataPtr->enabled = _enabled ||
+      (this->dataPtr->pub && this->dataPtr->pub->HasConnections());
+}
+
+/////////////////////////////////////////////////
+bool ProfileManager::Enabled() const
+{
+  return this->dataPtr->enabled.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+uint32_t ProfileManager::ScopeId(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->namesMutex);
+  auto inserted = this->dataPtr->ids.insert(std::make_pair(_name,
+      static_cast<uint32_t>(this->dataPtr->names.size())));
+  if (inserted.second)
+    this->dataPtr->names.push_back(_name);
+  return inserted.first->second;
+}
+
+/////////////////////////////////////////////////
+std::string ProfileManager::ScopeName(const uint32_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->namesMutex);
+  if (_id >= this->dataPtr->names.size())
+    return std::string();
+  return this->dataPtr->names[_id];
+}
+
+/////////////////////////////////////////////////
+size_t ProfileManager::Begin(const uint32_t _id)
+{
+  auto &stack = tlsProfileThread.stack;
+  stack.emplace_back(_id, this->Enabled() ? Now() : -1);
+  return stack.size() - 1;
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::End()
+{
+  const auto &stack = tlsProfileThread.stack;
+  if (!stack.empty())
+    this->End(stack.size() - 1);
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::End(const size_t _depth)
+{
+  auto &stack = tlsProfileThread.stack;
+  if (_depth >= stack.size())
+    return;
+
+  const auto scope = stack[_depth];
+  stack.resize(_depth);
+  if (scope.second < 0 || !this->Enabled())
+    return;
+
+  ProfileRecord record;
+  record.id = scope.first;
+  record.parent = stack.empty() ? kNoScope : stack.back().first;
+  record.duration = Now() - scope.second;
+
+  Push(*this->dataPtr, record);
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Record(const uint32_t _id, const common::Time &_elapsed)
+{
+  if (!this->Enabled())
+    return;
+
+  const auto &stack = tlsProfileThread.stack;
+  ProfileRecord record;
+  record.id = _id;
+  record.parent = stack.empty() ? kNoScope : stack.back().first;
+  record.duration = static_cast<int64_t>(_elapsed.sec) * 1000000000 +
+      _elapsed.nsec;
+
+  Push(*this->dataPtr, record);
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Aggregate()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Clear the slices that went out of the window
+  const int64_t index = Now() / kSliceDuration;
+  if (index != this->dataPtr->sliceIndex)
+  {
+    const int64_t first = this->dataPtr->sliceIndex < 0 ?
+        index : std::max(this->dataPtr->sliceIndex + 1,
+        index - static_cast<int64_t>(kSlices) + 1);
+    for (int64_t i = first; i <= index; ++i)
+      this->dataPtr->slices[i % kSlices].clear();
+    this->dataPtr->sliceIndex = index;
+  }
+
+  ProfileSlice &slice = this->dataPtr->slices[index % kSlices];
+  auto &buffers = this->dataPtr->buffers;
+  for (auto iter = buffers.begin(); iter != buffers.end();)
+  {
+    // Check before draining, so that no record is pushed after the last
+    // drain of an exited thread
+    const bool exited = (*iter)->exited;
+    (*iter)->Drain([&slice](const ProfileRecord &_record)
+        {
+          slice[(static_cast<uint64_t>(_record.parent) << 32) |
+              _record.id].Add(_record.duration);
+        });
+
+    if (exited)
+    {
+      this->dataPtr->exitedDropped += (*iter)->dropped;
+      iter = buffers.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Stats(msgs::ProfileStats &_msg)
+{
+  this->Aggregate();
+
+  // Merge the slices, sorted by name for a stable output
+  std::map<std::pair<std::string, std::string>, ProfileHistogram> merged;
+  uint64_t dropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (const auto &slice : this->dataPtr->slices)
+    {
+      for (const auto &entry : slice)
+      {
+        const uint32_t parent = static_cast<uint32_t>(entry.first >> 32);
+        const uint32_t id = static_cast<uint32_t>(entry.first);
+        merged[std::make_pair(this->ScopeName(id),
+            parent == kNoScope ? std::string() : this->ScopeName(parent))]
+            .Merge(entry.second);
+      }
+    }
+
+    dropped = this->dataPtr->exitedDropped;
+    for (const auto &buffer : this->dataPtr->buffers)
+      dropped += buffer->dropped;
+  }
+
+  _msg.Clear();
+  msgs::Set(_msg.mutable_wall_time(), common::Time::GetWallTime());
+  msgs::Set(_msg.mutable_window(),
+      common::Time(kSliceDuration * 1e-9 * kSlices));
+  _msg.set_dropped(dropped);
+  for (const auto &entry : merged)
+  {
+    msgs::ProfileStats::Scope *scope = _msg.add_scope();
+    scope->set_name(entry.first.first);
+    if (!entry.first.second.empty())
+      scope->set_parent(entry.first.second);
+    scope->set_count(entry.second.count);
+    scope->set_mean(entry.second.sum / entry.second.count * 1e-9);
+    scope->set_p50(entry.second.Quantile(0.5) * 1e-9);
+    scope->set_p99(entry.second.Quantile(0.99) * 1e-9);
+    scope->set_max(entry.second.max * 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Clear()
+{
+  this->Aggregate();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &slice : this->dataPtr->slices)
+    slice.clear();
+  this->dataPtr->exitedDropped = 0;
+  for (auto &buffer : this->dataPtr->buffers)
+    buffer->dropped = 0;
+}
+
+/////////////////////////////////////////////////
+void ProfileManager::Run()
+{
+  int64_t lastPublish = Now();
+  std::unique_lock<std::mutex> lock(this->dataPtr->runMutex);
+  while (!this->dataPtr->stop)
+  {
+    this->dataPtr->condition.wait_for(lock,
+        std::chrono::milliseconds(kDrainPeriod));
+    if (this->dataPtr->stop)
+      break;
+
+    // Only record while someone listens
+    const bool subscribed = this->dataPtr->pub->HasConnections();
+    this->dataPtr->enabled = this->dataPtr->forced || subscribed;
+
+    this->Aggregate();
+
+    const int64_t now = Now();
+    if (now - lastPublish >= kSliceDuration)
+    {
+      lastPublish = now;
+      if (subscribed)
+      {
+        msgs::ProfileStats msg;
+        this->Stats(msg);
+        this->dataPtr->pub->Publish(msg);
+      }
+    }
+  }
+}
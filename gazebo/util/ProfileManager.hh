@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_PROFILEMANAGER_HH_
+#define GAZEBO_UTIL_PROFILEMANAGER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_UTIL_VISIBLE, gazebo, util, ProfileManager)
+
+namespace gazebo
+{
+  namespace msgs
+  {
+    class ProfileStats;
+  }
+
+  namespace util
+  {
+    // Forward declare private data class
+    class ProfileManagerPrivate;
+
+    /// \addtogroup gazebo_util Utility
+    /// \{
+
+    /// \brief Concatenate two tokens, expanding them first.
+    #define GZ_PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+    #define GZ_PROFILE_CONCAT(_a, _b) GZ_PROFILE_CONCAT_IMPL(_a, _b)
+
+    /// \brief Profile the rest of the enclosing block, both with the
+    /// ignition profiler and with the ProfileManager.
+    /// \param[in] _name Name of the scope, a string literal.
+    #define GZ_PROFILE_SCOPE(_name) \
+    IGN_PROFILE(_name); \
+    static const uint32_t GZ_PROFILE_CONCAT(gzProfileId, __LINE__) = \
+      gazebo::util::ProfileManager::Instance()->ScopeId(_name); \
+    gazebo::util::ProfileScope GZ_PROFILE_CONCAT(gzProfileScope, __LINE__)( \
+      GZ_PROFILE_CONCAT(gzProfileId, __LINE__))
+
+    /// \brief Start profiling a scope, both with the ignition profiler and
+    /// with the ProfileManager. Make sure to run GZ_PROFILE_END to stop it.
+    /// \param[in] _name Name of the scope, a string literal.
+    #define GZ_PROFILE_BEGIN(_name) \
+    IGN_PROFILE_BEGIN(_name); \
+    do \
+    { \
+      static const uint32_t gzProfileId = \
+        gazebo::util::ProfileManager::Instance()->ScopeId(_name); \
+      gazebo::util::ProfileManager::Instance()->Begin(gzProfileId); \
+    } while (0)
+
+    /// \brief Stop profiling the scope started last by GZ_PROFILE_BEGIN.
+    #define GZ_PROFILE_END() \
+    IGN_PROFILE_END(); \
+    gazebo::util::ProfileManager::Instance()->End()
+
+    /// \class ProfileManager ProfileManager.hh util/util.hh
+    /// \brief In-process aggregator of scoped timings.
+    ///
+    /// Each thread records the durations of the scopes it runs in a
+    /// lock-free buffer of its own. A background thread drains the buffers
+    /// into histograms over a rolling window of wall time, and publishes
+    /// the count, mean, median, 99th percentile and maximum duration of
+    /// each scope as msgs::ProfileStats on ~/profile.
+    ///
+    /// Scopes are identified by name, interned once with ScopeId. The
+    /// statistics of a scope are kept apart for each enclosing scope. The
+    /// world update phases, the models, the sensors and the named updates
+    /// of the physics::UpdateScheduler are profiled, as are the diagnostic
+    /// timers when Gazebo is compiled with ENABLE_DIAGNOSTICS.
+    ///
+    /// Recording is enabled while ~/profile has subscribers, or after a
+    /// call to SetEnabled. When it's disabled, profiling a scope only
+    /// costs a push and a pop on a thread local stack.
+    class GZ_UTIL_VISIBLE ProfileManager :
+      public SingletonT<ProfileManager>
+    {
+      /// \brief Constructor
+      private: ProfileManager();
+
+      /// \brief Destructor
+      private: virtual ~ProfileManager();
+
+      /// \brief Start publishing the statistics of a world.
+      /// \param[in] _worldName Name of the world.
+      public: void Init(const std::string &_worldName);
+
+      /// \brief Stop publishing.
+      public: void Fini();
+
+      /// \brief Force recording, even without subscribers.
+      /// \param[in] _enabled True to record.
+      public: void SetEnabled(const bool _enabled);
+
+      /// \brief Get whether scopes are being recorded.
+      /// \return True if recording.
+      public: bool Enabled() const;
+
+      /// \brief Get the id of a scope, creating it if needed.
+      /// \param[in] _name Name of the scope.
+      /// \return Id of the scope.
+      public: uint32_t ScopeId(const std::string &_name);
+
+      /// \brief Get the name of a scope.
+      /// \param[in] _id Id of the scope.
+      /// \return Name of the scope, empty if the id is unknown.
+      public: std::string ScopeName(const uint32_t _id) const;
+
+      /// \brief Start timing a scope on the calling thread.
+      /// \param[in] _id Id of the scope.
+      /// \return Depth of the scope stack of the calling thread before the
+      /// scope started.
+      public: size_t Begin(const uint32_t _id);
+
+      /// \brief Stop timing the scope started last on the calling thread.
+      public: void End();
+
+      /// \brief Stop timing the scopes of the calling thread down to a
+      /// depth. Scopes above the scope at that depth are discarded, which
+      /// happens when an early return skips GZ_PROFILE_END.
+      /// \param[in] _depth Depth returned by Begin.
+      public: void End(const size_t _depth);
+
+      /// \brief Record a duration measured elsewhere, as a child of the
+      /// scope running on the calling thread.
+      /// \param[in] _id Id of the scope.
+      /// \param[in] _elapsed Duration.
+      public: void Record(const uint32_t _id, const common::Time &_elapsed);
+
+      /// \brief Drain the thread buffers into the statistics. This is done
+      /// periodically by the background thread after Init.
+      public: void Aggregate();
+
+      /// \brief Get the statistics over the rolling window.
+      /// \param[out] _msg Message to fill.
+      public: void Stats(msgs::ProfileStats &_msg);
+
+      /// \brief Clear the statistics and the pending records.
+      public: void Clear();
+
+      /// \brief Background thread, aggregating and publishing.
+      private: void Run();
+
+      // Singleton implementation
+      private: friend class SingletonT<ProfileManager>;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<ProfileManagerPrivate> dataPtr;
+    };
+
+    /// \class ProfileScope ProfileManager.hh util/util.hh
+    /// \brief Times a scope with the ProfileManager from construction to
+    /// destruction.
+    class GZ_UTIL_VISIBLE ProfileScope
+    {
+      /// \brief Constructor, starts timing.
+      /// \param[in] _id Id of the scope, from ProfileManager::ScopeId.
+      public: explicit ProfileScope(const uint32_t _id)
+        : depth(ProfileManager::Instance()->Begin(_id))
+      {
+      }
+
+      /// \brief Destructor, stops timing.
+      public: ~ProfileScope()
+      {
+        ProfileManager::Instance()->End(this->depth);
+      }
+
+      /// \brief Depth of the scope stack before this scope.
+      private: size_t depth;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_PROFILEMANAGERPRIVATE_HH_
+#define GAZEBO_UTIL_PROFILEMANAGERPRIVATE_HH_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/transport/TransportTypes.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \brief Duration of a scope, as recorded by a thread.
+    class ProfileRecord
+    {
+      /// \brief Id of the scope.
+      public: uint32_t id;
+
+      /// \brief Id of the enclosing scope, kNoScope if there is none.
+      public: uint32_t parent;
+
+      /// \brief Duration in nanoseconds.
+      public: int64_t duration;
+    };
+
+    /// \brief Single producer, single consumer ring of records. The owner
+    /// thread pushes, the aggregating thread drains.
+    class ProfileBuffer
+    {
+      /// \brief Capacity, a power of two.
+      public: static const uint64_t kCapacity = 8192;
+
+      /// \brief Constructor.
+      public: ProfileBuffer() : records(kCapacity) {}
+
+      /// \brief Add a record, dropping it if the ring is full.
+      /// \param[in] _record Record to add.
+      public: void Push(const ProfileRecord &_record)
+      {
+        const uint64_t h = this->head.load(std::memory_order_relaxed);
+        if (h - this->tail.load(std::memory_order_acquire) >= kCapacity)
+        {
+          this->dropped.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        this->records[h & (kCapacity - 1)] = _record;
+        this->head.store(h + 1, std::memory_order_release);
+      }
+
+      /// \brief Pass all the pending records to a function, and remove
+      /// them.
+      /// \param[in] _func Function called for each record.
+      public: template<typename F> void Drain(F _func)
+      {
+        uint64_t t = this->tail.load(std::memory_order_relaxed);
+        const uint64_t h = this->head.load(std::memory_order_acquire);
+        for (; t != h; ++t)
+          _func(this->records[t & (kCapacity - 1)]);
+        this->tail.store(h, std::memory_order_release);
+      }
+
+      /// \brief Records.
+      public: std::vector<ProfileRecord> records;
+
+      /// \brief Number of records pushed.
+      public: std::atomic<uint64_t> head{0};
+
+      /// \brief Number of records drained.
+      public: std::atomic<uint64_t> tail{0};
+
+      /// \brief Number of records dropped because the ring was full.
+      public: std::atomic<uint64_t> dropped{0};
+
+      /// \brief True once the owner thread exited.
+      public: std::atomic_bool exited{false};
+    };
+
+    /// \brief Histogram of durations, with four buckets per power of two
+    /// nanoseconds.
+    class ProfileHistogram
+    {
+      /// \brief Number of buckets, enough for about 18 minutes.
+      public: static const unsigned int kBuckets = 160;
+
+      /// \brief Add a duration.
+      /// \param[in] _duration Duration in nanoseconds.
+      public: void Add(const int64_t _duration);
+
+      /// \brief Add the durations of another histogram.
+      /// \param[in] _other Other histogram.
+      public: void Merge(const ProfileHistogram &_other);
+
+      /// \brief Estimate a quantile.
+      /// \param[in] _q Quantile, between 0 and 1.
+      /// \return Estimated duration in nanoseconds.
+      public: double Quantile(const double _q) const;
+
+      /// \brief Number of durations.
+      public: uint64_t count = 0;
+
+      /// \brief Sum of the durations, in nanoseconds.
+      public: double sum = 0;
+
+      /// \brief Longest duration, in nanoseconds.
+      public: int64_t max = 0;
+
+      /// \brief Number of durations in each bucket.
+      public: std::array<uint32_t, kBuckets> buckets{};
+    };
+
+    /// \brief Histograms of one slice of the rolling window, indexed by
+    /// parent id in the high bits and scope id in the low bits.
+    typedef std::unordered_map<uint64_t, ProfileHistogram> ProfileSlice;
+
+    /// \brief Private data for the ProfileManager class
+    class ProfileManagerPrivate
+    {
+      /// \brief True when SetEnabled forced recording.
+      public: std::atomic_bool forced{false};
+
+      /// \brief True when recording.
+      public: std::atomic_bool enabled{false};
+
+      /// \brief Protects the scope names.
+      public: mutable std::mutex namesMutex;
+
+      /// \brief Scope names, indexed by id.
+      public: std::vector<std::string> names;
+
+      /// \brief Scope ids, indexed by name.
+      public: std::unordered_map<std::string, uint32_t> ids;
+
+      /// \brief Protects the buffers and the statistics.
+      public: std::mutex mutex;
+
+      /// \brief Buffers of the threads that recorded scopes.
+      public: std::vector<std::shared_ptr<ProfileBuffer>> buffers;
+
+      /// \brief Ring of slices making up the rolling window.
+      public: std::vector<ProfileSlice> slices;
+
+      /// \brief Index of the wall time slice currently filled.
+      public: int64_t sliceIndex = -1;
+
+      /// \brief Records dropped by threads that exited.
+      public: uint64_t exitedDropped = 0;
+
+      /// \brief Node for publishing.
+      public: transport::NodePtr node;
+
+      /// \brief Publisher of the statistics.
+      public: transport::PublisherPtr pub;
+
+      /// \brief Background thread.
+      public: std::unique_ptr<std::thread> thread;
+
+      /// \brief Protects stop.
+      public: std::mutex runMutex;
+
+      /// \brief True to stop the background thread.
+      public: bool stop = false;
+
+      /// \brief Wakes the background thread up when stopping.
+      public: std::condition_variable condition;
+    };
+  }
+}
+#endif
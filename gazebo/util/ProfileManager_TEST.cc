@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/ProfileManager.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ProfileManagerTest : public gazebo::testing::AutoLogFixture
+{
+  // Documentation inherited
+  protected: virtual void SetUp()
+  {
+    gazebo::testing::AutoLogFixture::SetUp();
+    util::ProfileManager::Instance()->SetEnabled(true);
+    util::ProfileManager::Instance()->Clear();
+  }
+
+  // Documentation inherited
+  protected: virtual void TearDown()
+  {
+    util::ProfileManager::Instance()->SetEnabled(false);
+    gazebo::testing::AutoLogFixture::TearDown();
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Find the statistics of a scope.
+/// \param[in] _msg Statistics.
+/// \param[in] _name Scope name.
+/// \param[in] _parent Parent scope name.
+/// \return The scope statistics, null if not found.
+const msgs::ProfileStats::Scope *FindScope(const msgs::ProfileStats &_msg,
+    const std::string &_name, const std::string &_parent = "")
+{
+  for (int i = 0; i < _msg.scope_size(); ++i)
+  {
+    if (_msg.scope(i).name() == _name && _msg.scope(i).parent() == _parent)
+      return &_msg.scope(i);
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, ScopeId)
+{
+  util::ProfileManager *mgr = util::ProfileManager::Instance();
+  const uint32_t a = mgr->ScopeId("test::a");
+  const uint32_t b = mgr->ScopeId("test::b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, mgr->ScopeId("test::a"));
+  EXPECT_EQ("test::a", mgr->ScopeName(a));
+  EXPECT_EQ("test::b", mgr->ScopeName(b));
+  EXPECT_EQ("", mgr->ScopeName(1000000));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, Quantiles)
+{
+  util::ProfileManager *mgr = util::ProfileManager::Instance();
+  const uint32_t id = mgr->ScopeId("test::quantiles");
+  for (int i = 0; i < 98; ++i)
+    mgr->Record(id, common::Time(0, 1000000));
+  mgr->Record(id, common::Time(0, 100000000));
+  mgr->Record(id, common::Time(0, 200000000));
+
+  msgs::ProfileStats msg;
+  mgr->Stats(msg);
+  EXPECT_EQ(0u, msg.dropped());
+  EXPECT_GT(msgs::Convert(msg.window()), common::Time::Zero);
+
+  const msgs::ProfileStats::Scope *scope = FindScope(msg, "test::quantiles");
+  ASSERT_NE(nullptr, scope);
+  EXPECT_FALSE(scope->has_parent());
+  EXPECT_EQ(100u, scope->count());
+  EXPECT_NEAR(0.00398, scope->mean(), 1e-6);
+  EXPECT_DOUBLE_EQ(0.2, scope->max());
+
+  // Within the resolution of the histogram
+  EXPECT_NEAR(0.001, scope->p50(), 0.001 * 0.2);
+  EXPECT_NEAR(0.1, scope->p99(), 0.1 * 0.2);
+
+  mgr->Clear();
+  mgr->Stats(msg);
+  EXPECT_EQ(nullptr, FindScope(msg, "test::quantiles"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, Nested)
+{
+  {
+    GZ_PROFILE_SCOPE("test::outer");
+    for (int i = 0; i < 3; ++i)
+    {
+      GZ_PROFILE_BEGIN("test::inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      GZ_PROFILE_END();
+    }
+
+    // A scope left open by an early return is discarded by the enclosing
+    // scope
+    GZ_PROFILE_BEGIN("test::unfinished");
+  }
+
+  msgs::ProfileStats msg;
+  util::ProfileManager::Instance()->Stats(msg);
+
+  const msgs::ProfileStats::Scope *outer = FindScope(msg, "test::outer");
+  ASSERT_NE(nullptr, outer);
+  EXPECT_EQ(1u, outer->count());
+
+  const msgs::ProfileStats::Scope *inner =
+      FindScope(msg, "test::inner", "test::outer");
+  ASSERT_NE(nullptr, inner);
+  EXPECT_EQ(3u, inner->count());
+  EXPECT_GE(inner->p50(), 0.001 * 0.8);
+  EXPECT_GE(outer->max(), 3 * inner->mean());
+
+  EXPECT_EQ(nullptr, FindScope(msg, "test::inner"));
+  EXPECT_EQ(nullptr, FindScope(msg, "test::unfinished", "test::outer"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, Disabled)
+{
+  util::ProfileManager *mgr = util::ProfileManager::Instance();
+  mgr->SetEnabled(false);
+  EXPECT_FALSE(mgr->Enabled());
+  {
+    GZ_PROFILE_SCOPE("test::disabled");
+    mgr->Record(mgr->ScopeId("test::disabled_record"), common::Time(1, 0));
+
+    // Enabling while a scope runs doesn't record it
+    mgr->SetEnabled(true);
+  }
+
+  msgs::ProfileStats msg;
+  mgr->Stats(msg);
+  EXPECT_EQ(nullptr, FindScope(msg, "test::disabled"));
+  EXPECT_EQ(nullptr, FindScope(msg, "test::disabled_record"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, Threads)
+{
+  util::ProfileManager *mgr = util::ProfileManager::Instance();
+  const uint32_t id = mgr->ScopeId("test::thread");
+  const unsigned int threadCount = 4;
+  const unsigned int scopeCount = 1000;
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&]()
+        {
+          for (unsigned int j = 0; j < scopeCount; ++j)
+          {
+            util::ProfileScope scope(id);
+          }
+        });
+  }
+
+  // Aggregate while the threads record
+  msgs::ProfileStats msg;
+  for (int i = 0; i < 10; ++i)
+    mgr->Aggregate();
+  for (auto &thread : threads)
+    thread.join();
+
+  mgr->Stats(msg);
+  const msgs::ProfileStats::Scope *scope = FindScope(msg, "test::thread");
+  ASSERT_NE(nullptr, scope);
+  EXPECT_EQ(threadCount * scopeCount, scope->count() + msg.dropped());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ProfileManagerTest, Overflow)
+{
+  // Records are dropped, and counted, when the buffer is full
+  util::ProfileManager *mgr = util::ProfileManager::Instance();
+  const uint32_t id = mgr->ScopeId("test::overflow");
+  const unsigned int count = 20000;
+  for (unsigned int i = 0; i < count; ++i)
+    mgr->Record(id, common::Time(0, 1000));
+
+  msgs::ProfileStats msg;
+  mgr->Stats(msg);
+  const msgs::ProfileStats::Scope *scope = FindScope(msg, "test::overflow");
+  ASSERT_NE(nullptr, scope);
+  EXPECT_LT(scope->count(), count);
+  EXPECT_EQ(count, scope->count() + msg.dropped());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,19 +15,191 @@
  *
 */
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "ignition/common/Profiler.hh"
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "plugins/BuoyancyPlugin.hh"
 
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(BuoyancyPlugin)
 
+/// \brief Number of segments around the axis of tessellated spheres and
+/// cylinders.
+static const unsigned int kHullSegments = 16;
+
+/// \brief Number of rings between the poles of tessellated spheres.
+static const unsigned int kHullRings = 8;
+
+/////////////////////////////////////////////////
+/// \brief Compute the volume enclosed by a closed triangle mesh, and its
+/// center, as a sum of signed tetrahedra with apex at a reference point.
+/// \param[in] _vertices Mesh vertices.
+/// \param[in] _indices Vertex indices, three per triangle.
+/// \param[out] _center Center of volume.
+/// \return Enclosed volume.
+static double EnclosedVolume(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices,
+    ignition::math::Vector3d &_center)
+{
+  double volume = 0;
+  ignition::math::Vector3d moment = ignition::math::Vector3d::Zero;
+  for (size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    const ignition::math::Vector3d &a = _vertices[_indices[i]];
+    const ignition::math::Vector3d &b = _vertices[_indices[i + 1]];
+    const ignition::math::Vector3d &c = _vertices[_indices[i + 2]];
+    const double v = a.Dot(b.Cross(c)) / 6.0;
+    volume += v;
+    moment += v * (a + b + c) / 4.0;
+  }
+
+  _center = std::fabs(volume) > 1e-12 ?
+      moment / volume : ignition::math::Vector3d::Zero;
+  return volume;
+}
+
+/////////////////////////////////////////////////
+/// \brief Scale, transform and append triangles to a hull.
+/// \param[in] _vertices Vertices in the shape frame.
+/// \param[in] _indices Vertex indices, three per triangle.
+/// \param[in] _scale Scale applied to the vertices.
+/// \param[in] _pose Pose of the shape in the link frame.
+/// \param[in,out] _hull Hull to append to.
+static void AppendTriangles(
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices,
+    const ignition::math::Vector3d &_scale,
+    const ignition::math::Pose3d &_pose, BuoyancyHull &_hull)
+{
+  const unsigned int offset = _hull.vertices.size();
+  for (const auto &v : _vertices)
+    _hull.vertices.push_back(_pose.CoordPositionAdd(v * _scale));
+  for (const auto &i : _indices)
+    _hull.indices.push_back(i + offset);
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a quad as two triangles.
+static void AddQuad(std::vector<unsigned int> &_indices, const unsigned int _a,
+    const unsigned int _b, const unsigned int _c, const unsigned int _d)
+{
+  _indices.insert(_indices.end(), {_a, _b, _c, _a, _c, _d});
+}
+
+/////////////////////////////////////////////////
+/// \brief Tessellate a box centered at the origin.
+static void BoxHull(const ignition::math::Vector3d &_size,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    _vertices.push_back(ignition::math::Vector3d(
+        (i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5) *
+        _size);
+  }
+
+  AddQuad(_indices, 0, 2, 3, 1);
+  AddQuad(_indices, 4, 5, 7, 6);
+  AddQuad(_indices, 0, 1, 5, 4);
+  AddQuad(_indices, 2, 6, 7, 3);
+  AddQuad(_indices, 0, 4, 6, 2);
+  AddQuad(_indices, 1, 3, 7, 5);
+}
+
+/////////////////////////////////////////////////
+/// \brief Tessellate a sphere centered at the origin. The vertices are
+/// scaled so that the enclosed volume matches the sphere.
+static void SphereHull(const double _radius,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int s = kHullSegments;
+  _vertices.push_back(ignition::math::Vector3d::UnitZ);
+  for (unsigned int r = 1; r < kHullRings; ++r)
+  {
+    const double theta = IGN_PI * r / kHullRings;
+    for (unsigned int i = 0; i < s; ++i)
+    {
+      const double phi = 2 * IGN_PI * i / s;
+      _vertices.push_back(ignition::math::Vector3d(
+          std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+          std::cos(theta)));
+    }
+  }
+  _vertices.push_back(-ignition::math::Vector3d::UnitZ);
+
+  const unsigned int south = _vertices.size() - 1;
+  const unsigned int last = 1 + (kHullRings - 2) * s;
+  for (unsigned int i = 0; i < s; ++i)
+  {
+    const unsigned int next = (i + 1) % s;
+    _indices.insert(_indices.end(), {0, 1 + i, 1 + next});
+    for (unsigned int r = 0; r + 2 < kHullRings; ++r)
+    {
+      const unsigned int ring = 1 + r * s;
+      AddQuad(_indices, ring + i, ring + s + i, ring + s + next, ring + next);
+    }
+    _indices.insert(_indices.end(), {south, last + next, last + i});
+  }
+
+  ignition::math::Vector3d center;
+  const double scale = _radius * std::cbrt(4.0 / 3.0 * IGN_PI /
+      EnclosedVolume(_vertices, _indices, center));
+  for (auto &v : _vertices)
+    v *= scale;
+}
+
+/////////////////////////////////////////////////
+/// \brief Tessellate a cylinder centered at the origin and aligned with
+/// the Z axis. The radius is scaled so that the enclosed volume matches the
+/// cylinder.
+static void CylinderHull(const double _radius, const double _length,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int s = kHullSegments;
+  const double area = 0.5 * s * std::sin(2 * IGN_PI / s);
+  const double radius = _radius * std::sqrt(IGN_PI / area);
+
+  _vertices.push_back(ignition::math::Vector3d(0, 0, -0.5 * _length));
+  _vertices.push_back(ignition::math::Vector3d(0, 0, 0.5 * _length));
+  for (unsigned int i = 0; i < s; ++i)
+  {
+    const double phi = 2 * IGN_PI * i / s;
+    const double x = radius * std::cos(phi);
+    const double y = radius * std::sin(phi);
+    _vertices.push_back(ignition::math::Vector3d(x, y, -0.5 * _length));
+    _vertices.push_back(ignition::math::Vector3d(x, y, 0.5 * _length));
+  }
+
+  for (unsigned int i = 0; i < s; ++i)
+  {
+    const unsigned int bottom = 2 + 2 * i;
+    const unsigned int next = 2 + 2 * ((i + 1) % s);
+    _indices.insert(_indices.end(), {0, next, bottom});
+    _indices.insert(_indices.end(), {1, bottom + 1, next + 1});
+    AddQuad(_indices, bottom, next, next + 1, bottom + 1);
+  }
+}
+
 /////////////////////////////////////////////////
 BuoyancyPlugin::BuoyancyPlugin()
   // Density of liquid water at 1 atm pressure and 15 degrees Celsius.
-  : fluidDensity(999.1026)
+  : fluidDensity(999.1026), partialSubmersion(false), fluidLevel(0)
 {
 }
 
@@ -47,6 +219,12 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     this->fluidDensity = this->sdf->Get<double>("fluid_density");
   }
 
+  if (this->sdf->HasElement("fluid_level"))
+  {
+    this->partialSubmersion = true;
+    this->fluidLevel = this->sdf->Get<double>("fluid_level");
+  }
+
   // Get "center of volume" and "volume" that were inputted in SDF
   // SDF input is recommended for mesh or polylines collision shapes
   if (this->sdf->HasElement("link"))
@@ -118,6 +296,11 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     }
   }
 
+  // Links with user specified properties
+  std::set<int> userLinks;
+  for (auto const &props : this->volPropsMap)
+    userLinks.insert(props.first);
+
   // For links the user didn't input, precompute the center of volume and
   // density. This will be accurate for simple shapes.
   for (auto link : this->model->GetLinks())
@@ -142,6 +325,227 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       this->volPropsMap[id].volume = volumeSum;
     }
   }
+
+  if (!this->partialSubmersion)
+    return;
+
+  // Precompute the hull of each link. The volume properties of links
+  // without user input are replaced by those of the hull, which are more
+  // accurate for meshes.
+  this->hulls.clear();
+  for (auto link : this->model->GetLinks())
+  {
+    const int id = link->GetId();
+    VolumeProperties &props = this->volPropsMap[id];
+
+    BuoyancyHull hull;
+    hull.link = link;
+    if (this->BuildHull(link, hull))
+    {
+      ignition::math::Vector3d center;
+      const double volume = EnclosedVolume(hull.vertices, hull.indices,
+          center);
+      if (volume <= 0)
+      {
+        gzwarn << "Hull of link [" << link->GetName() << "] has a "
+               << "nonpositive volume, treating it as fully submerged"
+               << std::endl;
+        hull.vertices.clear();
+        hull.indices.clear();
+      }
+      else if (userLinks.count(id))
+      {
+        hull.volumeScale = props.volume / volume;
+      }
+      else
+      {
+        props.volume = volume;
+        props.cov = center;
+      }
+    }
+    else
+    {
+      gzwarn << "Link [" << link->GetName() << "] has no collision shape "
+             << "usable for partial submersion, treating it as fully "
+             << "submerged" << std::endl;
+    }
+
+    hull.depths.resize(hull.vertices.size());
+    hull.submerged = props;
+    this->hulls.push_back(hull);
+  }
+}
+
+/////////////////////////////////////////////////
+bool BuoyancyPlugin::BuildHull(const physics::LinkPtr &_link,
+    BuoyancyHull &_hull) const
+{
+  for (auto collision : _link->GetCollisions())
+  {
+    physics::ShapePtr shape = collision->GetShape();
+    const ignition::math::Pose3d pose = collision->RelativePose();
+    std::vector<ignition::math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+
+    if (shape->HasType(physics::Base::BOX_SHAPE))
+    {
+      BoxHull(boost::dynamic_pointer_cast<physics::BoxShape>(shape)->Size(),
+          vertices, indices);
+      AppendTriangles(vertices, indices, ignition::math::Vector3d::One, pose,
+          _hull);
+    }
+    else if (shape->HasType(physics::Base::SPHERE_SHAPE))
+    {
+      SphereHull(
+          boost::dynamic_pointer_cast<physics::SphereShape>(shape)->GetRadius(),
+          vertices, indices);
+      AppendTriangles(vertices, indices, ignition::math::Vector3d::One, pose,
+          _hull);
+    }
+    else if (shape->HasType(physics::Base::CYLINDER_SHAPE))
+    {
+      physics::CylinderShapePtr cylinder =
+          boost::dynamic_pointer_cast<physics::CylinderShape>(shape);
+      CylinderHull(cylinder->GetRadius(), cylinder->GetLength(), vertices,
+          indices);
+      AppendTriangles(vertices, indices, ignition::math::Vector3d::One, pose,
+          _hull);
+    }
+    else if (shape->HasType(physics::Base::MESH_SHAPE))
+    {
+      physics::MeshShapePtr meshShape =
+          boost::dynamic_pointer_cast<physics::MeshShape>(shape);
+
+      common::MeshManager *meshManager = common::MeshManager::Instance();
+      const common::Mesh *mesh = meshManager->GetMesh(meshShape->GetMeshURI());
+      if (!mesh)
+      {
+        const std::string filename = common::find_file(
+            meshShape->GetMeshURI());
+        if (!filename.empty())
+          mesh = meshManager->Load(filename);
+      }
+      if (!mesh)
+      {
+        gzwarn << "Unable to load mesh [" << meshShape->GetMeshURI()
+               << "] of link [" << _link->GetName() << "]" << std::endl;
+        continue;
+      }
+
+      for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+      {
+        const common::SubMesh *subMesh = mesh->GetSubMesh(i);
+        if (subMesh->GetPrimitiveType() != common::SubMesh::TRIANGLES)
+          continue;
+
+        vertices.clear();
+        indices.clear();
+        for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+          vertices.push_back(subMesh->Vertex(v));
+        for (unsigned int v = 0; v < subMesh->GetIndexCount(); ++v)
+          indices.push_back(subMesh->GetIndex(v));
+        AppendTriangles(vertices, indices, meshShape->Size(), pose, _hull);
+      }
+    }
+  }
+
+  return !_hull.indices.empty();
+}
+
+/////////////////////////////////////////////////
+void BuoyancyPlugin::UpdateSubmerged(BuoyancyHull &_hull) const
+{
+  // Hulls without vertices keep their full volume
+  if (_hull.vertices.empty())
+    return;
+
+  // Express the fluid surface in the link frame rather than transforming
+  // every vertex to the world frame.
+  const ignition::math::Pose3d pose = _hull.link->WorldPose();
+  const ignition::math::Vector3d up =
+      pose.Rot().RotateVectorReverse(ignition::math::Vector3d::UnitZ);
+  const double level = this->fluidLevel - pose.Pos().Z();
+
+  bool submerged = false;
+  for (size_t i = 0; i < _hull.vertices.size(); ++i)
+  {
+    _hull.depths[i] = level - up.Dot(_hull.vertices[i]);
+    submerged = submerged || _hull.depths[i] > 0;
+  }
+
+  if (!submerged)
+  {
+    _hull.submerged.volume = 0;
+    return;
+  }
+
+  // Sum the signed tetrahedra of the clipped triangles with apex on the
+  // surface. The cap closing the clipped hull lies on the surface and adds
+  // no volume, so it doesn't need to be built.
+  const ignition::math::Vector3d apex = up * level;
+  double volume = 0;
+  ignition::math::Vector3d moment = ignition::math::Vector3d::Zero;
+  auto addTriangle = [&](const ignition::math::Vector3d &_a,
+      const ignition::math::Vector3d &_b, const ignition::math::Vector3d &_c)
+  {
+    const ignition::math::Vector3d a = _a - apex;
+    const ignition::math::Vector3d b = _b - apex;
+    const ignition::math::Vector3d c = _c - apex;
+    const double v = a.Dot(b.Cross(c)) / 6.0;
+    volume += v;
+    moment += v * (a + b + c) / 4.0;
+  };
+
+  for (size_t t = 0; t + 2 < _hull.indices.size(); t += 3)
+  {
+    const ignition::math::Vector3d *p[3];
+    double d[3];
+    unsigned int count = 0;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      p[k] = &_hull.vertices[_hull.indices[t + k]];
+      d[k] = _hull.depths[_hull.indices[t + k]];
+      count += d[k] > 0 ? 1 : 0;
+    }
+
+    if (count == 0)
+      continue;
+    if (count == 3)
+    {
+      addTriangle(*p[0], *p[1], *p[2]);
+      continue;
+    }
+
+    // Rotate the vertices, keeping the winding, so that the first vertex is
+    // the only submerged one, or the last vertex is the only dry one.
+    for (unsigned int k = 0; k < 2; ++k)
+    {
+      if ((count == 1 && d[0] > 0) || (count == 2 && d[2] <= 0))
+        break;
+      std::swap(p[0], p[1]);
+      std::swap(p[1], p[2]);
+      std::swap(d[0], d[1]);
+      std::swap(d[1], d[2]);
+    }
+
+    const ignition::math::Vector3d &a = *p[0];
+    const ignition::math::Vector3d &b = *p[1];
+    const ignition::math::Vector3d &c = *p[2];
+    if (count == 1)
+    {
+      addTriangle(a, a + (b - a) * (d[0] / (d[0] - d[1])),
+          a + (c - a) * (d[0] / (d[0] - d[2])));
+    }
+    else
+    {
+      const ignition::math::Vector3d bc = b + (c - b) * (d[1] / (d[1] - d[2]));
+      addTriangle(a, b, bc);
+      addTriangle(a, bc, a + (c - a) * (d[0] / (d[0] - d[2])));
+    }
+  }
+
+  _hull.submerged.volume = volume * _hull.volumeScale;
+  _hull.submerged.cov = volume > 1e-12 ? apex + moment / volume : apex;
 }
 
 /////////////////////////////////////////////////
@@ -156,6 +560,33 @@ void BuoyancyPlugin::OnUpdate()
 {
   IGN_PROFILE("BuoyancyPlugin::OnUpdate");
   IGN_PROFILE_BEGIN("Update");
+  if (this->partialSubmersion)
+  {
+    // Clip the hulls in parallel, then apply the forces serially.
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, this->hulls.size()),
+        [this](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            this->UpdateSubmerged(this->hulls[i]);
+        });
+
+    const ignition::math::Vector3d gravity =
+        this->model->GetWorld()->Gravity();
+    for (auto const &hull : this->hulls)
+    {
+      if (hull.submerged.volume <= 0)
+        continue;
+
+      ignition::math::Vector3d buoyancy =
+          -this->fluidDensity * hull.submerged.volume * gravity;
+      ignition::math::Vector3d buoyancyLinkFrame =
+          hull.link->WorldPose().Rot().Inverse().RotateVector(buoyancy);
+      hull.link->AddLinkForce(buoyancyLinkFrame, hull.submerged.cov);
+    }
+    IGN_PROFILE_END();
+    return;
+  }
+
   for (auto link : this->model->GetLinks())
   {
     VolumeProperties volumeProperties = this->volPropsMap[link->GetId()];
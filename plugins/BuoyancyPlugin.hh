@@ -19,6 +19,7 @@
 #define GAZEBO_PLUGINS_BUOYANCYPLUGIN_HH_
 
 #include <map>
+#include <vector>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/Event.hh"
@@ -40,6 +41,34 @@ namespace gazebo
     public: double volume;
   };
 
+  /// \brief A closed triangle mesh approximating the collision shapes of a
+  /// link, used to compute the submerged part of the link when the fluid has
+  /// a free surface.
+  class BuoyancyHull
+  {
+    /// \brief Link this hull belongs to.
+    public: physics::LinkPtr link;
+
+    /// \brief Hull vertices in the link frame.
+    public: std::vector<ignition::math::Vector3d> vertices;
+
+    /// \brief Vertex indices, three per triangle. Triangles are wound
+    /// counter-clockwise when seen from outside of the hull.
+    public: std::vector<unsigned int> indices;
+
+    /// \brief Depth of each vertex below the fluid surface. Preallocated so
+    /// that updates don't allocate memory.
+    public: std::vector<double> depths;
+
+    /// \brief Ratio between the link volume and the volume enclosed by the
+    /// hull, used to correct tessellation errors and user specified volumes.
+    public: double volumeScale = 1.0;
+
+    /// \brief Submerged volume and its center in the link frame, computed on
+    /// every update.
+    public: VolumeProperties submerged;
+  };
+
   /// \brief A plugin that simulates buoyancy of an object immersed in fluid.
   /// All SDF parameters are optional.
   /// <fluid_density> sets the density of the fluid that surrounds the buoyant
@@ -57,6 +86,12 @@ namespace gazebo
   /// to compute these properties from the link collision shapes. This
   /// computation will not be accurate if the object is not composed of simple
   /// collision shapes.
+  /// <fluid_level> sets the height of the fluid surface along the world Z
+  /// axis and enables partial submersion. Buoyancy is then computed from the
+  /// part of each link that lies below the surface, by clipping a hull built
+  /// from the box, sphere, cylinder and mesh collisions of the link. Meshes
+  /// must be closed. When a link has a <volume>, the hull is scaled to match
+  /// it. Links without supported shapes are treated as fully submerged.
   class GZ_PLUGIN_VISIBLE BuoyancyPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -72,6 +107,17 @@ namespace gazebo
     /// \brief Callback for World Update events.
     protected: virtual void OnUpdate();
 
+    /// \brief Build the hull of a link from its collision shapes.
+    /// \param[in] _link Link to build the hull of.
+    /// \param[out] _hull Hull in the link frame.
+    /// \return False if the link has no shape that can be tessellated.
+    protected: bool BuildHull(const physics::LinkPtr &_link,
+                   BuoyancyHull &_hull) const;
+
+    /// \brief Compute the submerged volume of a hull and its center.
+    /// \param[in,out] _hull Hull to update.
+    protected: void UpdateSubmerged(BuoyancyHull &_hull) const;
+
     /// \brief Connection to World Update events.
     protected: event::ConnectionPtr updateConnection;
 
@@ -88,6 +134,15 @@ namespace gazebo
     /// \brief Map of <link ID, point> pairs mapping link IDs to the CoV (center
     /// of volume) and volume of the link.
     protected: std::map<int, VolumeProperties> volPropsMap;
+
+    /// \brief True if the fluid has a free surface at fluidLevel.
+    protected: bool partialSubmersion;
+
+    /// \brief Height of the fluid surface along the world Z axis.
+    protected: double fluidLevel;
+
+    /// \brief Hulls of the links, used with partial submersion.
+    protected: std::vector<BuoyancyHull> hulls;
   };
 }
 
@@ -16,13 +16,17 @@
 */
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Events.hh"
 
+#include "gazebo/physics/WindField.hh"
 #include "gazebo/sensors/Noise.hh"
 
 #include "plugins/WindPlugin.hh"
@@ -86,6 +90,27 @@ class gazebo::WindPluginPrivate
 
   /// \brief The scaling factor to approximate wind as force on a mass.
   public: double forceApproximationScalingFactor = 0;
+
+  /// \brief Connection to add entity events.
+  public: event::ConnectionPtr addEntityConnection;
+
+  /// \brief Connection to wind mode changed events.
+  public: event::ConnectionPtr windModeConnection;
+
+  /// \brief Wind enabled links of all models, cached between updates.
+  public: physics::Link_V links;
+
+  /// \brief World positions of the cached links, reused every update.
+  public: std::vector<ignition::math::Vector3d> positions;
+
+  /// \brief Wind field velocities at the cached links, reused every update.
+  public: std::vector<ignition::math::Vector3d> fieldVels;
+
+  /// \brief Number of models when links was built.
+  public: unsigned int cachedModelCount = 0;
+
+  /// \brief True if links needs to be rebuilt.
+  public: bool linksDirty = true;
 };
 
 
@@ -196,6 +221,52 @@ void WindPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
     }
   }
 
+  if (_sdf->HasElement("field"))
+  {
+    sdf::ElementPtr sdfField = _sdf->GetElement("field");
+    physics::WindFieldPtr field(new physics::WindField());
+    bool loaded = false;
+
+    if (sdfField->HasElement("uri"))
+    {
+      std::string uri = sdfField->Get<std::string>("uri");
+      std::string filename = common::find_file(uri);
+      if (filename.empty())
+        gzerr << "Unable to find wind field file[" << uri << "]\n";
+      else
+        loaded = field->Load(filename);
+    }
+    else if (sdfField->HasElement("turbulence"))
+    {
+      sdf::ElementPtr sdfTurb = sdfField->GetElement("turbulence");
+      auto param = [&sdfTurb](const std::string &_name, const double _default)
+      {
+        return sdfTurb->HasElement(_name) ?
+          sdfTurb->Get<double>(_name) : _default;
+      };
+
+      ignition::math::Vector3d min(-50, -50, 0);
+      ignition::math::Vector3d max(50, 50, 50);
+      if (sdfTurb->HasElement("min"))
+        min = sdfTurb->Get<ignition::math::Vector3d>("min");
+      if (sdfTurb->HasElement("max"))
+        max = sdfTurb->Get<ignition::math::Vector3d>("max");
+
+      loaded = field->GenerateTurbulence(min, max,
+          param("resolution", 1.0), param("intensity", 1.0),
+          param("length_scale", 10.0),
+          static_cast<unsigned int>(param("modes", 64)),
+          static_cast<unsigned int>(param("seed", 0)));
+    }
+    else
+    {
+      gzerr << "<field> requires either <uri> or <turbulence>\n";
+    }
+
+    if (loaded)
+      wind.SetField(field);
+  }
+
   if (_sdf->HasElement("force_approximation_scaling_factor"))
   {
     sdf::ElementPtr sdfForceApprox =
@@ -227,6 +298,18 @@ void WindPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
           std::bind(&WindPlugin::OnUpdate, this));
+
+  this->dataPtr->addEntityConnection = event::Events::ConnectAddEntity(
+      [this](const std::string &)
+      {
+        this->dataPtr->linksDirty = true;
+      });
+
+  this->dataPtr->windModeConnection = event::Events::ConnectWindModeChanged(
+      [this](const std::string &)
+      {
+        this->dataPtr->linksDirty = true;
+      });
 }
 
 /////////////////////////////////////////////////
@@ -298,27 +381,60 @@ void WindPlugin::OnUpdate()
   // Update loop for using the force on mass approximation
   // This is not recommended. Please use the LiftDragPlugin instead.
 
-  // Get all the models
-  physics::Model_V models = this->dataPtr->world->Models();
+  // Rebuild the link cache when models were added or removed, or when the
+  // wind mode of a link changed, instead of copying the model and link lists
+  // every step.
+  if (this->dataPtr->linksDirty ||
+      this->dataPtr->cachedModelCount != this->dataPtr->world->ModelCount())
+  {
+    this->dataPtr->links.clear();
+    for (auto const &model : this->dataPtr->world->Models())
+    {
+      for (auto const &link : model->GetLinks())
+      {
+        if (link->WindMode())
+          this->dataPtr->links.push_back(link);
+      }
+    }
+    this->dataPtr->cachedModelCount = this->dataPtr->world->ModelCount();
+    this->dataPtr->linksDirty = false;
+  }
 
-  // Process each model.
-  for (auto const &model : models)
+  if (this->dataPtr->links.empty())
   {
-    // Get all the links
-    physics::Link_V links = model->GetLinks();
+    IGN_PROFILE_END();
+    return;
+  }
 
-    // Process each link.
-    for (auto const &link : links)
+  // Sample the wind field at all the links in one call
+  physics::WindFieldPtr field = this->dataPtr->world->Wind().Field();
+  if (field)
+  {
+    this->dataPtr->positions.resize(this->dataPtr->links.size());
+    for (size_t i = 0; i < this->dataPtr->links.size(); ++i)
     {
-      // Skip links for which the wind is disabled
-      if (!link->WindMode())
-        continue;
-
-      // Add wind velocity as a force to the body
-      link->AddRelativeForce(link->GetInertial()->Mass() *
-          this->dataPtr->forceApproximationScalingFactor *
-          (link->RelativeWindLinearVel() - link->RelativeLinearVel()));
+      this->dataPtr->positions[i] =
+          this->dataPtr->links[i]->WorldPose().Pos();
     }
+    field->Velocities(this->dataPtr->positions, this->dataPtr->fieldVels);
+  }
+
+  // Process each link.
+  for (size_t i = 0; i < this->dataPtr->links.size(); ++i)
+  {
+    const physics::LinkPtr &link = this->dataPtr->links[i];
+
+    // The wind velocity of the link was computed by LinearVel during the
+    // link update, the field is added here
+    ignition::math::Vector3d linkWindVel = link->WorldWindLinearVel();
+    if (field)
+      linkWindVel += this->dataPtr->fieldVels[i];
+
+    // Add wind velocity as a force to the body
+    link->AddRelativeForce(link->GetInertial()->Mass() *
+        this->dataPtr->forceApproximationScalingFactor *
+        (link->WorldPose().Rot().RotateVectorReverse(linkWindVel) -
+         link->RelativeLinearVel()));
   }
   IGN_PROFILE_END();
 }
@@ -45,6 +45,12 @@ namespace gazebo
   //
   // - Vertical amplitude:
   //      Noise proportionnal to wind magnitude.
+  //
+  // An optional <field> element adds a spatially varying component on top
+  // of the uniform model, either loaded from a file with <uri> or generated
+  // as synthetic turbulence with <turbulence>. See physics::WindField.
+  // The field is sampled for all wind enabled links in one batch per step
+  // and only enters the force approximation.
   class GZ_PLUGIN_VISIBLE WindPlugin : public WorldPlugin
   {
     /// \brief Constructor.
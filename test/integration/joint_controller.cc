@@ -173,6 +173,45 @@ TEST_F(JointControllerTest, JointCmd)
   EXPECT_DOUBLE_EQ(velPids[jointName].GetDGain(), 9);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, GroupPositionControl)
+{
+  Load("worlds/simple_arm_test.world", true);
+  gazebo::physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  gazebo::physics::ModelPtr model = world->ModelByName("simple_arm");
+  gazebo::physics::JointControllerPtr jointController =
+    model->GetJointController();
+
+  const std::string jointName = "simple_arm::arm_shoulder_pan_joint";
+  gazebo::physics::JointPtr joint =
+    model->GetJoint("arm_shoulder_pan_joint");
+  ASSERT_TRUE(joint != NULL);
+  jointController->SetPositionPID(jointName, common::PID(10, 0.1, 4.5));
+
+  // Control the joint by name
+  world->Step(1);
+  EXPECT_TRUE(jointController->SetPositionTarget(jointName, 1.0));
+  world->Step(5000);
+  const double byName = joint->Position(0);
+  EXPECT_NEAR(byName, 1.0, 0.1);
+
+  // Start over, and control the joint in a group
+  world->Reset();
+  jointController->Reset();
+  EXPECT_TRUE(jointController->GetPositions().empty());
+
+  const int group = jointController->CreateGroup({jointName},
+      physics::JointController::POSITION);
+  ASSERT_EQ(group, 0);
+  world->Step(1);
+  EXPECT_TRUE(jointController->SetCommands(group, {1.0}));
+  world->Step(5000);
+
+  // The PID controllers of the group compute the same forces
+  EXPECT_NEAR(joint->Position(0), byName, 1e-4);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
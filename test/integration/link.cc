@@ -91,6 +91,50 @@ TEST_F(LinkTest, StaticWrench)
   EXPECT_EQ(model0->WorldPose(), model0Initial);
 }
 
+/////////////////////////////////////////////////
+// This tests that a link without batteries, audio or wind applies the
+// wrenches it receives once
+TEST_F(LinkTest, QueuedWrenches)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 10));
+  auto model = this->GetModel("box");
+  ASSERT_TRUE(model != nullptr);
+  auto link = model->GetLink("link");
+  ASSERT_TRUE(link != nullptr);
+  EXPECT_FALSE(link->WindMode());
+
+  std::string topicName = "~/" + link->GetScopedName() + "/wrench";
+  boost::replace_all(topicName, "::", "/");
+  auto wrenchPub = this->node->Advertise<msgs::Wrench>(topicName);
+  wrenchPub->WaitForConnection();
+
+  // Several wrenches received during a step add up
+  const unsigned int wrenchCount = 4;
+  msgs::Wrench msg;
+  msgs::Set(msg.mutable_force(), ignition::math::Vector3d(1, 0, 0));
+  msgs::Set(msg.mutable_torque(), ignition::math::Vector3d::Zero);
+  for (unsigned int i = 0; i < wrenchCount; ++i)
+    wrenchPub->Publish(msg);
+  common::Time::MSleep(500);
+
+  world->Step(1);
+  const double dt = world->Physics()->GetMaxStepSize();
+  const double mass = link->GetInertial()->Mass();
+  const double vel = link->WorldLinearVel().X();
+  EXPECT_NEAR(wrenchCount * dt / mass, vel, 1e-6);
+
+  // And are only applied once
+  world->Step(10);
+  EXPECT_NEAR(vel, link->WorldLinearVel().X(), 1e-6);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -40,6 +40,7 @@ int g_latchCreatedAfterPub = 0;
 int g_latchCreatedAfterPub2 = 0;
 int g_subBeforeClear = 0;
 int g_subAfterClear = 0;
+int g_policyMsgs = 0;
 
 void ReceiveBeforeClear(ConstVector3dPtr &/*_msg*/)
 {
@@ -51,6 +52,11 @@ void ReceiveAfterClear(ConstVector3dPtr &/*_msg*/)
   g_subAfterClear++;
 }
 
+void ReceivePolicyMsg(ConstVector3dPtr &/*_msg*/)
+{
+  g_policyMsgs++;
+}
+
 void ReceiveNoLatchCreatedAfterPub(ConstVector3dPtr &/*_msg*/)
 {
   g_noLatchCreatedAfterPub++;
@@ -766,6 +772,137 @@ TEST_F(TransportTest, Errors)
   testNode.reset();
 }
 
+/////////////////////////////////////////////////
+/// \brief Wait until a number of policy test messages are received.
+/// \param[in] _count Number of messages to wait for.
+void WaitForPolicyMsgs(const int _count)
+{
+  for (int i = 0; i < 100 && g_policyMsgs < _count; ++i)
+    common::Time::MSleep(10);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, BatchPolicy)
+{
+  Load("worlds/empty.world");
+  g_policyMsgs = 0;
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("~/policy",
+      &ReceivePolicyMsg);
+  transport::PublisherPtr pub = node->Advertise<msgs::Vector3d>("~/policy");
+
+  EXPECT_EQ(transport::PublishPolicy::QUEUE, pub->Policy());
+  pub->SetPolicy(transport::PublishPolicy::BATCH, 5);
+  pub->SetCountBytes(true);
+  EXPECT_EQ(transport::PublishPolicy::BATCH, pub->Policy());
+  EXPECT_EQ(5u, pub->BatchSize());
+
+  msgs::Vector3d msg = msgs::Convert(ignition::math::Vector3d(1, 2, 3));
+
+  // Incomplete batches are held back
+  for (int i = 0; i < 4; ++i)
+    pub->Publish(msg);
+  common::Time::MSleep(300);
+  EXPECT_EQ(0, g_policyMsgs);
+  EXPECT_EQ(4u, pub->GetOutgoingCount());
+  EXPECT_EQ(0u, pub->SentCount());
+
+  // Completing the batch sends it
+  pub->Publish(msg);
+  WaitForPolicyMsgs(5);
+  EXPECT_EQ(5, g_policyMsgs);
+
+  // Flush sends an incomplete batch
+  pub->Publish(msg);
+  pub->Publish(msg);
+  pub->Flush();
+  WaitForPolicyMsgs(7);
+  EXPECT_EQ(7, g_policyMsgs);
+
+  EXPECT_EQ(7u, pub->SentCount());
+  EXPECT_EQ(0u, pub->DroppedCount());
+  EXPECT_GT(pub->SentBytes(), 0u);
+
+  // The batch size can't exceed the queue limit
+  transport::PublisherPtr smallPub =
+      node->Advertise<msgs::Vector3d>("~/policy_small", 3);
+  smallPub->SetPolicy(transport::PublishPolicy::BATCH, 10);
+  EXPECT_EQ(3u, smallPub->BatchSize());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, LatestPolicy)
+{
+  Load("worlds/empty.world");
+  g_policyMsgs = 0;
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("~/policy",
+      &ReceivePolicyMsg);
+  transport::PublisherPtr pub = node->Advertise<msgs::Vector3d>("~/policy");
+  pub->SetPolicy(transport::PublishPolicy::LATEST);
+
+  msgs::Vector3d msg = msgs::Convert(ignition::math::Vector3d(1, 2, 3));
+  const unsigned int count = 1000;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    pub->Publish(msg);
+    EXPECT_LE(pub->GetOutgoingCount(), 1u);
+  }
+  pub->Flush();
+
+  for (int i = 0; i < 100 && pub->SentCount() + pub->DroppedCount() < count;
+      ++i)
+  {
+    common::Time::MSleep(10);
+  }
+
+  // Every message is either sent or replaced by a newer one
+  EXPECT_EQ(count, pub->SentCount() + pub->DroppedCount());
+  EXPECT_GT(pub->SentCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportTest, RateClock)
+{
+  Load("worlds/empty.world");
+  g_policyMsgs = 0;
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("~/policy",
+      &ReceivePolicyMsg);
+
+  // 10 Hz, throttled with a clock controlled by the test
+  transport::PublisherPtr pub =
+      node->Advertise<msgs::Vector3d>("~/policy", 100, 10);
+  common::Time simTime(1, 0);
+  pub->SetRateClock([&simTime]() { return simTime; });
+
+  msgs::Vector3d msg = msgs::Convert(ignition::math::Vector3d(1, 2, 3));
+
+  // 1 second of a 1 kHz stream, however long it takes in wall time
+  for (int i = 0; i < 1000; ++i)
+  {
+    pub->Publish(msg);
+    simTime += common::Time(0, 1000000);
+  }
+  WaitForPolicyMsgs(10);
+  EXPECT_EQ(10, g_policyMsgs);
+  EXPECT_EQ(990u, pub->DroppedCount());
+
+  // A clock going backwards restarts the throttling
+  simTime = common::Time(0, 500000000);
+  pub->Publish(msg);
+  WaitForPolicyMsgs(11);
+  EXPECT_EQ(11, g_policyMsgs);
+
+  pub->SetRateClock(nullptr);
+}
+
 /////////////////////////////////////////////////
 TEST_F(TransportTest, TryInit)
 {
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/physics.hh"
@@ -500,6 +505,108 @@ TEST_F(WorldTest, RemoveModelUnPaused)
   EXPECT_FALSE(boxModel != NULL);
 }
 
+/// \brief Packed pose messages received.
+std::vector<msgs::PackedPoses> g_packedPoses;
+
+/// \brief Mutex protecting g_packedPoses.
+std::mutex g_packedPosesMutex;
+
+/// \brief Callback for packed pose messages.
+/// \param[in] _msg Packed poses.
+void onPackedPoses(ConstPackedPosesPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_packedPosesMutex);
+  g_packedPoses.push_back(*_msg);
+}
+
+/// \brief Wait for a packed pose message that matches a predicate.
+/// \param[in] _pred Predicate.
+/// \return The matching message, empty if none arrived in time.
+msgs::PackedPoses waitForPackedPoses(
+    const std::function<bool(const msgs::PackedPoses &)> &_pred)
+{
+  for (int i = 0; i < 200; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_packedPosesMutex);
+      for (const auto &msg : g_packedPoses)
+      {
+        if (_pred(msg))
+          return msg;
+      }
+      g_packedPoses.clear();
+    }
+    common::Time::MSleep(10);
+  }
+  return msgs::PackedPoses();
+}
+
+/// \brief Whether a packed pose message holds the pose of an entity.
+/// \param[in] _msg Packed poses.
+/// \param[in] _id Entity id.
+/// \return True if the id is in the message.
+bool hasPackedPose(const msgs::PackedPoses &_msg, const uint32_t _id)
+{
+  return std::find(_msg.id().begin(), _msg.id().end(), _id) !=
+      _msg.id().end();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, PackedPoses)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  EXPECT_TRUE(world->PackedPoseDelta());
+
+  physics::ModelPtr sphereModel = world->ModelByName("sphere");
+  physics::ModelPtr boxModel = world->ModelByName("box");
+  ASSERT_TRUE(sphereModel != NULL);
+  ASSERT_TRUE(boxModel != NULL);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub =
+      node->Subscribe("~/pose/packed/info", &onPackedPoses);
+
+  // The first message holds every pose
+  msgs::PackedPoses msg = waitForPackedPoses(
+      [](const msgs::PackedPoses &_msg) {return !_msg.delta();});
+  EXPECT_TRUE(hasPackedPose(msg, sphereModel->GetId()));
+  EXPECT_TRUE(hasPackedPose(msg, boxModel->GetId()));
+  EXPECT_TRUE(hasPackedPose(msg, boxModel->GetLink("link")->GetId()));
+  EXPECT_EQ(7 * msg.id_size(), msg.pose_size());
+
+  // Only the pose that changed is sent while the world is paused
+  const ignition::math::Pose3d pose(1, 2, 3, 0, 0, 0.5);
+  boxModel->SetWorldPose(pose);
+  msg = waitForPackedPoses([&](const msgs::PackedPoses &_msg)
+      {return _msg.delta() && hasPackedPose(_msg, boxModel->GetId());});
+  ASSERT_TRUE(msg.delta());
+  EXPECT_FALSE(hasPackedPose(msg, sphereModel->GetId()));
+  for (int i = 0; i < msg.id_size(); ++i)
+  {
+    if (msg.id(i) != boxModel->GetId())
+      continue;
+    const ignition::math::Pose3d received(msg.pose(7 * i),
+        msg.pose(7 * i + 1), msg.pose(7 * i + 2), msg.pose(7 * i + 3),
+        msg.pose(7 * i + 4), msg.pose(7 * i + 5), msg.pose(7 * i + 6));
+    EXPECT_TRUE(received.Pos().Equal(pose.Pos(), 1e-5));
+    EXPECT_TRUE(received.Rot().Equal(pose.Rot(), 1e-5));
+  }
+
+  // Without delta encoding every message holds every pose
+  world->SetPackedPoseDelta(false);
+  EXPECT_FALSE(world->PackedPoseDelta());
+  {
+    std::lock_guard<std::mutex> lock(g_packedPosesMutex);
+    g_packedPoses.clear();
+  }
+  msg = waitForPackedPoses(
+      [](const msgs::PackedPoses &_msg) {return !_msg.delta();});
+  EXPECT_TRUE(hasPackedPose(msg, sphereModel->GetId()));
+}
+
 /////////////////////////////////////////////////
 /// \brief Check if WorldUpdateBegin, BeforePhysicsUpdate and WorldUpdateEnd
 /// events are called, and if the BeforePhysicsUpdate event is really called
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/Actor.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of iterations measured for each crowd size.
+static const unsigned int kSteps = 1000;
+
+class ActorCrowdTest : public ServerFixture
+{
+  /// \brief Spawn a walking actor.
+  /// \param[in] _name Actor name.
+  /// \param[in] _y Position of the actor along the world Y axis.
+  protected: void SpawnActor(const std::string &_name, const double _y)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<actor name='" << _name << "'>"
+        << "  <skin><filename>walk.dae</filename></skin>"
+        << "  <animation name='walking'>"
+        << "    <filename>walk.dae</filename>"
+        << "    <interpolate_x>true</interpolate_x>"
+        << "  </animation>"
+        << "  <script>"
+        << "    <loop>true</loop>"
+        << "    <trajectory id='0' type='walking'>"
+        << "      <waypoint><time>0</time>"
+        << "        <pose>0 " << _y << " 0 0 0 0</pose></waypoint>"
+        << "      <waypoint><time>10</time>"
+        << "        <pose>10 " << _y << " 0 0 0 0</pose></waypoint>"
+        << "    </trajectory>"
+        << "  </script>"
+        << "</actor>"
+        << "</sdf>";
+    this->SpawnSDF(sdf.str());
+  }
+
+  /// \brief Named skeleton pose callback.
+  /// \param[in] _msg Skeleton pose.
+  public: void OnNamedPose(ConstPoseAnimationPtr &_msg)
+  {
+    ++this->count[0];
+    this->bytes[0] += _msg->ByteSize();
+  }
+
+  /// \brief Packed skeleton pose callback.
+  /// \param[in] _msg Skeleton pose.
+  public: void OnPackedPose(ConstPackedSkeletonPosePtr &_msg)
+  {
+    ++this->count[1];
+    this->bytes[1] += _msg->ByteSize();
+  }
+
+  /// \brief Number of named and packed messages received.
+  protected: std::atomic<unsigned int> count[2] = {{0}, {0}};
+
+  /// \brief Size of the named and packed messages received.
+  protected: std::atomic<uint64_t> bytes[2] = {{0}, {0}};
+};
+
+/////////////////////////////////////////////////
+TEST_F(ActorCrowdTest, SkeletonPoseMessages)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Subscribe to both skeleton pose streams, measuring their volume
+  auto namedSub = this->node->Subscribe("~/skeleton_pose/info",
+      &ActorCrowdTest::OnNamedPose, this);
+  auto packedSub = this->node->Subscribe("~/skeleton_pose/packed/info",
+      &ActorCrowdTest::OnPackedPose, this);
+
+  unsigned int actorCount = 0;
+  for (const unsigned int crowd : {1u, 8u, 32u})
+  {
+    for (; actorCount < crowd; ++actorCount)
+      this->SpawnActor("actor_" + std::to_string(actorCount), actorCount);
+    ASSERT_TRUE(world->ModelByName("actor_" + std::to_string(crowd - 1)) !=
+        nullptr);
+
+    for (int i = 0; i < 2; ++i)
+    {
+      this->count[i] = 0;
+      this->bytes[i] = 0;
+    }
+
+    const common::Time start = common::Time::GetWallTime();
+    world->Step(kSteps);
+    const common::Time elapsed = common::Time::GetWallTime() - start;
+
+    // Let the messages arrive
+    for (int i = 0; i < 50 && (!this->count[0] || !this->count[1]); ++i)
+      common::Time::MSleep(10);
+    common::Time::MSleep(100);
+
+    const unsigned int namedCount = this->count[0];
+    const unsigned int packedCount = this->count[1];
+    ASSERT_GT(namedCount, 0u);
+    ASSERT_GT(packedCount, 0u);
+    const double namedSize = static_cast<double>(this->bytes[0]) / namedCount;
+    const double packedSize =
+        static_cast<double>(this->bytes[1]) / packedCount;
+    EXPECT_LT(packedSize, namedSize);
+
+    gzdbg << crowd << " actors, " << kSteps << " steps: ["
+          << elapsed.Double() * 1e3 / kSteps << " ms/step], named ["
+          << namedSize << " bytes/frame], packed [" << packedSize
+          << " bytes/frame]\n";
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class BuoyancyStressTest : public ServerFixture
+{
+  /// \brief SDF of a floating box link, half as dense as the fluid.
+  /// \param[in] _name Link name.
+  /// \param[in] _pos Link position.
+  /// \return Link SDF.
+  public: std::string BoxLink(const std::string &_name,
+              const ignition::math::Vector3d &_pos) const;
+
+  /// \brief SDF of the buoyancy plugin with partial submersion.
+  /// \return Plugin SDF.
+  public: std::string Plugin() const;
+
+  /// \brief Step the world and check that the links float at the surface.
+  /// \param[in] _world World to step.
+  /// \param[in] _label Name of the test case, for the log.
+  public: void Run(physics::WorldPtr _world, const std::string &_label);
+
+  /// \brief Number of floating bodies.
+  public: static constexpr unsigned int kBodies = 100;
+
+  /// \brief Height of the fluid surface.
+  public: static constexpr double kFluidLevel = 2.0;
+};
+
+/////////////////////////////////////////////////
+std::string BuoyancyStressTest::BoxLink(const std::string &_name,
+    const ignition::math::Vector3d &_pos) const
+{
+  // 1 m^3 box of 500 kg floats with its center on the surface
+  std::ostringstream sdf;
+  sdf << "<link name='" << _name << "'>"
+      << "  <pose>" << _pos << " 0 0 0</pose>"
+      << "  <inertial>"
+      << "    <mass>500</mass>"
+      << "    <inertia>"
+      << "      <ixx>83.33</ixx><iyy>83.33</iyy><izz>83.33</izz>"
+      << "      <ixy>0</ixy><ixz>0</ixz><iyz>0</iyz>"
+      << "    </inertia>"
+      << "  </inertial>"
+      << "  <collision name='collision'>"
+      << "    <geometry><box><size>1 1 1</size></box></geometry>"
+      << "  </collision>"
+      << "</link>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+std::string BuoyancyStressTest::Plugin() const
+{
+  std::ostringstream sdf;
+  sdf << "<plugin name='buoyancy' filename='libBuoyancyPlugin.so'>"
+      << "  <fluid_density>1000</fluid_density>"
+      << "  <fluid_level>" << kFluidLevel << "</fluid_level>"
+      << "</plugin>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+void BuoyancyStressTest::Run(physics::WorldPtr _world,
+    const std::string &_label)
+{
+  const unsigned int steps = 2000;
+  common::Time startTime = common::Time::GetWallTime();
+  _world->Step(steps);
+  common::Time endTime = common::Time::GetWallTime();
+
+  gzdbg << _label << ": time elapsed for " << steps << " steps with "
+        << kBodies << " floating bodies [" << endTime - startTime << "]\n";
+
+  // The boxes were released 0.2 m above their equilibrium and bob around it
+  unsigned int count = 0;
+  for (auto const &model : _world->Models())
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      const double z = link->WorldPose().Pos().Z();
+      EXPECT_NEAR(kFluidLevel, z, 0.35) << link->GetScopedName();
+      ++count;
+    }
+  }
+  EXPECT_EQ(kBodies, count);
+
+  EXPECT_LT(endTime - startTime, common::Time(60, 0));
+}
+
+/////////////////////////////////////////////////
+// Many boats, each with its own plugin.
+TEST_F(BuoyancyStressTest, Fleet)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  for (unsigned int i = 0; i < kBodies; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<model name='boat_" << i << "'>"
+        << "  <pose>" << 2.0 * (i % 10) << " " << 2.0 * (i / 10) << " "
+        << kFluidLevel + 0.2 << " 0 0 0</pose>"
+        << BoxLink("hull", ignition::math::Vector3d::Zero)
+        << Plugin()
+        << "</model>"
+        << "</sdf>";
+    SpawnSDF(sdf.str());
+  }
+
+  Run(world, "Fleet");
+}
+
+/////////////////////////////////////////////////
+// One model with many links, clipped in parallel by a single plugin.
+TEST_F(BuoyancyStressTest, Raft)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  std::ostringstream sdf;
+  sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='raft'>"
+      << "  <pose>0 0 " << kFluidLevel + 0.2 << " 0 0 0</pose>";
+  for (unsigned int i = 0; i < kBodies; ++i)
+  {
+    sdf << BoxLink("hull_" + std::to_string(i),
+        ignition::math::Vector3d(2.0 * (i % 10), 2.0 * (i / 10), 0));
+  }
+  sdf << Plugin()
+      << "</model>"
+      << "</sdf>";
+  SpawnSDF(sdf.str());
+
+  Run(world, "Raft");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/CollisionMeshCache.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+
+using namespace gazebo;
+
+class CollisionMeshCacheStress : public ServerFixture,
+                                 public testing::WithParamInterface<const char*>
+{
+  /// \brief Spawn many instances of the same mesh collision and report the
+  /// load time and the memory used by their triangles.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void Instances(const std::string &_physicsEngine);
+};
+
+/////////////////////////////////////////////////
+void CollisionMeshCacheStress::Instances(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::CollisionMeshCache *cache = physics::CollisionMeshCache::Instance();
+  const unsigned int entries = cache->EntryCount();
+  const size_t memory = cache->MemorySize();
+  const uint64_t hits = cache->HitCount();
+
+  // A single static model with one link per instance
+  const unsigned int instances = 1000;
+  std::ostringstream sdf;
+  sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='pallets'>"
+      << "<static>true</static>";
+  for (unsigned int i = 0; i < instances; ++i)
+  {
+    sdf << "<link name='link_" << i << "'>"
+        << "  <pose>" << 3.0 * (i % 40) << " " << 3.0 * (i / 40)
+        << " 1 0 0 0</pose>"
+        << "  <collision name='collision'>"
+        << "    <geometry>"
+        << "      <mesh>"
+        << "        <uri>file://media/models/cube_20k/meshes/cube_20k.stl</uri>"
+        << "      </mesh>"
+        << "    </geometry>"
+        << "  </collision>"
+        << "</link>";
+  }
+  sdf << "</model>"
+      << "</sdf>";
+
+  common::Time startTime = common::Time::GetWallTime();
+  SpawnSDF(sdf.str());
+  common::Time endTime = common::Time::GetWallTime();
+
+  // Without sharing, every instance held its own copy of the triangles
+  const size_t meshMemory = cache->MemorySize() - memory;
+  gzdbg << _physicsEngine << ": loaded " << instances
+        << " mesh collisions in [" << endTime - startTime << "], "
+        << "triangle data [" << meshMemory / 1024 << " KiB], "
+        << "unshared triangle data [" << instances * meshMemory / 1024
+        << " KiB], "
+        << "cache hits [" << cache->HitCount() - hits << "]\n";
+
+  // All instances share a single copy of the triangles
+  EXPECT_EQ(entries + 1, cache->EntryCount());
+  EXPECT_GE(cache->HitCount() - hits, instances - 1);
+  EXPECT_GT(meshMemory, 0u);
+
+  // The copy is released with the last instance
+  world->RemoveModel("pallets");
+  EXPECT_EQ(entries, cache->EntryCount());
+}
+
+/////////////////////////////////////////////////
+TEST_P(CollisionMeshCacheStress, Instances)
+{
+  const std::string physicsEngine = GetParam();
+  if (physicsEngine != "ode" && physicsEngine != "bullet")
+  {
+    gzerr << physicsEngine << " doesn't use the collision mesh cache\n";
+    return;
+  }
+  Instances(physicsEngine);
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, CollisionMeshCacheStress,
+                        PHYSICS_ENGINE_VALUES);
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/Time.hh"
+
+using namespace gazebo;
+
+/// \brief Number of connected callbacks, as with one per plugin.
+static const unsigned int kConnections = 400;
+
+/// \brief Number of signals.
+static const unsigned int kSignals = 20000;
+
+/// \brief Reference dispatcher storing its callbacks the way EventT used
+/// to: a map of connections, and a mutex locked on every signal.
+class MapDispatcher
+{
+  /// \brief Connect a callback.
+  /// \param[in] _callback Callback.
+  public: void Connect(const std::function<void (const int &)> &_callback)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    const int id = this->connections.empty() ? 0 :
+        this->connections.rbegin()->first + 1;
+    this->connections[id].reset(
+        new std::function<void (const int &)>(_callback));
+  }
+
+  /// \brief Call all the callbacks.
+  /// \param[in] _value Callback parameter.
+  public: void Signal(const int &_value)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+    }
+    for (const auto &iter : this->connections)
+      (*iter.second)(_value);
+  }
+
+  /// \brief Callbacks.
+  private: std::map<int,
+      std::unique_ptr<std::function<void (const int &)>>> connections;
+
+  /// \brief Lock.
+  private: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+TEST(EventDispatch, Signal)
+{
+  int total = 0;
+  auto callback = [&total](const int &_i)
+  {
+    total += _i;
+  };
+
+  event::EventT<void (const int &)> evt;
+  std::vector<event::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < kConnections; ++i)
+    connections.push_back(evt.Connect(callback));
+  EXPECT_EQ(kConnections, evt.ConnectionCount());
+
+  MapDispatcher reference;
+  for (unsigned int i = 0; i < kConnections; ++i)
+    reference.Connect(callback);
+
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < kSignals; ++i)
+    evt(1);
+  const common::Time eventTime = common::Time::GetWallTime() - start;
+  EXPECT_EQ(static_cast<int>(kConnections * kSignals), total);
+
+  total = 0;
+  start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < kSignals; ++i)
+    reference.Signal(1);
+  const common::Time referenceTime = common::Time::GetWallTime() - start;
+  EXPECT_EQ(static_cast<int>(kConnections * kSignals), total);
+
+  const double calls = static_cast<double>(kConnections) * kSignals;
+  gzdbg << kSignals << " signals to " << kConnections << " connections: "
+        << "EventT [" << eventTime.Double() * 1e9 / calls
+        << " ns/call], map and mutex [" << referenceTime.Double() * 1e9 / calls
+        << " ns/call]\n";
+}
+
+/////////////////////////////////////////////////
+TEST(EventDispatch, SignalWhileConnecting)
+{
+  std::atomic<int> total(0);
+  event::EventT<void (const int &)> evt;
+  std::vector<event::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < kConnections; ++i)
+  {
+    connections.push_back(evt.Connect([&total](const int &_i)
+        {
+          total.fetch_add(_i, std::memory_order_relaxed);
+        }));
+  }
+
+  // Another thread keeps connecting and disconnecting, as when models are
+  // inserted and removed while the world runs
+  std::atomic_bool done(false);
+  unsigned int changes = 0;
+  std::thread thread([&]()
+      {
+        while (!done)
+        {
+          event::ConnectionPtr conn = evt.Connect([](const int &) {});
+          conn.reset();
+          ++changes;
+        }
+      });
+
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < kSignals; ++i)
+    evt(1);
+  const common::Time time = common::Time::GetWallTime() - start;
+  done = true;
+  thread.join();
+
+  // The permanent connections saw every signal
+  EXPECT_EQ(static_cast<int>(kConnections * kSignals), total);
+  EXPECT_EQ(kConnections, evt.ConnectionCount());
+
+  gzdbg << kSignals << " signals to " << kConnections << " connections, with "
+        << changes << " concurrent connections: ["
+        << time.Double() * 1e9 / (static_cast<double>(kConnections) * kSignals)
+        << " ns/call]\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,11 +14,62 @@
  * limitations under the License.
  *
 */
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
+
+/// \brief Number of crates inserted at once.
+static const unsigned int kCrates = 5000;
+
+/// \brief Number of crates inserted one by one, from strings.
+static const unsigned int kStringCrates = 500;
+
 class FactoryStressTest : public ServerFixture
 {
+  /// \brief Get the description of a crate.
+  /// \param[in] _name Model name.
+  /// \param[in] _pose Model pose.
+  /// \return SDF string of the crate.
+  protected: std::string CrateSDF(const std::string &_name,
+                 const ignition::math::Pose3d &_pose)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<model name='" << _name << "'>"
+        << "  <pose>" << _pose << "</pose>"
+        << "  <link name='link'>"
+        << "    <inertial><mass>10</mass></inertial>"
+        << "    <collision name='collision'>"
+        << "      <geometry><box><size>0.5 0.5 0.5</size></box></geometry>"
+        << "    </collision>"
+        << "    <visual name='visual'>"
+        << "      <geometry><box><size>0.5 0.5 0.5</size></box></geometry>"
+        << "    </visual>"
+        << "  </link>"
+        << "</model>"
+        << "</sdf>";
+    return sdf.str();
+  }
+
+  /// \brief Step the world until it has a number of models.
+  /// \param[in] _world The world.
+  /// \param[in] _count Number of models to wait for.
+  /// \return Wall time it took.
+  protected: common::Time WaitForModels(physics::WorldPtr _world,
+                 const unsigned int _count)
+  {
+    const common::Time start = common::Time::GetWallTime();
+    while (_world->ModelCount() < _count &&
+        common::Time::GetWallTime() - start < common::Time(600, 0))
+    {
+      _world->Step(1);
+    }
+    return common::Time::GetWallTime() - start;
+  }
 };
 
 /////////////////////////////////////////////////
@@ -44,6 +95,57 @@ TEST_F(FactoryStressTest, Bookshelf)
   sub.reset();
 }
 
+/////////////////////////////////////////////////
+TEST_F(FactoryStressTest, Crates)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  const unsigned int initialCount = world->ModelCount();
+
+  // Poses on a grid, 1 m apart
+  const unsigned int side = 100;
+  std::vector<ignition::math::Pose3d> poses;
+  for (unsigned int i = 0; i < kCrates; ++i)
+    poses.emplace_back(i % side, i / side + 1, 0.25, 0, 0, 0);
+
+  // One by one, each string is parsed
+  for (unsigned int i = 0; i < kStringCrates; ++i)
+  {
+    world->InsertModelString(this->CrateSDF(
+          "string_crate_" + std::to_string(i),
+          ignition::math::Pose3d(i % side, -1.0 - i / side, 0.25, 0, 0, 0)));
+  }
+  const common::Time stringTime =
+    this->WaitForModels(world, initialCount + kStringCrates);
+  ASSERT_EQ(initialCount + kStringCrates, world->ModelCount());
+
+  // All at once, parsed once
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  ASSERT_TRUE(sdf::readString(this->CrateSDF("crate",
+          ignition::math::Pose3d::Zero), sdf));
+  sdf::ElementPtr crate = sdf->Root()->GetElement("model");
+  ASSERT_TRUE(crate != nullptr);
+
+  world->InsertModels(crate, poses, "crate_");
+  const common::Time bulkTime =
+    this->WaitForModels(world, initialCount + kStringCrates + kCrates);
+  ASSERT_EQ(initialCount + kStringCrates + kCrates, world->ModelCount());
+
+  // Each copy has its own name and pose
+  for (unsigned int i = 0; i < kCrates; i += kCrates / 10)
+  {
+    physics::ModelPtr model = world->ModelByName("crate_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr);
+    EXPECT_LT(poses[i].Pos().Distance(model->WorldPose().Pos()), 1e-3);
+  }
+
+  gzdbg << kStringCrates << " crates inserted from strings in ["
+        << stringTime.Double() << " s], " << kCrates
+        << " crates inserted at once in [" << bulkTime.Double() << " s]\n";
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -15,11 +15,13 @@
  *
 */
 #include <iostream>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/common.hh"
+#include "gazebo/common/PixelFormatConversion.hh"
 
 using namespace std;
 using namespace gazebo;
@@ -62,6 +64,78 @@ TEST_F(ImageConvertStressTest, ManyConversions)
   EXPECT_LE(memAfter - memBefore, 2000);
 }
 
+/////////////////////////////////////////////////
+// Measure the throughput of the pixel format converters on a full HD frame.
+// Results are printed for human inspection.
+TEST_F(ImageConvertStressTest, ConversionThroughput)
+{
+  const unsigned int width = 1920;
+  const unsigned int height = 1080;
+  const unsigned int pixels = width * height;
+  const int iterations = 200;
+
+  std::vector<unsigned char> rgb(pixels * 3);
+  for (unsigned int i = 0; i < rgb.size(); ++i)
+    rgb[i] = static_cast<unsigned char>(i % 251);
+  std::vector<unsigned char> rgba(pixels * 4, 255);
+  std::vector<float> depth(pixels, 2.5f);
+
+  std::vector<unsigned char> out(pixels * 3);
+  std::vector<uint16_t> out16(pixels);
+
+  auto report = [&](const std::string &_name, const common::Time &_start)
+  {
+    double seconds = (common::Time::GetWallTime() - _start).Double();
+    EXPECT_GT(seconds, 0.0);
+    gzmsg << _name << ": " << iterations / seconds << " frames/s, "
+      << (iterations * pixels) / seconds * 1e-6 << " Mpixel/s\n";
+  };
+
+  common::Time start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    common::ConvertRGBToBGR(rgb.data(), out.data(), pixels);
+  report("RGB to BGR", start);
+  EXPECT_EQ(rgb[2], out[0]);
+
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    common::ConvertRGBAToRGB(rgba.data(), out.data(), pixels);
+  report("RGBA to RGB", start);
+
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    common::ConvertRGBToMono(rgb.data(), out.data(), pixels);
+  report("RGB to mono", start);
+
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    EXPECT_TRUE(common::ConvertRGBToBayer(rgb.data(), out.data(), width,
+          height, common::Image::BAYER_RGGB8));
+  }
+  report("RGB to BAYER_RGGB8", start);
+
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    common::ConvertDepthToUInt16(depth.data(), out16.data(), pixels);
+  report("Depth to uint16", start);
+  EXPECT_EQ(2500u, out16[0]);
+
+  // Round trip through common::Image, reusing the same image and buffer
+  common::Image image;
+  unsigned char *data = nullptr;
+  unsigned int size = 0;
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    image.SetFromData(rgb.data(), width, height, common::Image::RGB_INT8);
+    image.GetRGBData(&data, size);
+  }
+  report("Image SetFromData + GetRGBData", start);
+  EXPECT_EQ(pixels * 3, size);
+  delete [] data;
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/JointController.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of controlled joints, as in a humanoid.
+static const unsigned int kJoints = 40;
+
+/// \brief Number of iterations measured.
+static const unsigned int kSteps = 2000;
+
+class JointControllerBatchTest : public ServerFixture
+{
+  /// \brief Spawn a model with pendulums hinged to the world.
+  /// \param[in] _name Model name.
+  protected: void SpawnPendulums(const std::string &_name)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<model name='" << _name << "'>"
+        << "  <pose>0 0 2 0 0 0</pose>";
+    for (unsigned int i = 0; i < kJoints; ++i)
+    {
+      sdf << "  <link name='arm_" << i << "'>"
+          << "    <pose>0 " << i * 0.2 << " -0.5 0 0 0</pose>"
+          << "    <inertial><mass>1</mass></inertial>"
+          << "  </link>"
+          << "  <joint name='joint_" << i << "' type='revolute'>"
+          << "    <parent>world</parent>"
+          << "    <child>arm_" << i << "</child>"
+          << "    <pose>0 0 0.5 0 0 0</pose>"
+          << "    <axis><xyz>1 0 0</xyz></axis>"
+          << "  </joint>";
+    }
+    sdf << "</model>"
+        << "</sdf>";
+    this->SpawnSDF(sdf.str());
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(JointControllerBatchTest, PositionControl)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnPendulums("humanoid");
+  physics::ModelPtr model = world->ModelByName("humanoid");
+  ASSERT_TRUE(model != nullptr);
+
+  // One controller commands the joints by name, the other in a group
+  physics::JointControllerPtr byName(new physics::JointController(model));
+  physics::JointControllerPtr batch(new physics::JointController(model));
+  std::vector<std::string> names;
+  std::vector<double> targets;
+  for (unsigned int i = 0; i < kJoints; ++i)
+  {
+    physics::JointPtr joint = model->GetJoint("joint_" + std::to_string(i));
+    ASSERT_TRUE(joint != nullptr);
+    byName->AddJoint(joint);
+    batch->AddJoint(joint);
+    names.push_back(joint->GetScopedName());
+    targets.push_back(0.01 * i);
+  }
+
+  const int group = batch->CreateGroup(names,
+      physics::JointController::POSITION);
+  ASSERT_EQ(0, group);
+
+  common::Time elapsed[2];
+  for (unsigned int i = 0; i < kSteps; ++i)
+  {
+    world->Step(1);
+
+    // Commands are set every step, as a controller would
+    common::Time start = common::Time::GetWallTime();
+    for (unsigned int j = 0; j < kJoints; ++j)
+      byName->SetPositionTarget(names[j], targets[j]);
+    byName->Update();
+    elapsed[0] += common::Time::GetWallTime() - start;
+
+    start = common::Time::GetWallTime();
+    EXPECT_TRUE(batch->SetCommands(group, targets));
+    batch->Update();
+    elapsed[1] += common::Time::GetWallTime() - start;
+  }
+
+  gzdbg << kSteps << " updates of " << kJoints << " position controllers: "
+        << "by name [" << elapsed[0].Double() * 1e6 / kSteps
+        << " us/update], in a group [" << elapsed[1].Double() * 1e6 / kSteps
+        << " us/update]\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
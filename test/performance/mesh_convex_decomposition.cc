@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/CollisionMeshCache.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+
+using namespace gazebo;
+
+class MeshConvexDecompositionStress : public ServerFixture,
+    public testing::WithParamInterface<const char*>
+{
+  /// \brief SDF of a chair model with a mesh collision.
+  /// \param[in] _name Model name.
+  /// \param[in] _pose Model pose.
+  /// \param[in] _maxConvexHulls Number of convex hulls, zero for raw
+  /// triangles.
+  /// \return Model SDF.
+  public: std::string Chair(const std::string &_name,
+              const ignition::math::Pose3d &_pose,
+              const unsigned int _maxConvexHulls) const;
+
+  /// \brief Drop a pile of chairs and time the steps and, with ODE, the
+  /// collision detection.
+  /// \param[in] _world World to run.
+  /// \param[in] _name Model name prefix.
+  /// \param[in] _maxConvexHulls Number of convex hulls per chair, zero for
+  /// raw triangles.
+  /// \param[out] _stepTime Wall time of the steps.
+  /// \param[out] _collisionTime Wall time of the collision detection.
+  public: void Run(physics::WorldPtr _world, const std::string &_name,
+              const unsigned int _maxConvexHulls, common::Time &_stepTime,
+              common::Time &_collisionTime);
+
+  /// \brief Compare raw trimesh collisions with their convex hulls.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void Compare(const std::string &_physicsEngine);
+
+  /// \brief Chairs per side of each layer.
+  public: static constexpr unsigned int kSide = 4;
+
+  /// \brief Number of layers.
+  public: static constexpr unsigned int kLayers = 2;
+};
+
+/////////////////////////////////////////////////
+std::string MeshConvexDecompositionStress::Chair(const std::string &_name,
+    const ignition::math::Pose3d &_pose,
+    const unsigned int _maxConvexHulls) const
+{
+  std::ostringstream sdf;
+  sdf << "<sdf version='" << SDF_VERSION << "'"
+      << " xmlns:gz='http://gazebosim.org/schema'>"
+      << "<model name='" << _name << "'>"
+      << "<pose>" << _pose << "</pose>"
+      << "<link name='link'>"
+      << "  <inertial>"
+      << "    <pose>0.2 0.2 0.4 0 0 0</pose>"
+      << "    <mass>5</mass>"
+      << "    <inertia>"
+      << "      <ixx>0.35</ixx><iyy>0.35</iyy><izz>0.17</izz>"
+      << "      <ixy>0</ixy><ixz>0</ixz><iyz>0</iyz>"
+      << "    </inertia>"
+      << "  </inertial>"
+      << "  <collision name='collision'>"
+      << "    <geometry>"
+      << "      <mesh>"
+      << "        <uri>file://media/models/chair3/models/chair.stl</uri>"
+      << "        <scale>0.01 0.01 0.01</scale>";
+  if (_maxConvexHulls > 0)
+  {
+    sdf << "        <gz:convex_decomposition>"
+        << "          <max_convex_hulls>" << _maxConvexHulls
+        << "</max_convex_hulls>"
+        << "        </gz:convex_decomposition>";
+  }
+  sdf << "      </mesh>"
+      << "    </geometry>"
+      << "  </collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+void MeshConvexDecompositionStress::Run(physics::WorldPtr _world,
+    const std::string &_name, const unsigned int _maxConvexHulls,
+    common::Time &_stepTime, common::Time &_collisionTime)
+{
+  physics::CollisionMeshCache *cache = physics::CollisionMeshCache::Instance();
+  const size_t memory = cache->MemorySize();
+
+  // Upper layers are shifted and turned so that the chairs tangle
+  const unsigned int count = kSide * kSide * kLayers;
+  std::vector<physics::ModelPtr> models;
+  common::Time loadStart = common::Time::GetWallTime();
+  for (unsigned int layer = 0; layer < kLayers; ++layer)
+  {
+    for (unsigned int i = 0; i < kSide * kSide; ++i)
+    {
+      std::ostringstream name;
+      name << _name << "_" << layer << "_" << i;
+      const ignition::math::Pose3d pose(0.4 * (i % kSide) + 0.2 * layer,
+          0.4 * (i / kSide) + 0.2 * layer, 0.05 + 0.9 * layer,
+          0, 0, 1.2 * layer);
+      SpawnSDF(this->Chair(name.str(), pose, _maxConvexHulls));
+
+      physics::ModelPtr model = _world->ModelByName(name.str());
+      ASSERT_TRUE(model != nullptr) << name.str();
+      models.push_back(model);
+    }
+  }
+  const common::Time loadTime = common::Time::GetWallTime() - loadStart;
+
+  auto meshShape = boost::dynamic_pointer_cast<physics::MeshShape>(
+      models[0]->GetLink("link")->GetCollision("collision")->GetShape());
+  ASSERT_TRUE(meshShape != nullptr);
+  EXPECT_EQ(_maxConvexHulls, meshShape->MaxConvexHulls());
+
+  // Let the pile fall and settle
+  const unsigned int steps = 2000;
+  common::Time start = common::Time::GetWallTime();
+  _world->Step(steps);
+  _stepTime = common::Time::GetWallTime() - start;
+
+  // Time the collision detection alone on the settled pile
+  physics::PhysicsEnginePtr physics = _world->Physics();
+  const unsigned int collisions = 200;
+  start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < collisions; ++i)
+    physics->UpdateCollision();
+  _collisionTime = common::Time::GetWallTime() - start;
+
+  gzdbg << physics->GetType() << " " << _name << ": " << count
+        << " chairs, loaded in [" << loadTime << "], triangle data ["
+        << (cache->MemorySize() - memory) / 1024 << " KiB], "
+        << steps << " steps in [" << _stepTime << "], "
+        << collisions << " collision updates in [" << _collisionTime << "]\n";
+
+  // The chairs rest on the ground and on each other
+  for (auto const &model : models)
+  {
+    EXPECT_GT(model->WorldPose().Pos().Z(), -0.1) << model->GetName();
+    EXPECT_LT(model->WorldLinearVel().Length(), 0.5) << model->GetName();
+  }
+
+  for (auto const &model : models)
+    _world->RemoveModel(model);
+}
+
+/////////////////////////////////////////////////
+void MeshConvexDecompositionStress::Compare(
+    const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  common::Time rawStep, rawCollision;
+  Run(world, "raw", 0, rawStep, rawCollision);
+
+  common::Time hullStep, hullCollision;
+  Run(world, "hulls", 16, hullStep, hullCollision);
+
+  gzdbg << _physicsEngine << ": convex hulls step speedup ["
+        << rawStep.Double() / std::max(hullStep.Double(), 1e-9)
+        << "], collision speedup ["
+        << rawCollision.Double() / std::max(hullCollision.Double(), 1e-9)
+        << "]\n";
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshConvexDecompositionStress, Compare)
+{
+  const std::string physicsEngine = GetParam();
+  if (physicsEngine != "ode" && physicsEngine != "bullet")
+  {
+    gzerr << physicsEngine << " doesn't use the collision mesh cache\n";
+    return;
+  }
+  Compare(physicsEngine);
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, MeshConvexDecompositionStress,
+                        PHYSICS_ENGINE_VALUES);
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <string>
+
+#include "gazebo/physics/ode/ODELink.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Simulated time measured for each configuration, in seconds.
+static const double kDuration = 2.0;
+
+class ODEFastLinksTest : public ServerFixture
+{
+  /// \brief Shoot the projectile at the wall and simulate it.
+  /// \param[in] _stepSize Step size.
+  /// \param[in] _fast True to flag the projectile as fast.
+  /// \param[out] _x Final position of the projectile along X.
+  /// \return Steps simulated per second of wall time.
+  protected: double Shoot(const double _stepSize, const bool _fast,
+                          double &_x)
+  {
+    physics::WorldPtr world = physics::get_world("default");
+    world->Reset();
+    world->Physics()->SetMaxStepSize(_stepSize);
+
+    physics::ODELinkPtr link = boost::static_pointer_cast<physics::ODELink>(
+        world->ModelByName("projectile")->GetLink());
+    link->SetFast(_fast);
+    link->SetLinearVel(ignition::math::Vector3d(50, 0, 0));
+
+    const unsigned int steps = static_cast<unsigned int>(
+        std::round(kDuration / _stepSize));
+    const common::Time start = common::Time::GetWallTime();
+    world->Step(steps);
+    const common::Time elapsed = common::Time::GetWallTime() - start;
+
+    _x = link->WorldPose().Pos().X();
+    return steps / elapsed.Double();
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(ODEFastLinksTest, Projectile)
+{
+  this->Load("test/worlds/fast_projectile.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Boxes resting on the ground, which all the substeps simulate with
+  // their contacts
+  world->SetGravity(ignition::math::Vector3d(0, 0, -9.8));
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    this->SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(2.0 * (i % 10), 5 + 2.0 * (i / 10), 0.5));
+  }
+  world->Step(100);
+
+  // A step small enough for the projectile not to tunnel, for the whole
+  // world
+  double smallX;
+  const double smallRate = this->Shoot(0.001, false, smallX);
+  EXPECT_LT(smallX, 5.0);
+
+  // A large step, which the projectile tunnels at
+  double largeX;
+  const double largeRate = this->Shoot(0.01, false, largeX);
+  EXPECT_GT(largeX, 5.0);
+
+  // A large step, split only while the projectile flies
+  double fastX;
+  const double fastRate = this->Shoot(0.01, true, fastX);
+  EXPECT_LT(fastX, 5.0);
+  EXPECT_NEAR(smallX, fastX, 0.1);
+
+  gzdbg << "Simulated seconds per second: 1 ms step ["
+        << smallRate * 0.001 << "], 10 ms step [" << largeRate * 0.01
+        << "], 10 ms step with fast links [" << fastRate * 0.01 << "]\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/UpdateScheduler.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of controlled models.
+static const unsigned int kModels = 32;
+
+/// \brief Number of iterations measured.
+static const unsigned int kSteps = 500;
+
+class ParallelPluginUpdateTest : public ServerFixture
+{
+  /// \brief Spawn a pendulum with a revolute joint to the world.
+  /// \param[in] _name Model name.
+  /// \param[in] _y Position of the pivot along the world Y axis.
+  protected: void SpawnPendulum(const std::string &_name, const double _y)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<model name='" << _name << "'>"
+        << "  <pose>0 " << _y << " 2 0 0 0</pose>"
+        << "  <link name='arm'>"
+        << "    <pose>0 0 -0.5 0 0 0</pose>"
+        << "    <inertial><mass>1</mass></inertial>"
+        << "    <collision name='collision'>"
+        << "      <geometry><box><size>0.05 0.05 1</size></box></geometry>"
+        << "    </collision>"
+        << "  </link>"
+        << "  <joint name='pivot' type='revolute'>"
+        << "    <parent>world</parent>"
+        << "    <child>arm</child>"
+        << "    <pose>0 0 0.5 0 0 0</pose>"
+        << "    <axis><xyz>1 0 0</xyz></axis>"
+        << "  </joint>"
+        << "</model>"
+        << "</sdf>";
+    this->SpawnSDF(sdf.str());
+  }
+};
+
+/// \brief Joint controller, as JointControlPlugin would set up, with an
+/// expensive command: a PID on a target computed by searching the best
+/// constant torque over a short horizon of a pendulum model.
+class Controller
+{
+  /// \brief Constructor.
+  /// \param[in] _joint Controlled joint.
+  /// \param[in] _target Target position.
+  public: Controller(physics::JointPtr _joint, const double _target)
+    : joint(_joint), target(_target)
+  {
+  }
+
+  /// \brief Reset the controller state.
+  public: void Reset()
+  {
+    this->integral = 0;
+    this->prevError = 0;
+  }
+
+  /// \brief Compute and apply the joint command.
+  /// \param[in] _info Update information.
+  public: void Update(const common::UpdateInfo &/*_info*/)
+  {
+    const double dt = 0.001;
+    const double position = this->joint->Position(0);
+    const double velocity = this->joint->GetVelocity(0);
+
+    // Rollouts of a simple pendulum model
+    double bestTorque = 0;
+    double bestCost = 1e30;
+    for (int c = -50; c <= 50; ++c)
+    {
+      const double torque = c * 0.2;
+      double q = position;
+      double v = velocity;
+      double cost = 0;
+      for (int k = 0; k < 100; ++k)
+      {
+        v += (torque - 9.81 * 0.5 * std::sin(q)) / 0.33 * dt;
+        q += v * dt;
+        cost += (q - this->target) * (q - this->target) + 1e-4 * v * v;
+      }
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestTorque = torque;
+      }
+    }
+
+    const double error = position - this->target;
+    this->integral += error * dt;
+    const double derivative = (error - this->prevError) / dt;
+    this->prevError = error;
+    const double pid = -(10 * error + 0.1 * this->integral +
+        0.01 * derivative);
+
+    this->joint->SetForce(0, 0.5 * bestTorque + 0.5 * pid);
+  }
+
+  /// \brief Controlled joint.
+  private: physics::JointPtr joint;
+
+  /// \brief Target position.
+  private: double target;
+
+  /// \brief Integral of the error.
+  private: double integral = 0;
+
+  /// \brief Error at the previous update.
+  private: double prevError = 0;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ParallelPluginUpdateTest, JointControllers)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::vector<std::unique_ptr<Controller>> controllers;
+  std::vector<physics::JointPtr> joints;
+  for (unsigned int i = 0; i < kModels; ++i)
+  {
+    const std::string name = "pendulum_" + std::to_string(i);
+    this->SpawnPendulum(name, i * 0.5);
+    physics::ModelPtr model = world->ModelByName(name);
+    ASSERT_TRUE(model != nullptr);
+    physics::JointPtr joint = model->GetJoint("pivot");
+    ASSERT_TRUE(joint != nullptr);
+    joints.push_back(joint);
+    controllers.emplace_back(new Controller(joint, 0.1 * (i % 10)));
+  }
+
+  // Each controller reads the state of its model and writes its joints
+  physics::UpdateSchedulerPtr scheduler = world->Scheduler();
+  ASSERT_TRUE(scheduler != nullptr);
+  std::vector<event::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < kModels; ++i)
+  {
+    const std::string name = "pendulum_" + std::to_string(i);
+    Controller *controller = controllers[i].get();
+    connections.push_back(scheduler->Connect(
+        [controller](const common::UpdateInfo &_info)
+        {
+          controller->Update(_info);
+        }, {name}, {name + "::joints"}));
+  }
+  EXPECT_EQ(kModels, scheduler->ConnectionCount());
+  EXPECT_EQ(1u, scheduler->StageCount());
+
+  // Run the same steps in order and in parallel, the results must match
+  std::vector<double> positions[2];
+  common::Time elapsed[2];
+  for (const bool parallel : {false, true})
+  {
+    world->Reset();
+    for (auto &controller : controllers)
+      controller->Reset();
+    scheduler->SetParallel(parallel);
+
+    const common::Time start = common::Time::GetWallTime();
+    world->Step(kSteps);
+    elapsed[parallel] = common::Time::GetWallTime() - start;
+
+    for (const auto &joint : joints)
+      positions[parallel].push_back(joint->Position(0));
+  }
+
+  for (unsigned int i = 0; i < kModels; ++i)
+    EXPECT_DOUBLE_EQ(positions[0][i], positions[1][i]);
+
+  gzdbg << kSteps << " steps with " << kModels << " joint controllers: "
+        << "in order [" << elapsed[0].Double() * 1e3 / kSteps
+        << " ms/step], in parallel [" << elapsed[1].Double() * 1e3 / kSteps
+        << " ms/step]\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of iterations measured for each step multiple.
+static const unsigned int kSteps = 2000;
+
+class PhysicsRateGroupsTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+TEST_F(PhysicsRateGroupsTest, MobileRobots)
+{
+  this->Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // A small step, as a stiff manipulator would need
+  world->Physics()->SetMaxStepSize(0.0001);
+
+  // Simple mobile robots, pushed around on the ground
+  std::vector<physics::ModelPtr> robots;
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    const std::string name = "robot_" + std::to_string(i);
+    this->SpawnBox(name, ignition::math::Vector3d(0.5, 0.4, 0.2),
+        ignition::math::Vector3d(1.0 * (i % 20), 1.0 * (i / 20), 0.1));
+    robots.push_back(world->ModelByName(name));
+    ASSERT_TRUE(robots.back() != nullptr);
+  }
+  world->Step(100);
+
+  for (const unsigned int multiple : {1u, 10u, 50u})
+  {
+    for (auto &robot : robots)
+      robot->SetStepMultiple(multiple);
+
+    const common::Time start = common::Time::GetWallTime();
+    for (unsigned int i = 0; i < kSteps; ++i)
+    {
+      for (auto &robot : robots)
+        robot->GetLink()->AddForce(ignition::math::Vector3d(1, 0, 0));
+      world->Step(1);
+    }
+    const common::Time elapsed = common::Time::GetWallTime() - start;
+
+    // Still resting on the ground
+    for (auto &robot : robots)
+      EXPECT_NEAR(0.1, robot->WorldPose().Pos().Z(), 0.01);
+
+    gzdbg << robots.size() << " robots, step multiple " << multiple << ": ["
+          << elapsed.Double() * 1e3 / kSteps << " ms/step], ["
+          << kSteps * 0.0001 / elapsed.Double()
+          << " simulated seconds per second]\n";
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
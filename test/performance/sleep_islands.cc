@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+
+using namespace gazebo;
+
+/// \brief Number of iterations measured with and without sleeping.
+static const unsigned int kSteps = 1000;
+
+class SleepIslandsStress : public ServerFixture,
+                           public testing::WithParamInterface<const char*>
+{
+  /// \brief Compare the step time of a world of resting boxes, with and
+  /// without sleeping.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void RestingBoxes(const std::string &_physicsEngine);
+};
+
+/////////////////////////////////////////////////
+void SleepIslandsStress::RestingBoxes(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Stacks of two boxes on a grid
+  const unsigned int stacks = 100;
+  for (unsigned int i = 0; i < stacks; ++i)
+  {
+    const double x = 2.0 * (i % 10);
+    const double y = 2.0 * (i / 10);
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+      SpawnBox("box_" + std::to_string(i) + "_" + std::to_string(j),
+          ignition::math::Vector3d::One,
+          ignition::math::Vector3d(x, y, 0.5 + j));
+    }
+  }
+
+  // Let the boxes settle
+  world->Step(kSteps);
+
+  common::Time start = common::Time::GetWallTime();
+  world->Step(kSteps);
+  const common::Time awake = common::Time::GetWallTime() - start;
+
+  // Let the boxes fall asleep
+  physics::SleepManagerPtr mgr = world->SleepMgr();
+  mgr->SetEnabled(true);
+  world->Step(kSteps);
+  EXPECT_EQ(2 * stacks, mgr->SleepingCount());
+
+  start = common::Time::GetWallTime();
+  world->Step(kSteps);
+  const common::Time asleep = common::Time::GetWallTime() - start;
+  EXPECT_EQ(2 * stacks, mgr->SleepingCount());
+
+  gzdbg << _physicsEngine << ": " << 2 * stacks << " resting boxes, awake ["
+        << awake.Double() * 1e3 / kSteps << " ms/step], asleep ["
+        << asleep.Double() * 1e3 / kSteps << " ms/step]\n";
+}
+
+/////////////////////////////////////////////////
+TEST_P(SleepIslandsStress, RestingBoxes)
+{
+  const std::string physicsEngine = GetParam();
+  if (physicsEngine == "simbody")
+  {
+    gzerr << physicsEngine << " can't disable links\n";
+    return;
+  }
+  RestingBoxes(physicsEngine);
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, SleepIslandsStress,
+                        PHYSICS_ENGINE_VALUES);
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}